@@ -0,0 +1,219 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <type_traits>  //  std::is_arithmetic, std::is_same, std::is_floating_point
+#include <string>  //  std::string, std::to_string
+#include <vector>  //  std::vector
+#include <initializer_list>  //  std::initializer_list
+#include <sstream>  //  std::stringstream
+#include <iomanip>  //  std::setprecision
+#include <limits>  //  std::numeric_limits
+#include <utility>  //  std::move, std::exchange
+#include <tuple>  //  std::tuple
+#include <cmath>  //  std::isfinite
+#include <system_error>  //  std::system_error
+
+#include "functional/cxx_core_features.h"
+#include "tuple_helper/tuple_iteration.h"
+#include "error_code.h"
+
+//  defining `SQLITE_ORM_ENABLE_CARRAY` promises that the carray extension is registered on every connection,
+//  e.g. by `sqlite3_auto_extension()`, and its pointer-passing interface is available (see carray.h)
+#if defined(SQLITE_ORM_ENABLE_CARRAY) && SQLITE_VERSION_NUMBER >= 3020000 &&                                           \
+    defined(SQLITE_ORM_INLINE_VARIABLES_SUPPORTED)
+#define SQLITE_ORM_CARRAY_IN_SUPPORTED
+#endif
+
+//  `as_array()` needs either the carray or the JSON1 extension
+#if defined(SQLITE_ORM_CARRAY_IN_SUPPORTED) || defined(SQLITE_ENABLE_JSON1)
+#define SQLITE_ORM_AS_ARRAY_SUPPORTED
+#endif
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+#ifdef SQLITE_ORM_CARRAY_IN_SUPPORTED
+        /**
+         *  The element type of the C array passed to `carray()` for array values of type E,
+         *  and the name of that type as carray's third argument.
+         */
+        template<class E, class SFINAE = void>
+        struct carray_element;
+
+        template<class E>
+        struct carray_element<E, std::enable_if_t<std::is_integral<E>::value>> {
+            using type = sqlite3_int64;
+
+            static constexpr const char* name() {
+                return "int64";
+            }
+
+            static type get(E value) {
+                return value;
+            }
+        };
+
+        template<class E>
+        struct carray_element<E, std::enable_if_t<std::is_floating_point<E>::value>> {
+            using type = double;
+
+            static constexpr const char* name() {
+                return "double";
+            }
+
+            static type get(E value) {
+                return value;
+            }
+        };
+
+        template<>
+        struct carray_element<std::string, void> {
+            using type = const char*;
+
+            static constexpr const char* name() {
+                return "char*";
+            }
+
+            static type get(const std::string& value) {
+                return value.c_str();
+            }
+        };
+#endif
+
+        /**
+         *  Values of an IN list bound as one array,
+         *  such that the statement's text doesn't depend on the number of values.
+         *
+         *  The values are bound as a C array and its length for `carray(?, ?, '<type>')`
+         *  if `SQLITE_ORM_ENABLE_CARRAY` is defined, otherwise as a JSON array text for `json_each(?)`,
+         *  which needs `SQLITE_ENABLE_JSON1`.
+         */
+        template<class E>
+        struct array_values_t {
+            static_assert(std::is_arithmetic<E>::value || std::is_same<E, std::string>::value,
+                          "Array values must be arithmetic or std::string");
+
+            using value_type = E;
+
+            std::vector<E> values;
+
+#ifdef SQLITE_ORM_CARRAY_IN_SUPPORTED
+            /**
+             *  Fills and returns the C array passed to `carray()`.
+             *  It is kept here because carray reads it while the statement is executed.
+             */
+            std::vector<typename carray_element<E>::type>& carray_values() const {
+                this->carrayValues.clear();
+                this->carrayValues.reserve(this->values.size());
+                for (auto& value: this->values) {
+                    this->carrayValues.push_back(carray_element<E>::get(value));
+                }
+                return this->carrayValues;
+            }
+
+            mutable std::vector<typename carray_element<E>::type> carrayValues;
+#endif
+        };
+
+        inline void write_json_value(std::stringstream& ss, const std::string& value) {
+            ss << '"';
+            for (unsigned char c: value) {
+                switch (c) {
+                    case '"':
+                        ss << "\\\"";
+                        break;
+                    case '\\':
+                        ss << "\\\\";
+                        break;
+                    default:
+                        if (c < 0x20) {
+                            static constexpr char hexDigits[] = "0123456789abcdef";
+                            ss << "\\u00" << hexDigits[c >> 4] << hexDigits[c & 0xF];
+                        } else {
+                            ss << char(c);
+                        }
+                }
+            }
+            ss << '"';
+        }
+
+        /**
+         *  JSON has no representation for NaN and infinity.
+         */
+        template<class E, std::enable_if_t<std::is_floating_point<E>::value, bool> = true>
+        void write_json_value(std::stringstream& ss, E value) {
+            if (!std::isfinite(value)) {
+                throw std::system_error{orm_error_code::value_is_not_finite};
+            }
+            ss << std::setprecision(std::numeric_limits<E>::max_digits10) << value;
+        }
+
+        template<class E, std::enable_if_t<!std::is_floating_point<E>::value, bool> = true>
+        void write_json_value(std::stringstream& ss, E value) {
+            ss << std::to_string(value);
+        }
+
+        /**
+         *  A tuple is written as a nested array, e.g. the values of a composite primary key.
+         */
+        template<class... Args>
+        void write_json_value(std::stringstream& ss, const std::tuple<Args...>& value) {
+            ss << '[';
+            iterate_tuple(value, [&ss, first = true](auto& element) mutable {
+                if (!std::exchange(first, false)) {
+                    ss << ',';
+                }
+                write_json_value(ss, element);
+            });
+            ss << ']';
+        }
+
+        /**
+         *  Serializes array values as a JSON array, e.g. `[1,2,3]`.
+         */
+        template<class E>
+        std::string serialize_json_array(const std::vector<E>& values) {
+            std::stringstream ss;
+            ss << '[';
+            for (size_t i = 0; i < values.size(); ++i) {
+                if (i > 0) {
+                    ss << ',';
+                }
+                write_json_value(ss, values[i]);
+            }
+            ss << ']';
+            return ss.str();
+        }
+    }
+
+#ifdef SQLITE_ORM_AS_ARRAY_SUPPORTED
+    /**
+     *  Wraps the values of an IN list such that they are bound as one array parameter.
+     *  Unlike `in(&User::id, std::vector<int>{...})`, which binds every value separately,
+     *  the statement's text is the same for any number of values, hence it can be reused and
+     *  is not subject to the limit on the number of bound variables.
+     *  Without the carray extension floating point values must be finite.
+     *
+     *  @example
+     *  ```c++
+     *  //  SELECT ... FROM users WHERE id IN (SELECT value FROM json_each(?))
+     *  //  or with the carray extension: SELECT ... FROM users WHERE id IN carray(?, ?, 'int64')
+     *  auto users = storage.get_all<User>(where(in(&User::id, as_array(ids))));
+     *  ```
+     */
+    template<class E>
+    internal::array_values_t<E> as_array(std::vector<E> values) {
+        return {std::move(values)};
+    }
+
+    template<class E>
+    internal::array_values_t<E> as_array(std::initializer_list<E> values) {
+        return {values};
+    }
+
+    inline internal::array_values_t<std::string> as_array(std::initializer_list<const char*> values) {
+        return {std::vector<std::string>(values.begin(), values.end())};
+    }
+#endif
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <utility>  //  std::move
+
+#include "../functional/cxx_type_traits_polyfill.h"
+
+namespace sqlite_orm {
+    namespace internal {
+
+        /**
+         *  RETURNING clause appended to a data modification statement.
+         *  S is the modifying statement, T is the returned column expression or `columns_t`.
+         */
+        template<class S, class T>
+        struct returning_t {
+            using statement_type = S;
+            using columns_type = T;
+
+            S statement;
+            T columns;
+        };
+
+        template<class T>
+        using is_returning = polyfill::is_specialization_of<T, returning_t>;
+    }
+
+#if SQLITE_VERSION_NUMBER >= 3035000
+    /**
+     *  RETURNING clause https://sqlite.org/lang_returning.html
+     *  Makes an `insert`, `insert_range`, `replace`, `replace_range`, `update_all` or `remove_all` statement
+     *  (including raw inserts and replaces) return the given columns of every modified row,
+     *  extracted like the results of a `select`.
+     *
+     *  Example:
+     *  auto statement = storage.prepare(returning(insert(user), columns(&User::id, &User::createdAt)));
+     *  std::vector<std::tuple<int, std::string>> rows = storage.execute(statement);
+     */
+    template<class S, class T>
+    internal::returning_t<S, T> returning(S statement, T columns) {
+        return {std::move(statement), std::move(columns)};
+    }
+#endif
+}
@@ -5,12 +5,50 @@
 #include <string>  //  std::string
 #include <memory>
 #include <utility>  //  std::move, std::exchange
+#include <chrono>  //  std::chrono::milliseconds
+#include <thread>  //  std::thread
+#include <mutex>  //  std::mutex, std::unique_lock, std::lock_guard
+#include <condition_variable>  //  std::condition_variable
+#include <functional>  //  std::function
+#include <exception>  //  std::exception_ptr, std::make_exception_ptr, std::rethrow_exception, std::current_exception
 
 #include "error_code.h"
 #include "connection_holder.h"
 
 namespace sqlite_orm {
 
+    /**
+     *  Progress of a backup running in the background.
+     */
+    struct backup_progress {
+        int remaining = 0;
+        int pagecount = 0;
+        /**
+         *  How many times the backup started over because the source database was written
+         *  through another connection than the one being backed up.
+         */
+        int restarts = 0;
+
+        double fraction() const {
+            return this->pagecount > 0 ? double(this->pagecount - this->remaining) / this->pagecount : 0;
+        }
+    };
+
+    struct backup_options {
+        /**
+         *  Number of pages copied per step. The source database is locked only while a step is copying pages.
+         */
+        int pages_per_step = 100;
+        /**
+         *  Pause between steps, letting writers of the source database proceed.
+         */
+        std::chrono::milliseconds pause{10};
+        /**
+         *  Called on the background thread after every step.
+         */
+        std::function<void(const backup_progress&)> on_progress;
+    };
+
     namespace internal {
 
         /**
@@ -20,21 +58,26 @@ namespace sqlite_orm {
          *  can skip creating a backup_t instance and just call storage.backup_from or storage.backup_to function.
          */
         struct backup_t {
+            /**
+             *  @param holder_ Connection owned by the backup, if any.
+             *  @param otherHolder_ Second connection owned by the backup, if both ends are owned.
+             */
             backup_t(connection_ref to_,
                      const std::string& zDestName,
                      connection_ref from_,
                      const std::string& zSourceName,
-                     std::unique_ptr<connection_holder> holder_) :
+                     std::unique_ptr<connection_holder> holder_,
+                     std::unique_ptr<connection_holder> otherHolder_ = {}) :
                 handle(sqlite3_backup_init(to_.get(), zDestName.c_str(), from_.get(), zSourceName.c_str())),
-                holder(std::move(holder_)), to(to_), from(from_) {
+                holder(std::move(holder_)), otherHolder(std::move(otherHolder_)), to(to_), from(from_) {
                 if (!this->handle) {
                     throw std::system_error{orm_error_code::failed_to_init_a_backup};
                 }
             }
 
             backup_t(backup_t&& other) :
-                handle(std::exchange(other.handle, nullptr)), holder(std::move(other.holder)), to(other.to),
-                from(other.from) {}
+                handle(std::exchange(other.handle, nullptr)), holder(std::move(other.holder)),
+                otherHolder(std::move(other.otherHolder)), to(std::move(other.to)), from(std::move(other.from)) {}
 
             ~backup_t() {
                 if (this->handle) {
@@ -66,8 +109,148 @@ namespace sqlite_orm {
           protected:
             sqlite3_backup* handle = nullptr;
             std::unique_ptr<connection_holder> holder;
+            std::unique_ptr<connection_holder> otherHolder;
             connection_ref to;
             connection_ref from;
         };
+
+        /**
+         *  Runs a backup on a background thread a few pages at a time, pausing between steps.
+         *  Don't construct it as is, call storage.start_backup_to instead.
+         *  The backup runs on connections of its own, hence it may outlive the storage.
+         *  A busy or locked source database is retried after the pause.
+         *  Destroying the runner cancels the backup and waits for the thread to finish.
+         */
+        class backup_runner {
+          public:
+            enum class status {
+                running,
+                done,
+                cancelled,
+                failed,
+            };
+
+            backup_runner(backup_t backup, backup_options options) :
+                state{std::make_unique<shared_state>(std::move(backup))} {
+                this->worker = std::thread{&backup_runner::run, this->state.get(), std::move(options)};
+            }
+
+            backup_runner(backup_runner&&) = default;
+
+            ~backup_runner() {
+                if (this->worker.joinable()) {
+                    this->cancel();
+                    this->worker.join();
+                }
+            }
+
+            /**
+             *  Stops the backup after the current step. The destination is left incomplete.
+             */
+            void cancel() {
+                std::lock_guard<std::mutex> lock{this->state->mutex};
+                this->state->cancelled = true;
+                this->state->changed.notify_all();
+            }
+
+            /**
+             *  Waits for the backup to finish.
+             *  @return Whether the backup completed, false if it was cancelled.
+             *  @throws std::system_error if the backup failed.
+             */
+            bool wait() {
+                if (this->worker.joinable()) {
+                    this->worker.join();
+                }
+                if (this->state->error) {
+                    std::rethrow_exception(this->state->error);
+                }
+                return this->state->currentStatus == status::done;
+            }
+
+            status get_status() const {
+                std::lock_guard<std::mutex> lock{this->state->mutex};
+                return this->state->currentStatus;
+            }
+
+            backup_progress progress() const {
+                std::lock_guard<std::mutex> lock{this->state->mutex};
+                return this->state->progress;
+            }
+
+          private:
+            /**
+             *  State shared with the thread, which owns the backup and its connections
+             *  such that they outlive the thread.
+             */
+            struct shared_state {
+                explicit shared_state(backup_t backup) : backup{std::move(backup)} {}
+
+                backup_t backup;
+                mutable std::mutex mutex;
+                std::condition_variable changed;
+                bool cancelled = false;
+                status currentStatus = status::running;
+                backup_progress progress;
+                std::exception_ptr error;
+            };
+
+            static void run(shared_state* state, backup_options options) {
+                backup_t& backup = state->backup;
+                int previousCopied = -1;
+                for (;;) {
+                    const int rc = backup.step(options.pages_per_step);
+                    backup_progress progress;
+                    {
+                        std::unique_lock<std::mutex> lock{state->mutex};
+                        progress = state->progress;
+                        progress.remaining = backup.remaining();
+                        progress.pagecount = backup.pagecount();
+                        //  sqlite3_backup_step() starts over if the source was written through another connection,
+                        //  in which case a step doesn't add to the pages copied so far
+                        const int copied = progress.pagecount - progress.remaining;
+                        if (rc == SQLITE_OK && previousCopied >= 0 && copied <= previousCopied) {
+                            ++progress.restarts;
+                        }
+                        previousCopied = copied;
+                        state->progress = progress;
+                    }
+                    std::exception_ptr callbackError;
+                    if (options.on_progress) {
+                        try {
+                            options.on_progress(progress);
+                        } catch (...) {
+                            callbackError = std::current_exception();
+                        }
+                    }
+
+                    std::unique_lock<std::mutex> lock{state->mutex};
+                    if (callbackError) {
+                        state->error = std::move(callbackError);
+                        state->currentStatus = status::failed;
+                        return;
+                    }
+                    if (rc == SQLITE_DONE) {
+                        state->currentStatus = status::done;
+                        return;
+                    }
+                    if (rc != SQLITE_OK && rc != SQLITE_BUSY && rc != SQLITE_LOCKED) {
+                        state->error = std::make_exception_ptr(std::system_error{sqlite_errc(rc)});
+                        state->currentStatus = status::failed;
+                        return;
+                    }
+                    state->changed.wait_for(lock, options.pause, [state] {
+                        return state->cancelled;
+                    });
+                    if (state->cancelled) {
+                        state->currentStatus = status::cancelled;
+                        return;
+                    }
+                }
+            }
+
+            std::unique_ptr<shared_state> state;
+            std::thread worker;
+        };
     }
 }
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <cstddef>  //  size_t
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <istream>  //  std::istream
+#include <ostream>  //  std::ostream
+#include <functional>  //  std::function
+#include <utility>  //  std::move, std::exchange
+#include <algorithm>  //  std::min, std::max
+
+#include "error_code.h"
+#include "connection_holder.h"
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+        /**
+         *  Incremental I/O on a BLOB value, a wrapper around sqlite3_blob pointer.
+         *  Don't construct it as is, call storage.open_blob instead.
+         *
+         *  The size of a BLOB can't be changed through the handle: preallocate it with `storage.allocate_blob`
+         *  or the `zeroblob()` function, then write it in parts.
+         *  Changing the row by other means expires the handle, after which reads and writes fail with SQLITE_ABORT
+         *  until `reopen()` is called.
+         */
+        class blob_handle {
+          public:
+            blob_handle(connection_ref con,
+                        const std::string& tableName,
+                        const std::string& columnName,
+                        sqlite3_int64 rowid,
+                        bool writable,
+                        std::function<void(sqlite3_int64 rowid)> onWrite,
+                        std::function<void()> onWritesDone) :
+                con(std::move(con)), currentRowid(rowid), onWrite(std::move(onWrite)),
+                onWritesDone(std::move(onWritesDone)) {
+                sqlite3* db = this->con.get();
+                if (sqlite3_blob_open(db,
+                                      "main",
+                                      tableName.c_str(),
+                                      columnName.c_str(),
+                                      rowid,
+                                      writable,
+                                      &this->handle) != SQLITE_OK) {
+                    //  the handle is null on error
+                    throw_translated_sqlite_error(db);
+                }
+            }
+
+            blob_handle(blob_handle&& other) :
+                con(other.con), handle(std::exchange(other.handle, nullptr)), currentRowid(other.currentRowid),
+                onWrite(std::move(other.onWrite)), onWritesDone(std::move(other.onWritesDone)),
+                written(std::exchange(other.written, false)) {}
+
+            /**
+             *  Closes the handle if `close()` wasn't called, ignoring errors.
+             */
+            ~blob_handle() {
+                if (this->handle) {
+                    (void)sqlite3_blob_close(this->handle);
+                    this->writes_done();
+                }
+            }
+
+            /**
+             *  Closes the handle, after which it can't be used anymore.
+             *  In autocommit mode this commits the writes.
+             *  @throws std::system_error if closing fails, e.g. if the writes can't be committed.
+             *  The handle is closed even then.
+             */
+            void close() {
+                if (!this->handle) {
+                    return;
+                }
+                const int rc = sqlite3_blob_close(std::exchange(this->handle, nullptr));
+                this->writes_done();
+                if (rc != SQLITE_OK) {
+                    throw_translated_sqlite_error(rc);
+                }
+            }
+
+            sqlite3_int64 rowid() const {
+                return this->currentRowid;
+            }
+
+            /**
+             *  Size of the BLOB in bytes.
+             */
+            size_t size() const {
+                return size_t(sqlite3_blob_bytes(this->handle));
+            }
+
+            /**
+             *  Reads `count` bytes starting at `offset` into `buffer`.
+             *  @throws std::system_error if the range exceeds the BLOB or the handle expired.
+             */
+            void read(void* buffer, size_t count, size_t offset) const {
+                if (sqlite3_blob_read(this->handle, buffer, int(count), int(offset)) != SQLITE_OK) {
+                    throw_translated_sqlite_error(this->con.get());
+                }
+            }
+
+            /**
+             *  Writes `count` bytes from `data` starting at `offset`.
+             *  @throws std::system_error if the range exceeds the BLOB, the handle is read-only or expired.
+             */
+            void write(const void* data, size_t count, size_t offset) {
+                if (sqlite3_blob_write(this->handle, data, int(count), int(offset)) != SQLITE_OK) {
+                    throw_translated_sqlite_error(this->con.get());
+                }
+                this->written = true;
+                //  sqlite3_blob_write() doesn't invoke the update hook
+                if (this->onWrite) {
+                    this->onWrite(this->currentRowid);
+                }
+            }
+
+            /**
+             *  Moves the handle to the same column of another row, which is faster than opening a new handle.
+             *  @throws std::system_error if the row doesn't exist or its value isn't a BLOB or text,
+             *  after which the handle is expired.
+             */
+            void reopen(sqlite3_int64 rowid) {
+                if (sqlite3_blob_reopen(this->handle, rowid) != SQLITE_OK) {
+                    throw_translated_sqlite_error(this->con.get());
+                }
+                this->currentRowid = rowid;
+            }
+
+            /**
+             *  Streams the BLOB from `offset` to its end into `os`, `chunkSize` bytes at a time.
+             *  @return Number of bytes read.
+             */
+            size_t read_to(std::ostream& os, size_t offset = 0, size_t chunkSize = default_chunk_size) const {
+                const size_t blobSize = this->size();
+                const size_t remaining = blobSize > offset ? blobSize - offset : 0;
+                std::vector<char> chunk(std::min(std::max(chunkSize, size_t(1)), remaining));
+                size_t position = offset;
+                while (position < blobSize && os) {
+                    const size_t count = std::min(chunk.size(), blobSize - position);
+                    this->read(chunk.data(), count, position);
+                    os.write(chunk.data(), std::streamsize(count));
+                    position += count;
+                }
+                return position - offset;
+            }
+
+            /**
+             *  Writes what `is` provides into the BLOB starting at `offset`, `chunkSize` bytes at a time,
+             *  until the stream ends or the BLOB is full.
+             *  @return Number of bytes written.
+             */
+            size_t write_from(std::istream& is, size_t offset = 0, size_t chunkSize = default_chunk_size) {
+                const size_t blobSize = this->size();
+                const size_t remaining = blobSize > offset ? blobSize - offset : 0;
+                std::vector<char> chunk(std::min(std::max(chunkSize, size_t(1)), remaining));
+                size_t position = offset;
+                while (position < blobSize && is) {
+                    is.read(chunk.data(), std::streamsize(std::min(chunk.size(), blobSize - position)));
+                    const size_t count = size_t(is.gcount());
+                    if (count == 0) {
+                        break;
+                    }
+                    this->write(chunk.data(), count, position);
+                    position += count;
+                }
+                return position - offset;
+            }
+
+          private:
+            static constexpr size_t default_chunk_size = 64 * 1024;
+
+            void writes_done() {
+                //  in autocommit mode the writes are committed once the handle is closed
+                if (this->written && this->onWritesDone) {
+                    this->onWritesDone();
+                }
+            }
+
+            connection_ref con;
+            sqlite3_blob* handle = nullptr;
+            sqlite3_int64 currentRowid;
+            std::function<void(sqlite3_int64 rowid)> onWrite;
+            std::function<void()> onWritesDone;
+            bool written = false;
+        };
+    }
+}
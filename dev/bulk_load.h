@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>  //  size_t
+#include <chrono>  //  std::chrono::steady_clock, std::chrono::duration
+
+namespace sqlite_orm {
+
+    /**
+     *  Options for `storage_t::bulk_load()`.
+     */
+    struct bulk_load_options {
+        /**
+         *  Drop the indexes of the loaded table before writing and recreate them afterwards,
+         *  which builds every index once instead of updating it for every row.
+         */
+        bool drop_indexes = false;
+
+        /**
+         *  Set `synchronous` to OFF and `journal_mode` to MEMORY during the load and restore them afterwards.
+         *  A crash during the load may then corrupt the database.
+         *  `journal_mode` is kept if it is WAL. Has no effect inside an open transaction,
+         *  during which neither pragma can be changed.
+         */
+        bool relax_durability = false;
+
+        /**
+         *  Write objects including their primary key values, like `replace_range()`,
+         *  instead of letting SQLite assign them, like `insert_range()`.
+         */
+        bool keep_primary_keys = false;
+
+        /**
+         *  Sort objects by their primary key before writing them, which avoids B-tree page splits.
+         *  Only meaningful together with `keep_primary_keys`.
+         */
+        bool sort_by_primary_key = false;
+    };
+
+    /**
+     *  Result of `storage_t::bulk_load()`.
+     */
+    struct bulk_load_result {
+        size_t rows = 0;
+        std::chrono::steady_clock::duration elapsed{};
+
+        double rows_per_second() const {
+            const double seconds = std::chrono::duration<double>(this->elapsed).count();
+            return seconds > 0 ? double(this->rows) / seconds : 0;
+        }
+    };
+}
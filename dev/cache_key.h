@@ -0,0 +1,226 @@
+#pragma once
+
+#include <cstddef>  //  size_t, nullptr_t
+#include <cstdint>  //  uint64_t, uintptr_t
+#include <cstring>  //  memcpy, strlen
+#include <string>  //  std::string, std::to_string
+#include <vector>  //  std::vector
+#include <type_traits>  //  std::enable_if_t, std::is_integral, std::integral_constant, std::true_type
+#include "functional/cxx_optional.h"
+#include "functional/cxx_string_view.h"
+
+#include "functional/cxx_type_traits_polyfill.h"
+#include "is_std_ptr.h"
+#include "type_traits.h"
+#include "field_printer.h"
+#include "array_values.h"
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+        /**
+         *  An address unique to type T, such that values of different types never share a key.
+         */
+        template<class T>
+        const void* cache_type_id() {
+            static const char id = 0;
+            return &id;
+        }
+
+        /**
+         *  Appends a value to a cache key, tagged by its kind and such that distinct values never run together
+         *  or collide, e.g. floating point values are appended by their exact bits. Values that compare equal
+         *  in SQL but are of different kinds, like 1 and 1.0, get different keys.
+         *  Values of other types are appended as printed by `field_printer`, tagged by their type.
+         *  @return false if the value can't be appended, in which case there is no key.
+         */
+        template<class T, class SFINAE = void>
+        struct cache_key_writer {
+            bool operator()(std::string& key, const T& value) const {
+                return this->append_printed(key, value, is_printable<T>{});
+            }
+
+          private:
+            bool append_printed(std::string& key, const T& value, std::true_type) const {
+                key += 'p';
+                key += std::to_string(uintptr_t(cache_type_id<T>()));
+                key += ':';
+                const std::string text = field_printer<T>{}(value);
+                key += std::to_string(text.size());
+                key += ':';
+                key += text;
+                return true;
+            }
+
+            bool append_printed(std::string&, const T&, std::false_type) const {
+                return false;
+            }
+        };
+
+        template<class T>
+        struct cache_key_writer<T, match_if<std::is_integral, T>> {
+            bool operator()(std::string& key, const T& value) const {
+                key += 'i';
+                key += std::to_string(value);
+                key += ';';
+                return true;
+            }
+        };
+
+        template<class T>
+        struct cache_key_writer<T, match_if<std::is_floating_point, T>> {
+            bool operator()(std::string& key, const T& value) const {
+                //  bound as double
+                const double bound = static_cast<double>(value);
+                uint64_t bits = 0;
+                memcpy(&bits, &bound, sizeof(bits));
+                key += 'f';
+                key += std::to_string(bits);
+                key += ';';
+                return true;
+            }
+        };
+
+        template<class T>
+        using is_cache_key_text = polyfill::disjunction<std::is_base_of<std::string, T>
+#ifdef SQLITE_ORM_STRING_VIEW_SUPPORTED
+                                                        ,
+                                                        std::is_same<T, std::string_view>
+#endif
+                                                        >;
+
+        template<class T>
+        struct cache_key_writer<T, std::enable_if_t<is_cache_key_text<T>::value>> {
+            bool operator()(std::string& key, const T& value) const {
+                key += 't';
+                key += std::to_string(value.size());
+                key += ':';
+                key.append(value.data(), value.size());
+                return true;
+            }
+        };
+
+        template<>
+        struct cache_key_writer<const char*, void> {
+            bool operator()(std::string& key, const char* value) const {
+                const size_t size = strlen(value);
+                key += 't';
+                key += std::to_string(size);
+                key += ':';
+                key.append(value, size);
+                return true;
+            }
+        };
+
+        template<>
+        struct cache_key_writer<std::vector<char>, void> {
+            bool operator()(std::string& key, const std::vector<char>& value) const {
+                key += 'b';
+                key += std::to_string(value.size());
+                key += ':';
+                key.append(value.data(), value.size());
+                return true;
+            }
+        };
+
+        template<>
+        struct cache_key_writer<nullptr_t, void> {
+            bool operator()(std::string& key, const nullptr_t&) const {
+                key += 'n';
+                return true;
+            }
+        };
+
+#ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
+        template<>
+        struct cache_key_writer<std::nullopt_t, void> {
+            bool operator()(std::string& key, const std::nullopt_t&) const {
+                key += 'n';
+                return true;
+            }
+        };
+
+        template<class T>
+        struct cache_key_writer<T, std::enable_if_t<polyfill::is_specialization_of_v<T, std::optional>>> {
+            bool operator()(std::string& key, const T& value) const {
+                if (!value) {
+                    key += 'n';
+                    return true;
+                }
+                return cache_key_writer<std::remove_cv_t<typename T::value_type>>{}(key, *value);
+            }
+        };
+#endif  //  SQLITE_ORM_OPTIONAL_SUPPORTED
+
+        template<class T>
+        struct cache_key_writer<T, std::enable_if_t<is_std_ptr<T>::value>> {
+            bool operator()(std::string& key, const T& value) const {
+                if (!value) {
+                    key += 'n';
+                    return true;
+                }
+                return cache_key_writer<std::remove_cv_t<typename T::element_type>>{}(key, *value);
+            }
+        };
+
+        template<class E>
+        struct cache_key_writer<array_values_t<E>, void> {
+            bool operator()(std::string& key, const array_values_t<E>& value) const {
+                key += 'a';
+                key += std::to_string(value.values.size());
+                key += ':';
+                for (auto& element: value.values) {
+                    cache_key_writer<E>{}(key, element);
+                }
+                return true;
+            }
+        };
+
+        /**
+         *  The tag that keys of non-null values of type T start with. Values with the same tag are appended
+         *  alike, e.g. `int` and `long` values, hence equal values of such types get the same key.
+         */
+        template<class T, class SFINAE = void>
+        struct cache_key_tag : std::integral_constant<char, 'p'> {};
+
+        template<class T>
+        struct cache_key_tag<T, match_if<std::is_integral, T>> : std::integral_constant<char, 'i'> {};
+
+        template<class T>
+        struct cache_key_tag<T, match_if<std::is_floating_point, T>> : std::integral_constant<char, 'f'> {};
+
+        template<class T>
+        struct cache_key_tag<T, std::enable_if_t<is_cache_key_text<T>::value>> : std::integral_constant<char, 't'> {};
+
+        template<>
+        struct cache_key_tag<const char*, void> : std::integral_constant<char, 't'> {};
+
+        template<>
+        struct cache_key_tag<std::vector<char>, void> : std::integral_constant<char, 'b'> {};
+
+#ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
+        template<class T>
+        struct cache_key_tag<T, std::enable_if_t<polyfill::is_specialization_of_v<T, std::optional>>>
+            : cache_key_tag<std::remove_cv_t<typename T::value_type>> {};
+#endif  //  SQLITE_ORM_OPTIONAL_SUPPORTED
+
+        template<class T>
+        struct cache_key_tag<T, std::enable_if_t<is_std_ptr<T>::value>>
+            : cache_key_tag<std::remove_cv_t<typename T::element_type>> {};
+
+        template<class T>
+        bool append_cache_key(std::string& key, const T& value) {
+            return cache_key_writer<T>{}(key, value);
+        }
+
+        inline bool append_cache_keys(std::string&) {
+            return true;
+        }
+
+        template<class T, class... Ts>
+        bool append_cache_keys(std::string& key, const T& value, const Ts&... values) {
+            return append_cache_key(key, value) && append_cache_keys(key, values...);
+        }
+    }
+}
@@ -16,6 +16,8 @@
 #endif
 
 #include "pointer_value.h"
+#include "array_values.h"
+#include "statement_binder.h"
 
 #if SQLITE_VERSION_NUMBER >= 3020000
 #ifdef SQLITE_ORM_INLINE_VARIABLES_SUPPORTED
@@ -141,6 +143,33 @@ namespace sqlite_orm {
             return "remember";
         }
     };
+
+#ifdef SQLITE_ORM_CARRAY_IN_SUPPORTED
+    /**
+     *  Specialization for the values of an IN list bound as one array (`as_array()`),
+     *  bound as a C array and its length for `carray(?, ?, '<type>')`.
+     */
+    template<class E>
+    struct statement_binder<internal::array_values_t<E>, void> {
+        using pointer_binding_type = static_carray_pointer_binding<typename internal::carray_element<E>::type>;
+
+        int bind(sqlite3_stmt* stmt, int index, const internal::array_values_t<E>& value) const {
+            auto& carray = value.carray_values();
+            int rc = statement_binder<pointer_binding_type>{}.bind(stmt,
+                                                                   index,
+                                                                   bind_carray_pointer_statically(carray.data()));
+            if (SQLITE_OK != rc) {
+                return rc;
+            }
+            return sqlite3_bind_int(stmt, index + 1, int(carray.size()));
+        }
+    };
+
+    namespace internal {
+        template<class E>
+        SQLITE_ORM_INLINE_VAR constexpr int bound_parameters_count_v<array_values_t<E>> = 2;
+    }
+#endif
 }
 #endif
 #endif
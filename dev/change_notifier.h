@@ -0,0 +1,202 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <cstddef>  //  size_t
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <map>  //  std::map
+#include <functional>  //  std::function
+#include <mutex>  //  std::mutex, std::lock_guard
+#include <utility>  //  std::move
+#include <algorithm>  //  std::find_if
+
+namespace sqlite_orm {
+
+    enum class change_kind {
+        insert = SQLITE_INSERT,
+        update = SQLITE_UPDATE,
+        remove = SQLITE_DELETE,
+    };
+
+    /**
+     *  A row inserted, updated or deleted by a committed transaction.
+     */
+    struct row_change {
+        change_kind kind;
+        sqlite3_int64 rowid;
+    };
+
+    inline bool operator==(const row_change& lhs, const row_change& rhs) {
+        return lhs.kind == rhs.kind && lhs.rowid == rhs.rowid;
+    }
+
+    namespace internal {
+
+        /**
+         *  Holds the mutex of a connection, such that no other thread uses the connection meanwhile.
+         *  The mutex is recursive, and there is none unless SQLite runs in serialized mode.
+         */
+        class connection_mutex_lock {
+          public:
+            explicit connection_mutex_lock(sqlite3* db) : mutex{sqlite3_db_mutex(db)} {
+                sqlite3_mutex_enter(this->mutex);
+            }
+
+            connection_mutex_lock(const connection_mutex_lock&) = delete;
+            connection_mutex_lock& operator=(const connection_mutex_lock&) = delete;
+
+            ~connection_mutex_lock() {
+                sqlite3_mutex_leave(this->mutex);
+            }
+
+          private:
+            sqlite3_mutex* mutex;
+        };
+
+        /**
+         *  Collects the row changes reported by `sqlite3_update_hook()` per table while a transaction is running,
+         *  delivers them to the listeners of the tables from `sqlite3_commit_hook()`,
+         *  and discards them from `sqlite3_rollback_hook()`.
+         *  The changes of a failed statement or of a savepoint rolled back inside the transaction aren't reported
+         *  by a hook, the storage discards them by means of `mark()` and `discard_since()`. This isn't possible for
+         *  statements executed as raw SQL, e.g. `ROLLBACK TO` a savepoint.
+         *  Only changes of tables having listeners are collected.
+         *  A row observer, on the other hand, is called for every change right away.
+         */
+        class change_notifier {
+          public:
+            using listener_type = std::function<void(const std::vector<row_change>& changes)>;
+
+            size_t add_listener(std::string table, listener_type listener) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                const size_t id = this->nextId++;
+                this->listeners.push_back({id, std::move(table), std::move(listener)});
+                return id;
+            }
+
+            /**
+             *  @return Whether the listener was found.
+             */
+            bool remove_listener(size_t id) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                auto it = std::find_if(this->listeners.begin(), this->listeners.end(), [id](const listener& l) {
+                    return l.id == id;
+                });
+                if (it == this->listeners.end()) {
+                    return false;
+                }
+                this->listeners.erase(it);
+                return true;
+            }
+
+            bool empty() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->listeners.empty() && !this->rowObserver;
+            }
+
+            /**
+             *  Must be set before the hooks are installed, it isn't synchronized with them.
+             */
+            void set_row_observer(std::function<void(const char* table, sqlite3_int64 rowid)> observer) {
+                this->rowObserver = std::move(observer);
+            }
+
+            /**
+             *  Position in the changes collected so far, see `discard_since()`.
+             *  Like the hooks, `mark()` and `discard_since()` must be called holding the connection's mutex,
+             *  see `connection_mutex_lock`, which must be held in between as well such that the changes of
+             *  other threads' statements aren't discarded.
+             */
+            size_t mark() const {
+                return this->pending.size();
+            }
+
+            /**
+             *  Discards the changes collected since `mark()` was called.
+             */
+            void discard_since(size_t mark) {
+                if (mark < this->pending.size()) {
+                    this->pending.erase(this->pending.begin() + mark, this->pending.end());
+                }
+            }
+
+            /**
+             *  Installs the update, commit and rollback hooks, replacing any other such hooks of the connection.
+             */
+            void install(sqlite3* db) {
+                sqlite3_update_hook(db, update_callback, this);
+                sqlite3_commit_hook(db, commit_callback, this);
+                sqlite3_rollback_hook(db, rollback_callback, this);
+            }
+
+          private:
+            struct listener {
+                size_t id;
+                std::string table;
+                listener_type callback;
+            };
+
+            struct pending_change {
+                std::string table;
+                row_change change;
+            };
+
+            bool has_listener(const char* table) const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return std::find_if(this->listeners.begin(), this->listeners.end(), [table](const listener& l) {
+                           return l.table == table;
+                       }) != this->listeners.end();
+            }
+
+            static void update_callback(void* data, int kind, const char*, const char* table, sqlite3_int64 rowid) {
+                auto& notifier = *static_cast<change_notifier*>(data);
+                if (notifier.rowObserver) {
+                    notifier.rowObserver(table, rowid);
+                }
+                if (notifier.has_listener(table)) {
+                    notifier.pending.push_back({table, {change_kind(kind), rowid}});
+                }
+            }
+
+            static int commit_callback(void* data) {
+                auto& notifier = *static_cast<change_notifier*>(data);
+                if (notifier.pending.empty()) {
+                    return 0;
+                }
+                std::map<std::string, std::vector<row_change>> committed;
+                for (auto& change: notifier.pending) {
+                    committed[std::move(change.table)].push_back(change.change);
+                }
+                notifier.pending.clear();
+                std::vector<listener> listeners;
+                {
+                    std::lock_guard<std::mutex> lock{notifier.mutex};
+                    listeners = notifier.listeners;
+                }
+                for (auto& l: listeners) {
+                    auto it = committed.find(l.table);
+                    if (it == committed.end()) {
+                        continue;
+                    }
+                    //  an exception can't propagate through SQLite and must not turn the commit into a rollback
+                    try {
+                        l.callback(it->second);
+                    } catch (...) {
+                    }
+                }
+                return 0;
+            }
+
+            static void rollback_callback(void* data) {
+                static_cast<change_notifier*>(data)->pending.clear();
+            }
+
+            mutable std::mutex mutex;
+            std::vector<listener> listeners;
+            size_t nextId = 1;
+            std::function<void(const char* table, sqlite3_int64 rowid)> rowObserver;
+            //  in the order of the changes; only touched holding the connection's mutex
+            std::vector<pending_change> pending;
+        };
+    }
+}
@@ -3,35 +3,165 @@
 #include <sqlite3.h>
 #include <atomic>
 #include <string>  //  std::string
+#include <functional>  //  std::function
+#include <mutex>  //  std::mutex, std::lock_guard, std::unique_lock
+#include <condition_variable>  //  std::condition_variable
+#include <thread>  //  std::thread
+#include <chrono>  //  std::chrono::milliseconds, std::chrono::steady_clock
+#include <utility>  //  std::exchange
+#include <algorithm>  //  std::max
 
 #include "error_code.h"
+#include "open_options.h"
 
 namespace sqlite_orm {
 
+    /**
+     *  Counters of a storage's database connection.
+     */
+    struct connection_stats {
+        //  how many times the database connection was opened
+        size_t opened = 0;
+        //  how many times the database connection was closed
+        size_t closed = 0;
+        //  how many times a kept-alive database connection was reused instead of being reopened
+        size_t reused = 0;
+        //  how many times closing an idle database connection in the background failed, e.g. because
+        //  statements opened by the user weren't finalized
+        size_t failed_closes = 0;
+    };
+
     namespace internal {
 
         struct connection_holder {
 
-            connection_holder(std::string filename_) : filename(std::move(filename_)) {}
+            /**
+             *  @param didOpenDb_ Optional callback invoked right after the database connection was opened.
+             *  @param willCloseDb_ Optional callback invoked right before the database connection gets closed,
+             *  e.g. to finalize statements that are still kept around.
+             *  @param options_ How the database connection is opened, every time it is opened.
+             */
+            connection_holder(std::string filename_,
+                              std::function<void(sqlite3*)> didOpenDb_ = {},
+                              std::function<void(sqlite3*)> willCloseDb_ = {},
+                              open_options options_ = {}) :
+                filename(std::move(filename_)), options(std::move(options_)),
+                openFilename(make_open_filename(this->filename, this->options)),
+                didOpenDb(std::move(didOpenDb_)), willCloseDb(std::move(willCloseDb_)) {}
+
+            connection_holder(const connection_holder&) = delete;
+
+            ~connection_holder() {
+                if (this->closer.joinable()) {
+                    {
+                        std::lock_guard<std::mutex> lock{this->mutex};
+                        this->stopCloser = true;
+                    }
+                    this->closerCondition.notify_one();
+                    this->closer.join();
+                }
+                //  a connection kept alive is closed now
+                std::lock_guard<std::mutex> lock{this->mutex};
+                if (this->db && this->_retain_count == 0) {
+                    this->close_db();
+                }
+            }
 
             void retain() {
                 if (1 == ++this->_retain_count) {
-                    auto rc = sqlite3_open(this->filename.c_str(), &this->db);
+                    std::lock_guard<std::mutex> lock{this->mutex};
+                    if (this->db) {
+                        //  kept alive
+                        ++this->stats.reused;
+                        return;
+                    }
+                    auto rc = sqlite3_open_v2(this->openFilename.c_str(),
+                                              &this->db,
+                                              make_open_flags(this->options),
+                                              this->options.vfs.empty() ? nullptr : this->options.vfs.c_str());
                     if (rc != SQLITE_OK) {
-                        throw_translated_sqlite_error(db);
+                        --this->_retain_count;
+                        auto error = sqlite_to_system_error(this->db);
+                        sqlite3_close(std::exchange(this->db, nullptr));
+                        throw error;
+                    }
+                    //  lookaside memory can only be configured before the connection is used
+                    if (this->options.lookaside_slot_size > 0 && this->options.lookaside_slot_count > 0) {
+                        rc = sqlite3_db_config(this->db,
+                                               SQLITE_DBCONFIG_LOOKASIDE,
+                                               nullptr,
+                                               this->options.lookaside_slot_size,
+                                               this->options.lookaside_slot_count);
+                        if (rc != SQLITE_OK) {
+                            --this->_retain_count;
+                            sqlite3_close(std::exchange(this->db, nullptr));
+                            throw_translated_sqlite_error(rc);
+                        }
+                    }
+                    ++this->stats.opened;
+                    if (this->didOpenDb) {
+                        try {
+                            this->didOpenDb(this->db);
+                        } catch (...) {
+                            --this->_retain_count;
+                            this->close_db();
+                            throw;
+                        }
                     }
                 }
             }
 
             void release() {
                 if (0 == --this->_retain_count) {
-                    auto rc = sqlite3_close(this->db);
-                    if (rc != SQLITE_OK) {
-                        throw_translated_sqlite_error(db);
+                    std::unique_lock<std::mutex> lock{this->mutex};
+                    //  retained again by another thread in the meantime
+                    if (this->_retain_count != 0) {
+                        return;
+                    }
+                    if (this->keepAlive.count() > 0) {
+                        this->closeDeadline = std::chrono::steady_clock::now() + this->keepAlive;
+                        if (!this->closer.joinable()) {
+                            this->closer = std::thread{&connection_holder::run_closer, this};
+                        }
+                        lock.unlock();
+                        this->closerCondition.notify_one();
+                        return;
+                    }
+                    if (this->db) {
+                        auto rc = this->close_db();
+                        if (rc != SQLITE_OK) {
+                            throw_translated_sqlite_error(rc);
+                        }
                     }
                 }
             }
 
+            /**
+             *  Keep the database connection opened for the given idle period after the last reference
+             *  to it has been released, instead of closing it immediately.
+             *  The connection is closed by a background thread once the idle period has elapsed
+             *  without the connection being retained again.
+             *  A zero period restores the default behaviour of closing the connection immediately.
+             */
+            void keep_alive(std::chrono::milliseconds idlePeriod) {
+                {
+                    std::lock_guard<std::mutex> lock{this->mutex};
+                    this->keepAlive = idlePeriod;
+                    this->closeDeadline = std::chrono::steady_clock::now() + idlePeriod;
+                }
+                this->closerCondition.notify_one();
+            }
+
+            std::chrono::milliseconds keep_alive() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->keepAlive;
+            }
+
+            sqlite_orm::connection_stats connection_stats() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->stats;
+            }
+
             sqlite3* get() const {
                 return this->db;
             }
@@ -40,11 +170,71 @@ namespace sqlite_orm {
                 return this->_retain_count;
             }
 
+            /**
+             *  Whether the database connection is opened right now, also when it is merely kept alive.
+             */
+            bool is_open() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->db != nullptr;
+            }
+
             const std::string filename;
+            const open_options options;
+
+            //  serializes the `interrupt_guard`s sharing the connection's single progress handler
+            std::mutex interruptMutex;
 
           protected:
+            //  the filename or URI passed to `sqlite3_open_v2()`
+            const std::string openFilename;
             sqlite3* db = nullptr;
             std::atomic_int _retain_count{};
+            const std::function<void(sqlite3*)> didOpenDb;
+            const std::function<void(sqlite3*)> willCloseDb;
+
+            mutable std::mutex mutex;
+            sqlite_orm::connection_stats stats;
+            std::chrono::milliseconds keepAlive{0};
+            std::chrono::steady_clock::time_point closeDeadline;
+            std::condition_variable closerCondition;
+            bool stopCloser = false;
+            std::thread closer;
+
+            //  expects the mutex to be locked
+            int close_db() {
+                if (this->willCloseDb) {
+                    this->willCloseDb(this->db);
+                }
+                auto rc = sqlite3_close(this->db);
+                if (rc == SQLITE_OK) {
+                    this->db = nullptr;
+                    ++this->stats.closed;
+                }
+                return rc;
+            }
+
+            void run_closer() {
+                std::unique_lock<std::mutex> lock{this->mutex};
+                while (!this->stopCloser) {
+                    if (this->db && this->_retain_count == 0) {
+                        if (this->keepAlive.count() == 0 || std::chrono::steady_clock::now() >= this->closeDeadline) {
+                            if (this->close_db() != SQLITE_OK) {
+                                //  nothing to report to in the background but the counter;
+                                //  retried on the next release or after the idle period, at least 100 ms
+                                ++this->stats.failed_closes;
+                                const std::chrono::milliseconds retryPeriod =
+                                    std::max(this->keepAlive, std::chrono::milliseconds{100});
+                                this->closeDeadline = std::chrono::steady_clock::now() + retryPeriod;
+                                this->closerCondition.wait_until(lock, this->closeDeadline);
+                            }
+                            continue;
+                        }
+                        this->closerCondition.wait_until(lock, this->closeDeadline);
+                    } else {
+                        this->closerCondition.wait(lock);
+                    }
+                }
+            }
         };
 
         struct connection_ref {
@@ -56,10 +246,17 @@ namespace sqlite_orm {
                 this->holder->retain();
             }
 
+            /**
+             *  Takes over the reference, `other` doesn't refer to the connection anymore.
+             */
+            connection_ref(connection_ref&& other) : holder(std::exchange(other.holder, nullptr)) {}
+
             // rebind connection reference
             connection_ref& operator=(const connection_ref& other) {
                 if (other.holder != this->holder) {
-                    this->holder->release();
+                    if (this->holder) {
+                        this->holder->release();
+                    }
                     this->holder = other.holder;
                     this->holder->retain();
                 }
@@ -68,13 +265,19 @@ namespace sqlite_orm {
             }
 
             ~connection_ref() {
-                this->holder->release();
+                if (this->holder) {
+                    this->holder->release();
+                }
             }
 
             sqlite3* get() const {
                 return this->holder->get();
             }
 
+            std::mutex& interrupt_mutex() const {
+                return this->holder->interruptMutex;
+            }
+
           private:
             connection_holder* holder = nullptr;
         };
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <utility>  //  std::move
+#include <type_traits>  //  std::remove_cvref_t
+#include <functional>  //  std::reference_wrapper
+#if defined(SQLITE_ORM_SENTINEL_BASED_FOR_SUPPORTED) && defined(SQLITE_ORM_DEFAULT_COMPARISONS_SUPPORTED) &&           \
+    defined(SQLITE_ORM_CPP20_RANGES_SUPPORTED)
+#include <ranges>  //  std::ranges::view_interface
+#endif
+
+#include "row_view.h"
+#include "result_set_iterator.h"
+#include "ast_iterator.h"
+#include "connection_holder.h"
+#include "util.h"
+#include "storage_lookup.h"
+
+#if defined(SQLITE_ORM_SENTINEL_BASED_FOR_SUPPORTED) && defined(SQLITE_ORM_DEFAULT_COMPARISONS_SUPPORTED)
+namespace sqlite_orm::internal {
+    /*
+     *  A low-level C++ view over a result set of a select statement, returned by `storage_t::cursor()`.
+     *  Unlike `result_set_view` it doesn't extract the columns but yields a `row_view` of the current row.
+     *
+     *  `cursor_view` is also a 'borrowed range',
+     *  meaning that iterators obtained from it are not tied to the lifetime of the view instance.
+     */
+    template<class Select, class DBOs>
+    struct cursor_view
+#ifdef SQLITE_ORM_CPP20_RANGES_SUPPORTED
+        : std::ranges::view_interface<cursor_view<Select, DBOs>>
+#endif
+    {
+        using db_objects_type = DBOs;
+        using expression_type = Select;
+
+        cursor_view(const db_objects_type& dbObjects, connection_ref conn, Select expression) :
+            db_objects{dbObjects}, connection{std::move(conn)}, expression{std::move(expression)} {}
+
+        cursor_view(cursor_view&&) = default;
+        cursor_view& operator=(cursor_view&&) = default;
+        cursor_view(const cursor_view&) = default;
+        cursor_view& operator=(const cursor_view&) = default;
+
+        auto begin() {
+            const auto& exprDBOs = db_objects_for_expression(this->db_objects.get(), this->expression);
+            using context_t = serializer_context<std::remove_cvref_t<decltype(exprDBOs)>>;
+            context_t context{exprDBOs};
+            context.skip_table_name = false;
+            context.replace_bindable_with_question = true;
+
+            statement_finalizer stmt{prepare_stmt(this->connection.get(), serialize(this->expression, context))};
+            iterate_ast(this->expression, conditional_binder{stmt.get()});
+
+            using iterator_type = result_set_iterator<row_view, db_objects_type>;
+            return iterator_type{this->db_objects, std::move(stmt)};
+        }
+
+        result_set_sentinel_t end() {
+            return {};
+        }
+
+      private:
+        std::reference_wrapper<const db_objects_type> db_objects;
+        connection_ref connection;
+        expression_type expression;
+    };
+}
+
+#ifdef SQLITE_ORM_CPP20_RANGES_SUPPORTED
+template<class Select, class DBOs>
+inline constexpr bool std::ranges::enable_borrowed_range<sqlite_orm::internal::cursor_view<Select, DBOs>> = true;
+#endif
+#endif
@@ -39,6 +39,12 @@ namespace sqlite_orm {
         index_is_out_of_bounds,
         value_is_null,
         no_tables_specified,
+        full_table_scan,
+        deadline_exceeded,
+        query_cancelled,
+        value_is_not_finite,
+        reader_pool_is_enabled,
+        connection_is_not_kept_open,
     };
 }
 
@@ -98,6 +104,18 @@ namespace sqlite_orm {
                     return "Value is null";
                 case orm_error_code::no_tables_specified:
                     return "No tables specified";
+                case orm_error_code::full_table_scan:
+                    return "Query plan contains a full table scan";
+                case orm_error_code::deadline_exceeded:
+                    return "Deadline exceeded";
+                case orm_error_code::query_cancelled:
+                    return "Query cancelled";
+                case orm_error_code::value_is_not_finite:
+                    return "Value is not finite";
+                case orm_error_code::reader_pool_is_enabled:
+                    return "Reader pool is enabled";
+                case orm_error_code::connection_is_not_kept_open:
+                    return "Connection is not kept open";
                 default:
                     return "unknown error";
             }
@@ -166,4 +184,12 @@ namespace sqlite_orm {
     [[noreturn]] inline void throw_translated_sqlite_error(sqlite3_stmt* stmt) {
         throw sqlite_to_system_error(sqlite3_db_handle(stmt));
     }
+
+    /**
+     *  Translates the result code of a step rather than the connection's last error code,
+     *  which another thread sharing the connection may have overwritten in the meantime.
+     */
+    [[noreturn]] inline void throw_translated_sqlite_error(sqlite3_stmt* stmt, int rc) {
+        throw std::system_error{sqlite_errc(rc), sqlite3_errmsg(sqlite3_db_handle(stmt))};
+    }
 }
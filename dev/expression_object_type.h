@@ -22,6 +22,9 @@ namespace sqlite_orm {
         template<class T>
         struct expression_object_type<update_t<T>, void> : value_unref_type<T> {};
 
+        template<class T>
+        struct expression_object_type<update_columns_t<T>, void> : value_unref_type<T> {};
+
         template<class T>
         struct expression_object_type<replace_t<T>, void> : value_unref_type<T> {};
 
@@ -111,5 +114,15 @@ namespace sqlite_orm {
                 return get_ref(e.object);
             }
         };
+
+        template<class T>
+        struct get_object_t<update_columns_t<T>> {
+            using expression_type = update_columns_t<T>;
+
+            template<class O>
+            auto& operator()(O& e) const {
+                return get_ref(e.object);
+            }
+        };
     }
 }
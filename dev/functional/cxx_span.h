@@ -0,0 +1,12 @@
+#pragma once
+
+#include "cxx_core_features.h"
+
+#if SQLITE_ORM_HAS_INCLUDE(<version>)
+#include <version>
+#endif
+
+#if __cpp_lib_span >= 202002L
+#include <span>
+#define SQLITE_ORM_SPAN_SUPPORTED
+#endif
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <chrono>  //  std::chrono::steady_clock
+#include <memory>  //  std::shared_ptr, std::make_shared
+#include <mutex>  //  std::mutex, std::lock_guard
+#include <thread>  //  std::this_thread::get_id, std::thread::id
+#include <atomic>  //  std::atomic_bool
+#include <utility>  //  std::move, std::declval
+#include <iterator>  //  std::iterator_traits
+#include <system_error>  //  std::system_error
+
+#include "error_code.h"
+#include "connection_holder.h"
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+        struct cancellation_state {
+            std::atomic_bool cancelled{false};
+        };
+
+        struct interrupt_guard;
+    }
+
+    /**
+     *  Lets another thread cancel the calls the token is passed to.
+     *  Copies of a token share their state. Cancellation can't be undone.
+     */
+    class cancellation_token {
+      public:
+        cancellation_token() : state{std::make_shared<internal::cancellation_state>()} {}
+
+        /**
+         *  Cancels the statement running on behalf of this token at its next progress check,
+         *  and any call this token is passed to later on.
+         *  Unlike `sqlite3_interrupt()` this leaves alone the statements other threads run on the same connection.
+         */
+        void cancel() {
+            this->state->cancelled = true;
+        }
+
+        bool is_cancelled() const {
+            return this->state->cancelled;
+        }
+
+      private:
+        friend struct internal::interrupt_guard;
+
+        std::shared_ptr<internal::cancellation_state> state;
+    };
+
+    /**
+     *  Limits the time a call may take, passed as the first argument to
+     *  `get_all`, `select` and `iterate`.
+     *  Every `progress_interval` virtual machine operations SQLite checks the deadline and the cancellation token,
+     *  and interrupts the statement once the deadline has passed or the token is cancelled. The call then throws
+     *  a `std::system_error` with `orm_error_code::deadline_exceeded` or `orm_error_code::query_cancelled`,
+     *  and the connection stays usable.
+     */
+    struct query_deadline {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+        cancellation_token token;
+        int progress_interval = 1000;
+    };
+
+    /**
+     *  Deadline `timeout` from now.
+     *  @example
+     *  ```c++
+     *  try {
+     *      auto rows = storage.get_all<Visit>(with_timeout(std::chrono::milliseconds{200}), where(...));
+     *  } catch (const std::system_error& e) {
+     *      if (e.code() == orm_error_code::deadline_exceeded) {
+     *          //  shed load
+     *      }
+     *  }
+     *  ```
+     */
+    inline query_deadline with_timeout(std::chrono::steady_clock::duration timeout, int progressInterval = 1000) {
+        return {std::chrono::steady_clock::now() + timeout, {}, progressInterval};
+    }
+
+    inline query_deadline with_deadline(std::chrono::steady_clock::time_point deadline, int progressInterval = 1000) {
+        return {deadline, {}, progressInterval};
+    }
+
+    /**
+     *  No deadline, but cancellation by calling `token.cancel()` from another thread.
+     */
+    inline query_deadline with_cancellation(cancellation_token token, int progressInterval = 1000) {
+        return {std::chrono::steady_clock::time_point::max(), std::move(token), progressInterval};
+    }
+
+    namespace internal {
+
+        /**
+         *  Enforces a `query_deadline` on the statements run by `run()`, and translates the resulting
+         *  `SQLITE_INTERRUPT` errors into ORM errors.
+         *  While running, the guard installs a progress handler on its connection, replacing any other
+         *  progress handler of the connection. As a connection has only one progress handler,
+         *  guards on the same connection run one at a time. Statements other threads step on the connection
+         *  in the meantime are left alone.
+         */
+        struct interrupt_guard {
+            interrupt_guard(connection_ref con, query_deadline limits) :
+                con{std::move(con)}, limits{std::move(limits)} {}
+
+            interrupt_guard(const interrupt_guard&) = delete;
+            interrupt_guard& operator=(const interrupt_guard&) = delete;
+
+            /**
+             *  Calls `f`, translating an interruption caused by this guard.
+             */
+            template<class F>
+            decltype(auto) run(F&& f) {
+                if (this->limits.token.is_cancelled()) {
+                    throw std::system_error{orm_error_code::query_cancelled};
+                }
+                std::lock_guard<std::mutex> lock{this->con.interrupt_mutex()};
+                progress_handler_scope scope{*this};
+                try {
+                    return f();
+                } catch (const std::system_error& e) {
+                    if (e.code() == sqlite_errc(SQLITE_INTERRUPT)) {
+                        if (this->limits.token.is_cancelled()) {
+                            throw std::system_error{orm_error_code::query_cancelled};
+                        }
+                        if (this->timedOut) {
+                            throw std::system_error{orm_error_code::deadline_exceeded};
+                        }
+                    }
+                    throw;
+                }
+            }
+
+          private:
+            struct progress_handler_scope {
+                interrupt_guard& guard;
+
+                explicit progress_handler_scope(interrupt_guard& guard) : guard{guard} {
+                    this->guard.thread = std::this_thread::get_id();
+                    sqlite3_progress_handler(this->guard.con.get(),
+                                             this->guard.limits.progress_interval,
+                                             progress_callback,
+                                             &this->guard);
+                }
+
+                ~progress_handler_scope() {
+                    sqlite3_progress_handler(this->guard.con.get(), 0, nullptr, nullptr);
+                }
+            };
+
+            static int progress_callback(void* data) {
+                auto& guard = *static_cast<interrupt_guard*>(data);
+                //  a statement of another thread sharing the connection
+                if (std::this_thread::get_id() != guard.thread) {
+                    return 0;
+                }
+                if (guard.limits.token.is_cancelled()) {
+                    return 1;
+                }
+                if (std::chrono::steady_clock::now() >= guard.limits.deadline) {
+                    guard.timedOut = true;
+                    return 1;
+                }
+                return 0;
+            }
+
+            connection_ref con;
+            query_deadline limits;
+            //  the thread running the guarded statement
+            std::thread::id thread;
+            bool timedOut = false;
+        };
+
+        /**
+         *  Iterator of an `interruptible_view`, translating interruptions while stepping.
+         */
+        template<class It>
+        class interruptible_iterator {
+          public:
+            using iterator_category = typename std::iterator_traits<It>::iterator_category;
+            using difference_type = typename std::iterator_traits<It>::difference_type;
+            using value_type = typename std::iterator_traits<It>::value_type;
+            using reference = typename std::iterator_traits<It>::reference;
+            using pointer = typename std::iterator_traits<It>::pointer;
+
+            interruptible_iterator() = default;
+
+            interruptible_iterator(It it, std::shared_ptr<interrupt_guard> guard) :
+                it{std::move(it)}, guard{std::move(guard)} {}
+
+            reference operator*() const {
+                return *this->it;
+            }
+
+            pointer operator->() const {
+                return this->it.operator->();
+            }
+
+            interruptible_iterator& operator++() {
+                this->guard->run([this] {
+                    ++this->it;
+                });
+                return *this;
+            }
+
+            auto operator++(int) {
+                return this->guard->run([this] {
+                    return this->it++;
+                });
+            }
+
+            friend bool operator==(const interruptible_iterator& lhs, const interruptible_iterator& rhs) {
+                return lhs.it == rhs.it;
+            }
+
+            friend bool operator!=(const interruptible_iterator& lhs, const interruptible_iterator& rhs) {
+                return !(lhs.it == rhs.it);
+            }
+
+          private:
+            It it;
+            std::shared_ptr<interrupt_guard> guard;
+        };
+
+        /**
+         *  View returned by `storage_t::iterate()` with a `query_deadline`.
+         *  The deadline is enforced whenever the view or one of its iterators steps the statement.
+         */
+        template<class V>
+        struct interruptible_view {
+            using iterator = interruptible_iterator<decltype(std::declval<V&>().begin())>;
+
+            V view;
+            std::shared_ptr<interrupt_guard> guard;
+
+            iterator begin() {
+                return {this->guard->run([this] {
+                            return this->view.begin();
+                        }),
+                        this->guard};
+            }
+
+            iterator end() {
+                return {this->view.end(), this->guard};
+            }
+        };
+    }
+}
@@ -6,9 +6,16 @@
 #include <iterator>  //  std::input_iterator_tag
 #include <system_error>  //  std::system_error
 #include <functional>  //  std::bind
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <type_traits>  //  std::is_member_object_pointer
 
 #include "statement_finalizer.h"
 #include "error_code.h"
+#include "functional/static_magic.h"
+#include "member_traits/member_traits.h"
+#include "row_extractor.h"
+#include "schema/column.h"
 #include "object_from_column_builder.h"
 #include "storage_lookup.h"
 #include "util.h"
@@ -112,6 +119,149 @@ namespace sqlite_orm {
             friend bool operator!=(const mapped_iterator& lhs, const mapped_iterator& rhs) {
                 return !(lhs == rhs);
             }
+#endif
+        };
+
+        template<class T>
+        void assign_in_place(T& target, sqlite3_stmt* stmt, int columnIndex) {
+            const auto rowExtractor = row_value_extractor<T>();
+            target = rowExtractor.extract(stmt, columnIndex);
+        }
+
+        inline void assign_in_place(std::string& target, sqlite3_stmt* stmt, int columnIndex) {
+            if (auto cStr = (const char*)sqlite3_column_text(stmt, columnIndex)) {
+                target.assign(cStr);
+            } else {
+                target.clear();
+            }
+        }
+
+        inline void assign_in_place(std::vector<char>& target, sqlite3_stmt* stmt, int columnIndex) {
+            auto bytes = static_cast<const char*>(sqlite3_column_blob(stmt, columnIndex));
+            auto len = static_cast<size_t>(sqlite3_column_bytes(stmt, columnIndex));
+            target.assign(bytes, bytes + len);
+        }
+
+        /**
+         *  Like `object_from_column_builder`, but assigns text and BLOB fields in place,
+         *  such that an object read into repeatedly reuses their capacity.
+         */
+        template<class O>
+        struct in_place_object_builder : object_from_column_builder_base {
+            using object_type = O;
+
+            object_type& object;
+
+            in_place_object_builder(object_type& object_, sqlite3_stmt* stmt_) :
+                object_from_column_builder_base{stmt_, -1}, object(object_) {}
+
+            template<class G, class S>
+            void operator()(const column_field<G, S>& column) {
+                ++this->columnIndex;
+                static_if<std::is_member_object_pointer<G>::value>(
+                    [this](const auto& column) {
+                        assign_in_place(this->object.*column.member_pointer, this->stmt, this->columnIndex);
+                    },
+                    [this](const auto& column) {
+                        const auto rowExtractor = row_value_extractor<member_field_type_t<G>>();
+                        (this->object.*column.setter)(rowExtractor.extract(this->stmt, this->columnIndex));
+                    })(column);
+            }
+        };
+
+        /*
+         *  Input iterator over a result set for a mapped object, reading every row into the same object.
+         *
+         *  Stepping through the result set doesn't allocate, but the object is overwritten by each increment.
+         *  Copies are explicit and share the position of the copied iterator.
+         */
+        template<class O, class DBOs>
+        class in_place_mapped_iterator {
+          public:
+            using db_objects_type = DBOs;
+
+            using iterator_category = std::input_iterator_tag;
+            using difference_type = ptrdiff_t;
+            using value_type = O;
+            using reference = O&;
+            using pointer = O*;
+
+          private:
+            struct cursor {
+                statement_finalizer stmt;
+                value_type current;
+            };
+
+            /**
+                pointer to the db objects.
+                only null for the default constructed iterator.
+             */
+            const db_objects_type* db_objects = nullptr;
+
+            /**
+             *  Null when the iterator reached the end.
+             */
+            std::shared_ptr<cursor> state;
+
+            void extract_object() {
+                in_place_object_builder<value_type> builder{this->state->current, this->state->stmt.get()};
+                auto& table = pick_table<value_type>(*this->db_objects);
+                table.for_each_column(builder);
+            }
+
+            void step() {
+                bool hasRow = false;
+                perform_step(this->state->stmt.get(), [this, &hasRow](sqlite3_stmt*) {
+                    this->extract_object();
+                    hasRow = true;
+                });
+                if (!hasRow) {
+                    this->state.reset();
+                }
+            }
+
+          public:
+            in_place_mapped_iterator() = default;
+
+            in_place_mapped_iterator(const db_objects_type& dbObjects, statement_finalizer stmt) :
+                db_objects{&dbObjects}, state{std::make_shared<cursor>()} {
+                this->state->stmt = std::move(stmt);
+                this->step();
+            }
+
+            explicit in_place_mapped_iterator(const in_place_mapped_iterator&) = default;
+            in_place_mapped_iterator& operator=(const in_place_mapped_iterator&) = delete;
+            in_place_mapped_iterator(in_place_mapped_iterator&&) = default;
+            in_place_mapped_iterator& operator=(in_place_mapped_iterator&&) = default;
+
+            value_type& operator*() const {
+                if (!this->state) SQLITE_ORM_CPP_UNLIKELY {
+                    throw std::system_error{orm_error_code::trying_to_dereference_null_iterator};
+                }
+                return this->state->current;
+            }
+
+            value_type* operator->() const {
+                return &(this->operator*());
+            }
+
+            in_place_mapped_iterator& operator++() {
+                this->step();
+                return *this;
+            }
+
+            void operator++(int) {
+                ++*this;
+            }
+
+            friend bool operator==(const in_place_mapped_iterator& lhs, const in_place_mapped_iterator& rhs) {
+                return lhs.state == rhs.state;
+            }
+
+#ifndef SQLITE_ORM_DEFAULT_COMPARISONS_SUPPORTED
+            friend bool operator!=(const in_place_mapped_iterator& lhs, const in_place_mapped_iterator& rhs) {
+                return !(lhs == rhs);
+            }
 #endif
         };
     }
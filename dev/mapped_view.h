@@ -48,18 +48,43 @@ namespace sqlite_orm {
             }
 
             mapped_iterator<T, db_objects_type> begin() {
+                return {obtain_db_objects(this->storage), this->prepare_statement()};
+            }
+
+            mapped_iterator<T, db_objects_type> end() {
+                return {};
+            }
+
+          protected:
+            statement_finalizer prepare_statement() {
                 using context_t = serializer_context<db_objects_type>;
-                auto& dbObjects = obtain_db_objects(this->storage);
-                context_t context{dbObjects};
+                context_t context{obtain_db_objects(this->storage)};
                 context.skip_table_name = false;
                 context.replace_bindable_with_question = true;
 
                 statement_finalizer stmt{prepare_stmt(this->connection.get(), serialize(this->expression, context))};
                 iterate_ast(this->expression.conditions, conditional_binder{stmt.get()});
-                return {dbObjects, std::move(stmt)};
+                return stmt;
             }
+        };
 
-            mapped_iterator<T, db_objects_type> end() {
+        /**
+         *  A view like `mapped_view`, returned by `storage_t::iterate_in_place()`,
+         *  whose iterator reads every row into the same object instead of allocating one per row.
+         *  Strings and BLOBs of the object reuse their capacity.
+         *  The object is only valid until the iterator is incremented.
+         */
+        template<class T, class S, class... Args>
+        struct in_place_mapped_view : mapped_view<T, S, Args...> {
+            using typename mapped_view<T, S, Args...>::db_objects_type;
+
+            using mapped_view<T, S, Args...>::mapped_view;
+
+            in_place_mapped_iterator<T, db_objects_type> begin() {
+                return {obtain_db_objects(this->storage), this->prepare_statement()};
+            }
+
+            in_place_mapped_iterator<T, db_objects_type> end() {
                 return {};
             }
         };
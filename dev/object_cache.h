@@ -0,0 +1,215 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <cstddef>  //  size_t
+#include <cstdint>  //  uint64_t
+#include <string>  //  std::string
+#include <list>  //  std::list
+#include <unordered_map>  //  std::unordered_map
+#include <vector>  //  std::vector
+#include <memory>  //  std::shared_ptr
+#include <functional>  //  std::function
+#include <mutex>  //  std::mutex, std::lock_guard
+#include <utility>  //  std::move
+
+#include "cache_key.h"
+
+namespace sqlite_orm {
+
+    struct object_cache_options {
+        /**
+         *  Maximum number of cached objects, 0 for no limit.
+         */
+        size_t max_entries = 1024;
+        /**
+         *  Maximum total size of the cached objects in bytes, 0 for no limit.
+         *  Sizes are `sizeof` the object unless `enable_object_cache()` is given a size function.
+         */
+        size_t max_bytes = 0;
+    };
+
+    struct object_cache_stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+        size_t invalidations = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+
+        double hit_rate() const {
+            const size_t lookups = this->hits + this->misses;
+            return lookups ? double(this->hits) / double(lookups) : 0;
+        }
+    };
+
+    namespace internal {
+
+        /**
+         *  Identity map of the objects of one table by primary key, evicting the least recently used objects.
+         *  Objects are stored type-erased, the storage knowing their type.
+         *
+         *  Changed rows are invalidated as soon as the update hook reports them, and again by `settle()`
+         *  once the change is committed, because a reader loading the row between the two may still see
+         *  the previous version. Objects loaded while an invalidation happened aren't cached, which is
+         *  detected by comparing the generation before and after loading.
+         */
+        class object_cache {
+          public:
+            using size_function = std::function<size_t(const void* object)>;
+
+            /**
+             *  @param keyedByRowid Whether the primary key is the rowid, in which case a changed row
+             *  invalidates the object with the rowid as key, otherwise all objects.
+             */
+            object_cache(object_cache_options options, size_function sizeOf, bool keyedByRowid) :
+                options(options), sizeOf(std::move(sizeOf)), keyedByRowid(keyedByRowid) {}
+
+            std::shared_ptr<const void> find(const std::string& key) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                auto it = this->index.find(key);
+                if (it == this->index.end()) {
+                    ++this->counters.misses;
+                    return nullptr;
+                }
+                ++this->counters.hits;
+                this->entries.splice(this->entries.begin(), this->entries, it->second);
+                return it->second->object;
+            }
+
+            uint64_t generation() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->currentGeneration;
+            }
+
+            /**
+             *  Caches an object unless something was invalidated since `generation` was taken.
+             */
+            void insert(std::string key, std::shared_ptr<const void> object, uint64_t generation) {
+                const size_t bytes = this->sizeOf(object.get());
+                std::lock_guard<std::mutex> lock{this->mutex};
+                if (generation != this->currentGeneration || this->index.count(key)) {
+                    return;
+                }
+                this->entries.push_front({key, std::move(object), bytes});
+                this->index.emplace(std::move(key), this->entries.begin());
+                this->counters.bytes += bytes;
+                while (this->over_limits()) {
+                    auto& entry = this->entries.back();
+                    this->counters.bytes -= entry.bytes;
+                    this->index.erase(entry.key);
+                    this->entries.pop_back();
+                    ++this->counters.evictions;
+                }
+            }
+
+            /**
+             *  Invalidates the object of a changed row until the next `settle()`.
+             */
+            void invalidate(std::string key) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                this->erase(key);
+                if (this->changedRows.size() < max_changed_rows) {
+                    this->changedRows.push_back(std::move(key));
+                } else {
+                    this->changedAll = true;
+                }
+            }
+
+            /**
+             *  Invalidates all objects because of changed rows until the next `settle()`.
+             */
+            void invalidate_all() {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                this->clear_entries();
+                this->changedAll = true;
+            }
+
+            void clear() {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                this->clear_entries();
+            }
+
+            /**
+             *  Called by the update hook of the writer connection for every changed row of the table.
+             */
+            void invalidate_row(sqlite3_int64 rowid) {
+                if (this->keyedByRowid) {
+                    std::string key;
+                    append_cache_key(key, rowid);
+                    this->invalidate(std::move(key));
+                } else {
+                    this->invalidate_all();
+                }
+            }
+
+            /**
+             *  Invalidates the rows changed since the last call again, once their changes are visible to readers.
+             */
+            void settle() {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                if (this->changedAll) {
+                    this->clear_entries();
+                } else {
+                    for (auto& key: this->changedRows) {
+                        this->erase(key);
+                    }
+                }
+                this->changedRows.clear();
+                this->changedAll = false;
+            }
+
+            object_cache_stats stats() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                object_cache_stats result = this->counters;
+                result.entries = this->entries.size();
+                return result;
+            }
+
+          private:
+            //  beyond this many changed rows, `settle()` clears the cache instead of remembering each row
+            static constexpr size_t max_changed_rows = 1024;
+
+            struct entry {
+                std::string key;
+                std::shared_ptr<const void> object;
+                size_t bytes;
+            };
+
+            bool over_limits() const {
+                return (this->options.max_entries && this->entries.size() > this->options.max_entries) ||
+                       (this->options.max_bytes && this->counters.bytes > this->options.max_bytes);
+            }
+
+            void erase(const std::string& key) {
+                ++this->currentGeneration;
+                auto it = this->index.find(key);
+                if (it == this->index.end()) {
+                    return;
+                }
+                this->counters.bytes -= it->second->bytes;
+                this->entries.erase(it->second);
+                this->index.erase(it);
+                ++this->counters.invalidations;
+            }
+
+            void clear_entries() {
+                ++this->currentGeneration;
+                this->counters.invalidations += this->entries.size();
+                this->counters.bytes = 0;
+                this->index.clear();
+                this->entries.clear();
+            }
+
+            const object_cache_options options;
+            const size_function sizeOf;
+            const bool keyedByRowid;
+            mutable std::mutex mutex;
+            std::list<entry> entries;
+            std::unordered_map<std::string, std::list<entry>::iterator> index;
+            uint64_t currentGeneration = 0;
+            object_cache_stats counters;
+            std::vector<std::string> changedRows;
+            bool changedAll = false;
+        };
+    }
+}
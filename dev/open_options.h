@@ -0,0 +1,100 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <utility>  //  std::pair
+
+namespace sqlite_orm {
+
+    /**
+     *  How the storage opens its database connections, passed to `make_storage`.
+     *  The options are honored every time a connection is (re)opened.
+     *
+     *  @example
+     *  ```c++
+     *  open_options options;
+     *  options.flags = SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX;
+     *  options.uri_parameters = {{"immutable", "1"}};
+     *  auto storage = make_storage("archive.sqlite", options, make_table(...));
+     *  ```
+     */
+    struct open_options {
+        /**
+         *  Flags passed to `sqlite3_open_v2()`, e.g. `SQLITE_OPEN_READONLY`, or `SQLITE_OPEN_NOMUTEX` for
+         *  connections confined to one thread at a time.
+         *  Pooled reader connections are always opened with `SQLITE_OPEN_READONLY` and without
+         *  `SQLITE_OPEN_NOMUTEX`, because an exhausted pool shares readers between threads.
+         */
+        int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+        /**
+         *  Name of the VFS to use, the default VFS if empty.
+         */
+        std::string vfs;
+        /**
+         *  Query parameters of a URI filename, e.g. `{"immutable", "1"}` or `{"cache", "shared"}`.
+         *  If there are any the filename is opened as a `file:` URI with `SQLITE_OPEN_URI`.
+         */
+        std::vector<std::pair<std::string, std::string>> uri_parameters;
+        /**
+         *  Size of a lookaside memory slot in bytes and number of slots of every connection,
+         *  set by `SQLITE_DBCONFIG_LOOKASIDE`. SQLite's defaults are kept if either is 0.
+         */
+        int lookaside_slot_size = 0;
+        int lookaside_slot_count = 0;
+    };
+
+    namespace internal {
+
+        inline void append_uri_encoded(std::string& uri, const std::string& text, const char* reserved) {
+            static constexpr const char hexDigits[] = "0123456789ABCDEF";
+            for (const char c: text) {
+                bool escape = c == '%' || c == '#' || c == '?';
+                for (const char* r = reserved; *r && !escape; ++r) {
+                    escape = c == *r;
+                }
+                if (escape) {
+                    uri += '%';
+                    uri += hexDigits[(unsigned char)c >> 4];
+                    uri += hexDigits[(unsigned char)c & 0xF];
+                } else {
+                    uri += c;
+                }
+            }
+        }
+
+        /**
+         *  The filename passed to `sqlite3_open_v2()`: `filename` as is, or a `file:` URI
+         *  carrying the URI parameters of `options`, see https://sqlite.org/uri.html.
+         */
+        inline std::string make_open_filename(const std::string& filename, const open_options& options) {
+            if (options.uri_parameters.empty()) {
+                return filename;
+            }
+            std::string uri = "file:";
+            append_uri_encoded(uri, filename, "");
+            char separator = '?';
+            for (auto& parameter: options.uri_parameters) {
+                uri += separator;
+                append_uri_encoded(uri, parameter.first, "&=");
+                uri += '=';
+                append_uri_encoded(uri, parameter.second, "&=");
+                separator = '&';
+            }
+            return uri;
+        }
+
+        inline int make_open_flags(const open_options& options) {
+            return options.uri_parameters.empty() ? options.flags : options.flags | SQLITE_OPEN_URI;
+        }
+
+        /**
+         *  Options of pooled reader connections derived from the options of the storage.
+         */
+        inline open_options make_reader_open_options(open_options options) {
+            options.flags &= ~(SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX);
+            options.flags |= SQLITE_OPEN_READONLY;
+            return options;
+        }
+    }
+}
@@ -13,6 +13,7 @@
 #include "row_extractor.h"
 #include "journal_mode.h"
 #include "locking_mode.h"
+#include "pragma_profile.h"
 #include "connection_holder.h"
 #include "util.h"
 #include "serializing_util.h"
@@ -41,8 +42,14 @@ namespace sqlite_orm {
 
         struct pragma_t {
             using get_connection_t = std::function<internal::connection_ref()>;
+            using for_each_reader_t = std::function<void(const std::function<void(sqlite3*)>&)>;
 
-            pragma_t(get_connection_t get_connection_) : get_connection(std::move(get_connection_)) {}
+            /**
+             *  @param for_each_reader_ Optional function calling its argument with every opened reader connection,
+             *  which connection pragmas are applied to as well.
+             */
+            pragma_t(get_connection_t get_connection_, for_each_reader_t for_each_reader_ = {}) :
+                get_connection(std::move(get_connection_)), for_each_reader(std::move(for_each_reader_)) {}
 
             std::vector<std::string> module_list() {
                 return this->get_pragma<std::vector<std::string>>("module_list");
@@ -56,8 +63,11 @@ namespace sqlite_orm {
                 this->set_pragma("recursive_triggers", int(value));
             }
 
+            /**
+             *  Kept for connections opened later on, see `apply_profile()`.
+             */
             void busy_timeout(int value) {
-                this->set_pragma("busy_timeout", value);
+                this->apply_profile(pragma_profile{}.busy_timeout(value));
             }
 
             int busy_timeout() {
@@ -100,10 +110,98 @@ namespace sqlite_orm {
                 return this->get_pragma<int>("synchronous");
             }
 
+            /**
+             *  Kept for connections opened later on, see `apply_profile()`.
+             */
             void synchronous(int value) {
-                this->synchronous_ = -1;
-                this->set_pragma("synchronous", value);
-                this->synchronous_ = value;
+                this->apply_profile(pragma_profile{}.synchronous(value));
+            }
+
+            /**
+             *  https://www.sqlite.org/pragma.html#pragma_cache_size
+             *  Number of pages if positive, otherwise the size in KiB if negative.
+             *  Kept for connections opened later on, see `apply_profile()`.
+             */
+            int cache_size() {
+                return this->get_pragma<int>("cache_size");
+            }
+
+            void cache_size(int value) {
+                this->apply_profile(pragma_profile{}.cache_size(value));
+            }
+
+            /**
+             *  https://www.sqlite.org/pragma.html#pragma_mmap_size
+             *  Kept for connections opened later on, see `apply_profile()`.
+             */
+            sqlite3_int64 mmap_size() {
+                return this->get_pragma<sqlite3_int64>("mmap_size");
+            }
+
+            void mmap_size(sqlite3_int64 value) {
+                this->apply_profile(pragma_profile{}.mmap_size(value));
+            }
+
+            /**
+             *  https://www.sqlite.org/pragma.html#pragma_temp_store
+             *  Kept for connections opened later on, see `apply_profile()`.
+             */
+            sqlite_orm::temp_store temp_store() {
+                return static_cast<sqlite_orm::temp_store>(this->get_pragma<int>("temp_store"));
+            }
+
+            void temp_store(sqlite_orm::temp_store value) {
+                this->apply_profile(pragma_profile{}.temp_store(value));
+            }
+
+            /**
+             *  https://www.sqlite.org/pragma.html#pragma_page_size
+             *  Kept for connections opened later on, see `apply_profile()`.
+             */
+            int page_size() {
+                return this->get_pragma<int>("page_size");
+            }
+
+            void page_size(int value) {
+                this->apply_profile(pragma_profile{}.page_size(value));
+            }
+
+            /**
+             *  https://www.sqlite.org/pragma.html#pragma_wal_autocheckpoint
+             *  Kept for connections opened later on, see `apply_profile()`.
+             *  While a background checkpointer runs the value takes effect once it is stopped.
+             */
+            int wal_autocheckpoint() {
+                return this->get_pragma<int>("wal_autocheckpoint");
+            }
+
+            void wal_autocheckpoint(int value) {
+                this->apply_profile(pragma_profile{}.wal_autocheckpoint(value));
+            }
+
+            /**
+             *  Applies the pragmas set by `profile` at once to the writer connection and, as far as they
+             *  configure connections rather than writes, to every opened reader connection.
+             *  The pragmas are kept and applied again whenever a connection is opened,
+             *  hence they survive reconnects. Pragmas set before and not set by `profile` are kept as well.
+             */
+            void apply_profile(const pragma_profile& profile) {
+                auto con = this->get_connection();
+                const std::string connectionPragmas = profile.to_sql(false);
+                perform_void_exec(con.get(), profile.to_sql(true, this->walHookInstalled) + connectionPragmas);
+                if (this->for_each_reader && !connectionPragmas.empty()) {
+                    this->for_each_reader([&connectionPragmas](sqlite3* db) {
+                        perform_void_exec(db, connectionPragmas);
+                    });
+                }
+                this->appliedProfile.merge(profile);
+            }
+
+            /**
+             *  The pragmas applied whenever a connection is opened.
+             */
+            const pragma_profile& applied_profile() const {
+                return this->appliedProfile;
             }
 
             int user_version() {
@@ -222,14 +320,28 @@ namespace sqlite_orm {
           private:
             friend struct storage_base;
 
-            int synchronous_ = -1;
             signed char journal_mode_ = -1;  //  if != -1 stores static_cast<sqlite_orm::journal_mode>(journal_mode)
             get_connection_t get_connection;
+            for_each_reader_t for_each_reader;
+            pragma_profile appliedProfile;
+            //  whether a background checkpointer replaced the auto-checkpoints of the writer connection
+            bool walHookInstalled = false;
+
+            /**
+             *  Applies the kept pragmas to a connection that was just opened.
+             */
+            void apply_profile_on_open(sqlite3* db, bool writer) {
+                const std::string sql = this->appliedProfile.to_sql(writer, this->walHookInstalled);
+                if (!sql.empty()) {
+                    perform_void_exec(db, sql);
+                }
+            }
 
             template<class T>
             T get_pragma(const std::string& name) {
                 auto connection = this->get_connection();
-                T result;
+                //  value initialized for pragmas not returning a row, e.g. `mmap_size` of in-memory databases
+                T result{};
                 perform_exec(connection.get(), "PRAGMA " + name, getPragmaCallback<T>, &result);
                 return result;
             }
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <array>  //  std::array
+#include <string>  //  std::string
+#include <sstream>  //  std::stringstream
+#include <cstddef>  //  size_t
+
+namespace sqlite_orm {
+
+    /**
+     *  Caps case like `journal_mode`.
+     *  https://www.sqlite.org/pragma.html#pragma_temp_store
+     */
+    enum class temp_store {
+        DEFAULT = 0,
+        FILE = 1,
+        MEMORY = 2,
+    };
+
+    namespace internal {
+
+        /**
+         *  Pragmas a `pragma_profile` consists of, in the order they are applied.
+         *  `page_size` comes first because it must be set before the database is written.
+         */
+        enum class profile_pragma : size_t {
+            page_size,
+            cache_size,
+            mmap_size,
+            temp_store,
+            synchronous,
+            wal_autocheckpoint,
+            busy_timeout,
+            count,
+        };
+
+        inline const char* profile_pragma_name(profile_pragma pragma) {
+            static constexpr const char* names[] = {
+                "page_size",
+                "cache_size",
+                "mmap_size",
+                "temp_store",
+                "synchronous",
+                "wal_autocheckpoint",
+                "busy_timeout",
+            };
+            return names[size_t(pragma)];
+        }
+
+        /**
+         *  Whether a pragma only matters for the connection writing the database,
+         *  as opposed to pragmas configuring every connection including pooled readers.
+         */
+        inline bool is_writer_pragma(profile_pragma pragma) {
+            return pragma == profile_pragma::page_size || pragma == profile_pragma::synchronous ||
+                   pragma == profile_pragma::wal_autocheckpoint;
+        }
+    }
+
+    /**
+     *  A set of performance pragmas applied together, see `pragma_t::apply_profile()`.
+     *  Pragmas not set by a profile are left alone when it is applied.
+     *  The predefined profiles all set `cache_size`, `mmap_size`, `temp_store`, `synchronous` and
+     *  `wal_autocheckpoint`, hence switching between them replaces all settings of the previous one.
+     *
+     *  @example
+     *  ```c++
+     *  storage.pragma.apply_profile(pragma_profile::bulk_load());
+     *  //  import ...
+     *  storage.pragma.apply_profile(pragma_profile::read_heavy().busy_timeout(5000));
+     *  ```
+     */
+    class pragma_profile {
+      public:
+        /**
+         *  Number of pages if positive, otherwise the size in KiB if negative.
+         */
+        pragma_profile& cache_size(int value) {
+            return this->set(internal::profile_pragma::cache_size, value);
+        }
+
+        pragma_profile& mmap_size(sqlite3_int64 value) {
+            return this->set(internal::profile_pragma::mmap_size, value);
+        }
+
+        pragma_profile& temp_store(sqlite_orm::temp_store value) {
+            return this->set(internal::profile_pragma::temp_store, int(value));
+        }
+
+        /**
+         *  Takes effect for new databases only, or once the database is vacuumed.
+         */
+        pragma_profile& page_size(int value) {
+            return this->set(internal::profile_pragma::page_size, value);
+        }
+
+        pragma_profile& wal_autocheckpoint(int value) {
+            return this->set(internal::profile_pragma::wal_autocheckpoint, value);
+        }
+
+        pragma_profile& busy_timeout(int value) {
+            return this->set(internal::profile_pragma::busy_timeout, value);
+        }
+
+        pragma_profile& synchronous(int value) {
+            return this->set(internal::profile_pragma::synchronous, value);
+        }
+
+        /**
+         *  A large page cache and memory-mapped reads, for databases mostly read in WAL mode.
+         */
+        static pragma_profile read_heavy() {
+            return pragma_profile{}
+                .cache_size(-64 * 1024)
+                .mmap_size(256 * 1024 * 1024)
+                .temp_store(sqlite_orm::temp_store::MEMORY)
+                .synchronous(1)
+                .wal_autocheckpoint(1000);
+        }
+
+        /**
+         *  `synchronous = NORMAL`, which is durable in WAL mode, and less frequent but longer checkpoints.
+         */
+        static pragma_profile write_heavy() {
+            return pragma_profile{}
+                .cache_size(-32 * 1024)
+                .mmap_size(64 * 1024 * 1024)
+                .temp_store(sqlite_orm::temp_store::MEMORY)
+                .synchronous(1)
+                .wal_autocheckpoint(4000);
+        }
+
+        /**
+         *  Trades durability for speed while importing data: no syncs and no auto-checkpoints.
+         *  Switch to another profile once the import is done.
+         */
+        static pragma_profile bulk_load() {
+            return pragma_profile{}
+                .cache_size(-256 * 1024)
+                .mmap_size(0)
+                .temp_store(sqlite_orm::temp_store::MEMORY)
+                .synchronous(0)
+                .wal_autocheckpoint(0);
+        }
+
+        /**
+         *  A small page cache, no memory mapping and temporary tables in files.
+         */
+        static pragma_profile low_memory() {
+            return pragma_profile{}
+                .cache_size(-1024)
+                .mmap_size(0)
+                .temp_store(sqlite_orm::temp_store::FILE)
+                .synchronous(2)
+                .wal_autocheckpoint(1000);
+        }
+
+        bool has(internal::profile_pragma pragma) const {
+            return this->isSet[size_t(pragma)];
+        }
+
+        sqlite3_int64 get(internal::profile_pragma pragma) const {
+            return this->values[size_t(pragma)];
+        }
+
+        /**
+         *  Sets the pragmas set by `other`.
+         */
+        pragma_profile& merge(const pragma_profile& other) {
+            for (size_t i = 0; i < size_t(internal::profile_pragma::count); ++i) {
+                if (other.isSet[i]) {
+                    this->isSet[i] = true;
+                    this->values[i] = other.values[i];
+                }
+            }
+            return *this;
+        }
+
+        /**
+         *  The pragma statements setting the writer or the connection pragmas of this profile,
+         *  executed all at once.
+         *  @param skipWalAutocheckpoint Whether to leave `wal_autocheckpoint` alone
+         *  because a background checkpointer is hooked into the connection.
+         */
+        std::string to_sql(bool writer, bool skipWalAutocheckpoint = false) const {
+            std::stringstream ss;
+            for (size_t i = 0; i < size_t(internal::profile_pragma::count); ++i) {
+                const auto pragma = internal::profile_pragma(i);
+                if (!this->isSet[i] || internal::is_writer_pragma(pragma) != writer ||
+                    (skipWalAutocheckpoint && pragma == internal::profile_pragma::wal_autocheckpoint)) {
+                    continue;
+                }
+                ss << "PRAGMA " << internal::profile_pragma_name(pragma) << " = " << this->values[i] << "; ";
+            }
+            return ss.str();
+        }
+
+      private:
+        pragma_profile& set(internal::profile_pragma pragma, sqlite3_int64 value) {
+            this->isSet[size_t(pragma)] = true;
+            this->values[size_t(pragma)] = value;
+            return *this;
+        }
+
+        std::array<bool, size_t(internal::profile_pragma::count)> isSet{};
+        std::array<sqlite3_int64, size_t(internal::profile_pragma::count)> values{};
+    };
+}
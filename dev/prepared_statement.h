@@ -7,6 +7,7 @@
 #include <type_traits>  //  std::integral_constant, std::declval
 #include <utility>  //  std::move, std::forward, std::pair
 #include <tuple>  //  std::tuple
+#include <vector>  //  std::vector
 
 #include "functional/cxx_type_traits_polyfill.h"
 #include "functional/cxx_functional_polyfill.h"
@@ -21,6 +22,35 @@
 
 namespace sqlite_orm {
 
+#ifdef SQLITE_ENABLE_STMT_SCANSTATUS
+    /**
+     *  Statistics of one loop of a statement's query plan, see https://sqlite.org/c3ref/stmt_scanstatus.html
+     */
+    struct scan_status {
+        /**
+         *  Number of times the loop was run.
+         */
+        sqlite3_int64 loops = 0;
+        /**
+         *  Number of rows visited by the loop in total.
+         */
+        sqlite3_int64 rows_visited = 0;
+        /**
+         *  Query planner's estimate of the rows output by each run of the loop.
+         */
+        double estimated_rows = 0;
+        /**
+         *  Name of the table or index the loop iterates.
+         */
+        std::string name;
+        /**
+         *  Description of the loop like in the output of EXPLAIN QUERY PLAN, e.g. "SCAN users".
+         */
+        std::string explain;
+        int select_id = 0;
+    };
+#endif
+
     namespace internal {
 
         struct prepared_statement_base {
@@ -71,6 +101,125 @@ namespace sqlite_orm {
                 return sqlite3_column_name(stmt, index);
             }
 #endif
+
+            /**
+             *  Number of times SQLite stepped forward in a table as part of a full table scan
+             *  since the statement was prepared or the counters were reset.
+             *  Non-zero values hint at a missing index.
+             */
+            int fullscan_steps() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, false);
+            }
+
+            /**
+             *  Number of sort operations, which hint at an ORDER BY or GROUP BY not served by an index.
+             */
+            int sort_operations() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_SORT, false);
+            }
+
+            /**
+             *  Number of rows inserted into transient indices created automatically to help joins,
+             *  which hint at a missing index, too.
+             */
+            int autoindex_rows() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_AUTOINDEX, false);
+            }
+
+#ifdef SQLITE_STMTSTATUS_VM_STEP
+            /**
+             *  Number of virtual machine operations executed, a proxy for the total work done.
+             */
+            int vm_steps() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_VM_STEP, false);
+            }
+
+            /**
+             *  Number of times the statement was automatically regenerated due to schema changes.
+             */
+            int reprepares() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_REPREPARE, false);
+            }
+
+            /**
+             *  Number of times the statement was run, where a run counts as completed
+             *  once it is reset.
+             */
+            int runs() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_RUN, false);
+            }
+#endif
+#ifdef SQLITE_STMTSTATUS_FILTER_HIT
+            /**
+             *  Number of times a join step was bypassed because a Bloom filter returned not-found.
+             */
+            int filter_hits() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_FILTER_HIT, false);
+            }
+
+            /**
+             *  Number of times a Bloom filter check didn't bypass a join step.
+             */
+            int filter_misses() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_FILTER_MISS, false);
+            }
+#endif
+
+            /**
+             *  Resets all the counters above to zero.
+             */
+            void reset_status_counters() {
+                for (int counter: {SQLITE_STMTSTATUS_FULLSCAN_STEP,
+                                   SQLITE_STMTSTATUS_SORT,
+                                   SQLITE_STMTSTATUS_AUTOINDEX,
+#ifdef SQLITE_STMTSTATUS_VM_STEP
+                                   SQLITE_STMTSTATUS_VM_STEP,
+                                   SQLITE_STMTSTATUS_REPREPARE,
+                                   SQLITE_STMTSTATUS_RUN,
+#endif
+#ifdef SQLITE_STMTSTATUS_FILTER_HIT
+                                   SQLITE_STMTSTATUS_FILTER_HIT,
+                                   SQLITE_STMTSTATUS_FILTER_MISS,
+#endif
+                     }) {
+                    sqlite3_stmt_status(this->stmt, counter, true);
+                }
+            }
+
+#ifdef SQLITE_ENABLE_STMT_SCANSTATUS
+            /**
+             *  Returns the statistics of every loop of the statement's query plan.
+             *  Requires SQLite to be compiled with `SQLITE_ENABLE_STMT_SCANSTATUS`.
+             */
+            std::vector<scan_status> scan_statuses() const {
+                std::vector<scan_status> result;
+                for (int loop = 0;; ++loop) {
+                    scan_status status;
+                    const char* name = nullptr;
+                    const char* explain = nullptr;
+                    if (sqlite3_stmt_scanstatus(this->stmt, loop, SQLITE_SCANSTAT_NLOOP, &status.loops) != 0) {
+                        break;
+                    }
+                    sqlite3_stmt_scanstatus(this->stmt, loop, SQLITE_SCANSTAT_NVISIT, &status.rows_visited);
+                    sqlite3_stmt_scanstatus(this->stmt, loop, SQLITE_SCANSTAT_EST, &status.estimated_rows);
+                    sqlite3_stmt_scanstatus(this->stmt, loop, SQLITE_SCANSTAT_NAME, &name);
+                    sqlite3_stmt_scanstatus(this->stmt, loop, SQLITE_SCANSTAT_EXPLAIN, &explain);
+                    sqlite3_stmt_scanstatus(this->stmt, loop, SQLITE_SCANSTAT_SELECTID, &status.select_id);
+                    if (name) {
+                        status.name = name;
+                    }
+                    if (explain) {
+                        status.explain = explain;
+                    }
+                    result.push_back(std::move(status));
+                }
+                return result;
+            }
+
+            void reset_scan_statuses() {
+                sqlite3_stmt_scanstatus_reset(this->stmt);
+            }
+#endif
         };
 
         template<class T>
@@ -178,6 +327,27 @@ namespace sqlite_orm {
             ids_type ids;
         };
 
+        /**
+         *  Fetches the objects with the given primary keys in one statement.
+         *  Id is the primary key's type, or a std::tuple of the types of a composite primary key.
+         */
+        template<class T, class Id>
+        struct get_many_t {
+            using type = T;
+            using id_type = Id;
+
+            std::vector<Id> ids;
+        };
+
+        /**
+         *  Number of primary key columns identified by an id of type Id.
+         */
+        template<class Id>
+        struct id_columns_count : std::integral_constant<size_t, 1> {};
+
+        template<class... Args>
+        struct id_columns_count<std::tuple<Args...>> : std::integral_constant<size_t, sizeof...(Args)> {};
+
 #ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
         template<class T, class... Ids>
         struct get_optional_t {
@@ -195,6 +365,18 @@ namespace sqlite_orm {
             type object;
         };
 
+        /**
+         *  Update of only those columns of an object whose flag is set in `columnsMask`,
+         *  which is indexed in the order of the table's columns.
+         */
+        template<class T>
+        struct update_columns_t {
+            using type = T;
+
+            type object;
+            std::vector<bool> columnsMask;
+        };
+
         template<class T, class... Ids>
         struct remove_t {
             using type = T;
@@ -679,6 +861,19 @@ namespace sqlite_orm {
     }
 #endif
 
+#ifdef SQLITE_ENABLE_JSON1
+    /**
+     *  Create a get many statement.
+     *  T is an object type mapped to a storage.
+     *  Usage: get_many<User>(std::vector<int>{5, 6, 7});
+     *  Usage with a composite primary key: get_many<Membership>(std::vector<std::tuple<int, int>>{{1, 2}, {1, 3}});
+     */
+    template<class T, class Id>
+    internal::get_many_t<T, Id> get_many(std::vector<Id> ids) {
+        return {std::move(ids)};
+    }
+#endif  //  SQLITE_ENABLE_JSON1
+
 #ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
     /**
      *  Create a get optional statement.
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <cstring>  //  std::strlen
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <utility>  //  std::move
+
+#include "error_code.h"
+#include "statement_finalizer.h"
+#include "util.h"
+
+namespace sqlite_orm {
+
+    enum class query_plan_operation {
+        other,
+        scan,
+        search,
+    };
+
+    /**
+     *  One row of the output of `EXPLAIN QUERY PLAN`, see https://sqlite.org/eqp.html.
+     *  Nodes form a tree through `parent`, which is the `id` of the parent node or 0 for top-level nodes.
+     *  The fields following `detail` are parsed from it.
+     */
+    struct query_plan_node {
+        int id = 0;
+        int parent = 0;
+        std::string detail;
+
+        /**
+         *  Whether the node is a full scan (`SCAN`) or a lookup (`SEARCH`) of a table.
+         */
+        query_plan_operation operation = query_plan_operation::other;
+        /**
+         *  Name of the table scanned or searched, empty if the node isn't about a table.
+         */
+        std::string table;
+        /**
+         *  Name of the index used, empty if none or an automatic index is used.
+         */
+        std::string index;
+        bool covering_index = false;
+        bool automatic_index = false;
+        /**
+         *  Whether the rowid or the primary key of a WITHOUT ROWID table is used.
+         */
+        bool primary_key = false;
+        bool virtual_table = false;
+
+        bool is_scan() const {
+            return this->operation == query_plan_operation::scan;
+        }
+
+        bool is_search() const {
+            return this->operation == query_plan_operation::search;
+        }
+    };
+
+    namespace internal {
+
+        /**
+         *  Parses the detail text of a query plan node, e.g.
+         *  "SCAN users", "SEARCH TABLE visits USING COVERING INDEX idx_visits (user_id=?)"
+         *  or "SEARCH users USING INTEGER PRIMARY KEY (rowid=?)".
+         */
+        inline query_plan_node make_query_plan_node(int id, int parent, std::string detail) {
+            query_plan_node node;
+            node.id = id;
+            node.parent = parent;
+            node.detail = std::move(detail);
+
+            std::string rest = node.detail;
+            auto consume = [&rest](const char* prefix) {
+                const size_t length = std::strlen(prefix);
+                if (rest.compare(0, length, prefix) != 0) {
+                    return false;
+                }
+                rest.erase(0, length);
+                return true;
+            };
+            auto takeWord = [&rest]() {
+                std::string word = rest.substr(0, rest.find(' '));
+                rest.erase(0, word.size());
+                return word;
+            };
+
+            if (consume("SCAN ")) {
+                node.operation = query_plan_operation::scan;
+            } else if (consume("SEARCH ")) {
+                node.operation = query_plan_operation::search;
+            } else {
+                return node;
+            }
+            //  prior to SQLite 3.36
+            consume("TABLE ");
+            //  subqueries and constant rows are no tables
+            if (rest.empty() || rest[0] == '(' || consume("CONSTANT ROW")) {
+                return node;
+            }
+            node.table = takeWord();
+            if (consume(" AS ")) {
+                takeWord();
+            }
+            node.virtual_table = consume(" VIRTUAL TABLE");
+            if (consume(" USING ")) {
+                if (consume("INTEGER PRIMARY KEY") || consume("PRIMARY KEY")) {
+                    node.primary_key = true;
+                } else {
+                    node.automatic_index = consume("AUTOMATIC ");
+                    consume("PARTIAL ");
+                    node.covering_index = consume("COVERING ");
+                    if (consume("INDEX ") && !rest.empty() && rest[0] != '(') {
+                        node.index = takeWord();
+                    }
+                }
+            }
+            return node;
+        }
+
+        /**
+         *  Runs `EXPLAIN QUERY PLAN` for the given SQL.
+         */
+        inline std::vector<query_plan_node> query_plan_of(sqlite3* db, const std::string& sql) {
+            std::vector<query_plan_node> result;
+            statement_finalizer finalizer{prepare_stmt(db, "EXPLAIN QUERY PLAN " + sql)};
+            perform_steps(finalizer.get(), [&result](sqlite3_stmt* stmt) {
+                const char* detail = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+                result.push_back(make_query_plan_node(sqlite3_column_int(stmt, 0),
+                                                      sqlite3_column_int(stmt, 1),
+                                                      detail ? detail : ""));
+            });
+            return result;
+        }
+
+        /**
+         *  Returns the number of rows of a table, or -1 if `table` isn't a table, e.g. a CTE.
+         */
+        inline sqlite3_int64 table_rows_count(sqlite3* db, const std::string& table) {
+            sqlite3_stmt* stmt = nullptr;
+            const std::string sql = "SELECT count(*) FROM " + quote_identifier(table);
+            if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+                return -1;
+            }
+            statement_finalizer finalizer{stmt};
+            sqlite3_int64 count = -1;
+            perform_steps(stmt, [&count](sqlite3_stmt* stmt) {
+                count = sqlite3_column_int64(stmt, 0);
+            });
+            return count;
+        }
+    }
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <cstddef>  //  size_t
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <memory>  //  std::unique_ptr, std::make_unique
+#include <functional>  //  std::function
+#include <mutex>  //  std::mutex, std::lock_guard
+
+#include "functional/cxx_universal.h"
+#include "functional/cxx_type_traits_polyfill.h"
+#include "open_options.h"
+#include "connection_holder.h"
+#include "select_constraints.h"
+#include "prepared_statement.h"
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+        /**
+         *  Whether an expression only reads from the database and hence may run on a pooled reader connection.
+         */
+        template<class T>
+        SQLITE_ORM_INLINE_VAR constexpr bool is_read_only_expression_v =
+            polyfill::disjunction<polyfill::is_specialization_of<T, select_t>,
+                                  polyfill::is_specialization_of<T, get_all_t>,
+                                  polyfill::is_specialization_of<T, get_all_pointer_t>,
+#ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
+                                  polyfill::is_specialization_of<T, get_all_optional_t>,
+                                  polyfill::is_specialization_of<T, get_optional_t>,
+#endif
+                                  polyfill::is_specialization_of<T, get_t>,
+                                  polyfill::is_specialization_of<T, get_pointer_t>,
+                                  polyfill::is_specialization_of<T, get_many_t>>::value;
+
+        template<class T>
+        using is_read_only_expression = polyfill::bool_constant<is_read_only_expression_v<T>>;
+
+        /**
+         *  Pool of read-only connections to the same database file.
+         *
+         *  Reader connections are opened on demand, up to the pool's capacity, and stay opened
+         *  as long as they are part of the pool. A checkout hands out an idle reader if there is one,
+         *  otherwise it opens another reader or shares the least busy one if the pool is exhausted.
+         */
+        struct reader_pool {
+            /**
+             *  @param options Options of the storage, from which the options of the readers are derived.
+             */
+            reader_pool(std::string filename,
+                        std::function<void(sqlite3*)> didOpenDb,
+                        std::function<void(sqlite3*)> willCloseDb,
+                        const open_options& options = {}) :
+                filename(std::move(filename)), didOpenDb(std::move(didOpenDb)), willCloseDb(std::move(willCloseDb)),
+                options(make_reader_open_options(options)) {}
+
+            reader_pool(const reader_pool&) = delete;
+
+            ~reader_pool() {
+                this->set_capacity(0);
+            }
+
+            /**
+             *  Sets the maximum number of reader connections.
+             *  Readers exceeding the new capacity are closed as soon as they are not in use anymore.
+             */
+            void set_capacity(size_t newCapacity) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                this->capacity = newCapacity;
+                while (this->pooledCount > this->capacity) {
+                    this->readers[--this->pooledCount]->release();
+                }
+            }
+
+            size_t get_capacity() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->capacity;
+            }
+
+            /**
+             *  @param fallback Connection handed out if the pool's capacity is zero.
+             */
+            connection_ref checkout(connection_holder& fallback) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                connection_holder* leastBusy = nullptr;
+                for (size_t i = 0; i < this->pooledCount; ++i) {
+                    connection_holder* reader = this->readers[i].get();
+                    //  a reader not in use is only retained by the pool itself
+                    if (reader->retain_count() == 1) {
+                        return {*reader};
+                    }
+                    if (!leastBusy || reader->retain_count() < leastBusy->retain_count()) {
+                        leastBusy = reader;
+                    }
+                }
+                if (this->pooledCount < this->capacity) {
+                    if (this->pooledCount == this->readers.size()) {
+                        this->readers.push_back(std::make_unique<connection_holder>(this->filename,
+                                                                                    this->didOpenDb,
+                                                                                    this->willCloseDb,
+                                                                                    this->options));
+                    }
+                    connection_holder* reader = this->readers[this->pooledCount].get();
+                    reader->retain();
+                    ++this->pooledCount;
+                    return {*reader};
+                }
+                return {leastBusy ? *leastBusy : fallback};
+            }
+
+            /**
+             *  Calls `f` with every opened reader connection.
+             */
+            template<class F>
+            void for_each_opened(F&& f) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                for (auto& reader: this->readers) {
+                    if (reader->is_open()) {
+                        f(reader->get());
+                    }
+                }
+            }
+
+          private:
+            const std::string filename;
+            const std::function<void(sqlite3*)> didOpenDb;
+            const std::function<void(sqlite3*)> willCloseDb;
+            const open_options options;
+
+            mutable std::mutex mutex;
+            size_t capacity = 0;
+            //  number of leading readers retained by the pool
+            size_t pooledCount = 0;
+            //  never shrinks, such that connection references stay valid
+            std::vector<std::unique_ptr<connection_holder>> readers;
+        };
+    }
+}
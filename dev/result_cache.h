@@ -0,0 +1,240 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <cstddef>  //  size_t
+#include <cstdint>  //  uint64_t, uintptr_t
+#include <string>  //  std::string, std::to_string
+#include <set>  //  std::set
+#include <list>  //  std::list
+#include <unordered_map>  //  std::unordered_map
+#include <memory>  //  std::shared_ptr, std::unique_ptr
+#include <mutex>  //  std::mutex, std::lock_guard
+#include <utility>  //  std::move
+#include <functional>  //  std::less
+#include <iterator>  //  std::prev
+
+#include "type_traits.h"
+#include "statement_binder.h"
+#include "ast_iterator.h"
+#include "cache_key.h"
+#include "object_cache.h"
+
+namespace sqlite_orm {
+
+    struct result_cache_options {
+        /**
+         *  Maximum number of cached results, 0 for no limit.
+         */
+        size_t max_entries = 256;
+        /**
+         *  Maximum total size of the cached results in bytes, 0 for no limit.
+         *  The size of a result is estimated as its number of rows times the size of a row,
+         *  not counting memory rows own, like the characters of long strings.
+         */
+        size_t max_bytes = 0;
+        /**
+         *  Whether to check `PRAGMA data_version` before every lookup and clear the cache
+         *  once another connection, e.g. of another process, committed changes to the database.
+         */
+        bool detect_external_changes = true;
+    };
+
+    /**
+     *  The same counters as for object caches.
+     */
+    using result_cache_stats = object_cache_stats;
+
+    namespace internal {
+
+        /**
+         *  Appends the values a statement binds, in the order they are bound.
+         */
+        struct result_cache_key_binder {
+            std::string& key;
+            bool appended = true;
+
+            template<class T, satisfies<is_bindable, T> = true>
+            void operator()(const T& value) {
+                this->appended = this->appended && append_cache_key(this->key, value);
+            }
+
+            template<class T, satisfies_not<is_bindable, T> = true>
+            void operator()(const T&) const {}
+        };
+
+        /**
+         *  Key of the results of a statement: the type of the results, the SQL with parameter placeholders
+         *  and the values bound to the parameters.
+         *  @return An empty key if a bound value can't be appended, see `cache_key_writer`.
+         */
+        template<class R, class E>
+        std::string make_result_cache_key(sqlite3_stmt* stmt, const E& expression) {
+            std::string key = std::to_string(uintptr_t(cache_type_id<R>()));
+            key += ':';
+            key += sqlite3_sql(stmt);
+            key += '\0';
+            result_cache_key_binder binder{key};
+            iterate_ast(expression, binder);
+            if (!binder.appended) {
+                key.clear();
+            }
+            return key;
+        }
+
+        /**
+         *  Results of queries by their SQL and bound values, evicting the least recently used results.
+         *  Results are stored type-erased, the storage knowing their type.
+         *
+         *  Every result remembers the tables it was read from and is invalidated once one of them changes.
+         *  A changed table stays pending until `settle()` is called after the change was committed or rolled back,
+         *  results of the table aren't cached meanwhile because readers may still see the previous version.
+         *  Results read while a change happened aren't cached either, which is detected by comparing
+         *  the generation before and after reading.
+         */
+        class result_cache {
+          public:
+            explicit result_cache(result_cache_options options) : options(options) {}
+
+            const result_cache_options& get_options() const {
+                return this->options;
+            }
+
+            std::shared_ptr<const void> find(const std::string& key) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                auto it = this->index.find(key);
+                if (it == this->index.end()) {
+                    ++this->counters.misses;
+                    return nullptr;
+                }
+                ++this->counters.hits;
+                this->entries.splice(this->entries.begin(), this->entries, it->second);
+                return it->second->result;
+            }
+
+            uint64_t generation() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->currentGeneration;
+            }
+
+            /**
+             *  Caches a result unless anything changed since `generation` was taken or one of its tables is pending.
+             */
+            void insert(std::string key,
+                        std::shared_ptr<const void> result,
+                        size_t bytes,
+                        std::set<std::string> tables,
+                        uint64_t generation) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                if (generation != this->currentGeneration || this->index.count(key)) {
+                    return;
+                }
+                for (auto& table: tables) {
+                    if (this->pendingTables.count(table)) {
+                        return;
+                    }
+                }
+                this->entries.push_front({key, std::move(result), bytes, std::move(tables)});
+                this->index.emplace(std::move(key), this->entries.begin());
+                this->counters.bytes += bytes;
+                while (this->over_limits()) {
+                    ++this->counters.evictions;
+                    this->erase(std::prev(this->entries.end()));
+                }
+            }
+
+            /**
+             *  Invalidates the results read from a table and keeps the table pending until the next `settle()`.
+             *  Called by the update hook of the writer connection for every changed row.
+             */
+            void table_changed(const char* table) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                ++this->currentGeneration;
+                if (this->pendingTables.count(table)) {
+                    return;
+                }
+                this->pendingTables.emplace(table);
+                for (auto it = this->entries.begin(); it != this->entries.end();) {
+                    auto current = it++;
+                    if (current->tables.count(table)) {
+                        ++this->counters.invalidations;
+                        this->erase(current);
+                    }
+                }
+            }
+
+            /**
+             *  Ends pending changes, once they are visible to readers.
+             */
+            void settle() {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                if (this->pendingTables.empty()) {
+                    return;
+                }
+                ++this->currentGeneration;
+                this->pendingTables.clear();
+            }
+
+            /**
+             *  Clears the cache if the data version of the connection changed since the last call,
+             *  i.e. another connection committed changes.
+             */
+            void check_data_version(sqlite3_int64 dataVersion) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                if (this->hasDataVersion && dataVersion != this->dataVersion) {
+                    this->clear_entries();
+                }
+                this->dataVersion = dataVersion;
+                this->hasDataVersion = true;
+            }
+
+            void clear() {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                this->clear_entries();
+            }
+
+            result_cache_stats stats() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                result_cache_stats result = this->counters;
+                result.entries = this->entries.size();
+                return result;
+            }
+
+          private:
+            struct entry {
+                std::string key;
+                std::shared_ptr<const void> result;
+                size_t bytes;
+                std::set<std::string> tables;
+            };
+
+            bool over_limits() const {
+                return (this->options.max_entries && this->entries.size() > this->options.max_entries) ||
+                       (this->options.max_bytes && this->counters.bytes > this->options.max_bytes);
+            }
+
+            void erase(std::list<entry>::iterator it) {
+                this->counters.bytes -= it->bytes;
+                this->index.erase(it->key);
+                this->entries.erase(it);
+            }
+
+            void clear_entries() {
+                ++this->currentGeneration;
+                this->counters.invalidations += this->entries.size();
+                this->counters.bytes = 0;
+                this->index.clear();
+                this->entries.clear();
+            }
+
+            const result_cache_options options;
+            mutable std::mutex mutex;
+            std::list<entry> entries;
+            std::unordered_map<std::string, std::list<entry>::iterator> index;
+            uint64_t currentGeneration = 0;
+            result_cache_stats counters;
+            std::set<std::string, std::less<>> pendingTables;
+            sqlite3_int64 dataVersion = 0;
+            bool hasDataVersion = false;
+        };
+    }
+}
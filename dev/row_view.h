@@ -0,0 +1,80 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <cstddef>  //  size_t, std::byte
+
+#include "functional/cxx_string_view.h"
+#include "functional/cxx_span.h"
+#include "row_extractor.h"
+
+namespace sqlite_orm {
+
+    /**
+     *  Non-owning view of the current row of a statement, as yielded by `storage_t::cursor()`.
+     *  Text and blob accessors point directly into SQLite's column buffers without copying them,
+     *  so a row and everything obtained from it are only valid until the statement steps to the next row.
+     *
+     *  Column indexes are zero-based like the columns of the select statement.
+     */
+    class row_view {
+      public:
+        explicit row_view(sqlite3_stmt* stmt) : stmt{stmt} {}
+
+        int column_count() const {
+            return sqlite3_data_count(this->stmt);
+        }
+
+        bool is_null(int columnIndex) const {
+            return sqlite3_column_type(this->stmt, columnIndex) == SQLITE_NULL;
+        }
+
+        /**
+         *  Size of the text or blob value in bytes, after converting the value to text or blob if needed.
+         */
+        size_t size(int columnIndex) const {
+            return size_t(sqlite3_column_bytes(this->stmt, columnIndex));
+        }
+
+        /**
+         *  Extracts a copy of the value like `select()` does, e.g. for numeric columns.
+         */
+        template<class T>
+        T get(int columnIndex) const {
+            return row_extractor<T>{}.extract(this->stmt, columnIndex);
+        }
+
+#ifdef SQLITE_ORM_STRING_VIEW_SUPPORTED
+        /**
+         *  The value as UTF-8 text, empty for NULL.
+         */
+        std::string_view text(int columnIndex) const {
+            // note: the text has to be requested before its size, see https://sqlite.org/c3ref/column_blob.html
+            auto text = reinterpret_cast<const char*>(sqlite3_column_text(this->stmt, columnIndex));
+            return {text, this->size(columnIndex)};
+        }
+#endif
+
+#ifdef SQLITE_ORM_SPAN_SUPPORTED
+        /**
+         *  The value as bytes, empty for NULL and zero-length blobs.
+         */
+        std::span<const std::byte> blob(int columnIndex) const {
+            auto bytes = static_cast<const std::byte*>(sqlite3_column_blob(this->stmt, columnIndex));
+            return {bytes, this->size(columnIndex)};
+        }
+#endif
+
+      private:
+        sqlite3_stmt* stmt;
+    };
+
+    /**
+     *  Specialization for the current row of a result set, used by cursors.
+     */
+    template<>
+    struct row_extractor<row_view, void> {
+        row_view extract(sqlite3_stmt* stmt, int /*columnIndex*/) const {
+            return row_view{stmt};
+        }
+    };
+}
@@ -24,6 +24,7 @@
 #include "arithmetic_tag.h"
 #include "xdestroy_handling.h"
 #include "pointer_value.h"
+#include "array_values.h"
 
 namespace sqlite_orm {
 
@@ -267,6 +268,21 @@ namespace sqlite_orm {
         }
     };
 
+#if !defined(SQLITE_ORM_CARRAY_IN_SUPPORTED) && defined(SQLITE_ENABLE_JSON1)
+    /**
+     *  Specialization for the values of an IN list bound as one array (`as_array()`),
+     *  bound as a JSON array text.
+     *  With the carray extension they are bound as a C array instead, see carray.h.
+     */
+    template<class E>
+    struct statement_binder<internal::array_values_t<E>, void> {
+        int bind(sqlite3_stmt* stmt, int index, const internal::array_values_t<E>& value) const {
+            std::string json = internal::serialize_json_array(value.values);
+            return sqlite3_bind_text(stmt, index, json.c_str(), int(json.size()), SQLITE_TRANSIENT);
+        }
+    };
+#endif
+
 #ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
     template<class V>
     struct statement_binder<V,
@@ -286,6 +302,12 @@ namespace sqlite_orm {
 
     namespace internal {
 
+        /**
+         *  The number of statement parameters a bindable value occupies.
+         */
+        template<class T>
+        SQLITE_ORM_INLINE_VAR constexpr int bound_parameters_count_v = 1;
+
         struct conditional_binder {
             sqlite3_stmt* stmt = nullptr;
             int index = 1;
@@ -294,10 +316,11 @@ namespace sqlite_orm {
 
             template<class T, satisfies<is_bindable, T> = true>
             void operator()(const T& t) {
-                int rc = statement_binder<T>{}.bind(this->stmt, this->index++, t);
+                int rc = statement_binder<T>{}.bind(this->stmt, this->index, t);
                 if (SQLITE_OK != rc) {
                     throw_translated_sqlite_error(this->stmt);
                 }
+                this->index += bound_parameters_count_v<T>;
             }
 
             template<class T, satisfies_not<is_bindable, T> = true>
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <cstddef>  //  size_t
+#include <string>  //  std::string
+#include <list>  //  std::list
+#include <unordered_map>  //  std::unordered_map
+#include <functional>  //  std::hash
+#include <mutex>  //  std::mutex, std::lock_guard
+#include <utility>  //  std::move, std::exchange
+
+#include "prepared_statement.h"
+
+namespace sqlite_orm {
+
+    /**
+     *  Snapshot of the counters of a storage's statement cache.
+     */
+    struct statement_cache_stats {
+        size_t capacity = 0;
+        size_t size = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+    };
+
+    namespace internal {
+
+        SQLITE_ORM_INLINE_VAR constexpr size_t default_statement_cache_capacity = 64;
+
+        /**
+         *  Provides a unique address for every expression type,
+         *  used to discriminate cached statements by the type of the expression they were prepared for.
+         */
+        template<class T>
+        struct expression_type_tag {
+            static const char id;
+        };
+
+        template<class T>
+        const char expression_type_tag<T>::id = 0;
+
+        /**
+         *  LRU cache of idle prepared statements, keyed on the database connection,
+         *  the expression type and the serialized SQL.
+         *
+         *  A statement is taken out of the cache while it is in use and given back afterwards,
+         *  hence the same statement is never used by two callers at the same time.
+         *  Statements are reset and their bindings cleared when they are given back.
+         */
+        struct statement_cache {
+            struct key_type {
+                sqlite3* db;
+                const void* expressionType;
+                std::string sql;
+
+                friend bool operator==(const key_type& lhs, const key_type& rhs) {
+                    return lhs.db == rhs.db && lhs.expressionType == rhs.expressionType && lhs.sql == rhs.sql;
+                }
+            };
+
+            struct key_hash {
+                size_t operator()(const key_type& key) const {
+                    size_t seed = std::hash<std::string>{}(key.sql);
+                    seed ^= std::hash<const void*>{}(key.db) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                    seed ^= std::hash<const void*>{}(key.expressionType) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                    return seed;
+                }
+            };
+
+            statement_cache(size_t capacity) : capacity{capacity} {}
+
+            statement_cache(const statement_cache&) = delete;
+            statement_cache& operator=(const statement_cache&) = delete;
+
+            ~statement_cache() {
+                this->clear();
+            }
+
+            /**
+             *  Takes an idle statement out of the cache.
+             *  @return The cached statement or nullptr on a cache miss.
+             */
+            sqlite3_stmt* take(const key_type& key) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                auto it = this->entries.find(key);
+                if (it == this->entries.end()) {
+                    ++this->misses;
+                    return nullptr;
+                }
+                ++this->hits;
+                sqlite3_stmt* stmt = it->second.stmt;
+                this->lru.erase(it->second.lruPosition);
+                this->entries.erase(it);
+                return stmt;
+            }
+
+            /**
+             *  Puts a statement taken by `take()` or freshly prepared back into the cache,
+             *  evicting the least recently used statement if the capacity is exceeded.
+             */
+            void give_back(key_type key, sqlite3_stmt* stmt) {
+                sqlite3_reset(stmt);
+                sqlite3_clear_bindings(stmt);
+
+                std::lock_guard<std::mutex> lock{this->mutex};
+                if (this->capacity == 0 || this->entries.count(key)) {
+                    sqlite3_finalize(stmt);
+                    return;
+                }
+                auto inserted = this->entries.emplace(std::move(key), entry{stmt, {}}).first;
+                this->lru.push_front(&inserted->first);
+                inserted->second.lruPosition = this->lru.begin();
+                this->shrink_to_capacity();
+            }
+
+            /**
+             *  Finalizes all cached statements.
+             */
+            void clear() {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                for (auto& p: this->entries) {
+                    sqlite3_finalize(p.second.stmt);
+                }
+                this->entries.clear();
+                this->lru.clear();
+            }
+
+            /**
+             *  Finalizes all cached statements prepared on the given connection.
+             */
+            void clear(sqlite3* db) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                for (auto it = this->entries.begin(); it != this->entries.end();) {
+                    if (it->first.db == db) {
+                        sqlite3_finalize(it->second.stmt);
+                        this->lru.erase(it->second.lruPosition);
+                        it = this->entries.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+
+            void set_capacity(size_t newCapacity) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                this->capacity = newCapacity;
+                this->shrink_to_capacity();
+            }
+
+            size_t get_capacity() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->capacity;
+            }
+
+            statement_cache_stats stats() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                statement_cache_stats res;
+                res.capacity = this->capacity;
+                res.size = this->entries.size();
+                res.hits = this->hits;
+                res.misses = this->misses;
+                res.evictions = this->evictions;
+                return res;
+            }
+
+          private:
+            struct entry {
+                sqlite3_stmt* stmt;
+                std::list<const key_type*>::iterator lruPosition;
+            };
+
+            //  expects the mutex to be locked
+            void shrink_to_capacity() {
+                while (this->entries.size() > this->capacity) {
+                    auto it = this->entries.find(*this->lru.back());
+                    sqlite3_finalize(it->second.stmt);
+                    this->lru.pop_back();
+                    this->entries.erase(it);
+                    ++this->evictions;
+                }
+            }
+
+            mutable std::mutex mutex;
+            size_t capacity;
+            std::unordered_map<key_type, entry, key_hash> entries;
+            //  most recently used at the front
+            std::list<const key_type*> lru;
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t evictions = 0;
+        };
+
+        /**
+         *  A prepared statement whose `sqlite3_stmt` is given back to a statement cache
+         *  instead of being finalized when it goes out of scope.
+         */
+        template<class T>
+        struct cached_prepared_statement_t : prepared_statement_t<T> {
+            cached_prepared_statement_t(prepared_statement_t<T> statement,
+                                        statement_cache& cache,
+                                        statement_cache::key_type key) :
+                prepared_statement_t<T>{std::move(statement)}, cache{cache}, key{std::move(key)} {}
+
+            cached_prepared_statement_t(cached_prepared_statement_t&& other) :
+                prepared_statement_t<T>{std::move(other)}, cache{other.cache}, key{std::move(other.key)} {}
+
+            ~cached_prepared_statement_t() {
+                if (this->stmt) {
+                    this->cache.give_back(std::move(this->key), std::exchange(this->stmt, nullptr));
+                }
+            }
+
+          private:
+            statement_cache& cache;
+            statement_cache::key_type key;
+        };
+    }
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <cstddef>  //  size_t
+#include <cstdint>  //  uint64_t, int64_t
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <array>  //  std::array
+#include <map>  //  std::map
+#include <unordered_map>  //  std::unordered_map
+#include <chrono>  //  std::chrono::nanoseconds
+#include <mutex>  //  std::mutex, std::lock_guard
+#include <algorithm>  //  std::sort, std::min
+
+namespace sqlite_orm {
+
+    /**
+     *  Snapshot of the measurements of one SQL statement text collected by a storage's statement profiler.
+     *  Latencies are bucketed in powers of two nanoseconds, hence percentiles are upper bounds
+     *  of the bucket they fall in, i.e. they are accurate within a factor of two.
+     */
+    struct statement_profile {
+        std::string sql;
+        size_t count = 0;
+        size_t rows = 0;
+        std::chrono::nanoseconds total_time{0};
+        std::chrono::nanoseconds max_time{0};
+        std::chrono::nanoseconds p50{0};
+        std::chrono::nanoseconds p99{0};
+        /**
+         *  Number of runs per latency bucket, where bucket `i` counts the runs taking less than `2^i` ns
+         *  (and at least `2^(i - 1)` ns). Trailing empty buckets are trimmed.
+         */
+        std::vector<size_t> histogram;
+
+        std::chrono::nanoseconds mean_time() const {
+            return this->count ? this->total_time / int64_t(this->count) : std::chrono::nanoseconds{0};
+        }
+    };
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+    namespace internal {
+
+        /**
+         *  Collects count, rows stepped and a latency histogram per SQL text,
+         *  fed by `sqlite3_trace_v2()` with `SQLITE_TRACE_PROFILE` and `SQLITE_TRACE_ROW` events.
+         *  The SQL text is the normalized one if SQLite was compiled with `SQLITE_ENABLE_NORMALIZE`,
+         *  otherwise the text the statement was prepared with. Statements generated by the storage
+         *  bind their values, hence they are grouped properly either way.
+         *
+         *  Events can come from several connections (writer and readers) at the same time,
+         *  therefore all state is guarded by a mutex.
+         */
+        struct statement_profiler {
+            static constexpr size_t buckets_count = 48;
+
+            void on_row(sqlite3_stmt* stmt) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                ++this->pendingRows[stmt];
+            }
+
+            void on_profile(sqlite3_stmt* stmt, uint64_t nanoseconds) {
+                std::string sql = statement_text(stmt);
+                std::lock_guard<std::mutex> lock{this->mutex};
+                auto& entry = this->entries[std::move(sql)];
+                ++entry.count;
+                entry.totalNanoseconds += nanoseconds;
+                if (nanoseconds > entry.maxNanoseconds) {
+                    entry.maxNanoseconds = nanoseconds;
+                }
+                ++entry.histogram[bucket_of(nanoseconds)];
+                auto rowsIt = this->pendingRows.find(stmt);
+                if (rowsIt != this->pendingRows.end()) {
+                    entry.rows += rowsIt->second;
+                    this->pendingRows.erase(rowsIt);
+                }
+            }
+
+            /**
+             *  Returns the profiles ordered by descending total time.
+             */
+            std::vector<statement_profile> snapshot() const {
+                std::vector<statement_profile> result;
+                {
+                    std::lock_guard<std::mutex> lock{this->mutex};
+                    result.reserve(this->entries.size());
+                    for (auto& p: this->entries) {
+                        result.push_back(make_profile(p.first, p.second));
+                    }
+                }
+                std::sort(result.begin(), result.end(), [](const statement_profile& lhs, const statement_profile& rhs) {
+                    return lhs.total_time > rhs.total_time;
+                });
+                return result;
+            }
+
+            void clear() {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                this->entries.clear();
+                this->pendingRows.clear();
+            }
+
+            static int trace_callback(unsigned event, void* context, void* p, void* x) {
+                auto& profiler = *static_cast<statement_profiler*>(context);
+                switch (event) {
+                    case SQLITE_TRACE_ROW:
+                        profiler.on_row(static_cast<sqlite3_stmt*>(p));
+                        break;
+                    case SQLITE_TRACE_PROFILE:
+                        profiler.on_profile(static_cast<sqlite3_stmt*>(p),
+                                            uint64_t(*static_cast<sqlite3_int64*>(x)));
+                        break;
+                }
+                return 0;
+            }
+
+          private:
+            struct entry {
+                size_t count = 0;
+                size_t rows = 0;
+                uint64_t totalNanoseconds = 0;
+                uint64_t maxNanoseconds = 0;
+                std::array<size_t, buckets_count> histogram{};
+            };
+
+            static std::string statement_text(sqlite3_stmt* stmt) {
+#if SQLITE_VERSION_NUMBER >= 3026000 and defined(SQLITE_ENABLE_NORMALIZE)
+                if (const char* sql = sqlite3_normalized_sql(stmt)) {
+                    return sql;
+                }
+#endif
+                if (const char* sql = sqlite3_sql(stmt)) {
+                    return sql;
+                }
+                return {};
+            }
+
+            static size_t bucket_of(uint64_t nanoseconds) {
+                size_t bucket = 0;
+                while (nanoseconds && bucket < buckets_count - 1) {
+                    nanoseconds >>= 1;
+                    ++bucket;
+                }
+                return bucket;
+            }
+
+            static std::chrono::nanoseconds bucket_upper_bound(size_t bucket) {
+                return std::chrono::nanoseconds{int64_t(1) << bucket};
+            }
+
+            static std::chrono::nanoseconds percentile(const entry& entry, double fraction) {
+                const auto rank = size_t(fraction * double(entry.count - 1)) + 1;
+                size_t cumulated = 0;
+                for (size_t i = 0; i < buckets_count; ++i) {
+                    cumulated += entry.histogram[i];
+                    if (cumulated >= rank) {
+                        //  the maximum is exact and tighter than the last bucket's bound
+                        return std::min(bucket_upper_bound(i), std::chrono::nanoseconds(entry.maxNanoseconds));
+                    }
+                }
+                return std::chrono::nanoseconds(entry.maxNanoseconds);
+            }
+
+            static statement_profile make_profile(const std::string& sql, const entry& entry) {
+                statement_profile profile;
+                profile.sql = sql;
+                profile.count = entry.count;
+                profile.rows = entry.rows;
+                profile.total_time = std::chrono::nanoseconds(entry.totalNanoseconds);
+                profile.max_time = std::chrono::nanoseconds(entry.maxNanoseconds);
+                profile.p50 = percentile(entry, 0.5);
+                profile.p99 = percentile(entry, 0.99);
+                size_t used = buckets_count;
+                while (used > 0 && entry.histogram[used - 1] == 0) {
+                    --used;
+                }
+                profile.histogram.assign(entry.histogram.begin(), entry.histogram.begin() + used);
+                return profile;
+            }
+
+            mutable std::mutex mutex;
+            std::map<std::string, entry> entries;
+            std::unordered_map<sqlite3_stmt*, size_t> pendingRows;
+        };
+    }
+#endif
+}
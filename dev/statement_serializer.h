@@ -25,6 +25,7 @@
 #include "ast/match.h"
 #include "ast/rank.h"
 #include "ast/special_keywords.h"
+#include "ast/returning.h"
 #include "core_functions.h"
 #include "constraints.h"
 #include "conditions.h"
@@ -134,6 +135,11 @@ namespace sqlite_orm {
                 return quote_blob_literal(field_printer<std::vector<char>>{}(t));
             }
 
+            template<class E>
+            std::string do_serialize(const array_values_t<E>& a) const {
+                return quote_string_literal(serialize_json_array(a.values));
+            }
+
 #if SQLITE_VERSION_NUMBER >= 3020000
             template<class P, class PT, class D>
             std::string do_serialize(const pointer_binding<P, PT, D>&) const {
@@ -833,7 +839,8 @@ namespace sqlite_orm {
         struct statement_serializer<
             dynamic_in_t<L, C>,
             std::enable_if_t<!polyfill::disjunction<polyfill::is_specialization_of<C, std::vector>,
-                                                    polyfill::is_specialization_of<C, std::list>>::value>> {
+                                                    polyfill::is_specialization_of<C, std::list>,
+                                                    polyfill::is_specialization_of<C, array_values_t>>::value>> {
             using statement_type = dynamic_in_t<L, C>;
 
             template<class Ctx>
@@ -882,6 +889,36 @@ namespace sqlite_orm {
             }
         };
 
+        template<class L, class E>
+        struct statement_serializer<dynamic_in_t<L, array_values_t<E>>, void> {
+            using statement_type = dynamic_in_t<L, array_values_t<E>>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                std::stringstream ss;
+                ss << serialize(statement.left, context) << " ";
+                if (!statement.negative) {
+                    ss << "IN";
+                } else {
+                    ss << "NOT IN";
+                }
+#ifdef SQLITE_ORM_CARRAY_IN_SUPPORTED
+                //  bound are the pointer to the C array and its length
+                if (context.replace_bindable_with_question) {
+                    ss << " carray(?, ?, '" << carray_element<E>::name() << "')";
+                    return ss.str();
+                }
+#endif
+#ifdef SQLITE_ENABLE_JSON1
+                ss << " (SELECT value FROM json_each(" << serialize(statement.argument, context) << "))";
+#else
+                //  a literal array without JSON is a list of values
+                ss << " (" << streaming_dynamic_expressions(statement.argument.values, context) << ")";
+#endif
+                return ss.str();
+            }
+        };
+
         template<class L, class... Args>
         struct statement_serializer<in_t<L, Args...>, void> {
             using statement_type = in_t<L, Args...>;
@@ -1342,6 +1379,48 @@ namespace sqlite_orm {
             }
         };
 
+        template<class T>
+        struct statement_serializer<update_columns_t<T>, void> {
+            using statement_type = update_columns_t<T>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                using object_type = expression_object_type_t<statement_type>;
+                auto& table = pick_table<object_type>(context.db_objects);
+
+                std::stringstream ss;
+                ss << "UPDATE " << streaming_identifier(table.name) << " SET ";
+                table.for_each_column([&table,
+                                       &ss,
+                                       &context,
+                                       &object = get_ref(statement.object),
+                                       &columnsMask = statement.columnsMask,
+                                       index = size_t(0),
+                                       first = true](auto& column) mutable {
+                    if (!columnsMask.at(index++) || column.template is<is_primary_key>() ||
+                        column.template is<is_generated_always>() || exists_in_composite_primary_key(table, column)) {
+                        return;
+                    }
+
+                    static constexpr std::array<const char*, 2> sep = {", ", ""};
+                    ss << sep[std::exchange(first, false)] << streaming_identifier(column.name) << " = "
+                       << serialize(polyfill::invoke(column.member_pointer, object), context);
+                });
+                ss << " WHERE ";
+                table.for_each_column(
+                    [&table, &context, &ss, &object = get_ref(statement.object), first = true](auto& column) mutable {
+                        if (!column.template is<is_primary_key>() && !exists_in_composite_primary_key(table, column)) {
+                            return;
+                        }
+
+                        static constexpr std::array<const char*, 2> sep = {" AND ", ""};
+                        ss << sep[std::exchange(first, false)] << streaming_identifier(column.name) << " = "
+                           << serialize(polyfill::invoke(column.member_pointer, object), context);
+                    });
+                return ss.str();
+            }
+        };
+
         template<class C>
         struct statement_serializer<dynamic_set_t<C>, void> {
             using statement_type = dynamic_set_t<C>;
@@ -1423,6 +1502,24 @@ namespace sqlite_orm {
             }
         };
 
+        template<class S, class T>
+        struct statement_serializer<returning_t<S, T>, void> {
+            using statement_type = returning_t<S, T>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                //  only columns of the modified table can be returned
+                auto subCtx = context;
+                subCtx.skip_table_name = true;
+                subCtx.use_parentheses = true;
+
+                std::stringstream ss;
+                ss << serialize(statement.statement, context) << " RETURNING "
+                   << streaming_serialized(get_column_names(statement.columns, subCtx));
+                return ss.str();
+            }
+        };
+
         template<class T>
         struct statement_serializer<insert_t<T>, void> {
             using statement_type = insert_t<T>;
@@ -1718,6 +1815,55 @@ namespace sqlite_orm {
             }
         };
 
+#ifdef SQLITE_ENABLE_JSON1
+        template<class T, class Id>
+        struct statement_serializer<get_many_t<T, Id>, void> {
+            using statement_type = get_many_t<T, Id>;
+
+            /**
+             *  Ids are bound as one JSON array, which is joined with the table such that
+             *  the statement's text doesn't depend on the number of ids.
+             *  The last result column is the position of the id in the array.
+             */
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                auto& table = pick_table<T>(context.db_objects);
+                auto primaryKeyColumnNames = table.primary_key_column_names();
+                if (primaryKeyColumnNames.empty()) {
+                    throw std::system_error{orm_error_code::table_has_no_primary_key_column};
+                }
+                if (primaryKeyColumnNames.size() != id_columns_count<Id>::value) {
+                    throw std::system_error{orm_error_code::arguments_count_does_not_match};
+                }
+
+                const std::string idsAlias = "ids";
+                std::stringstream ss;
+                ss << "SELECT " << streaming_table_column_names(table, table.name) << ", "
+                   << streaming_identifier(idsAlias, "key", std::string{}) << " FROM json_each(";
+                if (context.replace_bindable_with_question) {
+                    ss << "?";
+                } else {
+                    ss << quote_string_literal(serialize_json_array(statement.ids));
+                }
+                ss << ") AS " << streaming_identifier(idsAlias) << " CROSS JOIN " << streaming_identifier(table.name)
+                   << " ON ";
+                for (size_t i = 0; i < primaryKeyColumnNames.size(); ++i) {
+                    if (i > 0) {
+                        ss << " AND ";
+                    }
+                    ss << streaming_identifier(table.name, primaryKeyColumnNames[i], std::string{}) << " = ";
+                    if (id_columns_count<Id>::value == 1 && !polyfill::is_specialization_of<Id, std::tuple>::value) {
+                        ss << streaming_identifier(idsAlias, "value", std::string{});
+                    } else {
+                        ss << "json_extract(" << streaming_identifier(idsAlias, "value", std::string{}) << ", '$["
+                           << i << "]')";
+                    }
+                }
+                return ss.str();
+            }
+        };
+#endif  //  SQLITE_ENABLE_JSON1
+
         template<>
         struct statement_serializer<conflict_action, void> {
             using statement_type = conflict_action;
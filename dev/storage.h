@@ -9,10 +9,13 @@
 #include <sstream>  //  std::stringstream
 #include <iomanip>  //  std::flush
 #include <map>  //  std::map
+#include <set>  //  std::set
 #include <vector>  //  std::vector
 #include <tuple>  //  std::tuple_size, std::tuple, std::make_tuple, std::tie
 #include <utility>  //  std::forward, std::pair
-#include <algorithm>  //  std::for_each, std::ranges::for_each
+#include <algorithm>  //  std::for_each, std::ranges::for_each, std::max, std::stable_sort, std::any_of
+#include <iterator>  //  std::distance, std::next, std::begin, std::end
+#include <chrono>  //  std::chrono::steady_clock
 #include "functional/cxx_optional.h"
 
 #include "functional/cxx_type_traits_polyfill.h"
@@ -43,9 +46,13 @@
 #include "journal_mode.h"
 #include "mapped_view.h"
 #include "result_set_view.h"
+#include "cursor_view.h"
+#include "blob_handle.h"
 #include "ast_iterator.h"
 #include "storage_base.h"
 #include "prepared_statement.h"
+#include "statement_cache.h"
+#include "bulk_load.h"
 #include "expression_object_type.h"
 #include "statement_serializer.h"
 #include "serializer_context.h"
@@ -58,6 +65,8 @@
 #include "cte_storage.h"
 #include "util.h"
 #include "serializing_util.h"
+#include "is_std_ptr.h"
+#include "interrupt.h"
 
 namespace sqlite_orm {
 
@@ -79,6 +88,19 @@ namespace sqlite_orm {
             polyfill::void_t<indirectly_test_preparable<decltype(std::declval<S>().prepare(std::declval<E>()))>>> =
             true;
 
+        /**
+         *  Compares field values of two objects, smart pointers by the values they point to.
+         */
+        template<class T, std::enable_if_t<!is_std_ptr<T>::value, bool> = true>
+        bool field_values_equal(const T& lhs, const T& rhs) {
+            return lhs == rhs;
+        }
+
+        template<class P, std::enable_if_t<is_std_ptr<P>::value, bool> = true>
+        bool field_values_equal(const P& lhs, const P& rhs) {
+            return lhs == rhs || (lhs && rhs && *lhs == *rhs);
+        }
+
         /**
          *  Storage class itself. Create an instanse to use it as an interfacto to sqlite db by calling `make_storage`
          *  function.
@@ -95,6 +117,13 @@ namespace sqlite_orm {
             storage_t(std::string filename, db_objects_type dbObjects) :
                 storage_base{std::move(filename), foreign_keys_count(dbObjects)}, db_objects{std::move(dbObjects)} {}
 
+            /**
+             *  @param options how database connections are opened.
+             */
+            storage_t(std::string filename, open_options options, db_objects_type dbObjects) :
+                storage_base{std::move(filename), foreign_keys_count(dbObjects), std::move(options)},
+                db_objects{std::move(dbObjects)} {}
+
             storage_t(const storage_t&) = default;
 
           private:
@@ -251,6 +280,37 @@ namespace sqlite_orm {
                 return {*this, std::move(con), std::forward<Args>(args)...};
             }
 
+            /**
+             *  Like `iterate<T>(args...)`, but interrupted once `limits` is exceeded, see `query_deadline`.
+             *  The deadline applies while the returned view or one of its iterators is alive.
+             */
+            template<class T, class O = mapped_type_proxy_t<T>, class... Args>
+            interruptible_view<mapped_view<O, self, Args...>> iterate(query_deadline limits, Args&&... args) {
+                this->assert_mapped_type<O>();
+
+                auto con = this->get_connection();
+                auto guard = std::make_shared<interrupt_guard>(con, std::move(limits));
+                return {{*this, std::move(con), std::forward<Args>(args)...}, std::move(guard)};
+            }
+
+            /**
+             *  Like `iterate<T>(args...)`, but every row is read into the same object, such that scanning
+             *  a large table doesn't allocate per row. The object is overwritten when the iterator is incremented.
+             *  @example
+             *  ```c++
+             *  for (User& user: storage.iterate_in_place<User>(order_by(&User::id))) {
+             *      //  `user` refers to the same object for every row
+             *  }
+             *  ```
+             */
+            template<class T, class O = mapped_type_proxy_t<T>, class... Args>
+            in_place_mapped_view<O, self, Args...> iterate_in_place(Args&&... args) {
+                this->assert_mapped_type<O>();
+
+                auto con = this->get_connection();
+                return {*this, std::move(con), std::forward<Args>(args)...};
+            }
+
 #ifdef SQLITE_ORM_WITH_CPP20_ALIASES
             template<orm_refers_to_table auto mapped, class... Args>
             auto iterate(Args&&... args) {
@@ -279,6 +339,37 @@ namespace sqlite_orm {
                 return {this->db_objects, std::move(con), std::move(expression)};
             }
 #endif
+
+            /**
+             *  Like `iterate(select(...))`, but yields a `row_view` of every row instead of extracting its columns.
+             *  Text and blobs are accessed in place without copying, valid until the next row is stepped to:
+             *  @example
+             *  for (const row_view& row: storage.cursor(select(columns(&Log::id, &Log::message)))) {
+             *      if (row.text(1).find("error") != std::string_view::npos) {
+             *          ids.push_back(row.get<int>(0));
+             *      }
+             *  }
+             */
+            template<class Select>
+#ifdef SQLITE_ORM_CONCEPTS_SUPPORTED
+                requires (is_select_v<Select>)
+#endif
+            cursor_view<Select, db_objects_type> cursor(Select expression) {
+                expression.highest_level = true;
+                auto con = this->get_connection();
+                return {this->db_objects, std::move(con), std::move(expression)};
+            }
+
+#if (SQLITE_VERSION_NUMBER >= 3008003) && defined(SQLITE_ORM_WITH_CTE)
+            template<class... CTEs, class E>
+#ifdef SQLITE_ORM_CONCEPTS_SUPPORTED
+                requires (is_select_v<E>)
+#endif
+            cursor_view<with_t<E, CTEs...>, db_objects_type> cursor(with_t<E, CTEs...> expression) {
+                auto con = this->get_connection();
+                return {this->db_objects, std::move(con), std::move(expression)};
+            }
+#endif
 #endif
 
             /**
@@ -291,7 +382,7 @@ namespace sqlite_orm {
             template<class O, class... Args>
             void remove_all(Args&&... args) {
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::remove_all<O>(std::forward<Args>(args)...));
+                auto statement = this->prepare_cached(sqlite_orm::remove_all<O>(std::forward<Args>(args)...));
                 this->execute(statement);
             }
 
@@ -310,7 +401,7 @@ namespace sqlite_orm {
             template<class O, class... Ids>
             void remove(Ids... ids) {
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::remove<O>(std::forward<Ids>(ids)...));
+                auto statement = this->prepare_cached(sqlite_orm::remove<O>(std::forward<Ids>(ids)...));
                 this->execute(statement);
             }
 
@@ -330,10 +421,81 @@ namespace sqlite_orm {
             template<class O>
             void update(const O& o) {
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::update(std::ref(o)));
+                auto statement = this->prepare_cached(sqlite_orm::update(std::ref(o)));
                 this->execute(statement);
             }
 
+            /**
+             *  Update routine that sets only the given fields where primary key is equal.
+             *  Statements are cached per distinct set of fields.
+             *  Throws std::system_error{orm_error_code::incorrect_set_fields_specified} if none of the fields
+             *  can be set, i.e. all are primary key or generated columns.
+             *  @param o object to be updated.
+             *  @param members member pointers or getters/setters of the fields to be updated.
+             *  @example
+             *  ```c++
+             *  user.email = "new@example.com";
+             *  storage.update(user, &User::email);
+             *  ```
+             */
+            template<class O, class M, class... Ms>
+            void update(const O& o, M member, Ms... members) {
+                this->assert_mapped_type<O>();
+                this->assert_updatable_type<O>();
+                auto& table = this->get_table<O>();
+                const std::string* names[] = {table.find_column_name(member), table.find_column_name(members)...};
+                for (const std::string* name: names) {
+                    if (!name) {
+                        throw std::system_error{orm_error_code::column_not_found};
+                    }
+                }
+                std::vector<bool> columnsMask;
+                bool settable = false;
+                table.for_each_column([&table, &names, &columnsMask, &settable](auto& column) {
+                    const bool set =
+                        is_settable_column(table, column) &&
+                        std::any_of(std::begin(names), std::end(names), [&column](const std::string* name) {
+                            return *name == column.name;
+                        });
+                    columnsMask.push_back(set);
+                    settable = settable || set;
+                });
+                //  key columns identify the row and can't be set
+                if (!settable) {
+                    throw std::system_error{orm_error_code::incorrect_set_fields_specified};
+                }
+                this->update_columns(o, std::move(columnsMask));
+            }
+
+            /**
+             *  Update routine that sets only the fields of `updated` that differ from `original`,
+             *  where primary key of `updated` is equal. Nothing is executed if no field differs;
+             *  primary key and generated columns are never set.
+             *  Statements are cached per distinct set of fields.
+             *  @param original snapshot of the object, e.g. as it was fetched.
+             *  @param updated object to be updated.
+             *  @return Whether any field differed.
+             */
+            template<class O>
+            bool update_changed(const O& original, const O& updated) {
+                this->assert_mapped_type<O>();
+                this->assert_updatable_type<O>();
+                auto& table = this->get_table<O>();
+                std::vector<bool> columnsMask;
+                bool changed = false;
+                table.for_each_column([&table, &original, &updated, &columnsMask, &changed](auto& column) {
+                    const bool differs = is_settable_column(table, column) &&
+                                         !field_values_equal(polyfill::invoke(column.member_pointer, original),
+                                                             polyfill::invoke(column.member_pointer, updated));
+                    columnsMask.push_back(differs);
+                    changed = changed || differs;
+                });
+                if (changed) {
+                    this->update_columns(updated, std::move(columnsMask));
+                }
+                return changed;
+            }
+
             template<class S, class... Wargs>
             void update_all(S set, Wargs... wh) {
                 static_assert(internal::is_set<S>::value,
@@ -343,6 +505,239 @@ namespace sqlite_orm {
             }
 
           protected:
+            /**
+             *  Looks up the object with the given primary key in the object cache of `O`,
+             *  loading and caching it on a miss.
+             *  @return Whether the object cache could be used, in which case `object` is a copy of the result.
+             */
+            template<class O, class... Ids>
+            bool get_through_object_cache(std::unique_ptr<O>& object, const Ids&... ids) {
+                return this->get_through_object_cache(std::is_copy_constructible<O>{}, object, ids...);
+            }
+
+            template<class O, class... Ids>
+            bool get_through_object_cache(std::false_type, std::unique_ptr<O>&, const Ids&...) {
+                return false;
+            }
+
+            template<class O, class... Ids>
+            bool get_through_object_cache(std::true_type, std::unique_ptr<O>& object, const Ids&... ids) {
+                //  objects aren't cached during own transactions, which may still roll back
+                object_cache* cache =
+                    this->in_own_transaction() ? nullptr : this->find_object_cache(this->tablename<O>());
+                std::string key;
+                if (!cache || !append_cache_keys(key, ids...)) {
+                    return false;
+                }
+                if (std::shared_ptr<const void> cached = cache->find(key)) {
+                    object = std::make_unique<O>(*static_cast<const O*>(cached.get()));
+                    return true;
+                }
+                const uint64_t generation = cache->generation();
+                auto statement = this->prepare_cached(sqlite_orm::get_pointer<O>(ids...));
+                object = this->execute(statement);
+                //  only cached by the key its primary key yields, which invalidation uses,
+                //  i.e. not if the ids were of other kinds than the primary key, e.g. `get<T>(1.0)` for an integer key
+                std::string objectKey;
+                if (object && this->append_object_cache_key(objectKey, *object) && objectKey == key) {
+                    cache->insert(std::move(key), std::make_shared<const O>(*object), generation);
+                }
+                return true;
+            }
+
+            /**
+             *  Executes a query through the result cache if it's enabled, see `enable_result_cache()`.
+             *  Results of move-only types aren't cached.
+             */
+            template<class S>
+            auto execute_through_result_cache(const S& statement) {
+                using R = decltype(this->execute(statement));
+                using is_cacheable = polyfill::bool_constant<std::is_copy_constructible<R>::value &&
+                                                             std::is_copy_constructible<typename R::value_type>::value>;
+                return this->execute_through_result_cache<R>(is_cacheable{}, statement);
+            }
+
+            template<class R, class S>
+            R execute_through_result_cache(std::false_type, const S& statement) {
+                return this->execute(statement);
+            }
+
+            template<class R, class S>
+            R execute_through_result_cache(std::true_type, const S& statement) {
+                result_cache* cache = this->find_result_cache();
+                if (!cache) {
+                    return this->execute(statement);
+                }
+                std::string key = make_result_cache_key<R>(statement.stmt, statement.expression);
+                if (key.empty()) {
+                    return this->execute(statement);
+                }
+                if (std::shared_ptr<const void> cached = cache->find(key)) {
+                    return *std::static_pointer_cast<const R>(std::move(cached));
+                }
+                const uint64_t generation = cache->generation();
+                R result = this->execute(statement);
+                std::set<std::string> tables = this->result_cache_tables(statement.expression);
+                if (!tables.empty()) {
+                    const size_t bytes = sizeof(R) + result.size() * sizeof(typename R::value_type);
+                    cache->insert(std::move(key), std::make_shared<const R>(result), bytes, std::move(tables), generation);
+                }
+                return result;
+            }
+
+            /**
+             *  Names of the tables a query reads, as far as its columns and conditions tell.
+             */
+            template<class E>
+            std::set<std::string> result_cache_tables(const E& expression) const {
+                auto collector = make_table_name_collector(this->db_objects);
+                iterate_ast(expression, collector);
+                std::set<std::string> tables;
+                for (auto& tableName: collector.table_names) {
+                    if (!tableName.first.empty()) {
+                        tables.insert(tableName.first);
+                    }
+                }
+                return tables;
+            }
+
+            template<class T, class R, class... Args>
+            std::set<std::string> result_cache_tables(const get_all_t<T, R, Args...>& expression) const {
+                std::set<std::string> tables = this->result_cache_tables(expression.conditions);
+                tables.insert(this->tablename<mapped_type_proxy_t<T>>());
+                return tables;
+            }
+
+            /**
+             *  Invalidates the cached object with the primary key of `object` after it was written.
+             */
+            template<class O>
+            void invalidate_cached_object(const O& object) {
+                object_cache* cache = this->find_object_cache(this->tablename<O>());
+                if (!cache) {
+                    return;
+                }
+                std::string key;
+                if (this->append_object_cache_key(key, object)) {
+                    cache->invalidate(std::move(key));
+                } else {
+                    cache->invalidate_all();
+                }
+            }
+
+            /**
+             *  Appends the values of the primary key of `object` to an object cache key.
+             *  @return false if a value can't be appended, in which case there is no key.
+             */
+            template<class O>
+            bool append_object_cache_key(std::string& key, const O& object) {
+                bool appended = true;
+                this->get_table<O>().for_each_primary_key_column([&key, &appended, &object](auto& memberPointer) {
+                    appended = append_cache_key(key, polyfill::invoke(memberPointer, object)) && appended;
+                });
+                return appended;
+            }
+
+            template<class O, class... Ids>
+            void invalidate_cached_object_by_id(const std::tuple<Ids...>& ids) {
+                object_cache* cache = this->find_object_cache(this->tablename<O>());
+                if (!cache) {
+                    return;
+                }
+                //  ids of other kinds than the primary key, e.g. `remove<T>(1.0)` for an integer key,
+                //  don't yield the key the object was cached by
+                std::string tags, idTags;
+                this->get_table<O>().for_each_primary_key_column([&tags](auto& memberPointer) {
+                    tags += cache_key_tag<member_field_type_t<std::decay_t<decltype(memberPointer)>>>::value;
+                });
+                std::string key;
+                bool appended = true;
+                iterate_tuple(ids, [&key, &appended, &idTags](auto& id) {
+                    idTags += cache_key_tag<std::decay_t<decltype(id)>>::value;
+                    appended = append_cache_key(key, id) && appended;
+                });
+                if (appended && idTags == tags) {
+                    cache->invalidate(std::move(key));
+                } else {
+                    cache->invalidate_all();
+                }
+            }
+
+            template<class T>
+            void invalidate_replaced_objects(const replace_t<T>& expression) {
+                this->invalidate_cached_object(get_object(expression));
+            }
+
+            template<class It, class Projection, class O>
+            void invalidate_replaced_objects(const replace_range_t<It, Projection, O>&) {
+                this->invalidate_object_caches(this->tablename<O>());
+            }
+
+            void invalidate_object_caches(const std::string& tableName) {
+                if (object_cache* cache = this->find_object_cache(tableName)) {
+                    cache->invalidate_all();
+                }
+            }
+
+            /**
+             *  Invalidates cached results of the table written by a completed statement, see `after_write()`.
+             */
+            void after_write(const std::string& tableName) {
+                this->invalidate_results(tableName);
+                this->after_write();
+            }
+
+            /**
+             *  Settles the caches after a completed statement wrote the database,
+             *  unless a transaction is running, which settles them when it ends.
+             */
+            void after_write() {
+                if (!this->inTransaction) {
+                    this->settle_caches();
+                }
+            }
+
+            /**
+             *  Calls `f` running a statement that writes the database through `db`.
+             *  If it fails, the row changes the statement already reported to change listeners are discarded,
+             *  because SQLite rolls back a failed statement without calling a hook.
+             *  The connection's mutex is held meanwhile, such that statements of other threads sharing
+             *  the connection don't report changes in between.
+             */
+            template<class F>
+            decltype(auto) run_write_statement(sqlite3* db, F&& f) {
+                connection_mutex_lock lock{db};
+                const size_t mark = this->changeNotifier.mark();
+                try {
+                    return f();
+                } catch (...) {
+                    this->changeNotifier.discard_since(mark);
+                    throw;
+                }
+            }
+
+            void perform_write_step(sqlite3_stmt* stmt) {
+                this->run_write_statement(sqlite3_db_handle(stmt), [stmt] {
+                    perform_step(stmt);
+                });
+            }
+
+            /**
+             *  Whether a column can be set by `update_columns()`, i.e. it is neither a key column nor generated.
+             */
+            template<class Table, class C>
+            static bool is_settable_column(const Table& table, const C& column) {
+                return !column.template is<is_primary_key>() && !column.template is<is_generated_always>() &&
+                       !exists_in_composite_primary_key(table, column);
+            }
+
+            template<class O>
+            void update_columns(const O& o, std::vector<bool> columnsMask) {
+                using statement_type = update_columns_t<std::reference_wrapper<const O>>;
+                auto statement = this->prepare_cached(statement_type{std::cref(o), std::move(columnsMask)});
+                this->execute(statement);
+            }
+
             template<class F, class O, class... Args>
             std::string group_concat_internal(F O::* m, std::unique_ptr<std::string> y, Args&&... args) {
                 this->assert_mapped_type<O>();
@@ -371,8 +766,22 @@ namespace sqlite_orm {
             template<class T, class R = std::vector<mapped_type_proxy_t<T>>, class... Args>
             R get_all(Args&&... args) {
                 this->assert_mapped_type<mapped_type_proxy_t<T>>();
-                auto statement = this->prepare(sqlite_orm::get_all<T, R>(std::forward<Args>(args)...));
-                return this->execute(statement);
+                auto statement = this->prepare_cached(sqlite_orm::get_all<T, R>(std::forward<Args>(args)...));
+                return this->execute_through_result_cache(statement);
+            }
+
+            /**
+             *  Like `get_all<T, R>(args...)`, but interrupted once `limits` is exceeded, see `query_deadline`.
+             *  @example: storage.get_all<User>(with_timeout(std::chrono::milliseconds{100}), where(...));
+             */
+            template<class T, class R = std::vector<mapped_type_proxy_t<T>>, class... Args>
+            R get_all(query_deadline limits, Args&&... args) {
+                this->assert_mapped_type<mapped_type_proxy_t<T>>();
+                auto statement = this->prepare_cached(sqlite_orm::get_all<T, R>(std::forward<Args>(args)...));
+                interrupt_guard guard{statement.con, std::move(limits)};
+                return guard.run([this, &statement] {
+                    return this->execute(statement);
+                });
             }
 
 #ifdef SQLITE_ORM_WITH_CPP20_ALIASES
@@ -404,7 +813,7 @@ namespace sqlite_orm {
             template<class O, class R = std::vector<std::unique_ptr<O>>, class... Args>
             auto get_all_pointer(Args&&... args) {
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::get_all_pointer<O, R>(std::forward<Args>(args)...));
+                auto statement = this->prepare_cached(sqlite_orm::get_all_pointer<O, R>(std::forward<Args>(args)...));
                 return this->execute(statement);
             }
 
@@ -429,7 +838,8 @@ namespace sqlite_orm {
             template<class O, class R = std::vector<std::optional<O>>, class... Args>
             auto get_all_optional(Args&&... conditions) {
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::get_all_optional<O, R>(std::forward<Args>(conditions)...));
+                auto statement =
+                    this->prepare_cached(sqlite_orm::get_all_optional<O, R>(std::forward<Args>(conditions)...));
                 return this->execute(statement);
             }
 #endif
@@ -454,7 +864,14 @@ namespace sqlite_orm {
             template<class O, class... Ids>
             O get(Ids... ids) {
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::get<O>(std::forward<Ids>(ids)...));
+                std::unique_ptr<O> cached;
+                if (this->get_through_object_cache(cached, ids...)) {
+                    if (!cached) {
+                        throw std::system_error{orm_error_code::not_found};
+                    }
+                    return std::move(*cached);
+                }
+                auto statement = this->prepare_cached(sqlite_orm::get<O>(std::forward<Ids>(ids)...));
                 return this->execute(statement);
             }
 
@@ -472,7 +889,11 @@ namespace sqlite_orm {
             template<class O, class... Ids>
             std::unique_ptr<O> get_pointer(Ids... ids) {
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::get_pointer<O>(std::forward<Ids>(ids)...));
+                std::unique_ptr<O> cached;
+                if (this->get_through_object_cache(cached, ids...)) {
+                    return cached;
+                }
+                auto statement = this->prepare_cached(sqlite_orm::get_pointer<O>(std::forward<Ids>(ids)...));
                 return this->execute(statement);
             }
 
@@ -483,6 +904,45 @@ namespace sqlite_orm {
             }
 #endif
 
+#ifdef SQLITE_ENABLE_JSON1
+            /**
+             *  Fetches the objects with the given primary keys in one statement.
+             *  The ids are bound as one JSON array, hence this needs the JSON1 extension.
+             *  @param ids Primary keys, or tuples of the values of a composite primary key.
+             *  @return Objects in the order of `ids`, with null pointers for ids that don't exist.
+             *  @example
+             *  ```c++
+             *  auto users = storage.get_many<User>(std::vector<int>{3, 1, 42});
+             *  //  users[2] == nullptr if there is no user with id 42
+             *  ```
+             */
+            template<class O, class Id>
+            std::vector<std::unique_ptr<O>> get_many(std::vector<Id> ids) {
+                this->assert_mapped_type<O>();
+                auto statement = this->prepare_cached(sqlite_orm::get_many<O>(std::move(ids)));
+                return this->execute(statement);
+            }
+
+            /**
+             *  The same as `get_many` but returns the found objects mapped by their id.
+             *  Ids that don't exist are absent from the map.
+             */
+            template<class O, class Id>
+            std::map<Id, O> get_many_map(std::vector<Id> ids) {
+                this->assert_mapped_type<O>();
+                auto statement = this->prepare_cached(sqlite_orm::get_many<O>(std::move(ids)));
+                auto objects = this->execute(statement);
+                auto& foundIds = statement.expression.ids;
+                std::map<Id, O> res;
+                for (size_t i = 0; i < objects.size(); ++i) {
+                    if (objects[i]) {
+                        res.emplace(std::move(foundIds[i]), std::move(*objects[i]));
+                    }
+                }
+                return res;
+            }
+#endif  //  SQLITE_ENABLE_JSON1
+
             /**
              * A previous version of get_pointer() that returns a shared_ptr
              * instead of a unique_ptr. New code should prefer get_pointer()
@@ -509,7 +969,11 @@ namespace sqlite_orm {
             template<class O, class... Ids>
             std::optional<O> get_optional(Ids... ids) {
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::get_optional<O>(std::forward<Ids>(ids)...));
+                std::unique_ptr<O> cached;
+                if (this->get_through_object_cache(cached, ids...)) {
+                    return cached ? std::optional<O>{std::move(*cached)} : std::nullopt;
+                }
+                auto statement = this->prepare_cached(sqlite_orm::get_optional<O>(std::forward<Ids>(ids)...));
                 return this->execute(statement);
             }
 #endif  // SQLITE_ORM_OPTIONAL_SUPPORTED
@@ -727,8 +1191,40 @@ namespace sqlite_orm {
             auto select(T m, Args... args) {
                 static_assert(!is_compound_operator_v<T> || sizeof...(Args) == 0,
                               "Cannot use args with a compound operator");
-                auto statement = this->prepare(sqlite_orm::select(std::move(m), std::forward<Args>(args)...));
-                return this->execute(statement);
+                auto statement = this->prepare_cached(sqlite_orm::select(std::move(m), std::forward<Args>(args)...));
+                return this->execute_through_result_cache(statement);
+            }
+
+            /**
+             *  Like `select(m, args...)`, but interrupted once `limits` is exceeded, see `query_deadline`.
+             */
+            template<class T, class... Args>
+            auto select(query_deadline limits, T m, Args... args) {
+                static_assert(!is_compound_operator_v<T> || sizeof...(Args) == 0,
+                              "Cannot use args with a compound operator");
+                auto statement = this->prepare_cached(sqlite_orm::select(std::move(m), std::forward<Args>(args)...));
+                interrupt_guard guard{statement.con, std::move(limits)};
+                return guard.run([this, &statement] {
+                    return this->execute(statement);
+                });
+            }
+
+            /**
+             *  Select multiple columns into one vector per column instead of one tuple per row,
+             *  such that the values of a column are contiguous in memory.
+             *  Arithmetic values are read by `sqlite3_column_int()`, `sqlite3_column_int64()`
+             *  or `sqlite3_column_double()` straight into their vector.
+             *  Example: `auto [ids, scores] = storage.get_columns(columns(&User::id, &User::score), where(...));`
+             *
+             *  @return `std::tuple` of `std::vector`s in the order of the columns.
+             */
+            template<class... Cols, class... Args>
+            auto get_columns(columns_t<Cols...> cols, Args... args) {
+                using ColResult = column_result_of_t<db_objects_type, columns_t<Cols...>>;
+                auto statement = this->prepare_cached(sqlite_orm::select(std::move(cols), std::forward<Args>(args)...));
+                sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+                iterate_ast(statement.expression, conditional_binder{stmt});
+                return this->extract_columns(stmt, polyfill::type_identity<ColResult>{});
             }
 
 #if (SQLITE_VERSION_NUMBER >= 3008003) && defined(SQLITE_ORM_WITH_CTE)
@@ -792,6 +1288,24 @@ namespace sqlite_orm {
                 return this->dump_highest_level(e2, parametrized);
             }
 
+            /**
+             *  Runs `EXPLAIN QUERY PLAN` for a high-level statement or a prepared statement,
+             *  serialized like by `prepare()`.
+             *  @return The nodes of the plan tree in the order SQLite reports them.
+             *
+             *  @example
+             *  ```c++
+             *  auto plan = storage.explain(get_all<User>(where(c(&User::email) == "")));
+             *  bool usesIndex = plan.at(0).is_search() && plan.at(0).index == "idx_users_email";
+             *  ```
+             */
+            template<class E>
+            std::vector<query_plan_node> explain(E&& expression) {
+                std::string sql = this->dump(std::forward<E>(expression), true);
+                auto con = this->get_connection();
+                return query_plan_of(con.get(), sql);
+            }
+
             /**
              *  Returns a string representation of object of a class mapped to the storage.
              *  Type of string has json-like style.
@@ -821,7 +1335,7 @@ namespace sqlite_orm {
             template<class O>
             void replace(const O& o) {
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::replace(std::ref(o)));
+                auto statement = this->prepare_cached(sqlite_orm::replace(std::ref(o)));
                 this->execute(statement);
             }
 
@@ -833,9 +1347,9 @@ namespace sqlite_orm {
                     return;
                 }
 
-                auto statement =
-                    this->prepare(sqlite_orm::replace_range(std::move(from), std::move(to), std::move(project)));
-                this->execute(statement);
+                this->execute_range_in_chunks(
+                    sqlite_orm::replace_range(std::move(from), std::move(to), std::move(project)),
+                    this->get_table<O>().template count_of_columns_excluding<is_generated_always>());
             }
 
             template<class O, class It, class Projection = polyfill::identity>
@@ -845,16 +1359,16 @@ namespace sqlite_orm {
                     return;
                 }
 
-                auto statement =
-                    this->prepare(sqlite_orm::replace_range<O>(std::move(from), std::move(to), std::move(project)));
-                this->execute(statement);
+                this->execute_range_in_chunks(
+                    sqlite_orm::replace_range<O>(std::move(from), std::move(to), std::move(project)),
+                    this->get_table<O>().template count_of_columns_excluding<is_generated_always>());
             }
 
             template<class O, class... Cols>
             int insert(const O& o, columns_t<Cols...> cols) {
                 static_assert(cols.count > 0, "Use insert or replace with 1 argument instead");
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::insert(std::ref(o), std::move(cols)));
+                auto statement = this->prepare_cached(sqlite_orm::insert(std::ref(o), std::move(cols)));
                 return int(this->execute(statement));
             }
 
@@ -867,7 +1381,7 @@ namespace sqlite_orm {
             int insert(const O& o) {
                 this->assert_mapped_type<O>();
                 this->assert_insertable_type<O>();
-                auto statement = this->prepare(sqlite_orm::insert(std::ref(o)));
+                auto statement = this->prepare_cached(sqlite_orm::insert(std::ref(o)));
                 return int(this->execute(statement));
             }
 
@@ -953,9 +1467,9 @@ namespace sqlite_orm {
                 if (from == to) {
                     return;
                 }
-                auto statement =
-                    this->prepare(sqlite_orm::insert_range(std::move(from), std::move(to), std::move(project)));
-                this->execute(statement);
+                this->execute_range_in_chunks(
+                    sqlite_orm::insert_range(std::move(from), std::move(to), std::move(project)),
+                    this->count_of_insertable_columns<O>());
             }
 
             template<class O, class It, class Projection = polyfill::identity>
@@ -965,9 +1479,87 @@ namespace sqlite_orm {
                 if (from == to) {
                     return;
                 }
-                auto statement =
-                    this->prepare(sqlite_orm::insert_range<O>(std::move(from), std::move(to), std::move(project)));
-                this->execute(statement);
+                this->execute_range_in_chunks(
+                    sqlite_orm::insert_range<O>(std::move(from), std::move(to), std::move(project)),
+                    this->count_of_insertable_columns<O>());
+            }
+
+            /**
+             *  Loads a large range of objects of type O into their table, following SQLite's bulk loading practices:
+             *  everything is written in one exclusive transaction, in chunks of reused statements,
+             *  optionally without the table's indexes (recreated at the end) and with relaxed durability.
+             *  If a transaction is already open the objects are written inside it, within a savepoint
+             *  that is rolled back on failure, and committing is left to the caller.
+             *  @param range Range of objects of type O, e.g. `std::vector<O>`.
+             *  @return Number of rows written and the time it took.
+             *  @example
+             *  ```c++
+             *  bulk_load_options options;
+             *  options.keep_primary_keys = true;
+             *  options.sort_by_primary_key = true;
+             *  auto result = storage.bulk_load<User>(users, options);
+             *  std::cout << result.rows_per_second() << " rows/s" << std::endl;
+             *  ```
+             */
+            template<class O, class R>
+            bulk_load_result bulk_load(const R& range, bulk_load_options options = {}) {
+                this->assert_mapped_type<O>();
+                const auto start = std::chrono::steady_clock::now();
+
+                //  pragmas are set per connection, hence the connection must stay opened during the load
+                auto con = this->get_connection();
+                sqlite3* db = con.get();
+
+                const bool inTransaction = !sqlite3_get_autocommit(db);
+                int synchronous = -1;
+                std::string journalMode;
+                //  neither pragma can be changed inside a transaction
+                if (options.relax_durability && !inTransaction) {
+                    perform_exec(db, "PRAGMA synchronous", extract_single_value<int>, &synchronous);
+                    perform_exec(db, "PRAGMA journal_mode", extract_single_value<std::string>, &journalMode);
+                    perform_void_exec(db, "PRAGMA synchronous = OFF");
+                    //  leaving WAL requires exclusive access to the database, so WAL is kept
+                    if (journalMode != "wal") {
+                        perform_void_exec(db, "PRAGMA journal_mode = MEMORY");
+                    }
+                }
+                auto restoreDurability = [db, synchronous, &journalMode] {
+                    if (synchronous != -1) {
+                        perform_void_exec(db, "PRAGMA synchronous = " + std::to_string(synchronous));
+                    }
+                    if (!journalMode.empty() && journalMode != "wal") {
+                        perform_void_exec(db, "PRAGMA journal_mode = " + journalMode);
+                    }
+                };
+
+                bulk_load_result result;
+                try {
+                    if (inTransaction) {
+                        connection_mutex_lock lock{db};
+                        perform_void_exec(db, "SAVEPOINT bulk_load");
+                        const size_t changesMark = this->changeNotifier.mark();
+                        try {
+                            result.rows = this->bulk_write_with_indexes<O>(range, options);
+                        } catch (...) {
+                            perform_void_exec(db, "ROLLBACK TO bulk_load");
+                            //  rolling back to a savepoint doesn't call a hook either
+                            this->changeNotifier.discard_since(changesMark);
+                            perform_void_exec(db, "RELEASE bulk_load");
+                            throw;
+                        }
+                        perform_void_exec(db, "RELEASE bulk_load");
+                    } else {
+                        auto guard = this->exclusive_transaction_guard();
+                        result.rows = this->bulk_write_with_indexes<O>(range, options);
+                        guard.commit();
+                    }
+                } catch (...) {
+                    restoreDurability();
+                    throw;
+                }
+                restoreDurability();
+                result.elapsed = std::chrono::steady_clock::now() - start;
+                return result;
             }
 
             /**
@@ -984,9 +1576,107 @@ namespace sqlite_orm {
             using storage_base::rename_table;
 
             /**
-             * Get table's name stored in storage's schema info. This function does not call
-             * any SQLite queries
-             */
+             *  Registers a listener of the rows of `O` inserted, updated or deleted by committed transactions,
+             *  see `storage_base::add_change_listener()`.
+             *
+             *  @example
+             *  ```c++
+             *  storage.add_change_listener<User>([&cache](const std::vector<row_change>& changes) {
+             *      for (auto& change: changes) {
+             *          cache.erase(change.rowid);
+             *      }
+             *  });
+             *  ```
+             */
+            template<class O>
+            size_t add_change_listener(std::function<void(const std::vector<row_change>& changes)> listener) {
+                this->assert_mapped_type<O>();
+                return this->storage_base::add_change_listener(this->tablename<O>(), std::move(listener));
+            }
+
+            using storage_base::add_change_listener;
+
+            /**
+             *  Enables an identity map of the objects of `O` by primary key, which `get()`, `get_pointer()` and
+             *  `get_optional()` consult before querying. Objects are loaded and cached outside of transactions only.
+             *  Cached objects are invalidated by `update()`, `replace()`, `remove()`, `update_all()` and
+             *  `remove_all()`, and by the update hook for rows changed otherwise through this storage.
+             *  Changes by other connections, and changes of WITHOUT ROWID tables other than by the functions above,
+             *  aren't noticed. Neither are rows the update hook doesn't report: rows deleted by a raw `DELETE`
+             *  without `WHERE` clause (SQLite's truncate optimization) and rows deleted by the `REPLACE` conflict
+             *  resolution, e.g. when `replace()` conflicts with a unique column of another row;
+             *  call `clear_object_cache<O>()` after such changes.
+             *  The whole database being replaced by `deserialize_database()` or `backup_from()` clears the cache.
+             *  Must be called before the storage is used by several threads.
+             *
+             *  @param sizeOf Size of an object counted against `object_cache_options::max_bytes`,
+             *  `sizeof(O)` by default.
+             *  @example
+             *  ```c++
+             *  storage.enable_object_cache<User>();
+             *  auto user = storage.get<User>(1);  //  queried
+             *  user = storage.get<User>(1);  //  copied from the cache
+             *  ```
+             */
+            template<class O>
+            void enable_object_cache(object_cache_options options = {},
+                                     std::function<size_t(const O& object)> sizeOf = {}) {
+                this->assert_mapped_type<O>();
+                static_assert(std::is_copy_constructible<O>::value, "cached objects are returned as copies");
+                //  a single integer primary key is an alias for the rowid the update hook reports
+                int primaryKeyColumnsCount = 0;
+                bool integerPrimaryKey = false;
+                this->get_table<O>().for_each_primary_key_column(
+                    [&primaryKeyColumnsCount, &integerPrimaryKey](auto& memberPointer) {
+                        using field_type = member_field_type_t<std::decay_t<decltype(memberPointer)>>;
+                        static_assert(is_printable<field_type>::value,
+                                      "a field_printer is needed for the primary key of cached objects");
+                        ++primaryKeyColumnsCount;
+                        integerPrimaryKey = std::is_integral<field_type>::value;
+                    });
+                object_cache::size_function size;
+                if (sizeOf) {
+                    size = [sizeOf = std::move(sizeOf)](const void* object) {
+                        return sizeOf(*static_cast<const O*>(object));
+                    };
+                } else {
+                    size = [](const void*) {
+                        return sizeof(O);
+                    };
+                }
+                this->add_object_cache(
+                    this->tablename<O>(),
+                    std::make_unique<object_cache>(options,
+                                                   std::move(size),
+                                                   primaryKeyColumnsCount == 1 && integerPrimaryKey));
+            }
+
+            template<class O>
+            void disable_object_cache() {
+                this->assert_mapped_type<O>();
+                this->objectCaches.erase(this->tablename<O>());
+            }
+
+            template<class O>
+            void clear_object_cache() {
+                this->assert_mapped_type<O>();
+                this->storage_base::clear_object_cache(this->tablename<O>());
+            }
+
+            /**
+             *  @return Counters of the object cache of `O`, all zero if it isn't enabled.
+             */
+            template<class O>
+            object_cache_stats get_object_cache_stats() const {
+                this->assert_mapped_type<O>();
+                auto it = this->objectCaches.find(this->tablename<O>());
+                return it != this->objectCaches.end() ? it->second->stats() : object_cache_stats{};
+            }
+
+            /**
+             * Get table's name stored in storage's schema info. This function does not call
+             * any SQLite queries
+             */
             template<class O>
             const std::string& tablename() const {
                 this->assert_mapped_type<O>();
@@ -1005,6 +1695,49 @@ namespace sqlite_orm {
                 return internal::find_column_name(this->db_objects, memberPointer);
             }
 
+            /**
+             *  Opens the BLOB of a column in the row with the given rowid for incremental I/O,
+             *  such that large values are read and written in parts instead of as a whole `std::vector<char>`.
+             *  Writes invalidate cached objects and results of the table like the other write functions.
+             *
+             *  @example
+             *  ```c++
+             *  storage.allocate_blob(&Artifact::data, id, fileSize);
+             *  auto blob = storage.open_blob(&Artifact::data, id, true);
+             *  blob.write_from(file);
+             *  ```
+             *  @throws std::system_error if the row doesn't exist or its value isn't a BLOB or text.
+             */
+            template<class F, class O>
+            blob_handle open_blob(F O::* memberPointer, int64 rowid, bool writable = false) {
+                const std::string* columnName = this->find_column_name(memberPointer);
+                if (!columnName) {
+                    throw std::system_error{orm_error_code::column_not_found};
+                }
+                const std::string& tableName = this->tablename<O>();
+                return {this->get_connection(),
+                        tableName,
+                        *columnName,
+                        rowid,
+                        writable,
+                        [this, &tableName](sqlite3_int64 rowid) {
+                            this->on_row_changed(tableName.c_str(), rowid);
+                        },
+                        [this] {
+                            this->after_write();
+                        }};
+            }
+
+            /**
+             *  Sets the BLOB of a column in the row with the given rowid to `size` zero bytes
+             *  using the `zeroblob()` function, such that it can be written in parts by a handle of `open_blob()`.
+             */
+            template<class F, class O>
+            void allocate_blob(F O::* memberPointer, int64 rowid, size_t size) {
+                this->update_all(sqlite_orm::set(sqlite_orm::c(memberPointer) = sqlite_orm::zeroblob(int64(size))),
+                                 sqlite_orm::where(sqlite_orm::is_equal(sqlite_orm::rowid<O>(), rowid)));
+            }
+
           protected:
             template<class M>
             sync_schema_result schema_status(const virtual_table_t<M>&, sqlite3*, bool, bool*) {
@@ -1158,6 +1891,11 @@ namespace sqlite_orm {
 
                 iterate_ast(statement.expression, conditional_binder{stmt});
 
+                return this->extract_rows<ColResult>(stmt);
+            }
+
+            template<class ColResult>
+            auto extract_rows(sqlite3_stmt* stmt) {
                 using R = decltype(make_row_extractor<ColResult>(this->db_objects).extract(nullptr, 0));
                 std::vector<R> res;
                 perform_steps(
@@ -1169,6 +1907,155 @@ namespace sqlite_orm {
                 return res;
             }
 
+            template<class... Rs>
+            std::tuple<std::vector<Rs>...> extract_columns(sqlite3_stmt* stmt,
+                                                           polyfill::type_identity<std::tuple<Rs...>>) {
+                static_assert(polyfill::conjunction<polyfill::negation<polyfill::disjunction<
+                                  polyfill::is_specialization_of<Rs, std::tuple>,
+                                  polyfill::is_specialization_of<Rs, structure>,
+                                  is_table_reference<Rs>>>...>::value,
+                              "get_columns() only supports columns of single values");
+                std::tuple<std::vector<Rs>...> res;
+                perform_steps(stmt, [&res](sqlite3_stmt* stmt) {
+                    extract_column_values(res, stmt, std::index_sequence_for<Rs...>{});
+                });
+                return res;
+            }
+
+#ifdef SQLITE_ORM_FOLD_EXPRESSIONS_SUPPORTED
+            template<class Tpl, size_t... Idx>
+            static void extract_column_values(Tpl& columnValues, sqlite3_stmt* stmt, std::index_sequence<Idx...>) {
+                (std::get<Idx>(columnValues)
+                     .push_back(row_value_extractor<typename std::tuple_element_t<Idx, Tpl>::value_type>().extract(
+                         stmt,
+                         int(Idx))),
+                 ...);
+            }
+#else
+            template<class Tpl, size_t... Idx>
+            static void extract_column_values(Tpl& columnValues, sqlite3_stmt* stmt, std::index_sequence<Idx...>) {
+                using Sink = int[sizeof...(Idx)];
+                (void)Sink{
+                    (std::get<Idx>(columnValues)
+                         .push_back(row_value_extractor<typename std::tuple_element_t<Idx, Tpl>::value_type>().extract(
+                             stmt,
+                             int(Idx))),
+                     0)...};
+            }
+#endif
+
+            /**
+             *  Binds the fields of the objects written by a replace or replace range statement.
+             *  @return Index of the next parameter.
+             */
+            template<class E,
+                     std::enable_if_t<polyfill::disjunction<is_replace<E>, is_replace_range<E>>::value, bool> = true>
+            int bind_written_values(sqlite3_stmt* stmt, const E& expression) {
+                using object_type = expression_object_type_t<E>;
+
+                field_value_binder bindValue{stmt};
+                auto processObject = [&table = this->get_table<object_type>(), &bindValue](auto& object) {
+                    table.template for_each_column_excluding<is_generated_always>(
+                        call_as_template_base<column_field>([&bindValue, &object](auto& column) {
+                            bindValue(polyfill::invoke(column.member_pointer, object));
+                        }));
+                };
+
+                static_if<is_replace_range<E>::value>(
+                    [&processObject](auto& expr) {
+#if __cpp_lib_ranges >= 201911L
+                        std::ranges::for_each(expr.range.first,
+                                              expr.range.second,
+                                              std::ref(processObject),
+                                              std::ref(expr.transformer));
+#else
+                        auto& transformer = expr.transformer;
+                        std::for_each(expr.range.first,
+                                      expr.range.second,
+                                      [&processObject, &transformer](auto& item) {
+                                          const object_type& object = polyfill::invoke(transformer, item);
+                                          processObject(object);
+                                      });
+#endif
+                    },
+                    [&processObject](auto& expr) {
+                        const object_type& o = get_object(expr);
+                        processObject(o);
+                    })(expression);
+
+                return bindValue.index;
+            }
+
+            /**
+             *  Binds the fields of the objects written by an insert or insert range statement.
+             *  @return Index of the next parameter.
+             */
+            template<class E,
+                     std::enable_if_t<polyfill::disjunction<is_insert<E>, is_insert_range<E>>::value, bool> = true>
+            int bind_written_values(sqlite3_stmt* stmt, const E& expression) {
+                using object_type = expression_object_type_t<E>;
+
+                field_value_binder bindValue{stmt};
+                auto processObject = [&table = this->get_table<object_type>(), &bindValue](auto& object) {
+                    using is_without_rowid = typename std::remove_reference_t<decltype(table)>::is_without_rowid;
+                    table.template for_each_column_excluding<
+                        mpl::conjunction<mpl::not_<mpl::always<is_without_rowid>>,
+                                         mpl::disjunction_fn<is_primary_key, is_generated_always>>>(
+                        call_as_template_base<column_field>([&table, &bindValue, &object](auto& column) {
+                            if (!exists_in_composite_primary_key(table, column)) {
+                                bindValue(polyfill::invoke(column.member_pointer, object));
+                            }
+                        }));
+                };
+
+                static_if<is_insert_range<E>::value>(
+                    [&processObject](auto& expr) {
+#if __cpp_lib_ranges >= 201911L
+                        std::ranges::for_each(expr.range.first,
+                                              expr.range.second,
+                                              std::ref(processObject),
+                                              std::ref(expr.transformer));
+#else
+                        auto& transformer = expr.transformer;
+                        std::for_each(expr.range.first,
+                                      expr.range.second,
+                                      [&processObject, &transformer](auto& item) {
+                                          const object_type& object = polyfill::invoke(transformer, item);
+                                          processObject(object);
+                                      });
+#endif
+                    },
+                    [&processObject](auto& expr) {
+                        const object_type& o = get_object(expr);
+                        processObject(o);
+                    })(expression);
+
+                return bindValue.index;
+            }
+
+            template<class E,
+                     std::enable_if_t<polyfill::disjunction<is_insert_raw<E>, is_replace_raw<E>>::value, bool> = true>
+            int bind_written_values(sqlite3_stmt* stmt, const E& expression) {
+                conditional_binder bindNode{stmt};
+                iterate_ast(expression, bindNode);
+                return bindNode.index;
+            }
+
+            template<class S, class... Wargs>
+            int bind_written_values(sqlite3_stmt* stmt, const update_all_t<S, Wargs...>& expression) {
+                conditional_binder bindNode{stmt};
+                iterate_ast(expression.set, bindNode);
+                iterate_ast(expression.conditions, bindNode);
+                return bindNode.index;
+            }
+
+            template<class T, class... Args>
+            int bind_written_values(sqlite3_stmt* stmt, const remove_all_t<T, Args...>& expression) {
+                conditional_binder bindNode{stmt};
+                iterate_ast(expression.conditions, bindNode);
+                return bindNode.index;
+            }
+
             template<class E>
             std::string dump_highest_level(E&& expression, bool parametrized) const {
                 const auto& exprDBOs = db_objects_for_expression(this->db_objects, expression);
@@ -1190,10 +2077,200 @@ namespace sqlite_orm {
 
                 auto con = this->get_connection();
                 std::string sql = serialize(statement, context);
+                this->check_query_plan(con.get(), sql);
                 sqlite3_stmt* stmt = prepare_stmt(con.get(), std::move(sql));
                 return prepared_statement_t<S>{std::forward<S>(statement), stmt, con};
             }
 
+            /**
+             *  Like `prepare_impl()`, but reuses an idle statement from the statement cache if there is one
+             *  for the same connection, expression type and SQL,
+             *  and gives the statement back to the cache afterwards instead of finalizing it.
+             */
+            template<typename S>
+            cached_prepared_statement_t<S> prepare_cached_impl(S statement) {
+                const auto& exprDBOs = db_objects_for_expression(this->db_objects, statement);
+                using context_t = serializer_context<polyfill::remove_cvref_t<decltype(exprDBOs)>>;
+                context_t context{exprDBOs};
+                context.skip_table_name = false;
+                context.replace_bindable_with_question = true;
+
+                auto con = is_read_only_expression<S>::value ? this->get_reader_connection() : this->get_connection();
+                statement_cache::key_type key{con.get(), &expression_type_tag<S>::id, serialize(statement, context)};
+                sqlite3_stmt* stmt = this->statementCache.take(key);
+                if (!stmt) {
+                    this->check_query_plan(con.get(), key.sql);
+                    stmt = prepare_stmt(con.get(), key.sql);
+                }
+                return {prepared_statement_t<S>{std::move(statement), stmt, con}, this->statementCache, std::move(key)};
+            }
+
+            template<class T, class... Args>
+            cached_prepared_statement_t<select_t<T, Args...>> prepare_cached(select_t<T, Args...> statement) {
+                statement.highest_level = true;
+                return this->prepare_cached_impl(std::move(statement));
+            }
+
+            template<class S>
+            cached_prepared_statement_t<S> prepare_cached(S statement) {
+                return this->prepare_cached_impl(std::move(statement));
+            }
+
+            /**
+             *  Collects the name and the `CREATE INDEX` statement of an index of the table mapped to O.
+             */
+            template<class O, class... Els>
+            void collect_index_of(const index_t<O, Els...>& index,
+                                  std::vector<std::pair<std::string, std::string>>& indexes) const {
+                using context_t = serializer_context<db_objects_type>;
+                context_t context{this->db_objects};
+                indexes.emplace_back(index.name, serialize(index, context));
+            }
+
+            template<class O, class E>
+            void collect_index_of(const E&, std::vector<std::pair<std::string, std::string>>&) const {}
+
+            template<class O, class R>
+            size_t bulk_write_with_indexes(const R& range, const bulk_load_options& options) {
+                std::vector<std::pair<std::string, std::string>> indexes;
+                if (options.drop_indexes) {
+                    iterate_tuple(this->db_objects, [this, &indexes](auto& dbObject) {
+                        this->collect_index_of<O>(dbObject, indexes);
+                    });
+                    for (auto& index: indexes) {
+                        //  an index of the storage's schema may not have been created yet
+                        this->drop_index_internal(index.first, true);
+                    }
+                }
+                const size_t rows = this->bulk_write<O>(std::begin(range), std::end(range), options);
+                auto con = this->get_connection();
+                for (auto& index: indexes) {
+                    perform_void_exec(con.get(), index.second);
+                }
+                return rows;
+            }
+
+            template<class O, class It>
+            size_t bulk_write(It from, It to, const bulk_load_options& options) {
+                const size_t count = std::distance(from, to);
+                if (!options.keep_primary_keys) {
+                    this->insert_range<O>(std::move(from), std::move(to));
+                    return count;
+                }
+                if (!options.sort_by_primary_key) {
+                    this->replace_range<O>(std::move(from), std::move(to));
+                    return count;
+                }
+
+                std::vector<std::reference_wrapper<const O>> objects(from, to);
+                auto& table = this->get_table<O>();
+                std::stable_sort(objects.begin(), objects.end(), [&table](const O& lhs, const O& rhs) {
+                    int res = 0;
+                    table.for_each_primary_key_column([&table, &lhs, &rhs, &res](auto& memberPointer) {
+                        if (res != 0) {
+                            return;
+                        }
+                        auto compare = [&res](const auto& lhsValue, const auto& rhsValue) {
+                            res = lhsValue < rhsValue ? -1 : (rhsValue < lhsValue ? 1 : 0);
+                        };
+                        using member_type = std::decay_t<decltype(memberPointer)>;
+                        static_if<is_setter<member_type>::value>(
+                            [&table, &lhs, &rhs, &compare](auto& setter) {
+                                auto lhsValue = table.object_field_value(lhs, setter);
+                                auto rhsValue = table.object_field_value(rhs, setter);
+                                //  null if no column is mapped with the setter
+                                if (lhsValue && rhsValue) {
+                                    compare(*lhsValue, *rhsValue);
+                                }
+                            },
+                            [&table, &lhs, &rhs, &compare](auto& memberPointer) {
+                                compare(table.object_field_value(lhs, memberPointer),
+                                        table.object_field_value(rhs, memberPointer));
+                            })(memberPointer);
+                    });
+                    return res < 0;
+                });
+                this->replace_range<O>(objects.begin(),
+                                       objects.end(),
+                                       [](const std::reference_wrapper<const O>& object) -> const O& {
+                                           return object.get();
+                                       });
+                return count;
+            }
+
+            /**
+             *  Number of values bound per object by an `insert_range` statement.
+             */
+            template<class O>
+            size_t count_of_insertable_columns() const {
+                auto& table = this->get_table<O>();
+                using is_without_rowid = typename std::remove_reference_t<decltype(table)>::is_without_rowid;
+                size_t res = 0;
+                table.template for_each_column_excluding<
+                    mpl::conjunction<mpl::not_<mpl::always<is_without_rowid>>,
+                                     mpl::disjunction_fn<is_primary_key, is_generated_always>>>(
+                    [&table, &res](auto& column) {
+                        if (!exists_in_composite_primary_key(table, column)) {
+                            ++res;
+                        }
+                    });
+                return res;
+            }
+
+            /**
+             *  Executes an `insert_range` or `replace_range` expression in chunks of as many objects as fit
+             *  into `SQLITE_LIMIT_VARIABLE_NUMBER`, such that ranges of any size can be written
+             *  and the SQL of a chunk is the same for every chunk.
+             *  The statement for full chunks is prepared once and rebound for every chunk,
+             *  the remainder is written by a single tail statement.
+             *  Multiple chunks are written in a transaction unless a transaction is already in progress.
+             *
+             *  @param columnsCount Number of values bound per object.
+             */
+            template<class E>
+            void execute_range_in_chunks(E expression, size_t columnsCount) {
+                auto con = this->get_connection();
+                const size_t objectsCount = std::distance(expression.range.first, expression.range.second);
+                size_t chunkSize = objectsCount;
+                //  a range of objects without any column to bind can't be split (`DEFAULT VALUES`)
+                if (columnsCount) {
+                    const int maxVariables = sqlite3_limit(con.get(), SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+                    chunkSize = std::max<size_t>(size_t(maxVariables) / columnsCount, 1);
+                }
+                if (objectsCount <= chunkSize) {
+                    auto statement = this->prepare(std::move(expression));
+                    this->execute(statement);
+                    return;
+                }
+
+                auto executeChunks = [this, &expression, objectsCount, chunkSize] {
+                    const auto last = expression.range.second;
+                    auto first = expression.range.first;
+                    expression.range.second = std::next(first, chunkSize);
+                    auto statement = this->prepare_cached(expression);
+                    size_t remaining = objectsCount;
+                    for (; remaining >= chunkSize; remaining -= chunkSize) {
+                        statement.expression.range.first = first;
+                        statement.expression.range.second = first = std::next(first, chunkSize);
+                        this->execute(statement);
+                    }
+                    if (remaining) {
+                        expression.range.first = first;
+                        expression.range.second = last;
+                        auto tailStatement = this->prepare(std::move(expression));
+                        this->execute(tailStatement);
+                    }
+                };
+                if (sqlite3_get_autocommit(con.get())) {
+                    this->transaction([&executeChunks] {
+                        executeChunks();
+                        return true;
+                    });
+                } else {
+                    executeChunks();
+                }
+            }
+
           public:
             /**
              *  This is a cute function used to replace migration up/down functionality.
@@ -1224,6 +2301,7 @@ namespace sqlite_orm {
              */
             std::map<std::string, sync_schema_result> sync_schema(bool preserve = false) {
                 auto con = this->get_connection();
+                this->clear_statement_caches_for_schema_change();
                 std::map<std::string, sync_schema_result> result;
                 iterate_tuple<true>(this->db_objects, [this, db = con.get(), preserve, &result](auto& schemaObject) {
                     sync_schema_result status = this->sync_table(schemaObject, db, preserve);
@@ -1317,6 +2395,29 @@ namespace sqlite_orm {
                 return this->prepare_impl(std::move(statement));
             }
 
+#ifdef SQLITE_ENABLE_JSON1
+            template<class T, class Id>
+            prepared_statement_t<get_many_t<T, Id>> prepare(get_many_t<T, Id> statement) {
+                return this->prepare_impl(std::move(statement));
+            }
+#endif  //  SQLITE_ENABLE_JSON1
+
+#if SQLITE_VERSION_NUMBER >= 3035000
+            template<class S, class T>
+            prepared_statement_t<returning_t<S, T>> prepare(returning_t<S, T> statement) {
+                static_assert(polyfill::disjunction<is_insert<S>,
+                                                    is_insert_range<S>,
+                                                    is_insert_raw<S>,
+                                                    is_replace<S>,
+                                                    is_replace_range<S>,
+                                                    is_replace_raw<S>,
+                                                    is_update_all<S>,
+                                                    is_remove_all<S>>::value,
+                              "RETURNING is only supported for insert, replace, update_all and remove_all statements");
+                return this->prepare_impl(std::move(statement));
+            }
+#endif
+
 #ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
             template<class T, class... Ids>
             prepared_statement_t<get_optional_t<T, Ids...>> prepare(get_optional_t<T, Ids...> statement) {
@@ -1380,7 +2481,8 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<replace_raw_t<Args...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_write_step(stmt);
+                this->after_write();
             }
 
 #if (SQLITE_VERSION_NUMBER >= 3008003) && defined(SQLITE_ORM_WITH_CTE)
@@ -1393,7 +2495,8 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<with_t<E, CTEs...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_write_step(stmt);
+                this->after_write();
             }
 #endif
 
@@ -1401,7 +2504,8 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<insert_raw_t<Args...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_write_step(stmt);
+                this->after_write();
             }
 
             template<class T, class... Cols>
@@ -1415,93 +2519,30 @@ namespace sqlite_orm {
                     [&table = this->get_table<object_type>(), &object = statement.expression.obj](auto& memberPointer) {
                         return table.object_field_value(object, memberPointer);
                     });
-                perform_step(stmt);
+                this->perform_write_step(stmt);
+                this->after_write(this->tablename<object_type>());
                 return sqlite3_last_insert_rowid(sqlite3_db_handle(stmt));
             }
 
             template<class T,
                      std::enable_if_t<polyfill::disjunction<is_replace<T>, is_replace_range<T>>::value, bool> = true>
             void execute(const prepared_statement_t<T>& statement) {
-                using object_type = statement_object_type_t<decltype(statement)>;
-
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
-
-                auto processObject = [&table = this->get_table<object_type>(),
-                                      bindValue = field_value_binder{stmt}](auto& object) mutable {
-                    table.template for_each_column_excluding<is_generated_always>(
-                        call_as_template_base<column_field>([&bindValue, &object](auto& column) {
-                            bindValue(polyfill::invoke(column.member_pointer, object));
-                        }));
-                };
-
-                static_if<is_replace_range<T>::value>(
-                    [&processObject](auto& expression) {
-#if __cpp_lib_ranges >= 201911L
-                        std::ranges::for_each(expression.range.first,
-                                              expression.range.second,
-                                              std::ref(processObject),
-                                              std::ref(expression.transformer));
-#else
-                        auto& transformer = expression.transformer;
-                        std::for_each(expression.range.first,
-                                      expression.range.second,
-                                      [&processObject, &transformer](auto& item) {
-                                          const object_type& object = polyfill::invoke(transformer, item);
-                                          processObject(object);
-                                      });
-#endif
-                    },
-                    [&processObject](auto& expression) {
-                        const object_type& o = get_object(expression);
-                        processObject(o);
-                    })(statement.expression);
-
-                perform_step(stmt);
+                this->bind_written_values(stmt, statement.expression);
+                this->perform_write_step(stmt);
+                using object_type = statement_object_type_t<decltype(statement)>;
+                this->invalidate_replaced_objects(statement.expression);
+                this->after_write(this->tablename<object_type>());
             }
 
             template<class T,
                      std::enable_if_t<polyfill::disjunction<is_insert<T>, is_insert_range<T>>::value, bool> = true>
             int64 execute(const prepared_statement_t<T>& statement) {
-                using object_type = statement_object_type_t<decltype(statement)>;
-
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
-
-                auto processObject = [&table = this->get_table<object_type>(),
-                                      bindValue = field_value_binder{stmt}](auto& object) mutable {
-                    using is_without_rowid = typename std::remove_reference_t<decltype(table)>::is_without_rowid;
-                    table.template for_each_column_excluding<
-                        mpl::conjunction<mpl::not_<mpl::always<is_without_rowid>>,
-                                         mpl::disjunction_fn<is_primary_key, is_generated_always>>>(
-                        call_as_template_base<column_field>([&table, &bindValue, &object](auto& column) {
-                            if (!exists_in_composite_primary_key(table, column)) {
-                                bindValue(polyfill::invoke(column.member_pointer, object));
-                            }
-                        }));
-                };
-
-                static_if<is_insert_range<T>::value>(
-                    [&processObject](auto& expression) {
-#if __cpp_lib_ranges >= 201911L
-                        std::ranges::for_each(expression.range.first,
-                                              expression.range.second,
-                                              std::ref(processObject),
-                                              std::ref(expression.transformer));
-#else
-                        auto& transformer = expression.transformer;
-                        std::for_each(expression.range.first,
-                                      expression.range.second,
-                                      [&processObject, &transformer](auto& item) {
-                                          const object_type& object = polyfill::invoke(transformer, item);
-                                          processObject(object);
-                                      });
-#endif
-                    },
-                    [&processObject](auto& expression) {
-                        const object_type& o = get_object(expression);
-                        processObject(o);
-                    })(statement.expression);
-
-                perform_step(stmt);
+                this->bind_written_values(stmt, statement.expression);
+                this->perform_write_step(stmt);
+                using object_type = statement_object_type_t<decltype(statement)>;
+                this->after_write(this->tablename<object_type>());
                 return sqlite3_last_insert_rowid(sqlite3_db_handle(stmt));
             }
 
@@ -1509,7 +2550,9 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<remove_t<T, Ids...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression.ids, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_write_step(stmt);
+                this->invalidate_cached_object_by_id<T>(statement.expression.ids);
+                this->after_write(this->tablename<T>());
             }
 
             template<class T>
@@ -1532,7 +2575,38 @@ namespace sqlite_orm {
                         bindValue(polyfill::invoke(column.member_pointer, object));
                     }
                 });
-                perform_step(stmt);
+                this->perform_write_step(stmt);
+                this->invalidate_cached_object(object);
+                this->after_write(this->tablename<object_type>());
+            }
+
+            template<class T>
+            void execute(const prepared_statement_t<update_columns_t<T>>& statement) {
+                using object_type = statement_object_type_t<decltype(statement)>;
+
+                sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+                auto& table = this->get_table<object_type>();
+
+                field_value_binder bindValue{stmt};
+                auto& object = get_object(statement.expression);
+                table.for_each_column([&table,
+                                       &bindValue,
+                                       &object,
+                                       &columnsMask = statement.expression.columnsMask,
+                                       index = size_t(0)](auto& column) mutable {
+                    if (columnsMask.at(index++) && !column.template is<is_primary_key>() &&
+                        !column.template is<is_generated_always>() && !exists_in_composite_primary_key(table, column)) {
+                        bindValue(polyfill::invoke(column.member_pointer, object));
+                    }
+                });
+                table.for_each_column([&table, &bindValue, &object](auto& column) {
+                    if (column.template is<is_primary_key>() || exists_in_composite_primary_key(table, column)) {
+                        bindValue(polyfill::invoke(column.member_pointer, object));
+                    }
+                });
+                this->perform_write_step(stmt);
+                this->invalidate_cached_object(object);
+                this->after_write(this->tablename<object_type>());
             }
 
             template<class T, class... Ids>
@@ -1550,6 +2624,30 @@ namespace sqlite_orm {
                 return res;
             }
 
+#ifdef SQLITE_ENABLE_JSON1
+            template<class T, class Id>
+            std::vector<std::unique_ptr<T>> execute(const prepared_statement_t<get_many_t<T, Id>>& statement) {
+                sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+
+                auto& ids = statement.expression.ids;
+                const std::string json = serialize_json_array(ids);
+                if (SQLITE_OK != statement_binder<std::string>().bind(stmt, 1, json)) {
+                    throw_translated_sqlite_error(stmt);
+                }
+
+                std::vector<std::unique_ptr<T>> res(ids.size());
+                perform_steps(stmt, [&table = this->get_table<T>(), &res](sqlite3_stmt* stmt) {
+                    //  the position of the id follows the table's columns
+                    const int position = sqlite3_column_int(stmt, sqlite3_column_count(stmt) - 1);
+                    auto object = std::make_unique<T>();
+                    object_from_column_builder<T> builder{*object, stmt};
+                    table.for_each_column(builder);
+                    res[position] = std::move(object);
+                });
+                return res;
+            }
+#endif  //  SQLITE_ENABLE_JSON1
+
 #ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
             template<class T, class... Ids>
             std::optional<T> execute(const prepared_statement_t<get_optional_t<T, Ids...>>& statement) {
@@ -1605,18 +2703,49 @@ namespace sqlite_orm {
             template<class T, class... Args>
             void execute(const prepared_statement_t<remove_all_t<T, Args...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
-                iterate_ast(statement.expression.conditions, conditional_binder{stmt});
-                perform_step(stmt);
+                this->bind_written_values(stmt, statement.expression);
+                this->perform_write_step(stmt);
+                this->invalidate_object_caches(this->tablename<T>());
+                this->after_write(this->tablename<T>());
             }
 
             template<class S, class... Wargs>
             void execute(const prepared_statement_t<update_all_t<S, Wargs...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+                this->bind_written_values(stmt, statement.expression);
+                this->perform_write_step(stmt);
+                if (!this->objectCaches.empty() || this->resultCache) {
+                    using context_t = serializer_context<db_objects_type>;
+                    context_t context{this->db_objects};
+                    for (auto& tableName: collect_table_names(statement.expression.set, context)) {
+                        this->invalidate_object_caches(tableName.first);
+                        this->invalidate_results(tableName.first);
+                    }
+                }
+                this->after_write();
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3035000
+            /**
+             *  Executes the modifying statement and returns the rows of its RETURNING clause,
+             *  like `select` with the same columns.
+             */
+            template<class S, class T>
+            auto execute(const prepared_statement_t<returning_t<S, T>>& statement) {
+                using ColResult = column_result_of_t<db_objects_type, T>;
+                sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+
                 conditional_binder bindNode{stmt};
-                iterate_ast(statement.expression.set, bindNode);
-                iterate_ast(statement.expression.conditions, bindNode);
-                perform_step(stmt);
+                bindNode.index = this->bind_written_values(stmt, statement.expression.statement);
+                iterate_ast(statement.expression.columns, bindNode);
+
+                auto rows = this->run_write_statement(sqlite3_db_handle(stmt), [this, stmt] {
+                    return this->extract_rows<ColResult>(stmt);
+                });
+                this->after_write();
+                return rows;
             }
+#endif
 
 #if (SQLITE_VERSION_NUMBER >= 3008003) && defined(SQLITE_ORM_WITH_CTE)
             template<class... CTEs, class T, class... Args>
@@ -1710,6 +2839,17 @@ namespace sqlite_orm {
         return {std::move(filename), internal::db_objects_tuple<DBO...>{std::forward<DBO>(dbObjects)...}};
     }
 
+    /**
+     *  Factory function for a storage whose database connections are opened with the given options,
+     *  e.g. read-only, with URI parameters or a particular VFS.
+     */
+    template<class... DBO>
+    internal::storage_t<DBO...> make_storage(std::string filename, open_options options, DBO... dbObjects) {
+        return {std::move(filename),
+                std::move(options),
+                internal::db_objects_tuple<DBO...>{std::forward<DBO>(dbObjects)...}};
+    }
+
     /**
      *  sqlite3_threadsafe() interface.
      */
@@ -13,8 +13,11 @@
 #include <list>  //  std::list
 #include <memory>  //  std::make_unique, std::unique_ptr
 #include <map>  //  std::map
-#include <type_traits>  //  std::is_same
-#include <algorithm>  //  std::find_if, std::ranges::find
+#include <type_traits>  //  std::is_same, std::integral_constant
+#include <algorithm>  //  std::find_if, std::ranges::find, std::copy
+#include <chrono>  //  std::chrono::milliseconds
+#include <atomic>  //  std::atomic_bool, std::atomic
+#include <thread>  //  std::thread, std::this_thread
 
 #include "functional/cxx_tuple_polyfill.h"  //  std::apply
 #include "tuple_helper/tuple_iteration.h"
@@ -23,7 +26,16 @@
 #include "transaction_guard.h"
 #include "row_extractor.h"
 #include "connection_holder.h"
+#include "statement_cache.h"
+#include "statement_finalizer.h"
+#include "statement_profiler.h"
+#include "query_plan.h"
+#include "reader_pool.h"
 #include "backup.h"
+#include "wal_checkpoint.h"
+#include "change_notifier.h"
+#include "object_cache.h"
+#include "result_cache.h"
 #include "function.h"
 #include "values_to_tuple.h"
 #include "arg_values.h"
@@ -142,7 +154,8 @@ namespace sqlite_orm {
             }
 
           protected:
-            void rename_table(sqlite3* db, const std::string& oldName, const std::string& newName) const {
+            void rename_table(sqlite3* db, const std::string& oldName, const std::string& newName) {
+                this->clear_statement_caches_for_schema_change();
                 std::stringstream ss;
                 ss << "ALTER TABLE " << streaming_identifier(oldName) << " RENAME TO " << streaming_identifier(newName)
                    << std::flush;
@@ -293,11 +306,217 @@ namespace sqlite_orm {
             void open_forever() {
                 this->isOpenedForever = true;
                 this->connection->retain();
-                if (1 == this->connection->retain_count()) {
-                    this->on_open_internal(this->connection->get());
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3036000 || defined(SQLITE_ENABLE_DESERIALIZE)
+#ifndef SQLITE_OMIT_DESERIALIZE
+            /**
+             *  Returns the image of the `main` database as one contiguous buffer,
+             *  which is the same as the content of the database file.
+             *  For in-memory databases the buffer is copied once from SQLite's memory.
+             */
+            std::vector<unsigned char> serialize_database() {
+                auto con = this->get_connection();
+                sqlite3_int64 size = 0;
+                //  an in-memory database is contiguous already and can be copied right away
+                if (const unsigned char* data = sqlite3_serialize(con.get(), "main", &size, SQLITE_SERIALIZE_NOCOPY)) {
+                    return {data, data + size};
                 }
+                using buffer_ptr =
+                    std::unique_ptr<unsigned char, std::integral_constant<decltype(&sqlite3_free), sqlite3_free>>;
+                buffer_ptr data{sqlite3_serialize(con.get(), "main", &size, 0)};
+                if (!data) {
+                    throw std::system_error{sqlite_errc(SQLITE_NOMEM)};
+                }
+                return {data.get(), data.get() + size};
+            }
+
+            /**
+             *  Replaces the `main` database by the given image, e.g. obtained from `serialize_database()`.
+             *  The database then lives in memory as long as the connection is opened,
+             *  hence this is meant for in-memory storages or storages opened by `open_forever()`.
+             *  The image is copied into memory owned by SQLite, which can grow as the database is written.
+             *  Throws std::system_error{orm_error_code::reader_pool_is_enabled} if the reader pool is enabled,
+             *  because pooled readers would keep reading the database file instead of the image.
+             *  Throws std::system_error{orm_error_code::connection_is_not_kept_open} if the connection isn't
+             *  retained, e.g. by `open_forever()` or a transaction, because it would be closed right away
+             *  together with the image.
+             */
+            void deserialize_database(const std::vector<unsigned char>& image, bool readonly = false) {
+                this->deserialize_database(image.data(), image.size(), readonly, true);
+            }
+
+            /**
+             *  Like `deserialize_database(image, readonly)`.
+             *  If `readonly` is true and `copy` is false the image is used as is without copying it,
+             *  in which case `data` must stay valid until the connection is closed or another image is loaded.
+             */
+            void deserialize_database(const unsigned char* data, size_t size, bool readonly, bool copy) {
+                if (this->reader_pool_size() > 0) {
+                    throw std::system_error{orm_error_code::reader_pool_is_enabled};
+                }
+                if (this->connection->retain_count() == 0) {
+                    throw std::system_error{orm_error_code::connection_is_not_kept_open};
+                }
+                auto con = this->get_connection();
+                unsigned char* buffer = const_cast<unsigned char*>(data);
+                unsigned flags = readonly ? SQLITE_DESERIALIZE_READONLY : 0;
+                if (copy || !readonly) {
+                    buffer = static_cast<unsigned char*>(sqlite3_malloc64(size));
+                    if (!buffer && size) {
+                        throw std::system_error{sqlite_errc(SQLITE_NOMEM)};
+                    }
+                    std::copy(data, data + size, buffer);
+                    flags |= SQLITE_DESERIALIZE_FREEONCLOSE | SQLITE_DESERIALIZE_RESIZEABLE;
+                }
+                //  cached statements refer to the schema of the image being replaced
+                this->statementCache.clear(con.get());
+                const auto length = sqlite3_int64(size);
+                //  on failure the buffer is freed by SQLite if it is to free it on close
+                if (sqlite3_deserialize(con.get(), "main", buffer, length, length, flags) != SQLITE_OK) {
+                    throw_translated_sqlite_error(con.get());
+                }
+                this->clear_object_caches();
+                this->clear_result_cache();
+            }
+#endif
+#endif
+
+            /**
+             *  Sets the maximum number of idle prepared statements kept by the statement cache.
+             *  The statement cache is used by CRUD functions like `get`, `insert`, `update`, `remove`, `replace`,
+             *  `count`, `get_all` and `select`: their statements are reset and rebound instead of being
+             *  prepared again for every call.
+             *  Cached statements live only as long as the database connection is opened, hence
+             *  the cache is most effective for in-memory databases or after calling `open_forever()`.
+             *  Passing 0 disables the cache. Least recently used statements exceeding the new capacity are finalized.
+             */
+            void statement_cache_capacity(size_t capacity) {
+                this->statementCache.set_capacity(capacity);
+            }
+
+            size_t statement_cache_capacity() const {
+                return this->statementCache.get_capacity();
+            }
+
+            /**
+             *  Returns capacity, size and hit/miss/eviction counters of the statement cache.
+             */
+            sqlite_orm::statement_cache_stats statement_cache_stats() const {
+                return this->statementCache.stats();
+            }
+
+            /**
+             *  Finalizes all statements held by the statement cache.
+             */
+            void clear_statement_cache() {
+                this->statementCache.clear();
+            }
+
+            /**
+             *  Keeps the database connection opened for `idleTimeout` after it is not needed anymore
+             *  instead of closing it right away, so that calls following each other shortly reuse
+             *  the same connection (and its cached statements) rather than opening a new one.
+             *  An idle connection is closed by a background thread once the timeout has elapsed.
+             *  Passing zero (the default) closes the connection as soon as it is not needed anymore.
+             *  Has no effect for in-memory databases or after calling `open_forever()`.
+             */
+            void keep_alive(std::chrono::milliseconds idleTimeout) {
+                this->connection->keep_alive(idleTimeout);
+            }
+
+            std::chrono::milliseconds keep_alive() const {
+                return this->connection->keep_alive();
+            }
+
+            /**
+             *  Returns how many times the database connection was opened, closed and reused while kept alive.
+             */
+            sqlite_orm::connection_stats connection_stats() const {
+                return this->connection->connection_stats();
+            }
+
+            /**
+             *  Sets the maximum number of read-only connections used for read-only expressions:
+             *  `select`, `count` and the other aggregate functions, `get_all`, `get`,
+             *  and their pointer and optional variants.
+             *  All other statements keep using the single writer connection, as do the reads of a thread
+             *  running a transaction.
+             *  Together with `journal_mode::WAL` this lets several threads read concurrently with each other
+             *  and with a writer, instead of serializing on one connection.
+             *  Reader connections are opened on demand, get the same collations, limits, busy handler,
+             *  functions and `on_open` callback as the writer, and stay opened while they are part of the pool.
+             *  Zero (the default) disables the pool. Has no effect for in-memory databases.
+             */
+            void reader_pool_size(size_t size) {
+                if (!this->inMemory) {
+                    this->readers->set_capacity(size);
+                }
+            }
+
+            size_t reader_pool_size() const {
+                return this->readers->get_capacity();
+            }
+
+            /**
+             *  Debug mode checking the query plan of every statement prepared by the storage
+             *  for full scans (`SCAN`) of tables having at least `minTableRows` rows.
+             *  On such a scan `onFullScan` is called with the statement's SQL and the offending plan node
+             *  if given, otherwise a `std::system_error` with `orm_error_code::full_table_scan` is thrown
+             *  before the statement is prepared.
+             *  Cached statements are checked once, when they are prepared.
+             *  Counting the rows of a table is costly, hence this is meant for test suites and sampling.
+             *
+             *  @example
+             *  ```c++
+             *  storage.check_full_scans(1000);
+             *  storage.get_all<User>(where(c(&User::email) == email));  //  throws unless users.email is indexed
+             *  ```
+             */
+            void check_full_scans(
+                size_t minTableRows,
+                std::function<void(const std::string& sql, const query_plan_node& node)> onFullScan = {}) {
+                this->checkingFullScans = true;
+                this->fullScanMinTableRows = minTableRows;
+                this->onFullScan = std::move(onFullScan);
+            }
+
+            void disable_full_scan_check() {
+                this->checkingFullScans = false;
+                this->onFullScan = nullptr;
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+            /**
+             *  Enables or disables collecting count, rows stepped, total time and a latency histogram
+             *  per SQL text of every statement run on the writer and the reader connections.
+             *  Measurements come from `sqlite3_trace_v2()`, which is installed on every connection
+             *  opened later on, too, hence profiling survives reconnects.
+             *  Disabled by default. Disabling keeps the collected profiles.
+             */
+            void profile_statements(bool enable) {
+                this->profilingStatements = enable;
+                this->for_each_opened_connection([this](sqlite3* db) {
+                    this->install_statement_profiler(db);
+                });
             }
 
+            bool profile_statements() const {
+                return this->profilingStatements;
+            }
+
+            /**
+             *  Returns the collected statement profiles ordered by descending total time.
+             */
+            std::vector<statement_profile> statement_profiles() const {
+                return this->statementProfiler.snapshot();
+            }
+
+            void clear_statement_profiles() {
+                this->statementProfiler.clear();
+            }
+#endif
+
             /**
              * Create an application-defined scalar SQL function.
              * Can be called at any time no matter whether the database connection is opened or not.
@@ -390,10 +609,9 @@ namespace sqlite_orm {
                     nullptr,
                     std::pair{nullptr, null_xdestroy_f});
 
-                if (this->connection->retain_count() > 0) {
-                    sqlite3* db = this->connection->get();
+                this->for_each_opened_connection([this](sqlite3* db) {
                     try_to_create_scalar_function(db, this->scalarFunctions.back());
-                }
+                });
             }
 #endif
 
@@ -529,8 +747,7 @@ namespace sqlite_orm {
                 }
 
                 //  create collations if db is open
-                if (this->connection->retain_count() > 0) {
-                    sqlite3* db = this->connection->get();
+                this->for_each_opened_connection([&name, function, functionExists](sqlite3* db) {
                     int rc = sqlite3_create_collation(db,
                                                       name.c_str(),
                                                       SQLITE_UTF8,
@@ -539,7 +756,7 @@ namespace sqlite_orm {
                     if (rc != SQLITE_OK) {
                         throw_translated_sqlite_error(db);
                     }
-                }
+                });
 
                 if (!functionExists) {
                     collatingFunctions.erase(name);
@@ -572,6 +789,8 @@ namespace sqlite_orm {
             void commit() {
                 sqlite3* db = this->connection->get();
                 perform_void_exec(db, "COMMIT");
+                this->end_transaction_internal();
+                this->settle_caches();
                 this->connection->release();
                 if (this->connection->retain_count() < 0) {
                     throw std::system_error{orm_error_code::no_active_transaction};
@@ -581,6 +800,8 @@ namespace sqlite_orm {
             void rollback() {
                 sqlite3* db = this->connection->get();
                 perform_void_exec(db, "ROLLBACK");
+                this->end_transaction_internal();
+                this->settle_caches();
                 this->connection->release();
                 if (this->connection->retain_count() < 0) {
                     throw std::system_error{orm_error_code::no_active_transaction};
@@ -600,11 +821,15 @@ namespace sqlite_orm {
             void backup_from(const std::string& filename) {
                 auto backup = this->make_backup_from(filename);
                 backup.step(-1);
+                this->clear_object_caches();
+                this->clear_result_cache();
             }
 
             void backup_from(storage_base& other) {
                 auto backup = this->make_backup_from(other);
                 backup.step(-1);
+                this->clear_object_caches();
+                this->clear_result_cache();
             }
 
             backup_t make_backup_to(const std::string& filename) {
@@ -627,16 +852,190 @@ namespace sqlite_orm {
                 return {this->get_connection(), "main", other.get_connection(), "main", {}};
             }
 
+            /**
+             *  Backs up the database to a file on a background thread, copying `options.pages_per_step` pages
+             *  at a time and pausing for `options.pause` in between, such that writers aren't stalled
+             *  for the whole duration of the backup like with `backup_to()`.
+             *  The backup opens connections of its own to the database files, such that it doesn't share
+             *  the storage's connection with the background thread, hence in-memory databases can't be
+             *  backed up this way. If the database is written meanwhile the backup starts over.
+             *
+             *  @example
+             *  ```c++
+             *  backup_options options;
+             *  options.on_progress = [](const backup_progress& progress) {
+             *      std::cout << progress.fraction() * 100 << "%" << std::endl;
+             *  };
+             *  auto runner = storage.start_backup_to("backup.sqlite", options);
+             *  //  ...
+             *  bool completed = runner.wait();
+             *  ```
+             */
+            backup_runner start_backup_to(const std::string& filename, backup_options options = {}) {
+                auto source = this->make_dedicated_connection();
+                auto destination = std::make_unique<connection_holder>(filename);
+                connection_holder& to = *destination;
+                connection_holder& from = *source;
+                backup_t backup{to, "main", from, "main", std::move(source), std::move(destination)};
+                return {std::move(backup), std::move(options)};
+            }
+
+            backup_runner start_backup_to(storage_base& other, backup_options options = {}) {
+                auto source = this->make_dedicated_connection();
+                auto destination = other.make_dedicated_connection();
+                connection_holder& to = *destination;
+                connection_holder& from = *source;
+                backup_t backup{to, "main", from, "main", std::move(source), std::move(destination)};
+                return {std::move(backup), std::move(options)};
+            }
+
+            /**
+             *  Checkpoints the write-ahead log of the `main` database by means of `sqlite3_wal_checkpoint_v2()`.
+             *  A checkpoint that couldn't complete because of other connections sets `busy` of the result
+             *  instead of throwing.
+             *
+             *  @example
+             *  ```c++
+             *  auto result = storage.wal_checkpoint(checkpoint_mode::truncate);
+             *  if (result.busy) {
+             *      //  retry later
+             *  }
+             *  ```
+             */
+            checkpoint_result wal_checkpoint(checkpoint_mode mode = checkpoint_mode::passive) {
+                auto con = this->get_connection();
+                return internal::wal_checkpoint(con.get(), mode);
+            }
+
+            /**
+             *  Starts a thread checkpointing the database through a connection of its own whenever a commit
+             *  left at least `options.wal_pages_threshold` pages in the write-ahead log.
+             *  Auto-checkpoints of the writer connection are disabled meanwhile, hence commits never
+             *  pay for a checkpoint. Replaces a background checkpointer started before.
+             *  Has no effect unless the database is in WAL mode, e.g. by `pragma.journal_mode(journal_mode::WAL)`.
+             */
+            void start_background_checkpointer(background_checkpoint_options options = {}) {
+                this->stop_background_checkpointer();
+                this->checkpointer = std::make_unique<background_checkpointer>(this->filename(),
+                                                                              this->connection->options,
+                                                                              std::move(options));
+                this->pragma.walHookInstalled = true;
+                if (this->connection->is_open()) {
+                    this->install_wal_hook(this->connection->get());
+                }
+            }
+
+            /**
+             *  Stops the background checkpointer, waiting for a running checkpoint to finish,
+             *  and restores auto-checkpoints of the writer connection as set by `pragma.wal_autocheckpoint()`.
+             */
+            void stop_background_checkpointer() {
+                if (!this->checkpointer) {
+                    return;
+                }
+                this->pragma.walHookInstalled = false;
+                if (this->connection->is_open()) {
+                    const pragma_profile& profile = this->pragma.applied_profile();
+                    const bool walAutocheckpointSet = profile.has(profile_pragma::wal_autocheckpoint);
+                    sqlite3_wal_autocheckpoint(
+                        this->connection->get(),
+                        walAutocheckpointSet ? int(profile.get(profile_pragma::wal_autocheckpoint))
+                                             : default_wal_autocheckpoint);
+                }
+                this->checkpointer.reset();
+            }
+
+            bool has_background_checkpointer() const {
+                return bool(this->checkpointer);
+            }
+
+            /**
+             *  Registers a listener of the rows inserted, updated or deleted in the table `tableName`.
+             *  The changes are collected by `sqlite3_update_hook()` while a transaction is running
+             *  and delivered all at once when it commits, or discarded when it rolls back.
+             *  Listeners are called on the thread committing from within `sqlite3_commit_hook()`,
+             *  hence they must not use the storage. Changes of WITHOUT ROWID tables aren't reported by SQLite.
+             *  The hooks are installed on the writer connection and survive reconnects.
+             *
+             *  @return An id to pass to `remove_change_listener()`.
+             */
+            size_t add_change_listener(std::string tableName,
+                                       std::function<void(const std::vector<row_change>& changes)> listener) {
+                const size_t id = this->changeNotifier.add_listener(std::move(tableName), std::move(listener));
+                if (this->connection->is_open()) {
+                    this->changeNotifier.install(this->connection->get());
+                }
+                return id;
+            }
+
+            /**
+             *  @return Whether a listener with the given id was registered.
+             */
+            bool remove_change_listener(size_t id) {
+                return this->changeNotifier.remove_listener(id);
+            }
+
+            /**
+             *  Enables caching the results of `select()` and `get_all()` by their SQL and bound values,
+             *  outside of transactions. A result is invalidated once one of the tables it was read from is written
+             *  through this storage, and the whole cache is cleared once another connection committed changes
+             *  if `result_cache_options::detect_external_changes` is set.
+             *  The tables of a query are the ones its columns and conditions refer to, queries without any
+             *  aren't cached. Queries calling non-deterministic functions like `random()`, `datetime('now')`
+             *  or user-defined functions return cached results like any other query, and so do queries
+             *  after schema changes until `clear_result_cache()` is called.
+             *  Keeps the connection open like `open_forever()` while the cache is enabled.
+             *  Must be called before the storage is used by several threads.
+             *
+             *  @example
+             *  ```c++
+             *  storage.enable_result_cache();
+             *  auto totals =
+             *      storage.select(columns(&Order::customerId, sum(&Order::amount)), group_by(&Order::customerId));
+             *  ```
+             */
+            void enable_result_cache(result_cache_options options = {}) {
+                if (!this->resultCache) {
+                    this->connection->retain();
+                }
+                this->resultCache = std::make_unique<result_cache>(options);
+                this->observe_rows();
+            }
+
+            void disable_result_cache() {
+                if (this->resultCache) {
+                    this->resultCache.reset();
+                    this->connection->release();
+                }
+            }
+
+            void clear_result_cache() {
+                if (this->resultCache) {
+                    this->resultCache->clear();
+                }
+            }
+
+            /**
+             *  @return Counters of the result cache, all zero if it isn't enabled.
+             */
+            result_cache_stats get_result_cache_stats() const {
+                return this->resultCache ? this->resultCache->stats() : result_cache_stats{};
+            }
+
             const std::string& filename() const {
                 return this->connection->filename;
             }
 
+            const open_options& get_open_options() const {
+                return this->connection->options;
+            }
+
             /**
              * Checks whether connection to database is opened right now.
              * Returns always `true` for in memory databases.
              */
             bool is_opened() const {
-                return this->connection->retain_count() > 0;
+                return this->connection->is_open();
             }
 
             /*
@@ -650,65 +1049,259 @@ namespace sqlite_orm {
 
             int busy_handler(std::function<int(int)> handler) {
                 _busy_handler = std::move(handler);
-                if (this->is_opened()) {
+                int res = SQLITE_OK;
+                this->for_each_opened_connection([this, &res](sqlite3* db) {
+                    int rc;
                     if (_busy_handler) {
-                        return sqlite3_busy_handler(this->connection->get(), busy_handler_callback, this);
+                        rc = sqlite3_busy_handler(db, busy_handler_callback, this);
                     } else {
-                        return sqlite3_busy_handler(this->connection->get(), nullptr, nullptr);
+                        rc = sqlite3_busy_handler(db, nullptr, nullptr);
                     }
-                } else {
-                    return SQLITE_OK;
-                }
+                    if (res == SQLITE_OK) {
+                        res = rc;
+                    }
+                });
+                return res;
             }
 
           protected:
-            storage_base(std::string filename, int foreignKeysCount) :
-                pragma(std::bind(&storage_base::get_connection, this)),
+            storage_base(std::string filename, int foreignKeysCount, open_options options = {}) :
+                pragma(std::bind(&storage_base::get_connection, this),
+                       std::bind(&storage_base::for_each_opened_reader, this, std::placeholders::_1)),
                 limit(std::bind(&storage_base::get_connection, this)),
                 inMemory(filename.empty() || filename == ":memory:"),
-                connection(std::make_unique<connection_holder>(std::move(filename))),
+                statementCache(default_statement_cache_capacity),
+                connection(std::make_unique<connection_holder>(
+                    std::move(filename),
+                    std::bind(&storage_base::on_open_internal, this, std::placeholders::_1),
+                    std::bind(&storage_base::on_close_internal, this, std::placeholders::_1),
+                    std::move(options))),
+                readers(std::make_unique<reader_pool>(
+                    this->connection->filename,
+                    std::bind(&storage_base::on_open_reader_internal, this, std::placeholders::_1),
+                    std::bind(&storage_base::on_close_internal, this, std::placeholders::_1),
+                    this->connection->options)),
                 cachedForeignKeysCount(foreignKeysCount) {
                 if (this->inMemory) {
                     this->connection->retain();
-                    this->on_open_internal(this->connection->get());
                 }
             }
 
             storage_base(const storage_base& other) :
-                on_open(other.on_open), pragma(std::bind(&storage_base::get_connection, this)),
+                on_open(other.on_open),
+                pragma(std::bind(&storage_base::get_connection, this),
+                       std::bind(&storage_base::for_each_opened_reader, this, std::placeholders::_1)),
                 limit(std::bind(&storage_base::get_connection, this)), inMemory(other.inMemory),
-                connection(std::make_unique<connection_holder>(other.connection->filename)),
-                cachedForeignKeysCount(other.cachedForeignKeysCount) {
+                statementCache(other.statementCache.get_capacity()),
+                connection(std::make_unique<connection_holder>(
+                    other.connection->filename,
+                    std::bind(&storage_base::on_open_internal, this, std::placeholders::_1),
+                    std::bind(&storage_base::on_close_internal, this, std::placeholders::_1),
+                    other.connection->options)),
+                readers(std::make_unique<reader_pool>(
+                    this->connection->filename,
+                    std::bind(&storage_base::on_open_reader_internal, this, std::placeholders::_1),
+                    std::bind(&storage_base::on_close_internal, this, std::placeholders::_1),
+                    this->connection->options)),
+                cachedForeignKeysCount(other.cachedForeignKeysCount), checkingFullScans(other.checkingFullScans),
+                fullScanMinTableRows(other.fullScanMinTableRows), onFullScan(other.onFullScan) {
+                this->pragma.appliedProfile = other.pragma.appliedProfile;
+#if SQLITE_VERSION_NUMBER >= 3014000
+                this->profilingStatements = other.profilingStatements;
+#endif
+                this->connection->keep_alive(other.connection->keep_alive());
+                this->readers->set_capacity(other.readers->get_capacity());
                 if (this->inMemory) {
                     this->connection->retain();
-                    this->on_open_internal(this->connection->get());
                 }
             }
 
+            /**
+             *  A connection to the database file that is independent of the storage,
+             *  e.g. to be used by another thread.
+             */
+            std::unique_ptr<connection_holder> make_dedicated_connection() const {
+                if (this->inMemory) {
+                    throw std::system_error{orm_error_code::failed_to_init_a_backup};
+                }
+                return std::make_unique<connection_holder>(this->connection->filename,
+                                                           std::function<void(sqlite3*)>{},
+                                                           std::function<void(sqlite3*)>{},
+                                                           this->connection->options);
+            }
+
             ~storage_base() {
                 if (this->isOpenedForever) {
                     this->connection->release();
                 }
+                if (this->resultCache) {
+                    this->connection->release();
+                }
                 if (this->inMemory) {
                     this->connection->release();
                 }
+                //  closes reader connections and a connection that is kept alive while the storage is still intact
+                this->readers.reset();
+                this->connection.reset();
             }
 
             void begin_transaction_internal(const std::string& query) {
                 this->connection->retain();
-                if (1 == this->connection->retain_count()) {
-                    this->on_open_internal(this->connection->get());
-                }
                 sqlite3* db = this->connection->get();
                 perform_void_exec(db, query);
+                this->transactionThread = std::this_thread::get_id();
+                this->inTransaction = true;
+            }
+
+            void end_transaction_internal() {
+                this->inTransaction = false;
+                this->transactionThread = std::thread::id{};
+            }
+
+            /**
+             *  Whether the calling thread began the running transaction, whose uncommitted changes
+             *  it must see through the writer connection.
+             */
+            bool in_own_transaction() const {
+                return this->inTransaction && this->transactionThread.load() == std::this_thread::get_id();
             }
 
             connection_ref get_connection() {
-                connection_ref res{*this->connection};
-                if (1 == this->connection->retain_count()) {
-                    this->on_open_internal(this->connection->get());
+                return {*this->connection};
+            }
+
+            /**
+             *  Connection for read-only expressions: a pooled reader connection,
+             *  unless there is no reader pool or the calling thread runs a transaction,
+             *  in which case its reads must see the transaction's changes.
+             *  Other threads keep reading the committed data from the readers meanwhile.
+             */
+            connection_ref get_reader_connection() {
+                if (this->in_own_transaction()) {
+                    return this->get_connection();
+                }
+                return this->readers->checkout(*this->connection);
+            }
+
+            /**
+             *  Calls `f` with the writer connection and every reader connection that are opened right now.
+             */
+            template<class F>
+            void for_each_opened_connection(F f) const {
+                if (this->connection->is_open()) {
+                    f(this->connection->get());
+                }
+                this->readers->for_each_opened(f);
+            }
+
+            void for_each_opened_reader(const std::function<void(sqlite3*)>& f) {
+                this->readers->for_each_opened(f);
+            }
+
+            object_cache* find_object_cache(const std::string& tableName) {
+                if (this->objectCaches.empty()) {
+                    return nullptr;
+                }
+                auto it = this->objectCaches.find(tableName);
+                return it != this->objectCaches.end() ? it->second.get() : nullptr;
+            }
+
+            void add_object_cache(const std::string& tableName, std::unique_ptr<object_cache> cache) {
+                this->objectCaches[tableName] = std::move(cache);
+                this->observe_rows();
+            }
+
+            /**
+             *  @return The result cache if it's enabled and the calling thread doesn't run a transaction,
+             *  during which its results are neither looked up nor cached.
+             */
+            result_cache* find_result_cache() {
+                if (!this->resultCache || this->in_own_transaction()) {
+                    return nullptr;
+                }
+                //  the writer connection is kept open by the result cache, hence its data version is continuous
+                if (this->resultCache->get_options().detect_external_changes && !this->inMemory) {
+                    this->resultCache->check_data_version(this->data_version());
+                }
+                return this->resultCache.get();
+            }
+
+            /**
+             *  `PRAGMA data_version` of the writer connection, by a statement kept in the statement cache
+             *  such that it isn't prepared for every lookup of the result cache.
+             */
+            sqlite3_int64 data_version() {
+                sqlite3* db = this->connection->get();
+                statement_cache::key_type key{db, &expression_type_tag<result_cache>::id, "PRAGMA data_version"};
+                statement_finalizer stmt{this->statementCache.take(key)};
+                if (!stmt) {
+                    stmt.reset(prepare_stmt(db, key.sql));
+                }
+                perform_step<SQLITE_ROW>(stmt.get());
+                const sqlite3_int64 dataVersion = sqlite3_column_int64(stmt.get(), 0);
+                this->statementCache.give_back(std::move(key), stmt.release());
+                return dataVersion;
+            }
+
+            /**
+             *  Invalidates cached results depending on a table written by the storage, for tables
+             *  the update hook doesn't report, i.e. WITHOUT ROWID tables.
+             */
+            void invalidate_results(const std::string& tableName) {
+                if (this->resultCache) {
+                    this->resultCache->table_changed(tableName.c_str());
+                }
+            }
+
+            void observe_rows() {
+                if (this->observingRows) {
+                    return;
+                }
+                this->observingRows = true;
+                this->changeNotifier.set_row_observer(
+                    std::bind(&storage_base::on_row_changed, this, std::placeholders::_1, std::placeholders::_2));
+                if (this->connection->is_open()) {
+                    this->changeNotifier.install(this->connection->get());
+                }
+            }
+
+            void clear_object_cache(const std::string& tableName) {
+                auto it = this->objectCaches.find(tableName);
+                if (it != this->objectCaches.end()) {
+                    it->second->clear();
+                }
+            }
+
+            /**
+             *  Drops all cached objects, e.g. once the whole database was replaced, which no hook reports.
+             */
+            void clear_object_caches() {
+                for (auto& entry: this->objectCaches) {
+                    entry.second->clear();
+                }
+            }
+
+            void on_row_changed(const char* tableName, sqlite3_int64 rowid) {
+                auto it = this->objectCaches.find(tableName);
+                if (it != this->objectCaches.end()) {
+                    it->second->invalidate_row(rowid);
+                }
+                if (this->resultCache) {
+                    this->resultCache->table_changed(tableName);
+                }
+            }
+
+            /**
+             *  Called once changes are committed or rolled back,
+             *  see `object_cache::settle()` and `result_cache::settle()`.
+             */
+            void settle_caches() {
+                for (auto& entry: this->objectCaches) {
+                    entry.second->settle();
+                }
+                if (this->resultCache) {
+                    this->resultCache->settle();
                 }
-                return res;
             }
 
 #if SQLITE_VERSION_NUMBER >= 3006019
@@ -732,14 +1325,28 @@ namespace sqlite_orm {
                     this->foreign_keys(db, true);
                 }
 #endif
-                if (this->pragma.synchronous_ != -1) {
-                    this->pragma.synchronous(this->pragma.synchronous_);
-                }
+                this->pragma.apply_profile_on_open(db, true);
 
                 if (this->pragma.journal_mode_ != -1) {
                     this->pragma.set_pragma("journal_mode", static_cast<journal_mode>(this->pragma.journal_mode_), db);
                 }
 
+                if (this->checkpointer) {
+                    this->install_wal_hook(db);
+                }
+
+                if (!this->changeNotifier.empty()) {
+                    this->changeNotifier.install(db);
+                }
+
+                this->on_open_reader_internal(db);
+            }
+
+            /**
+             *  Connection setup shared by the writer connection and pooled reader connections.
+             *  Pragmas changing how the database is written are left to the writer connection.
+             */
+            void on_open_reader_internal(sqlite3* db) {
                 for (auto& p: this->collatingFunctions) {
                     int rc = sqlite3_create_collation(db, p.first.c_str(), SQLITE_UTF8, &p.second, collate_callback);
                     if (rc != SQLITE_OK) {
@@ -751,10 +1358,18 @@ namespace sqlite_orm {
                     sqlite3_limit(db, p.first, p.second);
                 }
 
+                this->pragma.apply_profile_on_open(db, false);
+
                 if (_busy_handler) {
-                    sqlite3_busy_handler(this->connection->get(), busy_handler_callback, this);
+                    sqlite3_busy_handler(db, busy_handler_callback, this);
                 }
 
+#if SQLITE_VERSION_NUMBER >= 3014000
+                if (this->profilingStatements) {
+                    this->install_statement_profiler(db);
+                }
+#endif
+
                 for (auto& udfProxy: this->scalarFunctions) {
                     try_to_create_scalar_function(db, udfProxy);
                 }
@@ -768,6 +1383,64 @@ namespace sqlite_orm {
                 }
             }
 
+            /**
+             *  Replaces the auto-checkpoints of the writer connection by notifications of the background checkpointer.
+             */
+            void install_wal_hook(sqlite3* db) {
+                sqlite3_wal_hook(db, background_checkpointer::wal_hook_callback, this->checkpointer.get());
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+            void install_statement_profiler(sqlite3* db) {
+                if (this->profilingStatements) {
+                    sqlite3_trace_v2(db,
+                                     SQLITE_TRACE_PROFILE | SQLITE_TRACE_ROW,
+                                     statement_profiler::trace_callback,
+                                     &this->statementProfiler);
+                } else {
+                    sqlite3_trace_v2(db, 0, nullptr, nullptr);
+                }
+            }
+#endif
+
+            /**
+             *  Checks the query plan of `sql` if `check_full_scans()` is enabled.
+             */
+            void check_query_plan(sqlite3* db, const std::string& sql) const {
+                if (!this->checkingFullScans) {
+                    return;
+                }
+                for (const query_plan_node& node: query_plan_of(db, sql)) {
+                    if (!node.is_scan() || node.table.empty() || node.virtual_table) {
+                        continue;
+                    }
+                    const sqlite3_int64 rowsCount = table_rows_count(db, node.table);
+                    if (rowsCount < 0 || size_t(rowsCount) < this->fullScanMinTableRows) {
+                        continue;
+                    }
+                    if (this->onFullScan) {
+                        this->onFullScan(sql, node);
+                    } else {
+                        throw std::system_error{orm_error_code::full_table_scan, node.detail + " in " + sql};
+                    }
+                }
+            }
+
+            /**
+             *  A schema change expires the statements prepared by every connection, not only by the one
+             *  that made it, so the cached statements of pooled readers are finalized as well.
+             */
+            void clear_statement_caches_for_schema_change() {
+                this->for_each_opened_connection([this](sqlite3* db) {
+                    this->statementCache.clear(db);
+                });
+            }
+
+            void on_close_internal(sqlite3* db) {
+                //  cached statements must be finalized, otherwise the connection can't be closed
+                this->statementCache.clear(db);
+            }
+
             template<class F>
             void create_scalar_function_impl(udf_holder<F> udfName, std::function<void(void* location)> constructAt) {
                 using args_tuple = typename callable_arguments<F>::args_tuple;
@@ -795,10 +1468,9 @@ namespace sqlite_orm {
                     },
                     udfMemorySpace);
 
-                if (this->connection->retain_count() > 0) {
-                    sqlite3* db = this->connection->get();
+                this->for_each_opened_connection([this](sqlite3* db) {
                     try_to_create_scalar_function(db, this->scalarFunctions.back());
-                }
+                });
             }
 
             template<class F>
@@ -843,10 +1515,9 @@ namespace sqlite_orm {
                     },
                     obtain_udf_allocator<F>());
 
-                if (this->connection->retain_count() > 0) {
-                    sqlite3* db = this->connection->get();
+                this->for_each_opened_connection([this](sqlite3* db) {
                     try_to_create_aggregate_function(db, this->aggregateFunctions.back());
-                }
+                });
             }
 
             void delete_function_impl(const std::string& name, std::list<udf_proxy>& functions) const {
@@ -858,8 +1529,7 @@ namespace sqlite_orm {
                 });
 #endif
                 if (it != functions.end()) {
-                    if (this->connection->retain_count() > 0) {
-                        sqlite3* db = this->connection->get();
+                    this->for_each_opened_connection([&name, it](sqlite3* db) {
                         int rc = sqlite3_create_function_v2(db,
                                                             name.c_str(),
                                                             it->argumentsCount,
@@ -872,7 +1542,7 @@ namespace sqlite_orm {
                         if (rc != SQLITE_OK) {
                             throw_translated_sqlite_error(db);
                         }
-                    }
+                    });
                     it = functions.erase(it);
                 } else {
                     throw std::system_error{orm_error_code::function_not_found};
@@ -927,6 +1597,7 @@ namespace sqlite_orm {
             }
 
             void drop_table_internal(sqlite3* db, const std::string& tableName, bool ifExists) {
+                this->clear_statement_caches_for_schema_change();
                 std::stringstream ss;
                 ss << "DROP TABLE";
                 if (ifExists) {
@@ -1017,12 +1688,31 @@ namespace sqlite_orm {
 
             const bool inMemory;
             bool isOpenedForever = false;
+            //  declared before the connection such that it outlives it
+            statement_cache statementCache;
             std::unique_ptr<connection_holder> connection;
+            std::unique_ptr<reader_pool> readers;
+            std::atomic_bool inTransaction{false};
+            std::atomic<std::thread::id> transactionThread;
             std::map<std::string, collating_function> collatingFunctions;
             const int cachedForeignKeysCount;
             std::function<int(int)> _busy_handler;
             std::list<udf_proxy> scalarFunctions;
             std::list<udf_proxy> aggregateFunctions;
+            bool checkingFullScans = false;
+            size_t fullScanMinTableRows = 0;
+            std::function<void(const std::string&, const query_plan_node&)> onFullScan;
+            //  SQLite's default number of WAL pages triggering an auto-checkpoint
+            static constexpr int default_wal_autocheckpoint = 1000;
+            std::unique_ptr<background_checkpointer> checkpointer;
+            change_notifier changeNotifier;
+            std::map<std::string, std::unique_ptr<object_cache>, std::less<>> objectCaches;
+            bool observingRows = false;
+            std::unique_ptr<result_cache> resultCache;
+#if SQLITE_VERSION_NUMBER >= 3014000
+            bool profilingStatements = false;
+            statement_profiler statementProfiler;
+#endif
         };
     }
 }
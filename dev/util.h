@@ -92,7 +92,7 @@ namespace sqlite_orm {
         void perform_step(sqlite3_stmt* stmt) {
             int rc = sqlite3_step(stmt);
             if (rc != expected) {
-                throw_translated_sqlite_error(stmt);
+                throw_translated_sqlite_error(stmt, rc);
             }
         }
 
@@ -105,7 +105,7 @@ namespace sqlite_orm {
                 case SQLITE_DONE:
                     break;
                 default: {
-                    throw_translated_sqlite_error(stmt);
+                    throw_translated_sqlite_error(stmt, rc);
                 }
             }
         }
@@ -121,7 +121,7 @@ namespace sqlite_orm {
                     case SQLITE_DONE:
                         break;
                     default: {
-                        throw_translated_sqlite_error(stmt);
+                        throw_translated_sqlite_error(stmt, rc);
                     }
                 }
             } while (rc != SQLITE_DONE);
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <sqlite3.h>
+#include <string>  //  std::string
+#include <utility>  //  std::move
+#include <thread>  //  std::thread
+#include <mutex>  //  std::mutex, std::unique_lock, std::lock_guard
+#include <condition_variable>  //  std::condition_variable
+#include <functional>  //  std::function
+#include <chrono>  //  std::chrono::milliseconds
+#include <system_error>  //  std::system_error
+
+#include "error_code.h"
+#include "connection_holder.h"
+#include "util.h"
+
+namespace sqlite_orm {
+
+    /**
+     *  Checkpoint modes of `sqlite3_wal_checkpoint_v2()`, see https://sqlite.org/c3ref/wal_checkpoint_v2.html.
+     */
+    enum class checkpoint_mode {
+        /**
+         *  Checkpoints as many frames as possible without waiting for readers or writers.
+         */
+        passive = SQLITE_CHECKPOINT_PASSIVE,
+        /**
+         *  Waits for writers, then checkpoints all frames, waiting for readers of older frames.
+         */
+        full = SQLITE_CHECKPOINT_FULL,
+        /**
+         *  Like `full`, and waits for all readers such that the next writer starts over at the beginning of the WAL.
+         */
+        restart = SQLITE_CHECKPOINT_RESTART,
+        /**
+         *  Like `restart`, and truncates the WAL file to zero bytes.
+         */
+        truncate = SQLITE_CHECKPOINT_TRUNCATE,
+    };
+
+    struct checkpoint_result {
+        /**
+         *  Number of frames in the WAL, -1 if the database isn't in WAL mode.
+         */
+        int log_frames = -1;
+        /**
+         *  Number of frames of the WAL checkpointed into the database, -1 if the database isn't in WAL mode.
+         */
+        int checkpointed_frames = -1;
+        /**
+         *  Whether the checkpoint couldn't complete because of readers or writers
+         *  still busy after the busy handler gave up. Never set for `checkpoint_mode::passive`.
+         */
+        bool busy = false;
+    };
+
+    struct background_checkpoint_options {
+        /**
+         *  A checkpoint runs after a commit left at least this many pages in the WAL.
+         */
+        int wal_pages_threshold = 1000;
+        /**
+         *  Modes other than `checkpoint_mode::passive` lock out writers while the checkpoint runs,
+         *  hence writers should have a busy timeout then.
+         */
+        checkpoint_mode mode = checkpoint_mode::passive;
+        /**
+         *  Busy timeout of the checkpointer's connection, used by all modes but `checkpoint_mode::passive`.
+         */
+        std::chrono::milliseconds busy_timeout{1000};
+        /**
+         *  Called on the background thread after every checkpoint.
+         */
+        std::function<void(const checkpoint_result&)> on_checkpoint;
+        /**
+         *  Called on the background thread if a checkpoint fails.
+         */
+        std::function<void(const std::system_error&)> on_error;
+    };
+
+    namespace internal {
+
+        inline checkpoint_result wal_checkpoint(sqlite3* db, checkpoint_mode mode, const char* schema = "main") {
+            checkpoint_result result;
+            const int rc =
+                sqlite3_wal_checkpoint_v2(db, schema, int(mode), &result.log_frames, &result.checkpointed_frames);
+            if (rc == SQLITE_BUSY) {
+                result.busy = true;
+            } else if (rc != SQLITE_OK) {
+                throw_translated_sqlite_error(db);
+            }
+            return result;
+        }
+
+        /**
+         *  Checkpoints a database on a background thread through a connection of its own,
+         *  whenever `notify()` reports the WAL of the database grew beyond a threshold.
+         *  `wal_hook_callback` is meant to be installed as the `sqlite3_wal_hook()` of the writer connection,
+         *  which also disables auto-checkpoints of the writer such that commits never checkpoint.
+         *  Destroying the checkpointer waits for a running checkpoint to finish.
+         */
+        class background_checkpointer {
+          public:
+            background_checkpointer(const std::string& filename,
+                                    const open_options& openOptions,
+                                    background_checkpoint_options options) :
+                holder{filename, {}, {}, openOptions}, options{std::move(options)} {
+                this->holder.retain();
+                sqlite3_busy_timeout(this->holder.get(), int(this->options.busy_timeout.count()));
+                this->worker = std::thread{&background_checkpointer::run, this};
+            }
+
+            background_checkpointer(const background_checkpointer&) = delete;
+            background_checkpointer& operator=(const background_checkpointer&) = delete;
+
+            ~background_checkpointer() {
+                {
+                    std::lock_guard<std::mutex> lock{this->mutex};
+                    this->stopping = true;
+                }
+                this->changed.notify_one();
+                this->worker.join();
+                //  a connection failing to close now is closed by the holder's destructor, ignoring errors
+                try {
+                    this->holder.release();
+                } catch (...) {
+                }
+            }
+
+            /**
+             *  Reports the number of pages in the WAL after a commit.
+             */
+            void notify(int walPages) {
+                if (walPages < this->options.wal_pages_threshold) {
+                    return;
+                }
+                {
+                    std::lock_guard<std::mutex> lock{this->mutex};
+                    this->pending = true;
+                }
+                this->changed.notify_one();
+            }
+
+            static int wal_hook_callback(void* data, sqlite3*, const char*, int walPages) {
+                static_cast<background_checkpointer*>(data)->notify(walPages);
+                return SQLITE_OK;
+            }
+
+          private:
+            void run() {
+                std::unique_lock<std::mutex> lock{this->mutex};
+                for (;;) {
+                    this->changed.wait(lock, [this] {
+                        return this->pending || this->stopping;
+                    });
+                    if (this->stopping) {
+                        return;
+                    }
+                    this->pending = false;
+                    lock.unlock();
+                    try {
+                        //  reading the schema makes the connection notice the database is in WAL mode,
+                        //  otherwise there is no WAL to checkpoint as far as the connection is concerned
+                        perform_void_exec(this->holder.get(), "PRAGMA schema_version");
+                        auto result = internal::wal_checkpoint(this->holder.get(), this->options.mode);
+                        call_back(this->options.on_checkpoint, result);
+                    } catch (const std::system_error& e) {
+                        call_back(this->options.on_error, e);
+                    }
+                    lock.lock();
+                }
+            }
+
+            //  an exception escaping the background thread would terminate the program
+            template<class F, class Arg>
+            static void call_back(const F& callback, const Arg& arg) {
+                if (!callback) {
+                    return;
+                }
+                try {
+                    callback(arg);
+                } catch (...) {
+                }
+            }
+
+            connection_holder holder;
+            background_checkpoint_options options;
+            std::mutex mutex;
+            std::condition_variable changed;
+            bool pending = false;
+            bool stopping = false;
+            std::thread worker;
+        };
+    }
+}
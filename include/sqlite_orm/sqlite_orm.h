@@ -287,10 +287,13 @@ namespace sqlite_orm {
 #include <sstream>  //  std::stringstream
 #include <iomanip>  //  std::flush
 #include <map>  //  std::map
+#include <set>  //  std::set
 #include <vector>  //  std::vector
 #include <tuple>  //  std::tuple_size, std::tuple, std::make_tuple, std::tie
 #include <utility>  //  std::forward, std::pair
-#include <algorithm>  //  std::for_each, std::ranges::for_each
+#include <algorithm>  //  std::for_each, std::ranges::for_each, std::max, std::stable_sort, std::any_of
+#include <iterator>  //  std::distance, std::next, std::begin, std::end
+#include <chrono>  //  std::chrono::steady_clock
 // #include "functional/cxx_optional.h"
 
 // #include "cxx_core_features.h"
@@ -2858,6 +2861,12 @@ namespace sqlite_orm {
         index_is_out_of_bounds,
         value_is_null,
         no_tables_specified,
+        full_table_scan,
+        deadline_exceeded,
+        query_cancelled,
+        value_is_not_finite,
+        reader_pool_is_enabled,
+        connection_is_not_kept_open,
     };
 }
 
@@ -2917,6 +2926,18 @@ namespace sqlite_orm {
                     return "Value is null";
                 case orm_error_code::no_tables_specified:
                     return "No tables specified";
+                case orm_error_code::full_table_scan:
+                    return "Query plan contains a full table scan";
+                case orm_error_code::deadline_exceeded:
+                    return "Deadline exceeded";
+                case orm_error_code::query_cancelled:
+                    return "Query cancelled";
+                case orm_error_code::value_is_not_finite:
+                    return "Value is not finite";
+                case orm_error_code::reader_pool_is_enabled:
+                    return "Reader pool is enabled";
+                case orm_error_code::connection_is_not_kept_open:
+                    return "Connection is not kept open";
                 default:
                     return "unknown error";
             }
@@ -2985,6 +3006,14 @@ namespace sqlite_orm {
     [[noreturn]] inline void throw_translated_sqlite_error(sqlite3_stmt* stmt) {
         throw sqlite_to_system_error(sqlite3_db_handle(stmt));
     }
+
+    /**
+     *  Translates the result code of a step rather than the connection's last error code,
+     *  which another thread sharing the connection may have overwritten in the meantime.
+     */
+    [[noreturn]] inline void throw_translated_sqlite_error(sqlite3_stmt* stmt, int rc) {
+        throw std::system_error{sqlite_errc(rc), sqlite3_errmsg(sqlite3_db_handle(stmt))};
+    }
 }
 
 // #include "type_printer.h"
@@ -9967,6 +9996,228 @@ namespace sqlite_orm {
 }
 #endif
 
+// #include "array_values.h"
+
+#include <sqlite3.h>
+#include <type_traits>  //  std::is_arithmetic, std::is_same, std::is_floating_point
+#include <string>  //  std::string, std::to_string
+#include <vector>  //  std::vector
+#include <initializer_list>  //  std::initializer_list
+#include <sstream>  //  std::stringstream
+#include <iomanip>  //  std::setprecision
+#include <limits>  //  std::numeric_limits
+#include <utility>  //  std::move, std::exchange
+#include <tuple>  //  std::tuple
+#include <cmath>  //  std::isfinite
+#include <system_error>  //  std::system_error
+
+// #include "functional/cxx_core_features.h"
+
+// #include "tuple_helper/tuple_iteration.h"
+
+// #include "error_code.h"
+
+//  defining `SQLITE_ORM_ENABLE_CARRAY` promises that the carray extension is registered on every connection,
+//  e.g. by `sqlite3_auto_extension()`, and its pointer-passing interface is available (see carray.h)
+#if defined(SQLITE_ORM_ENABLE_CARRAY) && SQLITE_VERSION_NUMBER >= 3020000 &&                                           \
+    defined(SQLITE_ORM_INLINE_VARIABLES_SUPPORTED)
+#define SQLITE_ORM_CARRAY_IN_SUPPORTED
+#endif
+
+//  `as_array()` needs either the carray or the JSON1 extension
+#if defined(SQLITE_ORM_CARRAY_IN_SUPPORTED) || defined(SQLITE_ENABLE_JSON1)
+#define SQLITE_ORM_AS_ARRAY_SUPPORTED
+#endif
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+#ifdef SQLITE_ORM_CARRAY_IN_SUPPORTED
+        /**
+         *  The element type of the C array passed to `carray()` for array values of type E,
+         *  and the name of that type as carray's third argument.
+         */
+        template<class E, class SFINAE = void>
+        struct carray_element;
+
+        template<class E>
+        struct carray_element<E, std::enable_if_t<std::is_integral<E>::value>> {
+            using type = sqlite3_int64;
+
+            static constexpr const char* name() {
+                return "int64";
+            }
+
+            static type get(E value) {
+                return value;
+            }
+        };
+
+        template<class E>
+        struct carray_element<E, std::enable_if_t<std::is_floating_point<E>::value>> {
+            using type = double;
+
+            static constexpr const char* name() {
+                return "double";
+            }
+
+            static type get(E value) {
+                return value;
+            }
+        };
+
+        template<>
+        struct carray_element<std::string, void> {
+            using type = const char*;
+
+            static constexpr const char* name() {
+                return "char*";
+            }
+
+            static type get(const std::string& value) {
+                return value.c_str();
+            }
+        };
+#endif
+
+        /**
+         *  Values of an IN list bound as one array,
+         *  such that the statement's text doesn't depend on the number of values.
+         *
+         *  The values are bound as a C array and its length for `carray(?, ?, '<type>')`
+         *  if `SQLITE_ORM_ENABLE_CARRAY` is defined, otherwise as a JSON array text for `json_each(?)`,
+         *  which needs `SQLITE_ENABLE_JSON1`.
+         */
+        template<class E>
+        struct array_values_t {
+            static_assert(std::is_arithmetic<E>::value || std::is_same<E, std::string>::value,
+                          "Array values must be arithmetic or std::string");
+
+            using value_type = E;
+
+            std::vector<E> values;
+
+#ifdef SQLITE_ORM_CARRAY_IN_SUPPORTED
+            /**
+             *  Fills and returns the C array passed to `carray()`.
+             *  It is kept here because carray reads it while the statement is executed.
+             */
+            std::vector<typename carray_element<E>::type>& carray_values() const {
+                this->carrayValues.clear();
+                this->carrayValues.reserve(this->values.size());
+                for (auto& value: this->values) {
+                    this->carrayValues.push_back(carray_element<E>::get(value));
+                }
+                return this->carrayValues;
+            }
+
+            mutable std::vector<typename carray_element<E>::type> carrayValues;
+#endif
+        };
+
+        inline void write_json_value(std::stringstream& ss, const std::string& value) {
+            ss << '"';
+            for (unsigned char c: value) {
+                switch (c) {
+                    case '"':
+                        ss << "\\\"";
+                        break;
+                    case '\\':
+                        ss << "\\\\";
+                        break;
+                    default:
+                        if (c < 0x20) {
+                            static constexpr char hexDigits[] = "0123456789abcdef";
+                            ss << "\\u00" << hexDigits[c >> 4] << hexDigits[c & 0xF];
+                        } else {
+                            ss << char(c);
+                        }
+                }
+            }
+            ss << '"';
+        }
+
+        /**
+         *  JSON has no representation for NaN and infinity.
+         */
+        template<class E, std::enable_if_t<std::is_floating_point<E>::value, bool> = true>
+        void write_json_value(std::stringstream& ss, E value) {
+            if (!std::isfinite(value)) {
+                throw std::system_error{orm_error_code::value_is_not_finite};
+            }
+            ss << std::setprecision(std::numeric_limits<E>::max_digits10) << value;
+        }
+
+        template<class E, std::enable_if_t<!std::is_floating_point<E>::value, bool> = true>
+        void write_json_value(std::stringstream& ss, E value) {
+            ss << std::to_string(value);
+        }
+
+        /**
+         *  A tuple is written as a nested array, e.g. the values of a composite primary key.
+         */
+        template<class... Args>
+        void write_json_value(std::stringstream& ss, const std::tuple<Args...>& value) {
+            ss << '[';
+            iterate_tuple(value, [&ss, first = true](auto& element) mutable {
+                if (!std::exchange(first, false)) {
+                    ss << ',';
+                }
+                write_json_value(ss, element);
+            });
+            ss << ']';
+        }
+
+        /**
+         *  Serializes array values as a JSON array, e.g. `[1,2,3]`.
+         */
+        template<class E>
+        std::string serialize_json_array(const std::vector<E>& values) {
+            std::stringstream ss;
+            ss << '[';
+            for (size_t i = 0; i < values.size(); ++i) {
+                if (i > 0) {
+                    ss << ',';
+                }
+                write_json_value(ss, values[i]);
+            }
+            ss << ']';
+            return ss.str();
+        }
+    }
+
+#ifdef SQLITE_ORM_AS_ARRAY_SUPPORTED
+    /**
+     *  Wraps the values of an IN list such that they are bound as one array parameter.
+     *  Unlike `in(&User::id, std::vector<int>{...})`, which binds every value separately,
+     *  the statement's text is the same for any number of values, hence it can be reused and
+     *  is not subject to the limit on the number of bound variables.
+     *  Without the carray extension floating point values must be finite.
+     *
+     *  @example
+     *  ```c++
+     *  //  SELECT ... FROM users WHERE id IN (SELECT value FROM json_each(?))
+     *  //  or with the carray extension: SELECT ... FROM users WHERE id IN carray(?, ?, 'int64')
+     *  auto users = storage.get_all<User>(where(in(&User::id, as_array(ids))));
+     *  ```
+     */
+    template<class E>
+    internal::array_values_t<E> as_array(std::vector<E> values) {
+        return {std::move(values)};
+    }
+
+    template<class E>
+    internal::array_values_t<E> as_array(std::initializer_list<E> values) {
+        return {values};
+    }
+
+    inline internal::array_values_t<std::string> as_array(std::initializer_list<const char*> values) {
+        return {std::vector<std::string>(values.begin(), values.end())};
+    }
+#endif
+}
+
 namespace sqlite_orm {
 
     /**
@@ -10209,6 +10460,21 @@ namespace sqlite_orm {
         }
     };
 
+#if !defined(SQLITE_ORM_CARRAY_IN_SUPPORTED) && defined(SQLITE_ENABLE_JSON1)
+    /**
+     *  Specialization for the values of an IN list bound as one array (`as_array()`),
+     *  bound as a JSON array text.
+     *  With the carray extension they are bound as a C array instead, see carray.h.
+     */
+    template<class E>
+    struct statement_binder<internal::array_values_t<E>, void> {
+        int bind(sqlite3_stmt* stmt, int index, const internal::array_values_t<E>& value) const {
+            std::string json = internal::serialize_json_array(value.values);
+            return sqlite3_bind_text(stmt, index, json.c_str(), int(json.size()), SQLITE_TRANSIENT);
+        }
+    };
+#endif
+
 #ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
     template<class V>
     struct statement_binder<V,
@@ -10228,6 +10494,12 @@ namespace sqlite_orm {
 
     namespace internal {
 
+        /**
+         *  The number of statement parameters a bindable value occupies.
+         */
+        template<class T>
+        SQLITE_ORM_INLINE_VAR constexpr int bound_parameters_count_v = 1;
+
         struct conditional_binder {
             sqlite3_stmt* stmt = nullptr;
             int index = 1;
@@ -10236,10 +10508,11 @@ namespace sqlite_orm {
 
             template<class T, satisfies<is_bindable, T> = true>
             void operator()(const T& t) {
-                int rc = statement_binder<T>{}.bind(this->stmt, this->index++, t);
+                int rc = statement_binder<T>{}.bind(this->stmt, this->index, t);
                 if (SQLITE_OK != rc) {
                     throw_translated_sqlite_error(this->stmt);
                 }
+                this->index += bound_parameters_count_v<T>;
             }
 
             template<class T, satisfies_not<is_bindable, T> = true>
@@ -13351,6 +13624,9 @@ namespace sqlite_orm {
 #include <iterator>  //  std::input_iterator_tag
 #include <system_error>  //  std::system_error
 #include <functional>  //  std::bind
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <type_traits>  //  std::is_member_object_pointer
 
 // #include "statement_finalizer.h"
 
@@ -13369,6 +13645,14 @@ namespace sqlite_orm {
 
 // #include "error_code.h"
 
+// #include "functional/static_magic.h"
+
+// #include "member_traits/member_traits.h"
+
+// #include "row_extractor.h"
+
+// #include "schema/column.h"
+
 // #include "object_from_column_builder.h"
 
 #include <sqlite3.h>
@@ -13554,7 +13838,7 @@ namespace sqlite_orm {
         void perform_step(sqlite3_stmt* stmt) {
             int rc = sqlite3_step(stmt);
             if (rc != expected) {
-                throw_translated_sqlite_error(stmt);
+                throw_translated_sqlite_error(stmt, rc);
             }
         }
 
@@ -13567,7 +13851,7 @@ namespace sqlite_orm {
                 case SQLITE_DONE:
                     break;
                 default: {
-                    throw_translated_sqlite_error(stmt);
+                    throw_translated_sqlite_error(stmt, rc);
                 }
             }
         }
@@ -13583,7 +13867,7 @@ namespace sqlite_orm {
                     case SQLITE_DONE:
                         break;
                     default: {
-                        throw_translated_sqlite_error(stmt);
+                        throw_translated_sqlite_error(stmt, rc);
                     }
                 }
             } while (rc != SQLITE_DONE);
@@ -13690,6 +13974,149 @@ namespace sqlite_orm {
             friend bool operator!=(const mapped_iterator& lhs, const mapped_iterator& rhs) {
                 return !(lhs == rhs);
             }
+#endif
+        };
+
+        template<class T>
+        void assign_in_place(T& target, sqlite3_stmt* stmt, int columnIndex) {
+            const auto rowExtractor = row_value_extractor<T>();
+            target = rowExtractor.extract(stmt, columnIndex);
+        }
+
+        inline void assign_in_place(std::string& target, sqlite3_stmt* stmt, int columnIndex) {
+            if (auto cStr = (const char*)sqlite3_column_text(stmt, columnIndex)) {
+                target.assign(cStr);
+            } else {
+                target.clear();
+            }
+        }
+
+        inline void assign_in_place(std::vector<char>& target, sqlite3_stmt* stmt, int columnIndex) {
+            auto bytes = static_cast<const char*>(sqlite3_column_blob(stmt, columnIndex));
+            auto len = static_cast<size_t>(sqlite3_column_bytes(stmt, columnIndex));
+            target.assign(bytes, bytes + len);
+        }
+
+        /**
+         *  Like `object_from_column_builder`, but assigns text and BLOB fields in place,
+         *  such that an object read into repeatedly reuses their capacity.
+         */
+        template<class O>
+        struct in_place_object_builder : object_from_column_builder_base {
+            using object_type = O;
+
+            object_type& object;
+
+            in_place_object_builder(object_type& object_, sqlite3_stmt* stmt_) :
+                object_from_column_builder_base{stmt_, -1}, object(object_) {}
+
+            template<class G, class S>
+            void operator()(const column_field<G, S>& column) {
+                ++this->columnIndex;
+                static_if<std::is_member_object_pointer<G>::value>(
+                    [this](const auto& column) {
+                        assign_in_place(this->object.*column.member_pointer, this->stmt, this->columnIndex);
+                    },
+                    [this](const auto& column) {
+                        const auto rowExtractor = row_value_extractor<member_field_type_t<G>>();
+                        (this->object.*column.setter)(rowExtractor.extract(this->stmt, this->columnIndex));
+                    })(column);
+            }
+        };
+
+        /*
+         *  Input iterator over a result set for a mapped object, reading every row into the same object.
+         *
+         *  Stepping through the result set doesn't allocate, but the object is overwritten by each increment.
+         *  Copies are explicit and share the position of the copied iterator.
+         */
+        template<class O, class DBOs>
+        class in_place_mapped_iterator {
+          public:
+            using db_objects_type = DBOs;
+
+            using iterator_category = std::input_iterator_tag;
+            using difference_type = ptrdiff_t;
+            using value_type = O;
+            using reference = O&;
+            using pointer = O*;
+
+          private:
+            struct cursor {
+                statement_finalizer stmt;
+                value_type current;
+            };
+
+            /**
+                pointer to the db objects.
+                only null for the default constructed iterator.
+             */
+            const db_objects_type* db_objects = nullptr;
+
+            /**
+             *  Null when the iterator reached the end.
+             */
+            std::shared_ptr<cursor> state;
+
+            void extract_object() {
+                in_place_object_builder<value_type> builder{this->state->current, this->state->stmt.get()};
+                auto& table = pick_table<value_type>(*this->db_objects);
+                table.for_each_column(builder);
+            }
+
+            void step() {
+                bool hasRow = false;
+                perform_step(this->state->stmt.get(), [this, &hasRow](sqlite3_stmt*) {
+                    this->extract_object();
+                    hasRow = true;
+                });
+                if (!hasRow) {
+                    this->state.reset();
+                }
+            }
+
+          public:
+            in_place_mapped_iterator() = default;
+
+            in_place_mapped_iterator(const db_objects_type& dbObjects, statement_finalizer stmt) :
+                db_objects{&dbObjects}, state{std::make_shared<cursor>()} {
+                this->state->stmt = std::move(stmt);
+                this->step();
+            }
+
+            explicit in_place_mapped_iterator(const in_place_mapped_iterator&) = default;
+            in_place_mapped_iterator& operator=(const in_place_mapped_iterator&) = delete;
+            in_place_mapped_iterator(in_place_mapped_iterator&&) = default;
+            in_place_mapped_iterator& operator=(in_place_mapped_iterator&&) = default;
+
+            value_type& operator*() const {
+                if (!this->state) SQLITE_ORM_CPP_UNLIKELY {
+                    throw std::system_error{orm_error_code::trying_to_dereference_null_iterator};
+                }
+                return this->state->current;
+            }
+
+            value_type* operator->() const {
+                return &(this->operator*());
+            }
+
+            in_place_mapped_iterator& operator++() {
+                this->step();
+                return *this;
+            }
+
+            void operator++(int) {
+                ++*this;
+            }
+
+            friend bool operator==(const in_place_mapped_iterator& lhs, const in_place_mapped_iterator& rhs) {
+                return lhs.state == rhs.state;
+            }
+
+#ifndef SQLITE_ORM_DEFAULT_COMPARISONS_SUPPORTED
+            friend bool operator!=(const in_place_mapped_iterator& lhs, const in_place_mapped_iterator& rhs) {
+                return !(lhs == rhs);
+            }
 #endif
         };
     }
@@ -13723,6 +14150,7 @@ namespace sqlite_orm {
 #include <type_traits>  //  std::integral_constant, std::declval
 #include <utility>  //  std::move, std::forward, std::pair
 #include <tuple>  //  std::tuple
+#include <vector>  //  std::vector
 
 // #include "functional/cxx_type_traits_polyfill.h"
 
@@ -13735,33 +14163,263 @@ namespace sqlite_orm {
 #include <sqlite3.h>
 #include <atomic>
 #include <string>  //  std::string
+#include <functional>  //  std::function
+#include <mutex>  //  std::mutex, std::lock_guard, std::unique_lock
+#include <condition_variable>  //  std::condition_variable
+#include <thread>  //  std::thread
+#include <chrono>  //  std::chrono::milliseconds, std::chrono::steady_clock
+#include <utility>  //  std::exchange
+#include <algorithm>  //  std::max
 
 // #include "error_code.h"
 
-namespace sqlite_orm {
-
-    namespace internal {
-
-        struct connection_holder {
+// #include "open_options.h"
 
-            connection_holder(std::string filename_) : filename(std::move(filename_)) {}
+#include <sqlite3.h>
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <utility>  //  std::pair
 
-            void retain() {
-                if (1 == ++this->_retain_count) {
-                    auto rc = sqlite3_open(this->filename.c_str(), &this->db);
-                    if (rc != SQLITE_OK) {
-                        throw_translated_sqlite_error(db);
-                    }
-                }
-            }
+namespace sqlite_orm {
 
-            void release() {
-                if (0 == --this->_retain_count) {
-                    auto rc = sqlite3_close(this->db);
-                    if (rc != SQLITE_OK) {
-                        throw_translated_sqlite_error(db);
+    /**
+     *  How the storage opens its database connections, passed to `make_storage`.
+     *  The options are honored every time a connection is (re)opened.
+     *
+     *  @example
+     *  ```c++
+     *  open_options options;
+     *  options.flags = SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX;
+     *  options.uri_parameters = {{"immutable", "1"}};
+     *  auto storage = make_storage("archive.sqlite", options, make_table(...));
+     *  ```
+     */
+    struct open_options {
+        /**
+         *  Flags passed to `sqlite3_open_v2()`, e.g. `SQLITE_OPEN_READONLY`, or `SQLITE_OPEN_NOMUTEX` for
+         *  connections confined to one thread at a time.
+         *  Pooled reader connections are always opened with `SQLITE_OPEN_READONLY` and without
+         *  `SQLITE_OPEN_NOMUTEX`, because an exhausted pool shares readers between threads.
+         */
+        int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+        /**
+         *  Name of the VFS to use, the default VFS if empty.
+         */
+        std::string vfs;
+        /**
+         *  Query parameters of a URI filename, e.g. `{"immutable", "1"}` or `{"cache", "shared"}`.
+         *  If there are any the filename is opened as a `file:` URI with `SQLITE_OPEN_URI`.
+         */
+        std::vector<std::pair<std::string, std::string>> uri_parameters;
+        /**
+         *  Size of a lookaside memory slot in bytes and number of slots of every connection,
+         *  set by `SQLITE_DBCONFIG_LOOKASIDE`. SQLite's defaults are kept if either is 0.
+         */
+        int lookaside_slot_size = 0;
+        int lookaside_slot_count = 0;
+    };
+
+    namespace internal {
+
+        inline void append_uri_encoded(std::string& uri, const std::string& text, const char* reserved) {
+            static constexpr const char hexDigits[] = "0123456789ABCDEF";
+            for (const char c: text) {
+                bool escape = c == '%' || c == '#' || c == '?';
+                for (const char* r = reserved; *r && !escape; ++r) {
+                    escape = c == *r;
+                }
+                if (escape) {
+                    uri += '%';
+                    uri += hexDigits[(unsigned char)c >> 4];
+                    uri += hexDigits[(unsigned char)c & 0xF];
+                } else {
+                    uri += c;
+                }
+            }
+        }
+
+        /**
+         *  The filename passed to `sqlite3_open_v2()`: `filename` as is, or a `file:` URI
+         *  carrying the URI parameters of `options`, see https://sqlite.org/uri.html.
+         */
+        inline std::string make_open_filename(const std::string& filename, const open_options& options) {
+            if (options.uri_parameters.empty()) {
+                return filename;
+            }
+            std::string uri = "file:";
+            append_uri_encoded(uri, filename, "");
+            char separator = '?';
+            for (auto& parameter: options.uri_parameters) {
+                uri += separator;
+                append_uri_encoded(uri, parameter.first, "&=");
+                uri += '=';
+                append_uri_encoded(uri, parameter.second, "&=");
+                separator = '&';
+            }
+            return uri;
+        }
+
+        inline int make_open_flags(const open_options& options) {
+            return options.uri_parameters.empty() ? options.flags : options.flags | SQLITE_OPEN_URI;
+        }
+
+        /**
+         *  Options of pooled reader connections derived from the options of the storage.
+         */
+        inline open_options make_reader_open_options(open_options options) {
+            options.flags &= ~(SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX);
+            options.flags |= SQLITE_OPEN_READONLY;
+            return options;
+        }
+    }
+}
+
+namespace sqlite_orm {
+
+    /**
+     *  Counters of a storage's database connection.
+     */
+    struct connection_stats {
+        //  how many times the database connection was opened
+        size_t opened = 0;
+        //  how many times the database connection was closed
+        size_t closed = 0;
+        //  how many times a kept-alive database connection was reused instead of being reopened
+        size_t reused = 0;
+        //  how many times closing an idle database connection in the background failed, e.g. because
+        //  statements opened by the user weren't finalized
+        size_t failed_closes = 0;
+    };
+
+    namespace internal {
+
+        struct connection_holder {
+
+            /**
+             *  @param didOpenDb_ Optional callback invoked right after the database connection was opened.
+             *  @param willCloseDb_ Optional callback invoked right before the database connection gets closed,
+             *  e.g. to finalize statements that are still kept around.
+             *  @param options_ How the database connection is opened, every time it is opened.
+             */
+            connection_holder(std::string filename_,
+                              std::function<void(sqlite3*)> didOpenDb_ = {},
+                              std::function<void(sqlite3*)> willCloseDb_ = {},
+                              open_options options_ = {}) :
+                filename(std::move(filename_)), options(std::move(options_)),
+                openFilename(make_open_filename(this->filename, this->options)),
+                didOpenDb(std::move(didOpenDb_)), willCloseDb(std::move(willCloseDb_)) {}
+
+            connection_holder(const connection_holder&) = delete;
+
+            ~connection_holder() {
+                if (this->closer.joinable()) {
+                    {
+                        std::lock_guard<std::mutex> lock{this->mutex};
+                        this->stopCloser = true;
+                    }
+                    this->closerCondition.notify_one();
+                    this->closer.join();
+                }
+                //  a connection kept alive is closed now
+                std::lock_guard<std::mutex> lock{this->mutex};
+                if (this->db && this->_retain_count == 0) {
+                    this->close_db();
+                }
+            }
+
+            void retain() {
+                if (1 == ++this->_retain_count) {
+                    std::lock_guard<std::mutex> lock{this->mutex};
+                    if (this->db) {
+                        //  kept alive
+                        ++this->stats.reused;
+                        return;
+                    }
+                    auto rc = sqlite3_open_v2(this->openFilename.c_str(),
+                                              &this->db,
+                                              make_open_flags(this->options),
+                                              this->options.vfs.empty() ? nullptr : this->options.vfs.c_str());
+                    if (rc != SQLITE_OK) {
+                        --this->_retain_count;
+                        auto error = sqlite_to_system_error(this->db);
+                        sqlite3_close(std::exchange(this->db, nullptr));
+                        throw error;
+                    }
+                    //  lookaside memory can only be configured before the connection is used
+                    if (this->options.lookaside_slot_size > 0 && this->options.lookaside_slot_count > 0) {
+                        rc = sqlite3_db_config(this->db,
+                                               SQLITE_DBCONFIG_LOOKASIDE,
+                                               nullptr,
+                                               this->options.lookaside_slot_size,
+                                               this->options.lookaside_slot_count);
+                        if (rc != SQLITE_OK) {
+                            --this->_retain_count;
+                            sqlite3_close(std::exchange(this->db, nullptr));
+                            throw_translated_sqlite_error(rc);
+                        }
+                    }
+                    ++this->stats.opened;
+                    if (this->didOpenDb) {
+                        try {
+                            this->didOpenDb(this->db);
+                        } catch (...) {
+                            --this->_retain_count;
+                            this->close_db();
+                            throw;
+                        }
+                    }
+                }
+            }
+
+            void release() {
+                if (0 == --this->_retain_count) {
+                    std::unique_lock<std::mutex> lock{this->mutex};
+                    //  retained again by another thread in the meantime
+                    if (this->_retain_count != 0) {
+                        return;
+                    }
+                    if (this->keepAlive.count() > 0) {
+                        this->closeDeadline = std::chrono::steady_clock::now() + this->keepAlive;
+                        if (!this->closer.joinable()) {
+                            this->closer = std::thread{&connection_holder::run_closer, this};
+                        }
+                        lock.unlock();
+                        this->closerCondition.notify_one();
+                        return;
                     }
+                    if (this->db) {
+                        auto rc = this->close_db();
+                        if (rc != SQLITE_OK) {
+                            throw_translated_sqlite_error(rc);
+                        }
+                    }
+                }
+            }
+
+            /**
+             *  Keep the database connection opened for the given idle period after the last reference
+             *  to it has been released, instead of closing it immediately.
+             *  The connection is closed by a background thread once the idle period has elapsed
+             *  without the connection being retained again.
+             *  A zero period restores the default behaviour of closing the connection immediately.
+             */
+            void keep_alive(std::chrono::milliseconds idlePeriod) {
+                {
+                    std::lock_guard<std::mutex> lock{this->mutex};
+                    this->keepAlive = idlePeriod;
+                    this->closeDeadline = std::chrono::steady_clock::now() + idlePeriod;
                 }
+                this->closerCondition.notify_one();
+            }
+
+            std::chrono::milliseconds keep_alive() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->keepAlive;
+            }
+
+            sqlite_orm::connection_stats connection_stats() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->stats;
             }
 
             sqlite3* get() const {
@@ -13772,11 +14430,71 @@ namespace sqlite_orm {
                 return this->_retain_count;
             }
 
+            /**
+             *  Whether the database connection is opened right now, also when it is merely kept alive.
+             */
+            bool is_open() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->db != nullptr;
+            }
+
             const std::string filename;
+            const open_options options;
+
+            //  serializes the `interrupt_guard`s sharing the connection's single progress handler
+            std::mutex interruptMutex;
 
           protected:
+            //  the filename or URI passed to `sqlite3_open_v2()`
+            const std::string openFilename;
             sqlite3* db = nullptr;
             std::atomic_int _retain_count{};
+            const std::function<void(sqlite3*)> didOpenDb;
+            const std::function<void(sqlite3*)> willCloseDb;
+
+            mutable std::mutex mutex;
+            sqlite_orm::connection_stats stats;
+            std::chrono::milliseconds keepAlive{0};
+            std::chrono::steady_clock::time_point closeDeadline;
+            std::condition_variable closerCondition;
+            bool stopCloser = false;
+            std::thread closer;
+
+            //  expects the mutex to be locked
+            int close_db() {
+                if (this->willCloseDb) {
+                    this->willCloseDb(this->db);
+                }
+                auto rc = sqlite3_close(this->db);
+                if (rc == SQLITE_OK) {
+                    this->db = nullptr;
+                    ++this->stats.closed;
+                }
+                return rc;
+            }
+
+            void run_closer() {
+                std::unique_lock<std::mutex> lock{this->mutex};
+                while (!this->stopCloser) {
+                    if (this->db && this->_retain_count == 0) {
+                        if (this->keepAlive.count() == 0 || std::chrono::steady_clock::now() >= this->closeDeadline) {
+                            if (this->close_db() != SQLITE_OK) {
+                                //  nothing to report to in the background but the counter;
+                                //  retried on the next release or after the idle period, at least 100 ms
+                                ++this->stats.failed_closes;
+                                const std::chrono::milliseconds retryPeriod =
+                                    std::max(this->keepAlive, std::chrono::milliseconds{100});
+                                this->closeDeadline = std::chrono::steady_clock::now() + retryPeriod;
+                                this->closerCondition.wait_until(lock, this->closeDeadline);
+                            }
+                            continue;
+                        }
+                        this->closerCondition.wait_until(lock, this->closeDeadline);
+                    } else {
+                        this->closerCondition.wait(lock);
+                    }
+                }
+            }
         };
 
         struct connection_ref {
@@ -13788,10 +14506,17 @@ namespace sqlite_orm {
                 this->holder->retain();
             }
 
+            /**
+             *  Takes over the reference, `other` doesn't refer to the connection anymore.
+             */
+            connection_ref(connection_ref&& other) : holder(std::exchange(other.holder, nullptr)) {}
+
             // rebind connection reference
             connection_ref& operator=(const connection_ref& other) {
                 if (other.holder != this->holder) {
-                    this->holder->release();
+                    if (this->holder) {
+                        this->holder->release();
+                    }
                     this->holder = other.holder;
                     this->holder->retain();
                 }
@@ -13800,13 +14525,19 @@ namespace sqlite_orm {
             }
 
             ~connection_ref() {
-                this->holder->release();
+                if (this->holder) {
+                    this->holder->release();
+                }
             }
 
             sqlite3* get() const {
                 return this->holder->get();
             }
 
+            std::mutex& interrupt_mutex() const {
+                return this->holder->interruptMutex;
+            }
+
           private:
             connection_holder* holder = nullptr;
         };
@@ -14158,6 +14889,35 @@ namespace sqlite_orm {
 
 namespace sqlite_orm {
 
+#ifdef SQLITE_ENABLE_STMT_SCANSTATUS
+    /**
+     *  Statistics of one loop of a statement's query plan, see https://sqlite.org/c3ref/stmt_scanstatus.html
+     */
+    struct scan_status {
+        /**
+         *  Number of times the loop was run.
+         */
+        sqlite3_int64 loops = 0;
+        /**
+         *  Number of rows visited by the loop in total.
+         */
+        sqlite3_int64 rows_visited = 0;
+        /**
+         *  Query planner's estimate of the rows output by each run of the loop.
+         */
+        double estimated_rows = 0;
+        /**
+         *  Name of the table or index the loop iterates.
+         */
+        std::string name;
+        /**
+         *  Description of the loop like in the output of EXPLAIN QUERY PLAN, e.g. "SCAN users".
+         */
+        std::string explain;
+        int select_id = 0;
+    };
+#endif
+
     namespace internal {
 
         struct prepared_statement_base {
@@ -14208,6 +14968,125 @@ namespace sqlite_orm {
                 return sqlite3_column_name(stmt, index);
             }
 #endif
+
+            /**
+             *  Number of times SQLite stepped forward in a table as part of a full table scan
+             *  since the statement was prepared or the counters were reset.
+             *  Non-zero values hint at a missing index.
+             */
+            int fullscan_steps() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, false);
+            }
+
+            /**
+             *  Number of sort operations, which hint at an ORDER BY or GROUP BY not served by an index.
+             */
+            int sort_operations() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_SORT, false);
+            }
+
+            /**
+             *  Number of rows inserted into transient indices created automatically to help joins,
+             *  which hint at a missing index, too.
+             */
+            int autoindex_rows() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_AUTOINDEX, false);
+            }
+
+#ifdef SQLITE_STMTSTATUS_VM_STEP
+            /**
+             *  Number of virtual machine operations executed, a proxy for the total work done.
+             */
+            int vm_steps() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_VM_STEP, false);
+            }
+
+            /**
+             *  Number of times the statement was automatically regenerated due to schema changes.
+             */
+            int reprepares() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_REPREPARE, false);
+            }
+
+            /**
+             *  Number of times the statement was run, where a run counts as completed
+             *  once it is reset.
+             */
+            int runs() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_RUN, false);
+            }
+#endif
+#ifdef SQLITE_STMTSTATUS_FILTER_HIT
+            /**
+             *  Number of times a join step was bypassed because a Bloom filter returned not-found.
+             */
+            int filter_hits() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_FILTER_HIT, false);
+            }
+
+            /**
+             *  Number of times a Bloom filter check didn't bypass a join step.
+             */
+            int filter_misses() const {
+                return sqlite3_stmt_status(this->stmt, SQLITE_STMTSTATUS_FILTER_MISS, false);
+            }
+#endif
+
+            /**
+             *  Resets all the counters above to zero.
+             */
+            void reset_status_counters() {
+                for (int counter: {SQLITE_STMTSTATUS_FULLSCAN_STEP,
+                                   SQLITE_STMTSTATUS_SORT,
+                                   SQLITE_STMTSTATUS_AUTOINDEX,
+#ifdef SQLITE_STMTSTATUS_VM_STEP
+                                   SQLITE_STMTSTATUS_VM_STEP,
+                                   SQLITE_STMTSTATUS_REPREPARE,
+                                   SQLITE_STMTSTATUS_RUN,
+#endif
+#ifdef SQLITE_STMTSTATUS_FILTER_HIT
+                                   SQLITE_STMTSTATUS_FILTER_HIT,
+                                   SQLITE_STMTSTATUS_FILTER_MISS,
+#endif
+                     }) {
+                    sqlite3_stmt_status(this->stmt, counter, true);
+                }
+            }
+
+#ifdef SQLITE_ENABLE_STMT_SCANSTATUS
+            /**
+             *  Returns the statistics of every loop of the statement's query plan.
+             *  Requires SQLite to be compiled with `SQLITE_ENABLE_STMT_SCANSTATUS`.
+             */
+            std::vector<scan_status> scan_statuses() const {
+                std::vector<scan_status> result;
+                for (int loop = 0;; ++loop) {
+                    scan_status status;
+                    const char* name = nullptr;
+                    const char* explain = nullptr;
+                    if (sqlite3_stmt_scanstatus(this->stmt, loop, SQLITE_SCANSTAT_NLOOP, &status.loops) != 0) {
+                        break;
+                    }
+                    sqlite3_stmt_scanstatus(this->stmt, loop, SQLITE_SCANSTAT_NVISIT, &status.rows_visited);
+                    sqlite3_stmt_scanstatus(this->stmt, loop, SQLITE_SCANSTAT_EST, &status.estimated_rows);
+                    sqlite3_stmt_scanstatus(this->stmt, loop, SQLITE_SCANSTAT_NAME, &name);
+                    sqlite3_stmt_scanstatus(this->stmt, loop, SQLITE_SCANSTAT_EXPLAIN, &explain);
+                    sqlite3_stmt_scanstatus(this->stmt, loop, SQLITE_SCANSTAT_SELECTID, &status.select_id);
+                    if (name) {
+                        status.name = name;
+                    }
+                    if (explain) {
+                        status.explain = explain;
+                    }
+                    result.push_back(std::move(status));
+                }
+                return result;
+            }
+
+            void reset_scan_statuses() {
+                sqlite3_stmt_scanstatus_reset(this->stmt);
+            }
+#endif
         };
 
         template<class T>
@@ -14315,6 +15194,27 @@ namespace sqlite_orm {
             ids_type ids;
         };
 
+        /**
+         *  Fetches the objects with the given primary keys in one statement.
+         *  Id is the primary key's type, or a std::tuple of the types of a composite primary key.
+         */
+        template<class T, class Id>
+        struct get_many_t {
+            using type = T;
+            using id_type = Id;
+
+            std::vector<Id> ids;
+        };
+
+        /**
+         *  Number of primary key columns identified by an id of type Id.
+         */
+        template<class Id>
+        struct id_columns_count : std::integral_constant<size_t, 1> {};
+
+        template<class... Args>
+        struct id_columns_count<std::tuple<Args...>> : std::integral_constant<size_t, sizeof...(Args)> {};
+
 #ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
         template<class T, class... Ids>
         struct get_optional_t {
@@ -14332,6 +15232,18 @@ namespace sqlite_orm {
             type object;
         };
 
+        /**
+         *  Update of only those columns of an object whose flag is set in `columnsMask`,
+         *  which is indexed in the order of the table's columns.
+         */
+        template<class T>
+        struct update_columns_t {
+            using type = T;
+
+            type object;
+            std::vector<bool> columnsMask;
+        };
+
         template<class T, class... Ids>
         struct remove_t {
             using type = T;
@@ -14816,6 +15728,19 @@ namespace sqlite_orm {
     }
 #endif
 
+#ifdef SQLITE_ENABLE_JSON1
+    /**
+     *  Create a get many statement.
+     *  T is an object type mapped to a storage.
+     *  Usage: get_many<User>(std::vector<int>{5, 6, 7});
+     *  Usage with a composite primary key: get_many<Membership>(std::vector<std::tuple<int, int>>{{1, 2}, {1, 3}});
+     */
+    template<class T, class Id>
+    internal::get_many_t<T, Id> get_many(std::vector<Id> ids) {
+        return {std::move(ids)};
+    }
+#endif  //  SQLITE_ENABLE_JSON1
+
 #ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
     /**
      *  Create a get optional statement.
@@ -15796,18 +16721,43 @@ namespace sqlite_orm {
             }
 
             mapped_iterator<T, db_objects_type> begin() {
+                return {obtain_db_objects(this->storage), this->prepare_statement()};
+            }
+
+            mapped_iterator<T, db_objects_type> end() {
+                return {};
+            }
+
+          protected:
+            statement_finalizer prepare_statement() {
                 using context_t = serializer_context<db_objects_type>;
-                auto& dbObjects = obtain_db_objects(this->storage);
-                context_t context{dbObjects};
+                context_t context{obtain_db_objects(this->storage)};
                 context.skip_table_name = false;
                 context.replace_bindable_with_question = true;
 
                 statement_finalizer stmt{prepare_stmt(this->connection.get(), serialize(this->expression, context))};
                 iterate_ast(this->expression.conditions, conditional_binder{stmt.get()});
-                return {dbObjects, std::move(stmt)};
+                return stmt;
             }
+        };
 
-            mapped_iterator<T, db_objects_type> end() {
+        /**
+         *  A view like `mapped_view`, returned by `storage_t::iterate_in_place()`,
+         *  whose iterator reads every row into the same object instead of allocating one per row.
+         *  Strings and BLOBs of the object reuse their capacity.
+         *  The object is only valid until the iterator is incremented.
+         */
+        template<class T, class S, class... Args>
+        struct in_place_mapped_view : mapped_view<T, S, Args...> {
+            using typename mapped_view<T, S, Args...>::db_objects_type;
+
+            using mapped_view<T, S, Args...>::mapped_view;
+
+            in_place_mapped_iterator<T, db_objects_type> begin() {
+                return {obtain_db_objects(this->storage), this->prepare_statement()};
+            }
+
+            in_place_mapped_iterator<T, db_objects_type> end() {
                 return {};
             }
         };
@@ -15997,42 +16947,410 @@ inline constexpr bool std::ranges::enable_borrowed_range<sqlite_orm::internal::r
 #endif
 #endif
 
-// #include "ast_iterator.h"
-
-// #include "storage_base.h"
+// #include "cursor_view.h"
 
 #include <sqlite3.h>
-#include <cstdlib>  // atoi
-#include <memory>  //  std::allocator
-#include <functional>  //  std::function, std::bind, std::bind_front
-#include <string>  //  std::string
-#include <sstream>  //  std::stringstream
-#include <iomanip>  //  std::flush
 #include <utility>  //  std::move
-#include <system_error>  //  std::system_error
-#include <vector>  //  std::vector
-#include <list>  //  std::list
-#include <memory>  //  std::make_unique, std::unique_ptr
-#include <map>  //  std::map
-#include <type_traits>  //  std::is_same
-#include <algorithm>  //  std::find_if, std::ranges::find
+#include <type_traits>  //  std::remove_cvref_t
+#include <functional>  //  std::reference_wrapper
+#if defined(SQLITE_ORM_SENTINEL_BASED_FOR_SUPPORTED) && defined(SQLITE_ORM_DEFAULT_COMPARISONS_SUPPORTED) &&           \
+    defined(SQLITE_ORM_CPP20_RANGES_SUPPORTED)
+#include <ranges>  //  std::ranges::view_interface
+#endif
 
-// #include "functional/cxx_tuple_polyfill.h"
+// #include "row_view.h"
 
-#include <tuple>  //  std::apply; std::tuple_size
-#if __cpp_lib_apply < 201603L
-#include <utility>  //  std::forward, std::index_sequence, std::make_index_sequence
-#endif
+#include <sqlite3.h>
+#include <cstddef>  //  size_t, std::byte
 
-// #include "../functional/cxx_functional_polyfill.h"
-//  std::invoke
+// #include "functional/cxx_string_view.h"
 
-namespace sqlite_orm {
-    namespace internal {
-        namespace polyfill {
-#if __cpp_lib_apply >= 201603L
-            using std::apply;
-#else
+// #include "functional/cxx_span.h"
+
+// #include "cxx_core_features.h"
+
+#if SQLITE_ORM_HAS_INCLUDE(<version>)
+#include <version>
+#endif
+
+#if __cpp_lib_span >= 202002L
+#include <span>
+#define SQLITE_ORM_SPAN_SUPPORTED
+#endif
+
+// #include "row_extractor.h"
+
+namespace sqlite_orm {
+
+    /**
+     *  Non-owning view of the current row of a statement, as yielded by `storage_t::cursor()`.
+     *  Text and blob accessors point directly into SQLite's column buffers without copying them,
+     *  so a row and everything obtained from it are only valid until the statement steps to the next row.
+     *
+     *  Column indexes are zero-based like the columns of the select statement.
+     */
+    class row_view {
+      public:
+        explicit row_view(sqlite3_stmt* stmt) : stmt{stmt} {}
+
+        int column_count() const {
+            return sqlite3_data_count(this->stmt);
+        }
+
+        bool is_null(int columnIndex) const {
+            return sqlite3_column_type(this->stmt, columnIndex) == SQLITE_NULL;
+        }
+
+        /**
+         *  Size of the text or blob value in bytes, after converting the value to text or blob if needed.
+         */
+        size_t size(int columnIndex) const {
+            return size_t(sqlite3_column_bytes(this->stmt, columnIndex));
+        }
+
+        /**
+         *  Extracts a copy of the value like `select()` does, e.g. for numeric columns.
+         */
+        template<class T>
+        T get(int columnIndex) const {
+            return row_extractor<T>{}.extract(this->stmt, columnIndex);
+        }
+
+#ifdef SQLITE_ORM_STRING_VIEW_SUPPORTED
+        /**
+         *  The value as UTF-8 text, empty for NULL.
+         */
+        std::string_view text(int columnIndex) const {
+            // note: the text has to be requested before its size, see https://sqlite.org/c3ref/column_blob.html
+            auto text = reinterpret_cast<const char*>(sqlite3_column_text(this->stmt, columnIndex));
+            return {text, this->size(columnIndex)};
+        }
+#endif
+
+#ifdef SQLITE_ORM_SPAN_SUPPORTED
+        /**
+         *  The value as bytes, empty for NULL and zero-length blobs.
+         */
+        std::span<const std::byte> blob(int columnIndex) const {
+            auto bytes = static_cast<const std::byte*>(sqlite3_column_blob(this->stmt, columnIndex));
+            return {bytes, this->size(columnIndex)};
+        }
+#endif
+
+      private:
+        sqlite3_stmt* stmt;
+    };
+
+    /**
+     *  Specialization for the current row of a result set, used by cursors.
+     */
+    template<>
+    struct row_extractor<row_view, void> {
+        row_view extract(sqlite3_stmt* stmt, int /*columnIndex*/) const {
+            return row_view{stmt};
+        }
+    };
+}
+
+// #include "result_set_iterator.h"
+
+// #include "ast_iterator.h"
+
+// #include "connection_holder.h"
+
+// #include "util.h"
+
+// #include "storage_lookup.h"
+
+#if defined(SQLITE_ORM_SENTINEL_BASED_FOR_SUPPORTED) && defined(SQLITE_ORM_DEFAULT_COMPARISONS_SUPPORTED)
+namespace sqlite_orm::internal {
+    /*
+     *  A low-level C++ view over a result set of a select statement, returned by `storage_t::cursor()`.
+     *  Unlike `result_set_view` it doesn't extract the columns but yields a `row_view` of the current row.
+     *
+     *  `cursor_view` is also a 'borrowed range',
+     *  meaning that iterators obtained from it are not tied to the lifetime of the view instance.
+     */
+    template<class Select, class DBOs>
+    struct cursor_view
+#ifdef SQLITE_ORM_CPP20_RANGES_SUPPORTED
+        : std::ranges::view_interface<cursor_view<Select, DBOs>>
+#endif
+    {
+        using db_objects_type = DBOs;
+        using expression_type = Select;
+
+        cursor_view(const db_objects_type& dbObjects, connection_ref conn, Select expression) :
+            db_objects{dbObjects}, connection{std::move(conn)}, expression{std::move(expression)} {}
+
+        cursor_view(cursor_view&&) = default;
+        cursor_view& operator=(cursor_view&&) = default;
+        cursor_view(const cursor_view&) = default;
+        cursor_view& operator=(const cursor_view&) = default;
+
+        auto begin() {
+            const auto& exprDBOs = db_objects_for_expression(this->db_objects.get(), this->expression);
+            using context_t = serializer_context<std::remove_cvref_t<decltype(exprDBOs)>>;
+            context_t context{exprDBOs};
+            context.skip_table_name = false;
+            context.replace_bindable_with_question = true;
+
+            statement_finalizer stmt{prepare_stmt(this->connection.get(), serialize(this->expression, context))};
+            iterate_ast(this->expression, conditional_binder{stmt.get()});
+
+            using iterator_type = result_set_iterator<row_view, db_objects_type>;
+            return iterator_type{this->db_objects, std::move(stmt)};
+        }
+
+        result_set_sentinel_t end() {
+            return {};
+        }
+
+      private:
+        std::reference_wrapper<const db_objects_type> db_objects;
+        connection_ref connection;
+        expression_type expression;
+    };
+}
+
+#ifdef SQLITE_ORM_CPP20_RANGES_SUPPORTED
+template<class Select, class DBOs>
+inline constexpr bool std::ranges::enable_borrowed_range<sqlite_orm::internal::cursor_view<Select, DBOs>> = true;
+#endif
+#endif
+
+// #include "blob_handle.h"
+
+#include <sqlite3.h>
+#include <cstddef>  //  size_t
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <istream>  //  std::istream
+#include <ostream>  //  std::ostream
+#include <functional>  //  std::function
+#include <utility>  //  std::move, std::exchange
+#include <algorithm>  //  std::min, std::max
+
+// #include "error_code.h"
+
+// #include "connection_holder.h"
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+        /**
+         *  Incremental I/O on a BLOB value, a wrapper around sqlite3_blob pointer.
+         *  Don't construct it as is, call storage.open_blob instead.
+         *
+         *  The size of a BLOB can't be changed through the handle: preallocate it with `storage.allocate_blob`
+         *  or the `zeroblob()` function, then write it in parts.
+         *  Changing the row by other means expires the handle, after which reads and writes fail with SQLITE_ABORT
+         *  until `reopen()` is called.
+         */
+        class blob_handle {
+          public:
+            blob_handle(connection_ref con,
+                        const std::string& tableName,
+                        const std::string& columnName,
+                        sqlite3_int64 rowid,
+                        bool writable,
+                        std::function<void(sqlite3_int64 rowid)> onWrite,
+                        std::function<void()> onWritesDone) :
+                con(std::move(con)), currentRowid(rowid), onWrite(std::move(onWrite)),
+                onWritesDone(std::move(onWritesDone)) {
+                sqlite3* db = this->con.get();
+                if (sqlite3_blob_open(db,
+                                      "main",
+                                      tableName.c_str(),
+                                      columnName.c_str(),
+                                      rowid,
+                                      writable,
+                                      &this->handle) != SQLITE_OK) {
+                    //  the handle is null on error
+                    throw_translated_sqlite_error(db);
+                }
+            }
+
+            blob_handle(blob_handle&& other) :
+                con(other.con), handle(std::exchange(other.handle, nullptr)), currentRowid(other.currentRowid),
+                onWrite(std::move(other.onWrite)), onWritesDone(std::move(other.onWritesDone)),
+                written(std::exchange(other.written, false)) {}
+
+            /**
+             *  Closes the handle if `close()` wasn't called, ignoring errors.
+             */
+            ~blob_handle() {
+                if (this->handle) {
+                    (void)sqlite3_blob_close(this->handle);
+                    this->writes_done();
+                }
+            }
+
+            /**
+             *  Closes the handle, after which it can't be used anymore.
+             *  In autocommit mode this commits the writes.
+             *  @throws std::system_error if closing fails, e.g. if the writes can't be committed.
+             *  The handle is closed even then.
+             */
+            void close() {
+                if (!this->handle) {
+                    return;
+                }
+                const int rc = sqlite3_blob_close(std::exchange(this->handle, nullptr));
+                this->writes_done();
+                if (rc != SQLITE_OK) {
+                    throw_translated_sqlite_error(rc);
+                }
+            }
+
+            sqlite3_int64 rowid() const {
+                return this->currentRowid;
+            }
+
+            /**
+             *  Size of the BLOB in bytes.
+             */
+            size_t size() const {
+                return size_t(sqlite3_blob_bytes(this->handle));
+            }
+
+            /**
+             *  Reads `count` bytes starting at `offset` into `buffer`.
+             *  @throws std::system_error if the range exceeds the BLOB or the handle expired.
+             */
+            void read(void* buffer, size_t count, size_t offset) const {
+                if (sqlite3_blob_read(this->handle, buffer, int(count), int(offset)) != SQLITE_OK) {
+                    throw_translated_sqlite_error(this->con.get());
+                }
+            }
+
+            /**
+             *  Writes `count` bytes from `data` starting at `offset`.
+             *  @throws std::system_error if the range exceeds the BLOB, the handle is read-only or expired.
+             */
+            void write(const void* data, size_t count, size_t offset) {
+                if (sqlite3_blob_write(this->handle, data, int(count), int(offset)) != SQLITE_OK) {
+                    throw_translated_sqlite_error(this->con.get());
+                }
+                this->written = true;
+                //  sqlite3_blob_write() doesn't invoke the update hook
+                if (this->onWrite) {
+                    this->onWrite(this->currentRowid);
+                }
+            }
+
+            /**
+             *  Moves the handle to the same column of another row, which is faster than opening a new handle.
+             *  @throws std::system_error if the row doesn't exist or its value isn't a BLOB or text,
+             *  after which the handle is expired.
+             */
+            void reopen(sqlite3_int64 rowid) {
+                if (sqlite3_blob_reopen(this->handle, rowid) != SQLITE_OK) {
+                    throw_translated_sqlite_error(this->con.get());
+                }
+                this->currentRowid = rowid;
+            }
+
+            /**
+             *  Streams the BLOB from `offset` to its end into `os`, `chunkSize` bytes at a time.
+             *  @return Number of bytes read.
+             */
+            size_t read_to(std::ostream& os, size_t offset = 0, size_t chunkSize = default_chunk_size) const {
+                const size_t blobSize = this->size();
+                const size_t remaining = blobSize > offset ? blobSize - offset : 0;
+                std::vector<char> chunk(std::min(std::max(chunkSize, size_t(1)), remaining));
+                size_t position = offset;
+                while (position < blobSize && os) {
+                    const size_t count = std::min(chunk.size(), blobSize - position);
+                    this->read(chunk.data(), count, position);
+                    os.write(chunk.data(), std::streamsize(count));
+                    position += count;
+                }
+                return position - offset;
+            }
+
+            /**
+             *  Writes what `is` provides into the BLOB starting at `offset`, `chunkSize` bytes at a time,
+             *  until the stream ends or the BLOB is full.
+             *  @return Number of bytes written.
+             */
+            size_t write_from(std::istream& is, size_t offset = 0, size_t chunkSize = default_chunk_size) {
+                const size_t blobSize = this->size();
+                const size_t remaining = blobSize > offset ? blobSize - offset : 0;
+                std::vector<char> chunk(std::min(std::max(chunkSize, size_t(1)), remaining));
+                size_t position = offset;
+                while (position < blobSize && is) {
+                    is.read(chunk.data(), std::streamsize(std::min(chunk.size(), blobSize - position)));
+                    const size_t count = size_t(is.gcount());
+                    if (count == 0) {
+                        break;
+                    }
+                    this->write(chunk.data(), count, position);
+                    position += count;
+                }
+                return position - offset;
+            }
+
+          private:
+            static constexpr size_t default_chunk_size = 64 * 1024;
+
+            void writes_done() {
+                //  in autocommit mode the writes are committed once the handle is closed
+                if (this->written && this->onWritesDone) {
+                    this->onWritesDone();
+                }
+            }
+
+            connection_ref con;
+            sqlite3_blob* handle = nullptr;
+            sqlite3_int64 currentRowid;
+            std::function<void(sqlite3_int64 rowid)> onWrite;
+            std::function<void()> onWritesDone;
+            bool written = false;
+        };
+    }
+}
+
+// #include "ast_iterator.h"
+
+// #include "storage_base.h"
+
+#include <sqlite3.h>
+#include <cstdlib>  // atoi
+#include <memory>  //  std::allocator
+#include <functional>  //  std::function, std::bind, std::bind_front
+#include <string>  //  std::string
+#include <sstream>  //  std::stringstream
+#include <iomanip>  //  std::flush
+#include <utility>  //  std::move
+#include <system_error>  //  std::system_error
+#include <vector>  //  std::vector
+#include <list>  //  std::list
+#include <memory>  //  std::make_unique, std::unique_ptr
+#include <map>  //  std::map
+#include <type_traits>  //  std::is_same, std::integral_constant
+#include <algorithm>  //  std::find_if, std::ranges::find, std::copy
+#include <chrono>  //  std::chrono::milliseconds
+#include <atomic>  //  std::atomic_bool, std::atomic
+#include <thread>  //  std::thread, std::this_thread
+
+// #include "functional/cxx_tuple_polyfill.h"
+
+#include <tuple>  //  std::apply; std::tuple_size
+#if __cpp_lib_apply < 201603L
+#include <utility>  //  std::forward, std::index_sequence, std::make_index_sequence
+#endif
+
+// #include "../functional/cxx_functional_polyfill.h"
+//  std::invoke
+
+namespace sqlite_orm {
+    namespace internal {
+        namespace polyfill {
+#if __cpp_lib_apply >= 201603L
+            using std::apply;
+#else
             template<class Callable, class Tpl, size_t... Idx>
             decltype(auto) apply(Callable&& callable, Tpl&& tpl, std::index_sequence<Idx...>) {
                 return polyfill::invoke(std::forward<Callable>(callable), std::get<Idx>(std::forward<Tpl>(tpl))...);
@@ -16073,28 +17391,238 @@ namespace sqlite_orm {
 
 // #include "locking_mode.h"
 
-// #include "connection_holder.h"
-
-// #include "util.h"
-
-// #include "serializing_util.h"
+// #include "pragma_profile.h"
 
-#include <type_traits>  //  std::index_sequence, std::remove_cvref
-#include <tuple>
-#include <array>
-#include <string>
-#include <ostream>
-#include <utility>  //  std::exchange, std::tuple_size, std::make_index_sequence
+#include <sqlite3.h>
+#include <array>  //  std::array
+#include <string>  //  std::string
+#include <sstream>  //  std::stringstream
+#include <cstddef>  //  size_t
 
-// #include "functional/cxx_type_traits_polyfill.h"
-// std::remove_cvref, polyfill::is_detected
-// #include "functional/cxx_functional_polyfill.h"
+namespace sqlite_orm {
 
-// #include "tuple_helper/tuple_iteration.h"
+    /**
+     *  Caps case like `journal_mode`.
+     *  https://www.sqlite.org/pragma.html#pragma_temp_store
+     */
+    enum class temp_store {
+        DEFAULT = 0,
+        FILE = 1,
+        MEMORY = 2,
+    };
 
-// #include "type_traits.h"
+    namespace internal {
 
-// #include "error_code.h"
+        /**
+         *  Pragmas a `pragma_profile` consists of, in the order they are applied.
+         *  `page_size` comes first because it must be set before the database is written.
+         */
+        enum class profile_pragma : size_t {
+            page_size,
+            cache_size,
+            mmap_size,
+            temp_store,
+            synchronous,
+            wal_autocheckpoint,
+            busy_timeout,
+            count,
+        };
+
+        inline const char* profile_pragma_name(profile_pragma pragma) {
+            static constexpr const char* names[] = {
+                "page_size",
+                "cache_size",
+                "mmap_size",
+                "temp_store",
+                "synchronous",
+                "wal_autocheckpoint",
+                "busy_timeout",
+            };
+            return names[size_t(pragma)];
+        }
+
+        /**
+         *  Whether a pragma only matters for the connection writing the database,
+         *  as opposed to pragmas configuring every connection including pooled readers.
+         */
+        inline bool is_writer_pragma(profile_pragma pragma) {
+            return pragma == profile_pragma::page_size || pragma == profile_pragma::synchronous ||
+                   pragma == profile_pragma::wal_autocheckpoint;
+        }
+    }
+
+    /**
+     *  A set of performance pragmas applied together, see `pragma_t::apply_profile()`.
+     *  Pragmas not set by a profile are left alone when it is applied.
+     *  The predefined profiles all set `cache_size`, `mmap_size`, `temp_store`, `synchronous` and
+     *  `wal_autocheckpoint`, hence switching between them replaces all settings of the previous one.
+     *
+     *  @example
+     *  ```c++
+     *  storage.pragma.apply_profile(pragma_profile::bulk_load());
+     *  //  import ...
+     *  storage.pragma.apply_profile(pragma_profile::read_heavy().busy_timeout(5000));
+     *  ```
+     */
+    class pragma_profile {
+      public:
+        /**
+         *  Number of pages if positive, otherwise the size in KiB if negative.
+         */
+        pragma_profile& cache_size(int value) {
+            return this->set(internal::profile_pragma::cache_size, value);
+        }
+
+        pragma_profile& mmap_size(sqlite3_int64 value) {
+            return this->set(internal::profile_pragma::mmap_size, value);
+        }
+
+        pragma_profile& temp_store(sqlite_orm::temp_store value) {
+            return this->set(internal::profile_pragma::temp_store, int(value));
+        }
+
+        /**
+         *  Takes effect for new databases only, or once the database is vacuumed.
+         */
+        pragma_profile& page_size(int value) {
+            return this->set(internal::profile_pragma::page_size, value);
+        }
+
+        pragma_profile& wal_autocheckpoint(int value) {
+            return this->set(internal::profile_pragma::wal_autocheckpoint, value);
+        }
+
+        pragma_profile& busy_timeout(int value) {
+            return this->set(internal::profile_pragma::busy_timeout, value);
+        }
+
+        pragma_profile& synchronous(int value) {
+            return this->set(internal::profile_pragma::synchronous, value);
+        }
+
+        /**
+         *  A large page cache and memory-mapped reads, for databases mostly read in WAL mode.
+         */
+        static pragma_profile read_heavy() {
+            return pragma_profile{}
+                .cache_size(-64 * 1024)
+                .mmap_size(256 * 1024 * 1024)
+                .temp_store(sqlite_orm::temp_store::MEMORY)
+                .synchronous(1)
+                .wal_autocheckpoint(1000);
+        }
+
+        /**
+         *  `synchronous = NORMAL`, which is durable in WAL mode, and less frequent but longer checkpoints.
+         */
+        static pragma_profile write_heavy() {
+            return pragma_profile{}
+                .cache_size(-32 * 1024)
+                .mmap_size(64 * 1024 * 1024)
+                .temp_store(sqlite_orm::temp_store::MEMORY)
+                .synchronous(1)
+                .wal_autocheckpoint(4000);
+        }
+
+        /**
+         *  Trades durability for speed while importing data: no syncs and no auto-checkpoints.
+         *  Switch to another profile once the import is done.
+         */
+        static pragma_profile bulk_load() {
+            return pragma_profile{}
+                .cache_size(-256 * 1024)
+                .mmap_size(0)
+                .temp_store(sqlite_orm::temp_store::MEMORY)
+                .synchronous(0)
+                .wal_autocheckpoint(0);
+        }
+
+        /**
+         *  A small page cache, no memory mapping and temporary tables in files.
+         */
+        static pragma_profile low_memory() {
+            return pragma_profile{}
+                .cache_size(-1024)
+                .mmap_size(0)
+                .temp_store(sqlite_orm::temp_store::FILE)
+                .synchronous(2)
+                .wal_autocheckpoint(1000);
+        }
+
+        bool has(internal::profile_pragma pragma) const {
+            return this->isSet[size_t(pragma)];
+        }
+
+        sqlite3_int64 get(internal::profile_pragma pragma) const {
+            return this->values[size_t(pragma)];
+        }
+
+        /**
+         *  Sets the pragmas set by `other`.
+         */
+        pragma_profile& merge(const pragma_profile& other) {
+            for (size_t i = 0; i < size_t(internal::profile_pragma::count); ++i) {
+                if (other.isSet[i]) {
+                    this->isSet[i] = true;
+                    this->values[i] = other.values[i];
+                }
+            }
+            return *this;
+        }
+
+        /**
+         *  The pragma statements setting the writer or the connection pragmas of this profile,
+         *  executed all at once.
+         *  @param skipWalAutocheckpoint Whether to leave `wal_autocheckpoint` alone
+         *  because a background checkpointer is hooked into the connection.
+         */
+        std::string to_sql(bool writer, bool skipWalAutocheckpoint = false) const {
+            std::stringstream ss;
+            for (size_t i = 0; i < size_t(internal::profile_pragma::count); ++i) {
+                const auto pragma = internal::profile_pragma(i);
+                if (!this->isSet[i] || internal::is_writer_pragma(pragma) != writer ||
+                    (skipWalAutocheckpoint && pragma == internal::profile_pragma::wal_autocheckpoint)) {
+                    continue;
+                }
+                ss << "PRAGMA " << internal::profile_pragma_name(pragma) << " = " << this->values[i] << "; ";
+            }
+            return ss.str();
+        }
+
+      private:
+        pragma_profile& set(internal::profile_pragma pragma, sqlite3_int64 value) {
+            this->isSet[size_t(pragma)] = true;
+            this->values[size_t(pragma)] = value;
+            return *this;
+        }
+
+        std::array<bool, size_t(internal::profile_pragma::count)> isSet{};
+        std::array<sqlite3_int64, size_t(internal::profile_pragma::count)> values{};
+    };
+}
+
+// #include "connection_holder.h"
+
+// #include "util.h"
+
+// #include "serializing_util.h"
+
+#include <type_traits>  //  std::index_sequence, std::remove_cvref
+#include <tuple>
+#include <array>
+#include <string>
+#include <ostream>
+#include <utility>  //  std::exchange, std::tuple_size, std::make_index_sequence
+
+// #include "functional/cxx_type_traits_polyfill.h"
+// std::remove_cvref, polyfill::is_detected
+// #include "functional/cxx_functional_polyfill.h"
+
+// #include "tuple_helper/tuple_iteration.h"
+
+// #include "type_traits.h"
+
+// #include "error_code.h"
 
 // #include "serializer_context.h"
 
@@ -16513,558 +18041,2656 @@ namespace sqlite_orm {
                 }
             }
 
-            return ss;
-        }
+            return ss;
+        }
+    }
+}
+
+namespace sqlite_orm {
+
+    namespace internal {
+        struct storage_base;
+
+        template<class T>
+        int getPragmaCallback(void* data, int argc, char** argv, char** x) {
+            return extract_single_value<T>(data, argc, argv, x);
+        }
+
+        template<>
+        inline int getPragmaCallback<std::vector<std::string>>(void* data, int argc, char** argv, char**) {
+            auto& res = *(std::vector<std::string>*)data;
+            res.reserve(argc);
+            const auto rowExtractor = column_text_extractor<std::string>();
+            for (int i = 0; i < argc; ++i) {
+                auto rowString = rowExtractor.extract(argv[i]);
+                res.push_back(std::move(rowString));
+            }
+            return 0;
+        }
+
+        struct pragma_t {
+            using get_connection_t = std::function<internal::connection_ref()>;
+            using for_each_reader_t = std::function<void(const std::function<void(sqlite3*)>&)>;
+
+            /**
+             *  @param for_each_reader_ Optional function calling its argument with every opened reader connection,
+             *  which connection pragmas are applied to as well.
+             */
+            pragma_t(get_connection_t get_connection_, for_each_reader_t for_each_reader_ = {}) :
+                get_connection(std::move(get_connection_)), for_each_reader(std::move(for_each_reader_)) {}
+
+            std::vector<std::string> module_list() {
+                return this->get_pragma<std::vector<std::string>>("module_list");
+            }
+
+            bool recursive_triggers() {
+                return bool(this->get_pragma<int>("recursive_triggers"));
+            }
+
+            void recursive_triggers(bool value) {
+                this->set_pragma("recursive_triggers", int(value));
+            }
+
+            /**
+             *  Kept for connections opened later on, see `apply_profile()`.
+             */
+            void busy_timeout(int value) {
+                this->apply_profile(pragma_profile{}.busy_timeout(value));
+            }
+
+            int busy_timeout() {
+                return this->get_pragma<int>("busy_timeout");
+            }
+
+            sqlite_orm::locking_mode locking_mode() {
+                return this->get_pragma<sqlite_orm::locking_mode>("locking_mode");
+            }
+
+            void locking_mode(sqlite_orm::locking_mode value) {
+                this->set_pragma("locking_mode", value);
+            }
+
+            sqlite_orm::journal_mode journal_mode() {
+                return this->get_pragma<sqlite_orm::journal_mode>("journal_mode");
+            }
+
+            void journal_mode(sqlite_orm::journal_mode value) {
+                this->journal_mode_ = -1;
+                this->set_pragma("journal_mode", value);
+                this->journal_mode_ = static_cast<decltype(this->journal_mode_)>(value);
+            }
+
+            /**
+             *  https://www.sqlite.org/pragma.html#pragma_application_id
+             */
+            int application_id() {
+                return this->get_pragma<int>("application_id");
+            }
+
+            /**
+             *  https://www.sqlite.org/pragma.html#pragma_application_id
+             */
+            void application_id(int value) {
+                this->set_pragma("application_id", value);
+            }
+
+            int synchronous() {
+                return this->get_pragma<int>("synchronous");
+            }
+
+            /**
+             *  Kept for connections opened later on, see `apply_profile()`.
+             */
+            void synchronous(int value) {
+                this->apply_profile(pragma_profile{}.synchronous(value));
+            }
+
+            /**
+             *  https://www.sqlite.org/pragma.html#pragma_cache_size
+             *  Number of pages if positive, otherwise the size in KiB if negative.
+             *  Kept for connections opened later on, see `apply_profile()`.
+             */
+            int cache_size() {
+                return this->get_pragma<int>("cache_size");
+            }
+
+            void cache_size(int value) {
+                this->apply_profile(pragma_profile{}.cache_size(value));
+            }
+
+            /**
+             *  https://www.sqlite.org/pragma.html#pragma_mmap_size
+             *  Kept for connections opened later on, see `apply_profile()`.
+             */
+            sqlite3_int64 mmap_size() {
+                return this->get_pragma<sqlite3_int64>("mmap_size");
+            }
+
+            void mmap_size(sqlite3_int64 value) {
+                this->apply_profile(pragma_profile{}.mmap_size(value));
+            }
+
+            /**
+             *  https://www.sqlite.org/pragma.html#pragma_temp_store
+             *  Kept for connections opened later on, see `apply_profile()`.
+             */
+            sqlite_orm::temp_store temp_store() {
+                return static_cast<sqlite_orm::temp_store>(this->get_pragma<int>("temp_store"));
+            }
+
+            void temp_store(sqlite_orm::temp_store value) {
+                this->apply_profile(pragma_profile{}.temp_store(value));
+            }
+
+            /**
+             *  https://www.sqlite.org/pragma.html#pragma_page_size
+             *  Kept for connections opened later on, see `apply_profile()`.
+             */
+            int page_size() {
+                return this->get_pragma<int>("page_size");
+            }
+
+            void page_size(int value) {
+                this->apply_profile(pragma_profile{}.page_size(value));
+            }
+
+            /**
+             *  https://www.sqlite.org/pragma.html#pragma_wal_autocheckpoint
+             *  Kept for connections opened later on, see `apply_profile()`.
+             *  While a background checkpointer runs the value takes effect once it is stopped.
+             */
+            int wal_autocheckpoint() {
+                return this->get_pragma<int>("wal_autocheckpoint");
+            }
+
+            void wal_autocheckpoint(int value) {
+                this->apply_profile(pragma_profile{}.wal_autocheckpoint(value));
+            }
+
+            /**
+             *  Applies the pragmas set by `profile` at once to the writer connection and, as far as they
+             *  configure connections rather than writes, to every opened reader connection.
+             *  The pragmas are kept and applied again whenever a connection is opened,
+             *  hence they survive reconnects. Pragmas set before and not set by `profile` are kept as well.
+             */
+            void apply_profile(const pragma_profile& profile) {
+                auto con = this->get_connection();
+                const std::string connectionPragmas = profile.to_sql(false);
+                perform_void_exec(con.get(), profile.to_sql(true, this->walHookInstalled) + connectionPragmas);
+                if (this->for_each_reader && !connectionPragmas.empty()) {
+                    this->for_each_reader([&connectionPragmas](sqlite3* db) {
+                        perform_void_exec(db, connectionPragmas);
+                    });
+                }
+                this->appliedProfile.merge(profile);
+            }
+
+            /**
+             *  The pragmas applied whenever a connection is opened.
+             */
+            const pragma_profile& applied_profile() const {
+                return this->appliedProfile;
+            }
+
+            int user_version() {
+                return this->get_pragma<int>("user_version");
+            }
+
+            void user_version(int value) {
+                this->set_pragma("user_version", value);
+            }
+
+            int auto_vacuum() {
+                return this->get_pragma<int>("auto_vacuum");
+            }
+
+            void auto_vacuum(int value) {
+                this->set_pragma("auto_vacuum", value);
+            }
+
+            int max_page_count() {
+                return this->get_pragma<int>("max_page_count");
+            }
+
+            void max_page_count(int value) {
+                this->set_pragma("max_page_count", value);
+            }
+
+            std::vector<std::string> integrity_check() {
+                return this->get_pragma<std::vector<std::string>>("integrity_check");
+            }
+
+            template<class T>
+            std::vector<std::string> integrity_check(T table_name) {
+                std::ostringstream ss;
+                ss << "integrity_check(" << table_name << ")" << std::flush;
+                return this->get_pragma<std::vector<std::string>>(ss.str());
+            }
+
+            std::vector<std::string> integrity_check(int n) {
+                std::ostringstream ss;
+                ss << "integrity_check(" << n << ")" << std::flush;
+                return this->get_pragma<std::vector<std::string>>(ss.str());
+            }
+
+            std::vector<std::string> quick_check() {
+                return this->get_pragma<std::vector<std::string>>("quick_check");
+            }
+
+            // will include generated columns in response as opposed to table_info
+            std::vector<sqlite_orm::table_xinfo> table_xinfo(const std::string& tableName) const {
+                auto connection = this->get_connection();
+
+                std::vector<sqlite_orm::table_xinfo> result;
+                std::ostringstream ss;
+                ss << "PRAGMA "
+                      "table_xinfo("
+                   << streaming_identifier(tableName) << ")" << std::flush;
+                perform_exec(
+                    connection.get(),
+                    ss.str(),
+                    [](void* data, int argc, char** argv, char**) -> int {
+                        auto& res = *(std::vector<sqlite_orm::table_xinfo>*)data;
+                        if (argc) {
+                            auto index = 0;
+                            auto cid = atoi(argv[index++]);
+                            std::string name = argv[index++];
+                            std::string type = argv[index++];
+                            bool notnull = !!atoi(argv[index++]);
+                            std::string dflt_value = argv[index] ? argv[index] : "";
+                            ++index;
+                            auto pk = atoi(argv[index++]);
+                            auto hidden = atoi(argv[index++]);
+                            res.emplace_back(cid,
+                                             std::move(name),
+                                             std::move(type),
+                                             notnull,
+                                             std::move(dflt_value),
+                                             pk,
+                                             hidden);
+                        }
+                        return 0;
+                    },
+                    &result);
+                return result;
+            }
+
+            std::vector<sqlite_orm::table_info> table_info(const std::string& tableName) const {
+                auto connection = this->get_connection();
+
+                std::ostringstream ss;
+                ss << "PRAGMA "
+                      "table_info("
+                   << streaming_identifier(tableName) << ")" << std::flush;
+                std::vector<sqlite_orm::table_info> result;
+                perform_exec(
+                    connection.get(),
+                    ss.str(),
+                    [](void* data, int argc, char** argv, char**) -> int {
+                        auto& res = *(std::vector<sqlite_orm::table_info>*)data;
+                        if (argc) {
+                            auto index = 0;
+                            auto cid = atoi(argv[index++]);
+                            std::string name = argv[index++];
+                            std::string type = argv[index++];
+                            bool notnull = !!atoi(argv[index++]);
+                            std::string dflt_value = argv[index] ? argv[index] : "";
+                            ++index;
+                            auto pk = atoi(argv[index++]);
+                            res.emplace_back(cid, std::move(name), std::move(type), notnull, std::move(dflt_value), pk);
+                        }
+                        return 0;
+                    },
+                    &result);
+                return result;
+            }
+
+          private:
+            friend struct storage_base;
+
+            signed char journal_mode_ = -1;  //  if != -1 stores static_cast<sqlite_orm::journal_mode>(journal_mode)
+            get_connection_t get_connection;
+            for_each_reader_t for_each_reader;
+            pragma_profile appliedProfile;
+            //  whether a background checkpointer replaced the auto-checkpoints of the writer connection
+            bool walHookInstalled = false;
+
+            /**
+             *  Applies the kept pragmas to a connection that was just opened.
+             */
+            void apply_profile_on_open(sqlite3* db, bool writer) {
+                const std::string sql = this->appliedProfile.to_sql(writer, this->walHookInstalled);
+                if (!sql.empty()) {
+                    perform_void_exec(db, sql);
+                }
+            }
+
+            template<class T>
+            T get_pragma(const std::string& name) {
+                auto connection = this->get_connection();
+                //  value initialized for pragmas not returning a row, e.g. `mmap_size` of in-memory databases
+                T result{};
+                perform_exec(connection.get(), "PRAGMA " + name, getPragmaCallback<T>, &result);
+                return result;
+            }
+
+            /**
+             *  Yevgeniy Zakharov: I wanted to refactor this function with statements and value bindings
+             *  but it turns out that bindings in pragma statements are not supported.
+             */
+            template<class T>
+            void set_pragma(const std::string& name, const T& value, sqlite3* db = nullptr) {
+                std::stringstream ss;
+                ss << "PRAGMA " << name << " = " << value;
+                this->set_pragma_impl(ss.str(), db);
+            }
+
+            void set_pragma(const std::string& name, sqlite_orm::journal_mode value, sqlite3* db = nullptr) {
+                std::stringstream ss;
+                ss << "PRAGMA " << name << " = " << journal_mode_to_string(value);
+                this->set_pragma_impl(ss.str(), db);
+            }
+
+            void set_pragma(const std::string& name, sqlite_orm::locking_mode value, sqlite3* db = nullptr) {
+                std::stringstream ss;
+                ss << "PRAGMA " << name << " = " << locking_mode_to_string(value);
+                this->set_pragma_impl(ss.str(), db);
+            }
+
+            void set_pragma_impl(const std::string& query, sqlite3* db = nullptr) {
+                auto con = this->get_connection();
+                if (db == nullptr) {
+                    db = con.get();
+                }
+                perform_void_exec(db, query);
+            }
+        };
+    }
+}
+
+// #include "limit_accessor.h"
+
+#include <sqlite3.h>
+#include <map>  //  std::map
+#include <functional>  //  std::function
+#include <memory>  //  std::shared_ptr
+
+// #include "connection_holder.h"
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+        struct limit_accessor {
+            using get_connection_t = std::function<connection_ref()>;
+
+            limit_accessor(get_connection_t get_connection_) : get_connection(std::move(get_connection_)) {}
+
+            int length() {
+                return this->get(SQLITE_LIMIT_LENGTH);
+            }
+
+            void length(int newValue) {
+                this->set(SQLITE_LIMIT_LENGTH, newValue);
+            }
+
+            int sql_length() {
+                return this->get(SQLITE_LIMIT_SQL_LENGTH);
+            }
+
+            void sql_length(int newValue) {
+                this->set(SQLITE_LIMIT_SQL_LENGTH, newValue);
+            }
+
+            int column() {
+                return this->get(SQLITE_LIMIT_COLUMN);
+            }
+
+            void column(int newValue) {
+                this->set(SQLITE_LIMIT_COLUMN, newValue);
+            }
+
+            int expr_depth() {
+                return this->get(SQLITE_LIMIT_EXPR_DEPTH);
+            }
+
+            void expr_depth(int newValue) {
+                this->set(SQLITE_LIMIT_EXPR_DEPTH, newValue);
+            }
+
+            int compound_select() {
+                return this->get(SQLITE_LIMIT_COMPOUND_SELECT);
+            }
+
+            void compound_select(int newValue) {
+                this->set(SQLITE_LIMIT_COMPOUND_SELECT, newValue);
+            }
+
+            int vdbe_op() {
+                return this->get(SQLITE_LIMIT_VDBE_OP);
+            }
+
+            void vdbe_op(int newValue) {
+                this->set(SQLITE_LIMIT_VDBE_OP, newValue);
+            }
+
+            int function_arg() {
+                return this->get(SQLITE_LIMIT_FUNCTION_ARG);
+            }
+
+            void function_arg(int newValue) {
+                this->set(SQLITE_LIMIT_FUNCTION_ARG, newValue);
+            }
+
+            int attached() {
+                return this->get(SQLITE_LIMIT_ATTACHED);
+            }
+
+            void attached(int newValue) {
+                this->set(SQLITE_LIMIT_ATTACHED, newValue);
+            }
+
+            int like_pattern_length() {
+                return this->get(SQLITE_LIMIT_LIKE_PATTERN_LENGTH);
+            }
+
+            void like_pattern_length(int newValue) {
+                this->set(SQLITE_LIMIT_LIKE_PATTERN_LENGTH, newValue);
+            }
+
+            int variable_number() {
+                return this->get(SQLITE_LIMIT_VARIABLE_NUMBER);
+            }
+
+            void variable_number(int newValue) {
+                this->set(SQLITE_LIMIT_VARIABLE_NUMBER, newValue);
+            }
+
+            int trigger_depth() {
+                return this->get(SQLITE_LIMIT_TRIGGER_DEPTH);
+            }
+
+            void trigger_depth(int newValue) {
+                this->set(SQLITE_LIMIT_TRIGGER_DEPTH, newValue);
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3008007
+            int worker_threads() {
+                return this->get(SQLITE_LIMIT_WORKER_THREADS);
+            }
+
+            void worker_threads(int newValue) {
+                this->set(SQLITE_LIMIT_WORKER_THREADS, newValue);
+            }
+#endif
+
+          protected:
+            get_connection_t get_connection;
+
+            friend struct storage_base;
+
+            /**
+             *  Stores limit set between connections.
+             */
+            std::map<int, int> limits;
+
+            int get(int id) {
+                auto connection = this->get_connection();
+                return sqlite3_limit(connection.get(), id, -1);
+            }
+
+            void set(int id, int newValue) {
+                this->limits[id] = newValue;
+                auto connection = this->get_connection();
+                sqlite3_limit(connection.get(), id, newValue);
+            }
+        };
+    }
+}
+
+// #include "transaction_guard.h"
+
+#include <functional>  //  std::function
+#include <utility>  //  std::move
+
+// #include "connection_holder.h"
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+        /**
+         *  Class used as a guard for a transaction. Calls `ROLLBACK` in destructor.
+         *  Has explicit `commit()` and `rollback()` functions. After explicit function is fired
+         *  guard won't do anything in d-tor. Also you can set `commit_on_destroy` to true to
+         *  make it call `COMMIT` on destroy.
+         * 
+         *  Note: The guard's destructor is explicitly marked as potentially throwing,
+         *  so exceptions that occur during commit or rollback are propagated to the caller.
+         */
+        struct transaction_guard_t {
+            /**
+             *  This is a public lever to tell a guard what it must do in its destructor
+             *  if `gotta_fire` is true
+             */
+            bool commit_on_destroy = false;
+
+            transaction_guard_t(connection_ref connection_,
+                                std::function<void()> commit_func_,
+                                std::function<void()> rollback_func_) :
+                connection(std::move(connection_)), commit_func(std::move(commit_func_)),
+                rollback_func(std::move(rollback_func_)) {}
+
+            transaction_guard_t(transaction_guard_t&& other) :
+                commit_on_destroy(other.commit_on_destroy), connection(std::move(other.connection)),
+                commit_func(std::move(other.commit_func)), rollback_func(std::move(other.rollback_func)),
+                gotta_fire(other.gotta_fire) {
+                other.gotta_fire = false;
+            }
+
+            ~transaction_guard_t() noexcept(false) {
+                if (this->gotta_fire) {
+                    if (this->commit_on_destroy) {
+                        this->commit_func();
+                    } else {
+                        this->rollback_func();
+                    }
+                }
+            }
+
+            transaction_guard_t& operator=(transaction_guard_t&&) = delete;
+
+            /**
+             *  Call `COMMIT` explicitly. After this call
+             *  guard will not call `COMMIT` or `ROLLBACK`
+             *  in its destructor.
+             */
+            void commit() {
+                this->gotta_fire = false;
+                this->commit_func();
+            }
+
+            /**
+             *  Call `ROLLBACK` explicitly. After this call
+             *  guard will not call `COMMIT` or `ROLLBACK`
+             *  in its destructor.
+             */
+            void rollback() {
+                this->gotta_fire = false;
+                this->rollback_func();
+            }
+
+          protected:
+            connection_ref connection;
+            std::function<void()> commit_func;
+            std::function<void()> rollback_func;
+            bool gotta_fire = true;
+        };
+    }
+}
+
+// #include "row_extractor.h"
+
+// #include "connection_holder.h"
+
+// #include "statement_cache.h"
+
+#include <sqlite3.h>
+#include <cstddef>  //  size_t
+#include <string>  //  std::string
+#include <list>  //  std::list
+#include <unordered_map>  //  std::unordered_map
+#include <functional>  //  std::hash
+#include <mutex>  //  std::mutex, std::lock_guard
+#include <utility>  //  std::move, std::exchange
+
+// #include "prepared_statement.h"
+
+namespace sqlite_orm {
+
+    /**
+     *  Snapshot of the counters of a storage's statement cache.
+     */
+    struct statement_cache_stats {
+        size_t capacity = 0;
+        size_t size = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+    };
+
+    namespace internal {
+
+        SQLITE_ORM_INLINE_VAR constexpr size_t default_statement_cache_capacity = 64;
+
+        /**
+         *  Provides a unique address for every expression type,
+         *  used to discriminate cached statements by the type of the expression they were prepared for.
+         */
+        template<class T>
+        struct expression_type_tag {
+            static const char id;
+        };
+
+        template<class T>
+        const char expression_type_tag<T>::id = 0;
+
+        /**
+         *  LRU cache of idle prepared statements, keyed on the database connection,
+         *  the expression type and the serialized SQL.
+         *
+         *  A statement is taken out of the cache while it is in use and given back afterwards,
+         *  hence the same statement is never used by two callers at the same time.
+         *  Statements are reset and their bindings cleared when they are given back.
+         */
+        struct statement_cache {
+            struct key_type {
+                sqlite3* db;
+                const void* expressionType;
+                std::string sql;
+
+                friend bool operator==(const key_type& lhs, const key_type& rhs) {
+                    return lhs.db == rhs.db && lhs.expressionType == rhs.expressionType && lhs.sql == rhs.sql;
+                }
+            };
+
+            struct key_hash {
+                size_t operator()(const key_type& key) const {
+                    size_t seed = std::hash<std::string>{}(key.sql);
+                    seed ^= std::hash<const void*>{}(key.db) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                    seed ^= std::hash<const void*>{}(key.expressionType) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                    return seed;
+                }
+            };
+
+            statement_cache(size_t capacity) : capacity{capacity} {}
+
+            statement_cache(const statement_cache&) = delete;
+            statement_cache& operator=(const statement_cache&) = delete;
+
+            ~statement_cache() {
+                this->clear();
+            }
+
+            /**
+             *  Takes an idle statement out of the cache.
+             *  @return The cached statement or nullptr on a cache miss.
+             */
+            sqlite3_stmt* take(const key_type& key) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                auto it = this->entries.find(key);
+                if (it == this->entries.end()) {
+                    ++this->misses;
+                    return nullptr;
+                }
+                ++this->hits;
+                sqlite3_stmt* stmt = it->second.stmt;
+                this->lru.erase(it->second.lruPosition);
+                this->entries.erase(it);
+                return stmt;
+            }
+
+            /**
+             *  Puts a statement taken by `take()` or freshly prepared back into the cache,
+             *  evicting the least recently used statement if the capacity is exceeded.
+             */
+            void give_back(key_type key, sqlite3_stmt* stmt) {
+                sqlite3_reset(stmt);
+                sqlite3_clear_bindings(stmt);
+
+                std::lock_guard<std::mutex> lock{this->mutex};
+                if (this->capacity == 0 || this->entries.count(key)) {
+                    sqlite3_finalize(stmt);
+                    return;
+                }
+                auto inserted = this->entries.emplace(std::move(key), entry{stmt, {}}).first;
+                this->lru.push_front(&inserted->first);
+                inserted->second.lruPosition = this->lru.begin();
+                this->shrink_to_capacity();
+            }
+
+            /**
+             *  Finalizes all cached statements.
+             */
+            void clear() {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                for (auto& p: this->entries) {
+                    sqlite3_finalize(p.second.stmt);
+                }
+                this->entries.clear();
+                this->lru.clear();
+            }
+
+            /**
+             *  Finalizes all cached statements prepared on the given connection.
+             */
+            void clear(sqlite3* db) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                for (auto it = this->entries.begin(); it != this->entries.end();) {
+                    if (it->first.db == db) {
+                        sqlite3_finalize(it->second.stmt);
+                        this->lru.erase(it->second.lruPosition);
+                        it = this->entries.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+
+            void set_capacity(size_t newCapacity) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                this->capacity = newCapacity;
+                this->shrink_to_capacity();
+            }
+
+            size_t get_capacity() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->capacity;
+            }
+
+            statement_cache_stats stats() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                statement_cache_stats res;
+                res.capacity = this->capacity;
+                res.size = this->entries.size();
+                res.hits = this->hits;
+                res.misses = this->misses;
+                res.evictions = this->evictions;
+                return res;
+            }
+
+          private:
+            struct entry {
+                sqlite3_stmt* stmt;
+                std::list<const key_type*>::iterator lruPosition;
+            };
+
+            //  expects the mutex to be locked
+            void shrink_to_capacity() {
+                while (this->entries.size() > this->capacity) {
+                    auto it = this->entries.find(*this->lru.back());
+                    sqlite3_finalize(it->second.stmt);
+                    this->lru.pop_back();
+                    this->entries.erase(it);
+                    ++this->evictions;
+                }
+            }
+
+            mutable std::mutex mutex;
+            size_t capacity;
+            std::unordered_map<key_type, entry, key_hash> entries;
+            //  most recently used at the front
+            std::list<const key_type*> lru;
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t evictions = 0;
+        };
+
+        /**
+         *  A prepared statement whose `sqlite3_stmt` is given back to a statement cache
+         *  instead of being finalized when it goes out of scope.
+         */
+        template<class T>
+        struct cached_prepared_statement_t : prepared_statement_t<T> {
+            cached_prepared_statement_t(prepared_statement_t<T> statement,
+                                        statement_cache& cache,
+                                        statement_cache::key_type key) :
+                prepared_statement_t<T>{std::move(statement)}, cache{cache}, key{std::move(key)} {}
+
+            cached_prepared_statement_t(cached_prepared_statement_t&& other) :
+                prepared_statement_t<T>{std::move(other)}, cache{other.cache}, key{std::move(other.key)} {}
+
+            ~cached_prepared_statement_t() {
+                if (this->stmt) {
+                    this->cache.give_back(std::move(this->key), std::exchange(this->stmt, nullptr));
+                }
+            }
+
+          private:
+            statement_cache& cache;
+            statement_cache::key_type key;
+        };
+    }
+}
+
+// #include "statement_finalizer.h"
+
+// #include "statement_profiler.h"
+
+#include <sqlite3.h>
+#include <cstddef>  //  size_t
+#include <cstdint>  //  uint64_t, int64_t
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <array>  //  std::array
+#include <map>  //  std::map
+#include <unordered_map>  //  std::unordered_map
+#include <chrono>  //  std::chrono::nanoseconds
+#include <mutex>  //  std::mutex, std::lock_guard
+#include <algorithm>  //  std::sort, std::min
+
+namespace sqlite_orm {
+
+    /**
+     *  Snapshot of the measurements of one SQL statement text collected by a storage's statement profiler.
+     *  Latencies are bucketed in powers of two nanoseconds, hence percentiles are upper bounds
+     *  of the bucket they fall in, i.e. they are accurate within a factor of two.
+     */
+    struct statement_profile {
+        std::string sql;
+        size_t count = 0;
+        size_t rows = 0;
+        std::chrono::nanoseconds total_time{0};
+        std::chrono::nanoseconds max_time{0};
+        std::chrono::nanoseconds p50{0};
+        std::chrono::nanoseconds p99{0};
+        /**
+         *  Number of runs per latency bucket, where bucket `i` counts the runs taking less than `2^i` ns
+         *  (and at least `2^(i - 1)` ns). Trailing empty buckets are trimmed.
+         */
+        std::vector<size_t> histogram;
+
+        std::chrono::nanoseconds mean_time() const {
+            return this->count ? this->total_time / int64_t(this->count) : std::chrono::nanoseconds{0};
+        }
+    };
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+    namespace internal {
+
+        /**
+         *  Collects count, rows stepped and a latency histogram per SQL text,
+         *  fed by `sqlite3_trace_v2()` with `SQLITE_TRACE_PROFILE` and `SQLITE_TRACE_ROW` events.
+         *  The SQL text is the normalized one if SQLite was compiled with `SQLITE_ENABLE_NORMALIZE`,
+         *  otherwise the text the statement was prepared with. Statements generated by the storage
+         *  bind their values, hence they are grouped properly either way.
+         *
+         *  Events can come from several connections (writer and readers) at the same time,
+         *  therefore all state is guarded by a mutex.
+         */
+        struct statement_profiler {
+            static constexpr size_t buckets_count = 48;
+
+            void on_row(sqlite3_stmt* stmt) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                ++this->pendingRows[stmt];
+            }
+
+            void on_profile(sqlite3_stmt* stmt, uint64_t nanoseconds) {
+                std::string sql = statement_text(stmt);
+                std::lock_guard<std::mutex> lock{this->mutex};
+                auto& entry = this->entries[std::move(sql)];
+                ++entry.count;
+                entry.totalNanoseconds += nanoseconds;
+                if (nanoseconds > entry.maxNanoseconds) {
+                    entry.maxNanoseconds = nanoseconds;
+                }
+                ++entry.histogram[bucket_of(nanoseconds)];
+                auto rowsIt = this->pendingRows.find(stmt);
+                if (rowsIt != this->pendingRows.end()) {
+                    entry.rows += rowsIt->second;
+                    this->pendingRows.erase(rowsIt);
+                }
+            }
+
+            /**
+             *  Returns the profiles ordered by descending total time.
+             */
+            std::vector<statement_profile> snapshot() const {
+                std::vector<statement_profile> result;
+                {
+                    std::lock_guard<std::mutex> lock{this->mutex};
+                    result.reserve(this->entries.size());
+                    for (auto& p: this->entries) {
+                        result.push_back(make_profile(p.first, p.second));
+                    }
+                }
+                std::sort(result.begin(), result.end(), [](const statement_profile& lhs, const statement_profile& rhs) {
+                    return lhs.total_time > rhs.total_time;
+                });
+                return result;
+            }
+
+            void clear() {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                this->entries.clear();
+                this->pendingRows.clear();
+            }
+
+            static int trace_callback(unsigned event, void* context, void* p, void* x) {
+                auto& profiler = *static_cast<statement_profiler*>(context);
+                switch (event) {
+                    case SQLITE_TRACE_ROW:
+                        profiler.on_row(static_cast<sqlite3_stmt*>(p));
+                        break;
+                    case SQLITE_TRACE_PROFILE:
+                        profiler.on_profile(static_cast<sqlite3_stmt*>(p),
+                                            uint64_t(*static_cast<sqlite3_int64*>(x)));
+                        break;
+                }
+                return 0;
+            }
+
+          private:
+            struct entry {
+                size_t count = 0;
+                size_t rows = 0;
+                uint64_t totalNanoseconds = 0;
+                uint64_t maxNanoseconds = 0;
+                std::array<size_t, buckets_count> histogram{};
+            };
+
+            static std::string statement_text(sqlite3_stmt* stmt) {
+#if SQLITE_VERSION_NUMBER >= 3026000 and defined(SQLITE_ENABLE_NORMALIZE)
+                if (const char* sql = sqlite3_normalized_sql(stmt)) {
+                    return sql;
+                }
+#endif
+                if (const char* sql = sqlite3_sql(stmt)) {
+                    return sql;
+                }
+                return {};
+            }
+
+            static size_t bucket_of(uint64_t nanoseconds) {
+                size_t bucket = 0;
+                while (nanoseconds && bucket < buckets_count - 1) {
+                    nanoseconds >>= 1;
+                    ++bucket;
+                }
+                return bucket;
+            }
+
+            static std::chrono::nanoseconds bucket_upper_bound(size_t bucket) {
+                return std::chrono::nanoseconds{int64_t(1) << bucket};
+            }
+
+            static std::chrono::nanoseconds percentile(const entry& entry, double fraction) {
+                const auto rank = size_t(fraction * double(entry.count - 1)) + 1;
+                size_t cumulated = 0;
+                for (size_t i = 0; i < buckets_count; ++i) {
+                    cumulated += entry.histogram[i];
+                    if (cumulated >= rank) {
+                        //  the maximum is exact and tighter than the last bucket's bound
+                        return std::min(bucket_upper_bound(i), std::chrono::nanoseconds(entry.maxNanoseconds));
+                    }
+                }
+                return std::chrono::nanoseconds(entry.maxNanoseconds);
+            }
+
+            static statement_profile make_profile(const std::string& sql, const entry& entry) {
+                statement_profile profile;
+                profile.sql = sql;
+                profile.count = entry.count;
+                profile.rows = entry.rows;
+                profile.total_time = std::chrono::nanoseconds(entry.totalNanoseconds);
+                profile.max_time = std::chrono::nanoseconds(entry.maxNanoseconds);
+                profile.p50 = percentile(entry, 0.5);
+                profile.p99 = percentile(entry, 0.99);
+                size_t used = buckets_count;
+                while (used > 0 && entry.histogram[used - 1] == 0) {
+                    --used;
+                }
+                profile.histogram.assign(entry.histogram.begin(), entry.histogram.begin() + used);
+                return profile;
+            }
+
+            mutable std::mutex mutex;
+            std::map<std::string, entry> entries;
+            std::unordered_map<sqlite3_stmt*, size_t> pendingRows;
+        };
+    }
+#endif
+}
+
+// #include "query_plan.h"
+
+#include <sqlite3.h>
+#include <cstring>  //  std::strlen
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <utility>  //  std::move
+
+// #include "error_code.h"
+
+// #include "statement_finalizer.h"
+
+// #include "util.h"
+
+namespace sqlite_orm {
+
+    enum class query_plan_operation {
+        other,
+        scan,
+        search,
+    };
+
+    /**
+     *  One row of the output of `EXPLAIN QUERY PLAN`, see https://sqlite.org/eqp.html.
+     *  Nodes form a tree through `parent`, which is the `id` of the parent node or 0 for top-level nodes.
+     *  The fields following `detail` are parsed from it.
+     */
+    struct query_plan_node {
+        int id = 0;
+        int parent = 0;
+        std::string detail;
+
+        /**
+         *  Whether the node is a full scan (`SCAN`) or a lookup (`SEARCH`) of a table.
+         */
+        query_plan_operation operation = query_plan_operation::other;
+        /**
+         *  Name of the table scanned or searched, empty if the node isn't about a table.
+         */
+        std::string table;
+        /**
+         *  Name of the index used, empty if none or an automatic index is used.
+         */
+        std::string index;
+        bool covering_index = false;
+        bool automatic_index = false;
+        /**
+         *  Whether the rowid or the primary key of a WITHOUT ROWID table is used.
+         */
+        bool primary_key = false;
+        bool virtual_table = false;
+
+        bool is_scan() const {
+            return this->operation == query_plan_operation::scan;
+        }
+
+        bool is_search() const {
+            return this->operation == query_plan_operation::search;
+        }
+    };
+
+    namespace internal {
+
+        /**
+         *  Parses the detail text of a query plan node, e.g.
+         *  "SCAN users", "SEARCH TABLE visits USING COVERING INDEX idx_visits (user_id=?)"
+         *  or "SEARCH users USING INTEGER PRIMARY KEY (rowid=?)".
+         */
+        inline query_plan_node make_query_plan_node(int id, int parent, std::string detail) {
+            query_plan_node node;
+            node.id = id;
+            node.parent = parent;
+            node.detail = std::move(detail);
+
+            std::string rest = node.detail;
+            auto consume = [&rest](const char* prefix) {
+                const size_t length = std::strlen(prefix);
+                if (rest.compare(0, length, prefix) != 0) {
+                    return false;
+                }
+                rest.erase(0, length);
+                return true;
+            };
+            auto takeWord = [&rest]() {
+                std::string word = rest.substr(0, rest.find(' '));
+                rest.erase(0, word.size());
+                return word;
+            };
+
+            if (consume("SCAN ")) {
+                node.operation = query_plan_operation::scan;
+            } else if (consume("SEARCH ")) {
+                node.operation = query_plan_operation::search;
+            } else {
+                return node;
+            }
+            //  prior to SQLite 3.36
+            consume("TABLE ");
+            //  subqueries and constant rows are no tables
+            if (rest.empty() || rest[0] == '(' || consume("CONSTANT ROW")) {
+                return node;
+            }
+            node.table = takeWord();
+            if (consume(" AS ")) {
+                takeWord();
+            }
+            node.virtual_table = consume(" VIRTUAL TABLE");
+            if (consume(" USING ")) {
+                if (consume("INTEGER PRIMARY KEY") || consume("PRIMARY KEY")) {
+                    node.primary_key = true;
+                } else {
+                    node.automatic_index = consume("AUTOMATIC ");
+                    consume("PARTIAL ");
+                    node.covering_index = consume("COVERING ");
+                    if (consume("INDEX ") && !rest.empty() && rest[0] != '(') {
+                        node.index = takeWord();
+                    }
+                }
+            }
+            return node;
+        }
+
+        /**
+         *  Runs `EXPLAIN QUERY PLAN` for the given SQL.
+         */
+        inline std::vector<query_plan_node> query_plan_of(sqlite3* db, const std::string& sql) {
+            std::vector<query_plan_node> result;
+            statement_finalizer finalizer{prepare_stmt(db, "EXPLAIN QUERY PLAN " + sql)};
+            perform_steps(finalizer.get(), [&result](sqlite3_stmt* stmt) {
+                const char* detail = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+                result.push_back(make_query_plan_node(sqlite3_column_int(stmt, 0),
+                                                      sqlite3_column_int(stmt, 1),
+                                                      detail ? detail : ""));
+            });
+            return result;
+        }
+
+        /**
+         *  Returns the number of rows of a table, or -1 if `table` isn't a table, e.g. a CTE.
+         */
+        inline sqlite3_int64 table_rows_count(sqlite3* db, const std::string& table) {
+            sqlite3_stmt* stmt = nullptr;
+            const std::string sql = "SELECT count(*) FROM " + quote_identifier(table);
+            if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+                return -1;
+            }
+            statement_finalizer finalizer{stmt};
+            sqlite3_int64 count = -1;
+            perform_steps(stmt, [&count](sqlite3_stmt* stmt) {
+                count = sqlite3_column_int64(stmt, 0);
+            });
+            return count;
+        }
+    }
+}
+
+// #include "reader_pool.h"
+
+#include <sqlite3.h>
+#include <cstddef>  //  size_t
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <memory>  //  std::unique_ptr, std::make_unique
+#include <functional>  //  std::function
+#include <mutex>  //  std::mutex, std::lock_guard
+
+// #include "functional/cxx_universal.h"
+
+// #include "functional/cxx_type_traits_polyfill.h"
+
+// #include "open_options.h"
+
+// #include "connection_holder.h"
+
+// #include "select_constraints.h"
+
+// #include "prepared_statement.h"
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+        /**
+         *  Whether an expression only reads from the database and hence may run on a pooled reader connection.
+         */
+        template<class T>
+        SQLITE_ORM_INLINE_VAR constexpr bool is_read_only_expression_v =
+            polyfill::disjunction<polyfill::is_specialization_of<T, select_t>,
+                                  polyfill::is_specialization_of<T, get_all_t>,
+                                  polyfill::is_specialization_of<T, get_all_pointer_t>,
+#ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
+                                  polyfill::is_specialization_of<T, get_all_optional_t>,
+                                  polyfill::is_specialization_of<T, get_optional_t>,
+#endif
+                                  polyfill::is_specialization_of<T, get_t>,
+                                  polyfill::is_specialization_of<T, get_pointer_t>,
+                                  polyfill::is_specialization_of<T, get_many_t>>::value;
+
+        template<class T>
+        using is_read_only_expression = polyfill::bool_constant<is_read_only_expression_v<T>>;
+
+        /**
+         *  Pool of read-only connections to the same database file.
+         *
+         *  Reader connections are opened on demand, up to the pool's capacity, and stay opened
+         *  as long as they are part of the pool. A checkout hands out an idle reader if there is one,
+         *  otherwise it opens another reader or shares the least busy one if the pool is exhausted.
+         */
+        struct reader_pool {
+            /**
+             *  @param options Options of the storage, from which the options of the readers are derived.
+             */
+            reader_pool(std::string filename,
+                        std::function<void(sqlite3*)> didOpenDb,
+                        std::function<void(sqlite3*)> willCloseDb,
+                        const open_options& options = {}) :
+                filename(std::move(filename)), didOpenDb(std::move(didOpenDb)), willCloseDb(std::move(willCloseDb)),
+                options(make_reader_open_options(options)) {}
+
+            reader_pool(const reader_pool&) = delete;
+
+            ~reader_pool() {
+                this->set_capacity(0);
+            }
+
+            /**
+             *  Sets the maximum number of reader connections.
+             *  Readers exceeding the new capacity are closed as soon as they are not in use anymore.
+             */
+            void set_capacity(size_t newCapacity) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                this->capacity = newCapacity;
+                while (this->pooledCount > this->capacity) {
+                    this->readers[--this->pooledCount]->release();
+                }
+            }
+
+            size_t get_capacity() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->capacity;
+            }
+
+            /**
+             *  @param fallback Connection handed out if the pool's capacity is zero.
+             */
+            connection_ref checkout(connection_holder& fallback) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                connection_holder* leastBusy = nullptr;
+                for (size_t i = 0; i < this->pooledCount; ++i) {
+                    connection_holder* reader = this->readers[i].get();
+                    //  a reader not in use is only retained by the pool itself
+                    if (reader->retain_count() == 1) {
+                        return {*reader};
+                    }
+                    if (!leastBusy || reader->retain_count() < leastBusy->retain_count()) {
+                        leastBusy = reader;
+                    }
+                }
+                if (this->pooledCount < this->capacity) {
+                    if (this->pooledCount == this->readers.size()) {
+                        this->readers.push_back(std::make_unique<connection_holder>(this->filename,
+                                                                                    this->didOpenDb,
+                                                                                    this->willCloseDb,
+                                                                                    this->options));
+                    }
+                    connection_holder* reader = this->readers[this->pooledCount].get();
+                    reader->retain();
+                    ++this->pooledCount;
+                    return {*reader};
+                }
+                return {leastBusy ? *leastBusy : fallback};
+            }
+
+            /**
+             *  Calls `f` with every opened reader connection.
+             */
+            template<class F>
+            void for_each_opened(F&& f) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                for (auto& reader: this->readers) {
+                    if (reader->is_open()) {
+                        f(reader->get());
+                    }
+                }
+            }
+
+          private:
+            const std::string filename;
+            const std::function<void(sqlite3*)> didOpenDb;
+            const std::function<void(sqlite3*)> willCloseDb;
+            const open_options options;
+
+            mutable std::mutex mutex;
+            size_t capacity = 0;
+            //  number of leading readers retained by the pool
+            size_t pooledCount = 0;
+            //  never shrinks, such that connection references stay valid
+            std::vector<std::unique_ptr<connection_holder>> readers;
+        };
+    }
+}
+
+// #include "backup.h"
+
+#include <sqlite3.h>
+#include <system_error>  //  std::system_error
+#include <string>  //  std::string
+#include <memory>
+#include <utility>  //  std::move, std::exchange
+#include <chrono>  //  std::chrono::milliseconds
+#include <thread>  //  std::thread
+#include <mutex>  //  std::mutex, std::unique_lock, std::lock_guard
+#include <condition_variable>  //  std::condition_variable
+#include <functional>  //  std::function
+#include <exception>  //  std::exception_ptr, std::make_exception_ptr, std::rethrow_exception, std::current_exception
+
+// #include "error_code.h"
+
+// #include "connection_holder.h"
+
+namespace sqlite_orm {
+
+    /**
+     *  Progress of a backup running in the background.
+     */
+    struct backup_progress {
+        int remaining = 0;
+        int pagecount = 0;
+        /**
+         *  How many times the backup started over because the source database was written
+         *  through another connection than the one being backed up.
+         */
+        int restarts = 0;
+
+        double fraction() const {
+            return this->pagecount > 0 ? double(this->pagecount - this->remaining) / this->pagecount : 0;
+        }
+    };
+
+    struct backup_options {
+        /**
+         *  Number of pages copied per step. The source database is locked only while a step is copying pages.
+         */
+        int pages_per_step = 100;
+        /**
+         *  Pause between steps, letting writers of the source database proceed.
+         */
+        std::chrono::milliseconds pause{10};
+        /**
+         *  Called on the background thread after every step.
+         */
+        std::function<void(const backup_progress&)> on_progress;
+    };
+
+    namespace internal {
+
+        /**
+         *  A backup class. Don't construct it as is, call storage.make_backup_from or storage.make_backup_to instead.
+         *  An instance of this class represents a wrapper around sqlite3_backup pointer. Use this class
+         *  to have maximum control on a backup operation. In case you need a single backup in one line you
+         *  can skip creating a backup_t instance and just call storage.backup_from or storage.backup_to function.
+         */
+        struct backup_t {
+            /**
+             *  @param holder_ Connection owned by the backup, if any.
+             *  @param otherHolder_ Second connection owned by the backup, if both ends are owned.
+             */
+            backup_t(connection_ref to_,
+                     const std::string& zDestName,
+                     connection_ref from_,
+                     const std::string& zSourceName,
+                     std::unique_ptr<connection_holder> holder_,
+                     std::unique_ptr<connection_holder> otherHolder_ = {}) :
+                handle(sqlite3_backup_init(to_.get(), zDestName.c_str(), from_.get(), zSourceName.c_str())),
+                holder(std::move(holder_)), otherHolder(std::move(otherHolder_)), to(to_), from(from_) {
+                if (!this->handle) {
+                    throw std::system_error{orm_error_code::failed_to_init_a_backup};
+                }
+            }
+
+            backup_t(backup_t&& other) :
+                handle(std::exchange(other.handle, nullptr)), holder(std::move(other.holder)),
+                otherHolder(std::move(other.otherHolder)), to(std::move(other.to)), from(std::move(other.from)) {}
+
+            ~backup_t() {
+                if (this->handle) {
+                    (void)sqlite3_backup_finish(this->handle);
+                }
+            }
+
+            /**
+             *  Calls sqlite3_backup_step with pages argument
+             */
+            int step(int pages) {
+                return sqlite3_backup_step(this->handle, pages);
+            }
+
+            /**
+             *  Returns sqlite3_backup_remaining result
+             */
+            int remaining() const {
+                return sqlite3_backup_remaining(this->handle);
+            }
+
+            /**
+             *  Returns sqlite3_backup_pagecount result
+             */
+            int pagecount() const {
+                return sqlite3_backup_pagecount(this->handle);
+            }
+
+          protected:
+            sqlite3_backup* handle = nullptr;
+            std::unique_ptr<connection_holder> holder;
+            std::unique_ptr<connection_holder> otherHolder;
+            connection_ref to;
+            connection_ref from;
+        };
+
+        /**
+         *  Runs a backup on a background thread a few pages at a time, pausing between steps.
+         *  Don't construct it as is, call storage.start_backup_to instead.
+         *  The backup runs on connections of its own, hence it may outlive the storage.
+         *  A busy or locked source database is retried after the pause.
+         *  Destroying the runner cancels the backup and waits for the thread to finish.
+         */
+        class backup_runner {
+          public:
+            enum class status {
+                running,
+                done,
+                cancelled,
+                failed,
+            };
+
+            backup_runner(backup_t backup, backup_options options) :
+                state{std::make_unique<shared_state>(std::move(backup))} {
+                this->worker = std::thread{&backup_runner::run, this->state.get(), std::move(options)};
+            }
+
+            backup_runner(backup_runner&&) = default;
+
+            ~backup_runner() {
+                if (this->worker.joinable()) {
+                    this->cancel();
+                    this->worker.join();
+                }
+            }
+
+            /**
+             *  Stops the backup after the current step. The destination is left incomplete.
+             */
+            void cancel() {
+                std::lock_guard<std::mutex> lock{this->state->mutex};
+                this->state->cancelled = true;
+                this->state->changed.notify_all();
+            }
+
+            /**
+             *  Waits for the backup to finish.
+             *  @return Whether the backup completed, false if it was cancelled.
+             *  @throws std::system_error if the backup failed.
+             */
+            bool wait() {
+                if (this->worker.joinable()) {
+                    this->worker.join();
+                }
+                if (this->state->error) {
+                    std::rethrow_exception(this->state->error);
+                }
+                return this->state->currentStatus == status::done;
+            }
+
+            status get_status() const {
+                std::lock_guard<std::mutex> lock{this->state->mutex};
+                return this->state->currentStatus;
+            }
+
+            backup_progress progress() const {
+                std::lock_guard<std::mutex> lock{this->state->mutex};
+                return this->state->progress;
+            }
+
+          private:
+            /**
+             *  State shared with the thread, which owns the backup and its connections
+             *  such that they outlive the thread.
+             */
+            struct shared_state {
+                explicit shared_state(backup_t backup) : backup{std::move(backup)} {}
+
+                backup_t backup;
+                mutable std::mutex mutex;
+                std::condition_variable changed;
+                bool cancelled = false;
+                status currentStatus = status::running;
+                backup_progress progress;
+                std::exception_ptr error;
+            };
+
+            static void run(shared_state* state, backup_options options) {
+                backup_t& backup = state->backup;
+                int previousCopied = -1;
+                for (;;) {
+                    const int rc = backup.step(options.pages_per_step);
+                    backup_progress progress;
+                    {
+                        std::unique_lock<std::mutex> lock{state->mutex};
+                        progress = state->progress;
+                        progress.remaining = backup.remaining();
+                        progress.pagecount = backup.pagecount();
+                        //  sqlite3_backup_step() starts over if the source was written through another connection,
+                        //  in which case a step doesn't add to the pages copied so far
+                        const int copied = progress.pagecount - progress.remaining;
+                        if (rc == SQLITE_OK && previousCopied >= 0 && copied <= previousCopied) {
+                            ++progress.restarts;
+                        }
+                        previousCopied = copied;
+                        state->progress = progress;
+                    }
+                    std::exception_ptr callbackError;
+                    if (options.on_progress) {
+                        try {
+                            options.on_progress(progress);
+                        } catch (...) {
+                            callbackError = std::current_exception();
+                        }
+                    }
+
+                    std::unique_lock<std::mutex> lock{state->mutex};
+                    if (callbackError) {
+                        state->error = std::move(callbackError);
+                        state->currentStatus = status::failed;
+                        return;
+                    }
+                    if (rc == SQLITE_DONE) {
+                        state->currentStatus = status::done;
+                        return;
+                    }
+                    if (rc != SQLITE_OK && rc != SQLITE_BUSY && rc != SQLITE_LOCKED) {
+                        state->error = std::make_exception_ptr(std::system_error{sqlite_errc(rc)});
+                        state->currentStatus = status::failed;
+                        return;
+                    }
+                    state->changed.wait_for(lock, options.pause, [state] {
+                        return state->cancelled;
+                    });
+                    if (state->cancelled) {
+                        state->currentStatus = status::cancelled;
+                        return;
+                    }
+                }
+            }
+
+            std::unique_ptr<shared_state> state;
+            std::thread worker;
+        };
     }
 }
 
-namespace sqlite_orm {
-
-    namespace internal {
-        struct storage_base;
-
-        template<class T>
-        int getPragmaCallback(void* data, int argc, char** argv, char** x) {
-            return extract_single_value<T>(data, argc, argv, x);
-        }
+// #include "wal_checkpoint.h"
 
-        template<>
-        inline int getPragmaCallback<std::vector<std::string>>(void* data, int argc, char** argv, char**) {
-            auto& res = *(std::vector<std::string>*)data;
-            res.reserve(argc);
-            const auto rowExtractor = column_text_extractor<std::string>();
-            for (int i = 0; i < argc; ++i) {
-                auto rowString = rowExtractor.extract(argv[i]);
-                res.push_back(std::move(rowString));
-            }
-            return 0;
-        }
+#include <sqlite3.h>
+#include <string>  //  std::string
+#include <utility>  //  std::move
+#include <thread>  //  std::thread
+#include <mutex>  //  std::mutex, std::unique_lock, std::lock_guard
+#include <condition_variable>  //  std::condition_variable
+#include <functional>  //  std::function
+#include <chrono>  //  std::chrono::milliseconds
+#include <system_error>  //  std::system_error
 
-        struct pragma_t {
-            using get_connection_t = std::function<internal::connection_ref()>;
+// #include "error_code.h"
 
-            pragma_t(get_connection_t get_connection_) : get_connection(std::move(get_connection_)) {}
+// #include "connection_holder.h"
 
-            std::vector<std::string> module_list() {
-                return this->get_pragma<std::vector<std::string>>("module_list");
-            }
+// #include "util.h"
 
-            bool recursive_triggers() {
-                return bool(this->get_pragma<int>("recursive_triggers"));
-            }
+namespace sqlite_orm {
 
-            void recursive_triggers(bool value) {
-                this->set_pragma("recursive_triggers", int(value));
-            }
+    /**
+     *  Checkpoint modes of `sqlite3_wal_checkpoint_v2()`, see https://sqlite.org/c3ref/wal_checkpoint_v2.html.
+     */
+    enum class checkpoint_mode {
+        /**
+         *  Checkpoints as many frames as possible without waiting for readers or writers.
+         */
+        passive = SQLITE_CHECKPOINT_PASSIVE,
+        /**
+         *  Waits for writers, then checkpoints all frames, waiting for readers of older frames.
+         */
+        full = SQLITE_CHECKPOINT_FULL,
+        /**
+         *  Like `full`, and waits for all readers such that the next writer starts over at the beginning of the WAL.
+         */
+        restart = SQLITE_CHECKPOINT_RESTART,
+        /**
+         *  Like `restart`, and truncates the WAL file to zero bytes.
+         */
+        truncate = SQLITE_CHECKPOINT_TRUNCATE,
+    };
 
-            void busy_timeout(int value) {
-                this->set_pragma("busy_timeout", value);
-            }
+    struct checkpoint_result {
+        /**
+         *  Number of frames in the WAL, -1 if the database isn't in WAL mode.
+         */
+        int log_frames = -1;
+        /**
+         *  Number of frames of the WAL checkpointed into the database, -1 if the database isn't in WAL mode.
+         */
+        int checkpointed_frames = -1;
+        /**
+         *  Whether the checkpoint couldn't complete because of readers or writers
+         *  still busy after the busy handler gave up. Never set for `checkpoint_mode::passive`.
+         */
+        bool busy = false;
+    };
 
-            int busy_timeout() {
-                return this->get_pragma<int>("busy_timeout");
-            }
+    struct background_checkpoint_options {
+        /**
+         *  A checkpoint runs after a commit left at least this many pages in the WAL.
+         */
+        int wal_pages_threshold = 1000;
+        /**
+         *  Modes other than `checkpoint_mode::passive` lock out writers while the checkpoint runs,
+         *  hence writers should have a busy timeout then.
+         */
+        checkpoint_mode mode = checkpoint_mode::passive;
+        /**
+         *  Busy timeout of the checkpointer's connection, used by all modes but `checkpoint_mode::passive`.
+         */
+        std::chrono::milliseconds busy_timeout{1000};
+        /**
+         *  Called on the background thread after every checkpoint.
+         */
+        std::function<void(const checkpoint_result&)> on_checkpoint;
+        /**
+         *  Called on the background thread if a checkpoint fails.
+         */
+        std::function<void(const std::system_error&)> on_error;
+    };
 
-            sqlite_orm::locking_mode locking_mode() {
-                return this->get_pragma<sqlite_orm::locking_mode>("locking_mode");
-            }
+    namespace internal {
 
-            void locking_mode(sqlite_orm::locking_mode value) {
-                this->set_pragma("locking_mode", value);
+        inline checkpoint_result wal_checkpoint(sqlite3* db, checkpoint_mode mode, const char* schema = "main") {
+            checkpoint_result result;
+            const int rc =
+                sqlite3_wal_checkpoint_v2(db, schema, int(mode), &result.log_frames, &result.checkpointed_frames);
+            if (rc == SQLITE_BUSY) {
+                result.busy = true;
+            } else if (rc != SQLITE_OK) {
+                throw_translated_sqlite_error(db);
             }
+            return result;
+        }
 
-            sqlite_orm::journal_mode journal_mode() {
-                return this->get_pragma<sqlite_orm::journal_mode>("journal_mode");
+        /**
+         *  Checkpoints a database on a background thread through a connection of its own,
+         *  whenever `notify()` reports the WAL of the database grew beyond a threshold.
+         *  `wal_hook_callback` is meant to be installed as the `sqlite3_wal_hook()` of the writer connection,
+         *  which also disables auto-checkpoints of the writer such that commits never checkpoint.
+         *  Destroying the checkpointer waits for a running checkpoint to finish.
+         */
+        class background_checkpointer {
+          public:
+            background_checkpointer(const std::string& filename,
+                                    const open_options& openOptions,
+                                    background_checkpoint_options options) :
+                holder{filename, {}, {}, openOptions}, options{std::move(options)} {
+                this->holder.retain();
+                sqlite3_busy_timeout(this->holder.get(), int(this->options.busy_timeout.count()));
+                this->worker = std::thread{&background_checkpointer::run, this};
             }
 
-            void journal_mode(sqlite_orm::journal_mode value) {
-                this->journal_mode_ = -1;
-                this->set_pragma("journal_mode", value);
-                this->journal_mode_ = static_cast<decltype(this->journal_mode_)>(value);
-            }
+            background_checkpointer(const background_checkpointer&) = delete;
+            background_checkpointer& operator=(const background_checkpointer&) = delete;
 
-            /**
-             *  https://www.sqlite.org/pragma.html#pragma_application_id
-             */
-            int application_id() {
-                return this->get_pragma<int>("application_id");
+            ~background_checkpointer() {
+                {
+                    std::lock_guard<std::mutex> lock{this->mutex};
+                    this->stopping = true;
+                }
+                this->changed.notify_one();
+                this->worker.join();
+                //  a connection failing to close now is closed by the holder's destructor, ignoring errors
+                try {
+                    this->holder.release();
+                } catch (...) {
+                }
             }
 
             /**
-             *  https://www.sqlite.org/pragma.html#pragma_application_id
+             *  Reports the number of pages in the WAL after a commit.
              */
-            void application_id(int value) {
-                this->set_pragma("application_id", value);
+            void notify(int walPages) {
+                if (walPages < this->options.wal_pages_threshold) {
+                    return;
+                }
+                {
+                    std::lock_guard<std::mutex> lock{this->mutex};
+                    this->pending = true;
+                }
+                this->changed.notify_one();
             }
 
-            int synchronous() {
-                return this->get_pragma<int>("synchronous");
+            static int wal_hook_callback(void* data, sqlite3*, const char*, int walPages) {
+                static_cast<background_checkpointer*>(data)->notify(walPages);
+                return SQLITE_OK;
             }
 
-            void synchronous(int value) {
-                this->synchronous_ = -1;
-                this->set_pragma("synchronous", value);
-                this->synchronous_ = value;
+          private:
+            void run() {
+                std::unique_lock<std::mutex> lock{this->mutex};
+                for (;;) {
+                    this->changed.wait(lock, [this] {
+                        return this->pending || this->stopping;
+                    });
+                    if (this->stopping) {
+                        return;
+                    }
+                    this->pending = false;
+                    lock.unlock();
+                    try {
+                        //  reading the schema makes the connection notice the database is in WAL mode,
+                        //  otherwise there is no WAL to checkpoint as far as the connection is concerned
+                        perform_void_exec(this->holder.get(), "PRAGMA schema_version");
+                        auto result = internal::wal_checkpoint(this->holder.get(), this->options.mode);
+                        call_back(this->options.on_checkpoint, result);
+                    } catch (const std::system_error& e) {
+                        call_back(this->options.on_error, e);
+                    }
+                    lock.lock();
+                }
             }
 
-            int user_version() {
-                return this->get_pragma<int>("user_version");
+            //  an exception escaping the background thread would terminate the program
+            template<class F, class Arg>
+            static void call_back(const F& callback, const Arg& arg) {
+                if (!callback) {
+                    return;
+                }
+                try {
+                    callback(arg);
+                } catch (...) {
+                }
             }
 
-            void user_version(int value) {
-                this->set_pragma("user_version", value);
-            }
+            connection_holder holder;
+            background_checkpoint_options options;
+            std::mutex mutex;
+            std::condition_variable changed;
+            bool pending = false;
+            bool stopping = false;
+            std::thread worker;
+        };
+    }
+}
 
-            int auto_vacuum() {
-                return this->get_pragma<int>("auto_vacuum");
-            }
+// #include "change_notifier.h"
 
-            void auto_vacuum(int value) {
-                this->set_pragma("auto_vacuum", value);
-            }
+#include <sqlite3.h>
+#include <cstddef>  //  size_t
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <map>  //  std::map
+#include <functional>  //  std::function
+#include <mutex>  //  std::mutex, std::lock_guard
+#include <utility>  //  std::move
+#include <algorithm>  //  std::find_if
 
-            int max_page_count() {
-                return this->get_pragma<int>("max_page_count");
-            }
+namespace sqlite_orm {
 
-            void max_page_count(int value) {
-                this->set_pragma("max_page_count", value);
-            }
+    enum class change_kind {
+        insert = SQLITE_INSERT,
+        update = SQLITE_UPDATE,
+        remove = SQLITE_DELETE,
+    };
 
-            std::vector<std::string> integrity_check() {
-                return this->get_pragma<std::vector<std::string>>("integrity_check");
-            }
+    /**
+     *  A row inserted, updated or deleted by a committed transaction.
+     */
+    struct row_change {
+        change_kind kind;
+        sqlite3_int64 rowid;
+    };
 
-            template<class T>
-            std::vector<std::string> integrity_check(T table_name) {
-                std::ostringstream ss;
-                ss << "integrity_check(" << table_name << ")" << std::flush;
-                return this->get_pragma<std::vector<std::string>>(ss.str());
-            }
+    inline bool operator==(const row_change& lhs, const row_change& rhs) {
+        return lhs.kind == rhs.kind && lhs.rowid == rhs.rowid;
+    }
 
-            std::vector<std::string> integrity_check(int n) {
-                std::ostringstream ss;
-                ss << "integrity_check(" << n << ")" << std::flush;
-                return this->get_pragma<std::vector<std::string>>(ss.str());
-            }
+    namespace internal {
 
-            std::vector<std::string> quick_check() {
-                return this->get_pragma<std::vector<std::string>>("quick_check");
+        /**
+         *  Holds the mutex of a connection, such that no other thread uses the connection meanwhile.
+         *  The mutex is recursive, and there is none unless SQLite runs in serialized mode.
+         */
+        class connection_mutex_lock {
+          public:
+            explicit connection_mutex_lock(sqlite3* db) : mutex{sqlite3_db_mutex(db)} {
+                sqlite3_mutex_enter(this->mutex);
             }
 
-            // will include generated columns in response as opposed to table_info
-            std::vector<sqlite_orm::table_xinfo> table_xinfo(const std::string& tableName) const {
-                auto connection = this->get_connection();
+            connection_mutex_lock(const connection_mutex_lock&) = delete;
+            connection_mutex_lock& operator=(const connection_mutex_lock&) = delete;
 
-                std::vector<sqlite_orm::table_xinfo> result;
-                std::ostringstream ss;
-                ss << "PRAGMA "
-                      "table_xinfo("
-                   << streaming_identifier(tableName) << ")" << std::flush;
-                perform_exec(
-                    connection.get(),
-                    ss.str(),
-                    [](void* data, int argc, char** argv, char**) -> int {
-                        auto& res = *(std::vector<sqlite_orm::table_xinfo>*)data;
-                        if (argc) {
-                            auto index = 0;
-                            auto cid = atoi(argv[index++]);
-                            std::string name = argv[index++];
-                            std::string type = argv[index++];
-                            bool notnull = !!atoi(argv[index++]);
-                            std::string dflt_value = argv[index] ? argv[index] : "";
-                            ++index;
-                            auto pk = atoi(argv[index++]);
-                            auto hidden = atoi(argv[index++]);
-                            res.emplace_back(cid,
-                                             std::move(name),
-                                             std::move(type),
-                                             notnull,
-                                             std::move(dflt_value),
-                                             pk,
-                                             hidden);
-                        }
-                        return 0;
-                    },
-                    &result);
-                return result;
+            ~connection_mutex_lock() {
+                sqlite3_mutex_leave(this->mutex);
             }
 
-            std::vector<sqlite_orm::table_info> table_info(const std::string& tableName) const {
-                auto connection = this->get_connection();
+          private:
+            sqlite3_mutex* mutex;
+        };
 
-                std::ostringstream ss;
-                ss << "PRAGMA "
-                      "table_info("
-                   << streaming_identifier(tableName) << ")" << std::flush;
-                std::vector<sqlite_orm::table_info> result;
-                perform_exec(
-                    connection.get(),
-                    ss.str(),
-                    [](void* data, int argc, char** argv, char**) -> int {
-                        auto& res = *(std::vector<sqlite_orm::table_info>*)data;
-                        if (argc) {
-                            auto index = 0;
-                            auto cid = atoi(argv[index++]);
-                            std::string name = argv[index++];
-                            std::string type = argv[index++];
-                            bool notnull = !!atoi(argv[index++]);
-                            std::string dflt_value = argv[index] ? argv[index] : "";
-                            ++index;
-                            auto pk = atoi(argv[index++]);
-                            res.emplace_back(cid, std::move(name), std::move(type), notnull, std::move(dflt_value), pk);
-                        }
-                        return 0;
-                    },
-                    &result);
-                return result;
+        /**
+         *  Collects the row changes reported by `sqlite3_update_hook()` per table while a transaction is running,
+         *  delivers them to the listeners of the tables from `sqlite3_commit_hook()`,
+         *  and discards them from `sqlite3_rollback_hook()`.
+         *  The changes of a failed statement or of a savepoint rolled back inside the transaction aren't reported
+         *  by a hook, the storage discards them by means of `mark()` and `discard_since()`. This isn't possible for
+         *  statements executed as raw SQL, e.g. `ROLLBACK TO` a savepoint.
+         *  Only changes of tables having listeners are collected.
+         *  A row observer, on the other hand, is called for every change right away.
+         */
+        class change_notifier {
+          public:
+            using listener_type = std::function<void(const std::vector<row_change>& changes)>;
+
+            size_t add_listener(std::string table, listener_type listener) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                const size_t id = this->nextId++;
+                this->listeners.push_back({id, std::move(table), std::move(listener)});
+                return id;
+            }
+
+            /**
+             *  @return Whether the listener was found.
+             */
+            bool remove_listener(size_t id) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                auto it = std::find_if(this->listeners.begin(), this->listeners.end(), [id](const listener& l) {
+                    return l.id == id;
+                });
+                if (it == this->listeners.end()) {
+                    return false;
+                }
+                this->listeners.erase(it);
+                return true;
             }
 
-          private:
-            friend struct storage_base;
+            bool empty() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->listeners.empty() && !this->rowObserver;
+            }
 
-            int synchronous_ = -1;
-            signed char journal_mode_ = -1;  //  if != -1 stores static_cast<sqlite_orm::journal_mode>(journal_mode)
-            get_connection_t get_connection;
+            /**
+             *  Must be set before the hooks are installed, it isn't synchronized with them.
+             */
+            void set_row_observer(std::function<void(const char* table, sqlite3_int64 rowid)> observer) {
+                this->rowObserver = std::move(observer);
+            }
 
-            template<class T>
-            T get_pragma(const std::string& name) {
-                auto connection = this->get_connection();
-                T result;
-                perform_exec(connection.get(), "PRAGMA " + name, getPragmaCallback<T>, &result);
-                return result;
+            /**
+             *  Position in the changes collected so far, see `discard_since()`.
+             *  Like the hooks, `mark()` and `discard_since()` must be called holding the connection's mutex,
+             *  see `connection_mutex_lock`, which must be held in between as well such that the changes of
+             *  other threads' statements aren't discarded.
+             */
+            size_t mark() const {
+                return this->pending.size();
             }
 
             /**
-             *  Yevgeniy Zakharov: I wanted to refactor this function with statements and value bindings
-             *  but it turns out that bindings in pragma statements are not supported.
+             *  Discards the changes collected since `mark()` was called.
              */
-            template<class T>
-            void set_pragma(const std::string& name, const T& value, sqlite3* db = nullptr) {
-                std::stringstream ss;
-                ss << "PRAGMA " << name << " = " << value;
-                this->set_pragma_impl(ss.str(), db);
+            void discard_since(size_t mark) {
+                if (mark < this->pending.size()) {
+                    this->pending.erase(this->pending.begin() + mark, this->pending.end());
+                }
             }
 
-            void set_pragma(const std::string& name, sqlite_orm::journal_mode value, sqlite3* db = nullptr) {
-                std::stringstream ss;
-                ss << "PRAGMA " << name << " = " << journal_mode_to_string(value);
-                this->set_pragma_impl(ss.str(), db);
+            /**
+             *  Installs the update, commit and rollback hooks, replacing any other such hooks of the connection.
+             */
+            void install(sqlite3* db) {
+                sqlite3_update_hook(db, update_callback, this);
+                sqlite3_commit_hook(db, commit_callback, this);
+                sqlite3_rollback_hook(db, rollback_callback, this);
             }
 
-            void set_pragma(const std::string& name, sqlite_orm::locking_mode value, sqlite3* db = nullptr) {
-                std::stringstream ss;
-                ss << "PRAGMA " << name << " = " << locking_mode_to_string(value);
-                this->set_pragma_impl(ss.str(), db);
+          private:
+            struct listener {
+                size_t id;
+                std::string table;
+                listener_type callback;
+            };
+
+            struct pending_change {
+                std::string table;
+                row_change change;
+            };
+
+            bool has_listener(const char* table) const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return std::find_if(this->listeners.begin(), this->listeners.end(), [table](const listener& l) {
+                           return l.table == table;
+                       }) != this->listeners.end();
             }
 
-            void set_pragma_impl(const std::string& query, sqlite3* db = nullptr) {
-                auto con = this->get_connection();
-                if (db == nullptr) {
-                    db = con.get();
+            static void update_callback(void* data, int kind, const char*, const char* table, sqlite3_int64 rowid) {
+                auto& notifier = *static_cast<change_notifier*>(data);
+                if (notifier.rowObserver) {
+                    notifier.rowObserver(table, rowid);
                 }
-                perform_void_exec(db, query);
+                if (notifier.has_listener(table)) {
+                    notifier.pending.push_back({table, {change_kind(kind), rowid}});
+                }
+            }
+
+            static int commit_callback(void* data) {
+                auto& notifier = *static_cast<change_notifier*>(data);
+                if (notifier.pending.empty()) {
+                    return 0;
+                }
+                std::map<std::string, std::vector<row_change>> committed;
+                for (auto& change: notifier.pending) {
+                    committed[std::move(change.table)].push_back(change.change);
+                }
+                notifier.pending.clear();
+                std::vector<listener> listeners;
+                {
+                    std::lock_guard<std::mutex> lock{notifier.mutex};
+                    listeners = notifier.listeners;
+                }
+                for (auto& l: listeners) {
+                    auto it = committed.find(l.table);
+                    if (it == committed.end()) {
+                        continue;
+                    }
+                    //  an exception can't propagate through SQLite and must not turn the commit into a rollback
+                    try {
+                        l.callback(it->second);
+                    } catch (...) {
+                    }
+                }
+                return 0;
             }
+
+            static void rollback_callback(void* data) {
+                static_cast<change_notifier*>(data)->pending.clear();
+            }
+
+            mutable std::mutex mutex;
+            std::vector<listener> listeners;
+            size_t nextId = 1;
+            std::function<void(const char* table, sqlite3_int64 rowid)> rowObserver;
+            //  in the order of the changes; only touched holding the connection's mutex
+            std::vector<pending_change> pending;
         };
     }
 }
 
-// #include "limit_accessor.h"
+// #include "object_cache.h"
 
 #include <sqlite3.h>
-#include <map>  //  std::map
-#include <functional>  //  std::function
+#include <cstddef>  //  size_t
+#include <cstdint>  //  uint64_t
+#include <string>  //  std::string
+#include <list>  //  std::list
+#include <unordered_map>  //  std::unordered_map
+#include <vector>  //  std::vector
 #include <memory>  //  std::shared_ptr
+#include <functional>  //  std::function
+#include <mutex>  //  std::mutex, std::lock_guard
+#include <utility>  //  std::move
 
-// #include "connection_holder.h"
+// #include "cache_key.h"
 
-namespace sqlite_orm {
+#include <cstddef>  //  size_t, nullptr_t
+#include <cstdint>  //  uint64_t, uintptr_t
+#include <cstring>  //  memcpy, strlen
+#include <string>  //  std::string, std::to_string
+#include <vector>  //  std::vector
+#include <type_traits>  //  std::enable_if_t, std::is_integral, std::integral_constant, std::true_type
+// #include "functional/cxx_optional.h"
 
-    namespace internal {
+// #include "functional/cxx_string_view.h"
 
-        struct limit_accessor {
-            using get_connection_t = std::function<connection_ref()>;
+// #include "functional/cxx_type_traits_polyfill.h"
 
-            limit_accessor(get_connection_t get_connection_) : get_connection(std::move(get_connection_)) {}
+// #include "is_std_ptr.h"
 
-            int length() {
-                return this->get(SQLITE_LIMIT_LENGTH);
-            }
+// #include "type_traits.h"
 
-            void length(int newValue) {
-                this->set(SQLITE_LIMIT_LENGTH, newValue);
-            }
+// #include "field_printer.h"
 
-            int sql_length() {
-                return this->get(SQLITE_LIMIT_SQL_LENGTH);
-            }
+// #include "array_values.h"
 
-            void sql_length(int newValue) {
-                this->set(SQLITE_LIMIT_SQL_LENGTH, newValue);
-            }
+namespace sqlite_orm {
 
-            int column() {
-                return this->get(SQLITE_LIMIT_COLUMN);
-            }
+    namespace internal {
 
-            void column(int newValue) {
-                this->set(SQLITE_LIMIT_COLUMN, newValue);
-            }
+        /**
+         *  An address unique to type T, such that values of different types never share a key.
+         */
+        template<class T>
+        const void* cache_type_id() {
+            static const char id = 0;
+            return &id;
+        }
 
-            int expr_depth() {
-                return this->get(SQLITE_LIMIT_EXPR_DEPTH);
+        /**
+         *  Appends a value to a cache key, tagged by its kind and such that distinct values never run together
+         *  or collide, e.g. floating point values are appended by their exact bits. Values that compare equal
+         *  in SQL but are of different kinds, like 1 and 1.0, get different keys.
+         *  Values of other types are appended as printed by `field_printer`, tagged by their type.
+         *  @return false if the value can't be appended, in which case there is no key.
+         */
+        template<class T, class SFINAE = void>
+        struct cache_key_writer {
+            bool operator()(std::string& key, const T& value) const {
+                return this->append_printed(key, value, is_printable<T>{});
             }
 
-            void expr_depth(int newValue) {
-                this->set(SQLITE_LIMIT_EXPR_DEPTH, newValue);
+          private:
+            bool append_printed(std::string& key, const T& value, std::true_type) const {
+                key += 'p';
+                key += std::to_string(uintptr_t(cache_type_id<T>()));
+                key += ':';
+                const std::string text = field_printer<T>{}(value);
+                key += std::to_string(text.size());
+                key += ':';
+                key += text;
+                return true;
             }
 
-            int compound_select() {
-                return this->get(SQLITE_LIMIT_COMPOUND_SELECT);
+            bool append_printed(std::string&, const T&, std::false_type) const {
+                return false;
             }
+        };
 
-            void compound_select(int newValue) {
-                this->set(SQLITE_LIMIT_COMPOUND_SELECT, newValue);
+        template<class T>
+        struct cache_key_writer<T, match_if<std::is_integral, T>> {
+            bool operator()(std::string& key, const T& value) const {
+                key += 'i';
+                key += std::to_string(value);
+                key += ';';
+                return true;
             }
+        };
 
-            int vdbe_op() {
-                return this->get(SQLITE_LIMIT_VDBE_OP);
+        template<class T>
+        struct cache_key_writer<T, match_if<std::is_floating_point, T>> {
+            bool operator()(std::string& key, const T& value) const {
+                //  bound as double
+                const double bound = static_cast<double>(value);
+                uint64_t bits = 0;
+                memcpy(&bits, &bound, sizeof(bits));
+                key += 'f';
+                key += std::to_string(bits);
+                key += ';';
+                return true;
             }
+        };
 
-            void vdbe_op(int newValue) {
-                this->set(SQLITE_LIMIT_VDBE_OP, newValue);
-            }
+        template<class T>
+        using is_cache_key_text = polyfill::disjunction<std::is_base_of<std::string, T>
+#ifdef SQLITE_ORM_STRING_VIEW_SUPPORTED
+                                                        ,
+                                                        std::is_same<T, std::string_view>
+#endif
+                                                        >;
 
-            int function_arg() {
-                return this->get(SQLITE_LIMIT_FUNCTION_ARG);
+        template<class T>
+        struct cache_key_writer<T, std::enable_if_t<is_cache_key_text<T>::value>> {
+            bool operator()(std::string& key, const T& value) const {
+                key += 't';
+                key += std::to_string(value.size());
+                key += ':';
+                key.append(value.data(), value.size());
+                return true;
             }
+        };
 
-            void function_arg(int newValue) {
-                this->set(SQLITE_LIMIT_FUNCTION_ARG, newValue);
+        template<>
+        struct cache_key_writer<const char*, void> {
+            bool operator()(std::string& key, const char* value) const {
+                const size_t size = strlen(value);
+                key += 't';
+                key += std::to_string(size);
+                key += ':';
+                key.append(value, size);
+                return true;
             }
+        };
 
-            int attached() {
-                return this->get(SQLITE_LIMIT_ATTACHED);
+        template<>
+        struct cache_key_writer<std::vector<char>, void> {
+            bool operator()(std::string& key, const std::vector<char>& value) const {
+                key += 'b';
+                key += std::to_string(value.size());
+                key += ':';
+                key.append(value.data(), value.size());
+                return true;
             }
+        };
 
-            void attached(int newValue) {
-                this->set(SQLITE_LIMIT_ATTACHED, newValue);
+        template<>
+        struct cache_key_writer<nullptr_t, void> {
+            bool operator()(std::string& key, const nullptr_t&) const {
+                key += 'n';
+                return true;
             }
+        };
 
-            int like_pattern_length() {
-                return this->get(SQLITE_LIMIT_LIKE_PATTERN_LENGTH);
+#ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
+        template<>
+        struct cache_key_writer<std::nullopt_t, void> {
+            bool operator()(std::string& key, const std::nullopt_t&) const {
+                key += 'n';
+                return true;
             }
+        };
 
-            void like_pattern_length(int newValue) {
-                this->set(SQLITE_LIMIT_LIKE_PATTERN_LENGTH, newValue);
+        template<class T>
+        struct cache_key_writer<T, std::enable_if_t<polyfill::is_specialization_of_v<T, std::optional>>> {
+            bool operator()(std::string& key, const T& value) const {
+                if (!value) {
+                    key += 'n';
+                    return true;
+                }
+                return cache_key_writer<std::remove_cv_t<typename T::value_type>>{}(key, *value);
             }
+        };
+#endif  //  SQLITE_ORM_OPTIONAL_SUPPORTED
 
-            int variable_number() {
-                return this->get(SQLITE_LIMIT_VARIABLE_NUMBER);
+        template<class T>
+        struct cache_key_writer<T, std::enable_if_t<is_std_ptr<T>::value>> {
+            bool operator()(std::string& key, const T& value) const {
+                if (!value) {
+                    key += 'n';
+                    return true;
+                }
+                return cache_key_writer<std::remove_cv_t<typename T::element_type>>{}(key, *value);
             }
+        };
 
-            void variable_number(int newValue) {
-                this->set(SQLITE_LIMIT_VARIABLE_NUMBER, newValue);
+        template<class E>
+        struct cache_key_writer<array_values_t<E>, void> {
+            bool operator()(std::string& key, const array_values_t<E>& value) const {
+                key += 'a';
+                key += std::to_string(value.values.size());
+                key += ':';
+                for (auto& element: value.values) {
+                    cache_key_writer<E>{}(key, element);
+                }
+                return true;
             }
+        };
 
-            int trigger_depth() {
-                return this->get(SQLITE_LIMIT_TRIGGER_DEPTH);
-            }
+        /**
+         *  The tag that keys of non-null values of type T start with. Values with the same tag are appended
+         *  alike, e.g. `int` and `long` values, hence equal values of such types get the same key.
+         */
+        template<class T, class SFINAE = void>
+        struct cache_key_tag : std::integral_constant<char, 'p'> {};
 
-            void trigger_depth(int newValue) {
-                this->set(SQLITE_LIMIT_TRIGGER_DEPTH, newValue);
-            }
+        template<class T>
+        struct cache_key_tag<T, match_if<std::is_integral, T>> : std::integral_constant<char, 'i'> {};
 
-#if SQLITE_VERSION_NUMBER >= 3008007
-            int worker_threads() {
-                return this->get(SQLITE_LIMIT_WORKER_THREADS);
-            }
+        template<class T>
+        struct cache_key_tag<T, match_if<std::is_floating_point, T>> : std::integral_constant<char, 'f'> {};
 
-            void worker_threads(int newValue) {
-                this->set(SQLITE_LIMIT_WORKER_THREADS, newValue);
-            }
-#endif
+        template<class T>
+        struct cache_key_tag<T, std::enable_if_t<is_cache_key_text<T>::value>> : std::integral_constant<char, 't'> {};
 
-          protected:
-            get_connection_t get_connection;
+        template<>
+        struct cache_key_tag<const char*, void> : std::integral_constant<char, 't'> {};
 
-            friend struct storage_base;
+        template<>
+        struct cache_key_tag<std::vector<char>, void> : std::integral_constant<char, 'b'> {};
 
-            /**
-             *  Stores limit set between connections.
-             */
-            std::map<int, int> limits;
+#ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
+        template<class T>
+        struct cache_key_tag<T, std::enable_if_t<polyfill::is_specialization_of_v<T, std::optional>>>
+            : cache_key_tag<std::remove_cv_t<typename T::value_type>> {};
+#endif  //  SQLITE_ORM_OPTIONAL_SUPPORTED
 
-            int get(int id) {
-                auto connection = this->get_connection();
-                return sqlite3_limit(connection.get(), id, -1);
-            }
+        template<class T>
+        struct cache_key_tag<T, std::enable_if_t<is_std_ptr<T>::value>>
+            : cache_key_tag<std::remove_cv_t<typename T::element_type>> {};
 
-            void set(int id, int newValue) {
-                this->limits[id] = newValue;
-                auto connection = this->get_connection();
-                sqlite3_limit(connection.get(), id, newValue);
-            }
-        };
+        template<class T>
+        bool append_cache_key(std::string& key, const T& value) {
+            return cache_key_writer<T>{}(key, value);
+        }
+
+        inline bool append_cache_keys(std::string&) {
+            return true;
+        }
+
+        template<class T, class... Ts>
+        bool append_cache_keys(std::string& key, const T& value, const Ts&... values) {
+            return append_cache_key(key, value) && append_cache_keys(key, values...);
+        }
     }
 }
 
-// #include "transaction_guard.h"
+namespace sqlite_orm {
 
-#include <functional>  //  std::function
-#include <utility>  //  std::move
+    struct object_cache_options {
+        /**
+         *  Maximum number of cached objects, 0 for no limit.
+         */
+        size_t max_entries = 1024;
+        /**
+         *  Maximum total size of the cached objects in bytes, 0 for no limit.
+         *  Sizes are `sizeof` the object unless `enable_object_cache()` is given a size function.
+         */
+        size_t max_bytes = 0;
+    };
 
-// #include "connection_holder.h"
+    struct object_cache_stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+        size_t invalidations = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
 
-namespace sqlite_orm {
+        double hit_rate() const {
+            const size_t lookups = this->hits + this->misses;
+            return lookups ? double(this->hits) / double(lookups) : 0;
+        }
+    };
 
     namespace internal {
 
         /**
-         *  Class used as a guard for a transaction. Calls `ROLLBACK` in destructor.
-         *  Has explicit `commit()` and `rollback()` functions. After explicit function is fired
-         *  guard won't do anything in d-tor. Also you can set `commit_on_destroy` to true to
-         *  make it call `COMMIT` on destroy.
-         * 
-         *  Note: The guard's destructor is explicitly marked as potentially throwing,
-         *  so exceptions that occur during commit or rollback are propagated to the caller.
+         *  Identity map of the objects of one table by primary key, evicting the least recently used objects.
+         *  Objects are stored type-erased, the storage knowing their type.
+         *
+         *  Changed rows are invalidated as soon as the update hook reports them, and again by `settle()`
+         *  once the change is committed, because a reader loading the row between the two may still see
+         *  the previous version. Objects loaded while an invalidation happened aren't cached, which is
+         *  detected by comparing the generation before and after loading.
          */
-        struct transaction_guard_t {
-            /**
-             *  This is a public lever to tell a guard what it must do in its destructor
-             *  if `gotta_fire` is true
-             */
-            bool commit_on_destroy = false;
+        class object_cache {
+          public:
+            using size_function = std::function<size_t(const void* object)>;
 
-            transaction_guard_t(connection_ref connection_,
-                                std::function<void()> commit_func_,
-                                std::function<void()> rollback_func_) :
-                connection(std::move(connection_)), commit_func(std::move(commit_func_)),
-                rollback_func(std::move(rollback_func_)) {}
+            /**
+             *  @param keyedByRowid Whether the primary key is the rowid, in which case a changed row
+             *  invalidates the object with the rowid as key, otherwise all objects.
+             */
+            object_cache(object_cache_options options, size_function sizeOf, bool keyedByRowid) :
+                options(options), sizeOf(std::move(sizeOf)), keyedByRowid(keyedByRowid) {}
+
+            std::shared_ptr<const void> find(const std::string& key) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                auto it = this->index.find(key);
+                if (it == this->index.end()) {
+                    ++this->counters.misses;
+                    return nullptr;
+                }
+                ++this->counters.hits;
+                this->entries.splice(this->entries.begin(), this->entries, it->second);
+                return it->second->object;
+            }
 
-            transaction_guard_t(transaction_guard_t&& other) :
-                commit_on_destroy(other.commit_on_destroy), connection(std::move(other.connection)),
-                commit_func(std::move(other.commit_func)), rollback_func(std::move(other.rollback_func)),
-                gotta_fire(other.gotta_fire) {
-                other.gotta_fire = false;
+            uint64_t generation() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->currentGeneration;
             }
 
-            ~transaction_guard_t() noexcept(false) {
-                if (this->gotta_fire) {
-                    if (this->commit_on_destroy) {
-                        this->commit_func();
-                    } else {
-                        this->rollback_func();
-                    }
+            /**
+             *  Caches an object unless something was invalidated since `generation` was taken.
+             */
+            void insert(std::string key, std::shared_ptr<const void> object, uint64_t generation) {
+                const size_t bytes = this->sizeOf(object.get());
+                std::lock_guard<std::mutex> lock{this->mutex};
+                if (generation != this->currentGeneration || this->index.count(key)) {
+                    return;
+                }
+                this->entries.push_front({key, std::move(object), bytes});
+                this->index.emplace(std::move(key), this->entries.begin());
+                this->counters.bytes += bytes;
+                while (this->over_limits()) {
+                    auto& entry = this->entries.back();
+                    this->counters.bytes -= entry.bytes;
+                    this->index.erase(entry.key);
+                    this->entries.pop_back();
+                    ++this->counters.evictions;
                 }
             }
 
-            transaction_guard_t& operator=(transaction_guard_t&&) = delete;
+            /**
+             *  Invalidates the object of a changed row until the next `settle()`.
+             */
+            void invalidate(std::string key) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                this->erase(key);
+                if (this->changedRows.size() < max_changed_rows) {
+                    this->changedRows.push_back(std::move(key));
+                } else {
+                    this->changedAll = true;
+                }
+            }
 
             /**
-             *  Call `COMMIT` explicitly. After this call
-             *  guard will not call `COMMIT` or `ROLLBACK`
-             *  in its destructor.
+             *  Invalidates all objects because of changed rows until the next `settle()`.
              */
-            void commit() {
-                this->gotta_fire = false;
-                this->commit_func();
+            void invalidate_all() {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                this->clear_entries();
+                this->changedAll = true;
+            }
+
+            void clear() {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                this->clear_entries();
             }
 
             /**
-             *  Call `ROLLBACK` explicitly. After this call
-             *  guard will not call `COMMIT` or `ROLLBACK`
-             *  in its destructor.
+             *  Called by the update hook of the writer connection for every changed row of the table.
              */
-            void rollback() {
-                this->gotta_fire = false;
-                this->rollback_func();
+            void invalidate_row(sqlite3_int64 rowid) {
+                if (this->keyedByRowid) {
+                    std::string key;
+                    append_cache_key(key, rowid);
+                    this->invalidate(std::move(key));
+                } else {
+                    this->invalidate_all();
+                }
             }
 
-          protected:
-            connection_ref connection;
-            std::function<void()> commit_func;
-            std::function<void()> rollback_func;
-            bool gotta_fire = true;
+            /**
+             *  Invalidates the rows changed since the last call again, once their changes are visible to readers.
+             */
+            void settle() {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                if (this->changedAll) {
+                    this->clear_entries();
+                } else {
+                    for (auto& key: this->changedRows) {
+                        this->erase(key);
+                    }
+                }
+                this->changedRows.clear();
+                this->changedAll = false;
+            }
+
+            object_cache_stats stats() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                object_cache_stats result = this->counters;
+                result.entries = this->entries.size();
+                return result;
+            }
+
+          private:
+            //  beyond this many changed rows, `settle()` clears the cache instead of remembering each row
+            static constexpr size_t max_changed_rows = 1024;
+
+            struct entry {
+                std::string key;
+                std::shared_ptr<const void> object;
+                size_t bytes;
+            };
+
+            bool over_limits() const {
+                return (this->options.max_entries && this->entries.size() > this->options.max_entries) ||
+                       (this->options.max_bytes && this->counters.bytes > this->options.max_bytes);
+            }
+
+            void erase(const std::string& key) {
+                ++this->currentGeneration;
+                auto it = this->index.find(key);
+                if (it == this->index.end()) {
+                    return;
+                }
+                this->counters.bytes -= it->second->bytes;
+                this->entries.erase(it->second);
+                this->index.erase(it);
+                ++this->counters.invalidations;
+            }
+
+            void clear_entries() {
+                ++this->currentGeneration;
+                this->counters.invalidations += this->entries.size();
+                this->counters.bytes = 0;
+                this->index.clear();
+                this->entries.clear();
+            }
+
+            const object_cache_options options;
+            const size_function sizeOf;
+            const bool keyedByRowid;
+            mutable std::mutex mutex;
+            std::list<entry> entries;
+            std::unordered_map<std::string, std::list<entry>::iterator> index;
+            uint64_t currentGeneration = 0;
+            object_cache_stats counters;
+            std::vector<std::string> changedRows;
+            bool changedAll = false;
         };
     }
 }
 
-// #include "row_extractor.h"
+// #include "result_cache.h"
 
-// #include "connection_holder.h"
+#include <sqlite3.h>
+#include <cstddef>  //  size_t
+#include <cstdint>  //  uint64_t, uintptr_t
+#include <string>  //  std::string, std::to_string
+#include <set>  //  std::set
+#include <list>  //  std::list
+#include <unordered_map>  //  std::unordered_map
+#include <memory>  //  std::shared_ptr, std::unique_ptr
+#include <mutex>  //  std::mutex, std::lock_guard
+#include <utility>  //  std::move
+#include <functional>  //  std::less
+#include <iterator>  //  std::prev
 
-// #include "backup.h"
+// #include "type_traits.h"
 
-#include <sqlite3.h>
-#include <system_error>  //  std::system_error
-#include <string>  //  std::string
-#include <memory>
-#include <utility>  //  std::move, std::exchange
+// #include "statement_binder.h"
 
-// #include "error_code.h"
+// #include "ast_iterator.h"
 
-// #include "connection_holder.h"
+// #include "cache_key.h"
+
+// #include "object_cache.h"
 
 namespace sqlite_orm {
 
+    struct result_cache_options {
+        /**
+         *  Maximum number of cached results, 0 for no limit.
+         */
+        size_t max_entries = 256;
+        /**
+         *  Maximum total size of the cached results in bytes, 0 for no limit.
+         *  The size of a result is estimated as its number of rows times the size of a row,
+         *  not counting memory rows own, like the characters of long strings.
+         */
+        size_t max_bytes = 0;
+        /**
+         *  Whether to check `PRAGMA data_version` before every lookup and clear the cache
+         *  once another connection, e.g. of another process, committed changes to the database.
+         */
+        bool detect_external_changes = true;
+    };
+
+    /**
+     *  The same counters as for object caches.
+     */
+    using result_cache_stats = object_cache_stats;
+
     namespace internal {
 
         /**
-         *  A backup class. Don't construct it as is, call storage.make_backup_from or storage.make_backup_to instead.
-         *  An instance of this class represents a wrapper around sqlite3_backup pointer. Use this class
-         *  to have maximum control on a backup operation. In case you need a single backup in one line you
-         *  can skip creating a backup_t instance and just call storage.backup_from or storage.backup_to function.
+         *  Appends the values a statement binds, in the order they are bound.
          */
-        struct backup_t {
-            backup_t(connection_ref to_,
-                     const std::string& zDestName,
-                     connection_ref from_,
-                     const std::string& zSourceName,
-                     std::unique_ptr<connection_holder> holder_) :
-                handle(sqlite3_backup_init(to_.get(), zDestName.c_str(), from_.get(), zSourceName.c_str())),
-                holder(std::move(holder_)), to(to_), from(from_) {
-                if (!this->handle) {
-                    throw std::system_error{orm_error_code::failed_to_init_a_backup};
+        struct result_cache_key_binder {
+            std::string& key;
+            bool appended = true;
+
+            template<class T, satisfies<is_bindable, T> = true>
+            void operator()(const T& value) {
+                this->appended = this->appended && append_cache_key(this->key, value);
+            }
+
+            template<class T, satisfies_not<is_bindable, T> = true>
+            void operator()(const T&) const {}
+        };
+
+        /**
+         *  Key of the results of a statement: the type of the results, the SQL with parameter placeholders
+         *  and the values bound to the parameters.
+         *  @return An empty key if a bound value can't be appended, see `cache_key_writer`.
+         */
+        template<class R, class E>
+        std::string make_result_cache_key(sqlite3_stmt* stmt, const E& expression) {
+            std::string key = std::to_string(uintptr_t(cache_type_id<R>()));
+            key += ':';
+            key += sqlite3_sql(stmt);
+            key += '\0';
+            result_cache_key_binder binder{key};
+            iterate_ast(expression, binder);
+            if (!binder.appended) {
+                key.clear();
+            }
+            return key;
+        }
+
+        /**
+         *  Results of queries by their SQL and bound values, evicting the least recently used results.
+         *  Results are stored type-erased, the storage knowing their type.
+         *
+         *  Every result remembers the tables it was read from and is invalidated once one of them changes.
+         *  A changed table stays pending until `settle()` is called after the change was committed or rolled back,
+         *  results of the table aren't cached meanwhile because readers may still see the previous version.
+         *  Results read while a change happened aren't cached either, which is detected by comparing
+         *  the generation before and after reading.
+         */
+        class result_cache {
+          public:
+            explicit result_cache(result_cache_options options) : options(options) {}
+
+            const result_cache_options& get_options() const {
+                return this->options;
+            }
+
+            std::shared_ptr<const void> find(const std::string& key) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                auto it = this->index.find(key);
+                if (it == this->index.end()) {
+                    ++this->counters.misses;
+                    return nullptr;
                 }
+                ++this->counters.hits;
+                this->entries.splice(this->entries.begin(), this->entries, it->second);
+                return it->second->result;
             }
 
-            backup_t(backup_t&& other) :
-                handle(std::exchange(other.handle, nullptr)), holder(std::move(other.holder)), to(other.to),
-                from(other.from) {}
+            uint64_t generation() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                return this->currentGeneration;
+            }
 
-            ~backup_t() {
-                if (this->handle) {
-                    (void)sqlite3_backup_finish(this->handle);
+            /**
+             *  Caches a result unless anything changed since `generation` was taken or one of its tables is pending.
+             */
+            void insert(std::string key,
+                        std::shared_ptr<const void> result,
+                        size_t bytes,
+                        std::set<std::string> tables,
+                        uint64_t generation) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                if (generation != this->currentGeneration || this->index.count(key)) {
+                    return;
+                }
+                for (auto& table: tables) {
+                    if (this->pendingTables.count(table)) {
+                        return;
+                    }
+                }
+                this->entries.push_front({key, std::move(result), bytes, std::move(tables)});
+                this->index.emplace(std::move(key), this->entries.begin());
+                this->counters.bytes += bytes;
+                while (this->over_limits()) {
+                    ++this->counters.evictions;
+                    this->erase(std::prev(this->entries.end()));
                 }
             }
 
             /**
-             *  Calls sqlite3_backup_step with pages argument
+             *  Invalidates the results read from a table and keeps the table pending until the next `settle()`.
+             *  Called by the update hook of the writer connection for every changed row.
              */
-            int step(int pages) {
-                return sqlite3_backup_step(this->handle, pages);
+            void table_changed(const char* table) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                ++this->currentGeneration;
+                if (this->pendingTables.count(table)) {
+                    return;
+                }
+                this->pendingTables.emplace(table);
+                for (auto it = this->entries.begin(); it != this->entries.end();) {
+                    auto current = it++;
+                    if (current->tables.count(table)) {
+                        ++this->counters.invalidations;
+                        this->erase(current);
+                    }
+                }
             }
 
             /**
-             *  Returns sqlite3_backup_remaining result
+             *  Ends pending changes, once they are visible to readers.
              */
-            int remaining() const {
-                return sqlite3_backup_remaining(this->handle);
+            void settle() {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                if (this->pendingTables.empty()) {
+                    return;
+                }
+                ++this->currentGeneration;
+                this->pendingTables.clear();
             }
 
             /**
-             *  Returns sqlite3_backup_pagecount result
+             *  Clears the cache if the data version of the connection changed since the last call,
+             *  i.e. another connection committed changes.
              */
-            int pagecount() const {
-                return sqlite3_backup_pagecount(this->handle);
+            void check_data_version(sqlite3_int64 dataVersion) {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                if (this->hasDataVersion && dataVersion != this->dataVersion) {
+                    this->clear_entries();
+                }
+                this->dataVersion = dataVersion;
+                this->hasDataVersion = true;
             }
 
-          protected:
-            sqlite3_backup* handle = nullptr;
-            std::unique_ptr<connection_holder> holder;
-            connection_ref to;
-            connection_ref from;
+            void clear() {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                this->clear_entries();
+            }
+
+            result_cache_stats stats() const {
+                std::lock_guard<std::mutex> lock{this->mutex};
+                result_cache_stats result = this->counters;
+                result.entries = this->entries.size();
+                return result;
+            }
+
+          private:
+            struct entry {
+                std::string key;
+                std::shared_ptr<const void> result;
+                size_t bytes;
+                std::set<std::string> tables;
+            };
+
+            bool over_limits() const {
+                return (this->options.max_entries && this->entries.size() > this->options.max_entries) ||
+                       (this->options.max_bytes && this->counters.bytes > this->options.max_bytes);
+            }
+
+            void erase(std::list<entry>::iterator it) {
+                this->counters.bytes -= it->bytes;
+                this->index.erase(it->key);
+                this->entries.erase(it);
+            }
+
+            void clear_entries() {
+                ++this->currentGeneration;
+                this->counters.invalidations += this->entries.size();
+                this->counters.bytes = 0;
+                this->index.clear();
+                this->entries.clear();
+            }
+
+            const result_cache_options options;
+            mutable std::mutex mutex;
+            std::list<entry> entries;
+            std::unordered_map<std::string, std::list<entry>::iterator> index;
+            uint64_t currentGeneration = 0;
+            result_cache_stats counters;
+            std::set<std::string, std::less<>> pendingTables;
+            sqlite3_int64 dataVersion = 0;
+            bool hasDataVersion = false;
         };
     }
 }
@@ -17614,7 +21240,8 @@ namespace sqlite_orm {
             }
 
           protected:
-            void rename_table(sqlite3* db, const std::string& oldName, const std::string& newName) const {
+            void rename_table(sqlite3* db, const std::string& oldName, const std::string& newName) {
+                this->clear_statement_caches_for_schema_change();
                 std::stringstream ss;
                 ss << "ALTER TABLE " << streaming_identifier(oldName) << " RENAME TO " << streaming_identifier(newName)
                    << std::flush;
@@ -17754,22 +21381,228 @@ namespace sqlite_orm {
             }
 
             /**
-             *  Call it once during storage lifetime to make it keeping its connection opened till dtor call.
-             *  By default if storage is not in-memory it calls `sqlite3_open` only when the connection is really
-             *  needed and closes when it is not needed. This function breaks this rule. In memory storage always
-             *  keeps connection opened so calling this for in-memory storage changes nothing.
-             *  Note about multithreading: in multithreading context avoiding using this function for not in-memory
-             *  storage may lead to data races. If you have data races in such a configuration try to call `open_forever`
-             *  before accessing your storage - it may fix data races.
+             *  Call it once during storage lifetime to make it keeping its connection opened till dtor call.
+             *  By default if storage is not in-memory it calls `sqlite3_open` only when the connection is really
+             *  needed and closes when it is not needed. This function breaks this rule. In memory storage always
+             *  keeps connection opened so calling this for in-memory storage changes nothing.
+             *  Note about multithreading: in multithreading context avoiding using this function for not in-memory
+             *  storage may lead to data races. If you have data races in such a configuration try to call `open_forever`
+             *  before accessing your storage - it may fix data races.
+             */
+            void open_forever() {
+                this->isOpenedForever = true;
+                this->connection->retain();
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3036000 || defined(SQLITE_ENABLE_DESERIALIZE)
+#ifndef SQLITE_OMIT_DESERIALIZE
+            /**
+             *  Returns the image of the `main` database as one contiguous buffer,
+             *  which is the same as the content of the database file.
+             *  For in-memory databases the buffer is copied once from SQLite's memory.
+             */
+            std::vector<unsigned char> serialize_database() {
+                auto con = this->get_connection();
+                sqlite3_int64 size = 0;
+                //  an in-memory database is contiguous already and can be copied right away
+                if (const unsigned char* data = sqlite3_serialize(con.get(), "main", &size, SQLITE_SERIALIZE_NOCOPY)) {
+                    return {data, data + size};
+                }
+                using buffer_ptr =
+                    std::unique_ptr<unsigned char, std::integral_constant<decltype(&sqlite3_free), sqlite3_free>>;
+                buffer_ptr data{sqlite3_serialize(con.get(), "main", &size, 0)};
+                if (!data) {
+                    throw std::system_error{sqlite_errc(SQLITE_NOMEM)};
+                }
+                return {data.get(), data.get() + size};
+            }
+
+            /**
+             *  Replaces the `main` database by the given image, e.g. obtained from `serialize_database()`.
+             *  The database then lives in memory as long as the connection is opened,
+             *  hence this is meant for in-memory storages or storages opened by `open_forever()`.
+             *  The image is copied into memory owned by SQLite, which can grow as the database is written.
+             *  Throws std::system_error{orm_error_code::reader_pool_is_enabled} if the reader pool is enabled,
+             *  because pooled readers would keep reading the database file instead of the image.
+             *  Throws std::system_error{orm_error_code::connection_is_not_kept_open} if the connection isn't
+             *  retained, e.g. by `open_forever()` or a transaction, because it would be closed right away
+             *  together with the image.
+             */
+            void deserialize_database(const std::vector<unsigned char>& image, bool readonly = false) {
+                this->deserialize_database(image.data(), image.size(), readonly, true);
+            }
+
+            /**
+             *  Like `deserialize_database(image, readonly)`.
+             *  If `readonly` is true and `copy` is false the image is used as is without copying it,
+             *  in which case `data` must stay valid until the connection is closed or another image is loaded.
+             */
+            void deserialize_database(const unsigned char* data, size_t size, bool readonly, bool copy) {
+                if (this->reader_pool_size() > 0) {
+                    throw std::system_error{orm_error_code::reader_pool_is_enabled};
+                }
+                if (this->connection->retain_count() == 0) {
+                    throw std::system_error{orm_error_code::connection_is_not_kept_open};
+                }
+                auto con = this->get_connection();
+                unsigned char* buffer = const_cast<unsigned char*>(data);
+                unsigned flags = readonly ? SQLITE_DESERIALIZE_READONLY : 0;
+                if (copy || !readonly) {
+                    buffer = static_cast<unsigned char*>(sqlite3_malloc64(size));
+                    if (!buffer && size) {
+                        throw std::system_error{sqlite_errc(SQLITE_NOMEM)};
+                    }
+                    std::copy(data, data + size, buffer);
+                    flags |= SQLITE_DESERIALIZE_FREEONCLOSE | SQLITE_DESERIALIZE_RESIZEABLE;
+                }
+                //  cached statements refer to the schema of the image being replaced
+                this->statementCache.clear(con.get());
+                const auto length = sqlite3_int64(size);
+                //  on failure the buffer is freed by SQLite if it is to free it on close
+                if (sqlite3_deserialize(con.get(), "main", buffer, length, length, flags) != SQLITE_OK) {
+                    throw_translated_sqlite_error(con.get());
+                }
+                this->clear_object_caches();
+                this->clear_result_cache();
+            }
+#endif
+#endif
+
+            /**
+             *  Sets the maximum number of idle prepared statements kept by the statement cache.
+             *  The statement cache is used by CRUD functions like `get`, `insert`, `update`, `remove`, `replace`,
+             *  `count`, `get_all` and `select`: their statements are reset and rebound instead of being
+             *  prepared again for every call.
+             *  Cached statements live only as long as the database connection is opened, hence
+             *  the cache is most effective for in-memory databases or after calling `open_forever()`.
+             *  Passing 0 disables the cache. Least recently used statements exceeding the new capacity are finalized.
+             */
+            void statement_cache_capacity(size_t capacity) {
+                this->statementCache.set_capacity(capacity);
+            }
+
+            size_t statement_cache_capacity() const {
+                return this->statementCache.get_capacity();
+            }
+
+            /**
+             *  Returns capacity, size and hit/miss/eviction counters of the statement cache.
+             */
+            sqlite_orm::statement_cache_stats statement_cache_stats() const {
+                return this->statementCache.stats();
+            }
+
+            /**
+             *  Finalizes all statements held by the statement cache.
+             */
+            void clear_statement_cache() {
+                this->statementCache.clear();
+            }
+
+            /**
+             *  Keeps the database connection opened for `idleTimeout` after it is not needed anymore
+             *  instead of closing it right away, so that calls following each other shortly reuse
+             *  the same connection (and its cached statements) rather than opening a new one.
+             *  An idle connection is closed by a background thread once the timeout has elapsed.
+             *  Passing zero (the default) closes the connection as soon as it is not needed anymore.
+             *  Has no effect for in-memory databases or after calling `open_forever()`.
+             */
+            void keep_alive(std::chrono::milliseconds idleTimeout) {
+                this->connection->keep_alive(idleTimeout);
+            }
+
+            std::chrono::milliseconds keep_alive() const {
+                return this->connection->keep_alive();
+            }
+
+            /**
+             *  Returns how many times the database connection was opened, closed and reused while kept alive.
+             */
+            sqlite_orm::connection_stats connection_stats() const {
+                return this->connection->connection_stats();
+            }
+
+            /**
+             *  Sets the maximum number of read-only connections used for read-only expressions:
+             *  `select`, `count` and the other aggregate functions, `get_all`, `get`,
+             *  and their pointer and optional variants.
+             *  All other statements keep using the single writer connection, as do the reads of a thread
+             *  running a transaction.
+             *  Together with `journal_mode::WAL` this lets several threads read concurrently with each other
+             *  and with a writer, instead of serializing on one connection.
+             *  Reader connections are opened on demand, get the same collations, limits, busy handler,
+             *  functions and `on_open` callback as the writer, and stay opened while they are part of the pool.
+             *  Zero (the default) disables the pool. Has no effect for in-memory databases.
+             */
+            void reader_pool_size(size_t size) {
+                if (!this->inMemory) {
+                    this->readers->set_capacity(size);
+                }
+            }
+
+            size_t reader_pool_size() const {
+                return this->readers->get_capacity();
+            }
+
+            /**
+             *  Debug mode checking the query plan of every statement prepared by the storage
+             *  for full scans (`SCAN`) of tables having at least `minTableRows` rows.
+             *  On such a scan `onFullScan` is called with the statement's SQL and the offending plan node
+             *  if given, otherwise a `std::system_error` with `orm_error_code::full_table_scan` is thrown
+             *  before the statement is prepared.
+             *  Cached statements are checked once, when they are prepared.
+             *  Counting the rows of a table is costly, hence this is meant for test suites and sampling.
+             *
+             *  @example
+             *  ```c++
+             *  storage.check_full_scans(1000);
+             *  storage.get_all<User>(where(c(&User::email) == email));  //  throws unless users.email is indexed
+             *  ```
+             */
+            void check_full_scans(
+                size_t minTableRows,
+                std::function<void(const std::string& sql, const query_plan_node& node)> onFullScan = {}) {
+                this->checkingFullScans = true;
+                this->fullScanMinTableRows = minTableRows;
+                this->onFullScan = std::move(onFullScan);
+            }
+
+            void disable_full_scan_check() {
+                this->checkingFullScans = false;
+                this->onFullScan = nullptr;
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+            /**
+             *  Enables or disables collecting count, rows stepped, total time and a latency histogram
+             *  per SQL text of every statement run on the writer and the reader connections.
+             *  Measurements come from `sqlite3_trace_v2()`, which is installed on every connection
+             *  opened later on, too, hence profiling survives reconnects.
+             *  Disabled by default. Disabling keeps the collected profiles.
              */
-            void open_forever() {
-                this->isOpenedForever = true;
-                this->connection->retain();
-                if (1 == this->connection->retain_count()) {
-                    this->on_open_internal(this->connection->get());
-                }
+            void profile_statements(bool enable) {
+                this->profilingStatements = enable;
+                this->for_each_opened_connection([this](sqlite3* db) {
+                    this->install_statement_profiler(db);
+                });
             }
 
+            bool profile_statements() const {
+                return this->profilingStatements;
+            }
+
+            /**
+             *  Returns the collected statement profiles ordered by descending total time.
+             */
+            std::vector<statement_profile> statement_profiles() const {
+                return this->statementProfiler.snapshot();
+            }
+
+            void clear_statement_profiles() {
+                this->statementProfiler.clear();
+            }
+#endif
+
             /**
              * Create an application-defined scalar SQL function.
              * Can be called at any time no matter whether the database connection is opened or not.
@@ -17862,10 +21695,9 @@ namespace sqlite_orm {
                     nullptr,
                     std::pair{nullptr, null_xdestroy_f});
 
-                if (this->connection->retain_count() > 0) {
-                    sqlite3* db = this->connection->get();
+                this->for_each_opened_connection([this](sqlite3* db) {
                     try_to_create_scalar_function(db, this->scalarFunctions.back());
-                }
+                });
             }
 #endif
 
@@ -18001,8 +21833,7 @@ namespace sqlite_orm {
                 }
 
                 //  create collations if db is open
-                if (this->connection->retain_count() > 0) {
-                    sqlite3* db = this->connection->get();
+                this->for_each_opened_connection([&name, function, functionExists](sqlite3* db) {
                     int rc = sqlite3_create_collation(db,
                                                       name.c_str(),
                                                       SQLITE_UTF8,
@@ -18011,7 +21842,7 @@ namespace sqlite_orm {
                     if (rc != SQLITE_OK) {
                         throw_translated_sqlite_error(db);
                     }
-                }
+                });
 
                 if (!functionExists) {
                     collatingFunctions.erase(name);
@@ -18044,6 +21875,8 @@ namespace sqlite_orm {
             void commit() {
                 sqlite3* db = this->connection->get();
                 perform_void_exec(db, "COMMIT");
+                this->end_transaction_internal();
+                this->settle_caches();
                 this->connection->release();
                 if (this->connection->retain_count() < 0) {
                     throw std::system_error{orm_error_code::no_active_transaction};
@@ -18053,6 +21886,8 @@ namespace sqlite_orm {
             void rollback() {
                 sqlite3* db = this->connection->get();
                 perform_void_exec(db, "ROLLBACK");
+                this->end_transaction_internal();
+                this->settle_caches();
                 this->connection->release();
                 if (this->connection->retain_count() < 0) {
                     throw std::system_error{orm_error_code::no_active_transaction};
@@ -18072,11 +21907,15 @@ namespace sqlite_orm {
             void backup_from(const std::string& filename) {
                 auto backup = this->make_backup_from(filename);
                 backup.step(-1);
+                this->clear_object_caches();
+                this->clear_result_cache();
             }
 
             void backup_from(storage_base& other) {
                 auto backup = this->make_backup_from(other);
                 backup.step(-1);
+                this->clear_object_caches();
+                this->clear_result_cache();
             }
 
             backup_t make_backup_to(const std::string& filename) {
@@ -18099,16 +21938,190 @@ namespace sqlite_orm {
                 return {this->get_connection(), "main", other.get_connection(), "main", {}};
             }
 
+            /**
+             *  Backs up the database to a file on a background thread, copying `options.pages_per_step` pages
+             *  at a time and pausing for `options.pause` in between, such that writers aren't stalled
+             *  for the whole duration of the backup like with `backup_to()`.
+             *  The backup opens connections of its own to the database files, such that it doesn't share
+             *  the storage's connection with the background thread, hence in-memory databases can't be
+             *  backed up this way. If the database is written meanwhile the backup starts over.
+             *
+             *  @example
+             *  ```c++
+             *  backup_options options;
+             *  options.on_progress = [](const backup_progress& progress) {
+             *      std::cout << progress.fraction() * 100 << "%" << std::endl;
+             *  };
+             *  auto runner = storage.start_backup_to("backup.sqlite", options);
+             *  //  ...
+             *  bool completed = runner.wait();
+             *  ```
+             */
+            backup_runner start_backup_to(const std::string& filename, backup_options options = {}) {
+                auto source = this->make_dedicated_connection();
+                auto destination = std::make_unique<connection_holder>(filename);
+                connection_holder& to = *destination;
+                connection_holder& from = *source;
+                backup_t backup{to, "main", from, "main", std::move(source), std::move(destination)};
+                return {std::move(backup), std::move(options)};
+            }
+
+            backup_runner start_backup_to(storage_base& other, backup_options options = {}) {
+                auto source = this->make_dedicated_connection();
+                auto destination = other.make_dedicated_connection();
+                connection_holder& to = *destination;
+                connection_holder& from = *source;
+                backup_t backup{to, "main", from, "main", std::move(source), std::move(destination)};
+                return {std::move(backup), std::move(options)};
+            }
+
+            /**
+             *  Checkpoints the write-ahead log of the `main` database by means of `sqlite3_wal_checkpoint_v2()`.
+             *  A checkpoint that couldn't complete because of other connections sets `busy` of the result
+             *  instead of throwing.
+             *
+             *  @example
+             *  ```c++
+             *  auto result = storage.wal_checkpoint(checkpoint_mode::truncate);
+             *  if (result.busy) {
+             *      //  retry later
+             *  }
+             *  ```
+             */
+            checkpoint_result wal_checkpoint(checkpoint_mode mode = checkpoint_mode::passive) {
+                auto con = this->get_connection();
+                return internal::wal_checkpoint(con.get(), mode);
+            }
+
+            /**
+             *  Starts a thread checkpointing the database through a connection of its own whenever a commit
+             *  left at least `options.wal_pages_threshold` pages in the write-ahead log.
+             *  Auto-checkpoints of the writer connection are disabled meanwhile, hence commits never
+             *  pay for a checkpoint. Replaces a background checkpointer started before.
+             *  Has no effect unless the database is in WAL mode, e.g. by `pragma.journal_mode(journal_mode::WAL)`.
+             */
+            void start_background_checkpointer(background_checkpoint_options options = {}) {
+                this->stop_background_checkpointer();
+                this->checkpointer = std::make_unique<background_checkpointer>(this->filename(),
+                                                                              this->connection->options,
+                                                                              std::move(options));
+                this->pragma.walHookInstalled = true;
+                if (this->connection->is_open()) {
+                    this->install_wal_hook(this->connection->get());
+                }
+            }
+
+            /**
+             *  Stops the background checkpointer, waiting for a running checkpoint to finish,
+             *  and restores auto-checkpoints of the writer connection as set by `pragma.wal_autocheckpoint()`.
+             */
+            void stop_background_checkpointer() {
+                if (!this->checkpointer) {
+                    return;
+                }
+                this->pragma.walHookInstalled = false;
+                if (this->connection->is_open()) {
+                    const pragma_profile& profile = this->pragma.applied_profile();
+                    const bool walAutocheckpointSet = profile.has(profile_pragma::wal_autocheckpoint);
+                    sqlite3_wal_autocheckpoint(
+                        this->connection->get(),
+                        walAutocheckpointSet ? int(profile.get(profile_pragma::wal_autocheckpoint))
+                                             : default_wal_autocheckpoint);
+                }
+                this->checkpointer.reset();
+            }
+
+            bool has_background_checkpointer() const {
+                return bool(this->checkpointer);
+            }
+
+            /**
+             *  Registers a listener of the rows inserted, updated or deleted in the table `tableName`.
+             *  The changes are collected by `sqlite3_update_hook()` while a transaction is running
+             *  and delivered all at once when it commits, or discarded when it rolls back.
+             *  Listeners are called on the thread committing from within `sqlite3_commit_hook()`,
+             *  hence they must not use the storage. Changes of WITHOUT ROWID tables aren't reported by SQLite.
+             *  The hooks are installed on the writer connection and survive reconnects.
+             *
+             *  @return An id to pass to `remove_change_listener()`.
+             */
+            size_t add_change_listener(std::string tableName,
+                                       std::function<void(const std::vector<row_change>& changes)> listener) {
+                const size_t id = this->changeNotifier.add_listener(std::move(tableName), std::move(listener));
+                if (this->connection->is_open()) {
+                    this->changeNotifier.install(this->connection->get());
+                }
+                return id;
+            }
+
+            /**
+             *  @return Whether a listener with the given id was registered.
+             */
+            bool remove_change_listener(size_t id) {
+                return this->changeNotifier.remove_listener(id);
+            }
+
+            /**
+             *  Enables caching the results of `select()` and `get_all()` by their SQL and bound values,
+             *  outside of transactions. A result is invalidated once one of the tables it was read from is written
+             *  through this storage, and the whole cache is cleared once another connection committed changes
+             *  if `result_cache_options::detect_external_changes` is set.
+             *  The tables of a query are the ones its columns and conditions refer to, queries without any
+             *  aren't cached. Queries calling non-deterministic functions like `random()`, `datetime('now')`
+             *  or user-defined functions return cached results like any other query, and so do queries
+             *  after schema changes until `clear_result_cache()` is called.
+             *  Keeps the connection open like `open_forever()` while the cache is enabled.
+             *  Must be called before the storage is used by several threads.
+             *
+             *  @example
+             *  ```c++
+             *  storage.enable_result_cache();
+             *  auto totals =
+             *      storage.select(columns(&Order::customerId, sum(&Order::amount)), group_by(&Order::customerId));
+             *  ```
+             */
+            void enable_result_cache(result_cache_options options = {}) {
+                if (!this->resultCache) {
+                    this->connection->retain();
+                }
+                this->resultCache = std::make_unique<result_cache>(options);
+                this->observe_rows();
+            }
+
+            void disable_result_cache() {
+                if (this->resultCache) {
+                    this->resultCache.reset();
+                    this->connection->release();
+                }
+            }
+
+            void clear_result_cache() {
+                if (this->resultCache) {
+                    this->resultCache->clear();
+                }
+            }
+
+            /**
+             *  @return Counters of the result cache, all zero if it isn't enabled.
+             */
+            result_cache_stats get_result_cache_stats() const {
+                return this->resultCache ? this->resultCache->stats() : result_cache_stats{};
+            }
+
             const std::string& filename() const {
                 return this->connection->filename;
             }
 
+            const open_options& get_open_options() const {
+                return this->connection->options;
+            }
+
             /**
              * Checks whether connection to database is opened right now.
              * Returns always `true` for in memory databases.
              */
             bool is_opened() const {
-                return this->connection->retain_count() > 0;
+                return this->connection->is_open();
             }
 
             /*
@@ -18122,65 +22135,259 @@ namespace sqlite_orm {
 
             int busy_handler(std::function<int(int)> handler) {
                 _busy_handler = std::move(handler);
-                if (this->is_opened()) {
+                int res = SQLITE_OK;
+                this->for_each_opened_connection([this, &res](sqlite3* db) {
+                    int rc;
                     if (_busy_handler) {
-                        return sqlite3_busy_handler(this->connection->get(), busy_handler_callback, this);
+                        rc = sqlite3_busy_handler(db, busy_handler_callback, this);
                     } else {
-                        return sqlite3_busy_handler(this->connection->get(), nullptr, nullptr);
+                        rc = sqlite3_busy_handler(db, nullptr, nullptr);
                     }
-                } else {
-                    return SQLITE_OK;
-                }
+                    if (res == SQLITE_OK) {
+                        res = rc;
+                    }
+                });
+                return res;
             }
 
           protected:
-            storage_base(std::string filename, int foreignKeysCount) :
-                pragma(std::bind(&storage_base::get_connection, this)),
+            storage_base(std::string filename, int foreignKeysCount, open_options options = {}) :
+                pragma(std::bind(&storage_base::get_connection, this),
+                       std::bind(&storage_base::for_each_opened_reader, this, std::placeholders::_1)),
                 limit(std::bind(&storage_base::get_connection, this)),
                 inMemory(filename.empty() || filename == ":memory:"),
-                connection(std::make_unique<connection_holder>(std::move(filename))),
+                statementCache(default_statement_cache_capacity),
+                connection(std::make_unique<connection_holder>(
+                    std::move(filename),
+                    std::bind(&storage_base::on_open_internal, this, std::placeholders::_1),
+                    std::bind(&storage_base::on_close_internal, this, std::placeholders::_1),
+                    std::move(options))),
+                readers(std::make_unique<reader_pool>(
+                    this->connection->filename,
+                    std::bind(&storage_base::on_open_reader_internal, this, std::placeholders::_1),
+                    std::bind(&storage_base::on_close_internal, this, std::placeholders::_1),
+                    this->connection->options)),
                 cachedForeignKeysCount(foreignKeysCount) {
                 if (this->inMemory) {
                     this->connection->retain();
-                    this->on_open_internal(this->connection->get());
                 }
             }
 
             storage_base(const storage_base& other) :
-                on_open(other.on_open), pragma(std::bind(&storage_base::get_connection, this)),
+                on_open(other.on_open),
+                pragma(std::bind(&storage_base::get_connection, this),
+                       std::bind(&storage_base::for_each_opened_reader, this, std::placeholders::_1)),
                 limit(std::bind(&storage_base::get_connection, this)), inMemory(other.inMemory),
-                connection(std::make_unique<connection_holder>(other.connection->filename)),
-                cachedForeignKeysCount(other.cachedForeignKeysCount) {
+                statementCache(other.statementCache.get_capacity()),
+                connection(std::make_unique<connection_holder>(
+                    other.connection->filename,
+                    std::bind(&storage_base::on_open_internal, this, std::placeholders::_1),
+                    std::bind(&storage_base::on_close_internal, this, std::placeholders::_1),
+                    other.connection->options)),
+                readers(std::make_unique<reader_pool>(
+                    this->connection->filename,
+                    std::bind(&storage_base::on_open_reader_internal, this, std::placeholders::_1),
+                    std::bind(&storage_base::on_close_internal, this, std::placeholders::_1),
+                    this->connection->options)),
+                cachedForeignKeysCount(other.cachedForeignKeysCount), checkingFullScans(other.checkingFullScans),
+                fullScanMinTableRows(other.fullScanMinTableRows), onFullScan(other.onFullScan) {
+                this->pragma.appliedProfile = other.pragma.appliedProfile;
+#if SQLITE_VERSION_NUMBER >= 3014000
+                this->profilingStatements = other.profilingStatements;
+#endif
+                this->connection->keep_alive(other.connection->keep_alive());
+                this->readers->set_capacity(other.readers->get_capacity());
                 if (this->inMemory) {
                     this->connection->retain();
-                    this->on_open_internal(this->connection->get());
                 }
             }
 
+            /**
+             *  A connection to the database file that is independent of the storage,
+             *  e.g. to be used by another thread.
+             */
+            std::unique_ptr<connection_holder> make_dedicated_connection() const {
+                if (this->inMemory) {
+                    throw std::system_error{orm_error_code::failed_to_init_a_backup};
+                }
+                return std::make_unique<connection_holder>(this->connection->filename,
+                                                           std::function<void(sqlite3*)>{},
+                                                           std::function<void(sqlite3*)>{},
+                                                           this->connection->options);
+            }
+
             ~storage_base() {
                 if (this->isOpenedForever) {
                     this->connection->release();
                 }
+                if (this->resultCache) {
+                    this->connection->release();
+                }
                 if (this->inMemory) {
                     this->connection->release();
                 }
+                //  closes reader connections and a connection that is kept alive while the storage is still intact
+                this->readers.reset();
+                this->connection.reset();
             }
 
             void begin_transaction_internal(const std::string& query) {
                 this->connection->retain();
-                if (1 == this->connection->retain_count()) {
-                    this->on_open_internal(this->connection->get());
-                }
                 sqlite3* db = this->connection->get();
                 perform_void_exec(db, query);
+                this->transactionThread = std::this_thread::get_id();
+                this->inTransaction = true;
+            }
+
+            void end_transaction_internal() {
+                this->inTransaction = false;
+                this->transactionThread = std::thread::id{};
+            }
+
+            /**
+             *  Whether the calling thread began the running transaction, whose uncommitted changes
+             *  it must see through the writer connection.
+             */
+            bool in_own_transaction() const {
+                return this->inTransaction && this->transactionThread.load() == std::this_thread::get_id();
             }
 
             connection_ref get_connection() {
-                connection_ref res{*this->connection};
-                if (1 == this->connection->retain_count()) {
-                    this->on_open_internal(this->connection->get());
+                return {*this->connection};
+            }
+
+            /**
+             *  Connection for read-only expressions: a pooled reader connection,
+             *  unless there is no reader pool or the calling thread runs a transaction,
+             *  in which case its reads must see the transaction's changes.
+             *  Other threads keep reading the committed data from the readers meanwhile.
+             */
+            connection_ref get_reader_connection() {
+                if (this->in_own_transaction()) {
+                    return this->get_connection();
+                }
+                return this->readers->checkout(*this->connection);
+            }
+
+            /**
+             *  Calls `f` with the writer connection and every reader connection that are opened right now.
+             */
+            template<class F>
+            void for_each_opened_connection(F f) const {
+                if (this->connection->is_open()) {
+                    f(this->connection->get());
+                }
+                this->readers->for_each_opened(f);
+            }
+
+            void for_each_opened_reader(const std::function<void(sqlite3*)>& f) {
+                this->readers->for_each_opened(f);
+            }
+
+            object_cache* find_object_cache(const std::string& tableName) {
+                if (this->objectCaches.empty()) {
+                    return nullptr;
+                }
+                auto it = this->objectCaches.find(tableName);
+                return it != this->objectCaches.end() ? it->second.get() : nullptr;
+            }
+
+            void add_object_cache(const std::string& tableName, std::unique_ptr<object_cache> cache) {
+                this->objectCaches[tableName] = std::move(cache);
+                this->observe_rows();
+            }
+
+            /**
+             *  @return The result cache if it's enabled and the calling thread doesn't run a transaction,
+             *  during which its results are neither looked up nor cached.
+             */
+            result_cache* find_result_cache() {
+                if (!this->resultCache || this->in_own_transaction()) {
+                    return nullptr;
+                }
+                //  the writer connection is kept open by the result cache, hence its data version is continuous
+                if (this->resultCache->get_options().detect_external_changes && !this->inMemory) {
+                    this->resultCache->check_data_version(this->data_version());
+                }
+                return this->resultCache.get();
+            }
+
+            /**
+             *  `PRAGMA data_version` of the writer connection, by a statement kept in the statement cache
+             *  such that it isn't prepared for every lookup of the result cache.
+             */
+            sqlite3_int64 data_version() {
+                sqlite3* db = this->connection->get();
+                statement_cache::key_type key{db, &expression_type_tag<result_cache>::id, "PRAGMA data_version"};
+                statement_finalizer stmt{this->statementCache.take(key)};
+                if (!stmt) {
+                    stmt.reset(prepare_stmt(db, key.sql));
+                }
+                perform_step<SQLITE_ROW>(stmt.get());
+                const sqlite3_int64 dataVersion = sqlite3_column_int64(stmt.get(), 0);
+                this->statementCache.give_back(std::move(key), stmt.release());
+                return dataVersion;
+            }
+
+            /**
+             *  Invalidates cached results depending on a table written by the storage, for tables
+             *  the update hook doesn't report, i.e. WITHOUT ROWID tables.
+             */
+            void invalidate_results(const std::string& tableName) {
+                if (this->resultCache) {
+                    this->resultCache->table_changed(tableName.c_str());
+                }
+            }
+
+            void observe_rows() {
+                if (this->observingRows) {
+                    return;
+                }
+                this->observingRows = true;
+                this->changeNotifier.set_row_observer(
+                    std::bind(&storage_base::on_row_changed, this, std::placeholders::_1, std::placeholders::_2));
+                if (this->connection->is_open()) {
+                    this->changeNotifier.install(this->connection->get());
+                }
+            }
+
+            void clear_object_cache(const std::string& tableName) {
+                auto it = this->objectCaches.find(tableName);
+                if (it != this->objectCaches.end()) {
+                    it->second->clear();
+                }
+            }
+
+            /**
+             *  Drops all cached objects, e.g. once the whole database was replaced, which no hook reports.
+             */
+            void clear_object_caches() {
+                for (auto& entry: this->objectCaches) {
+                    entry.second->clear();
+                }
+            }
+
+            void on_row_changed(const char* tableName, sqlite3_int64 rowid) {
+                auto it = this->objectCaches.find(tableName);
+                if (it != this->objectCaches.end()) {
+                    it->second->invalidate_row(rowid);
+                }
+                if (this->resultCache) {
+                    this->resultCache->table_changed(tableName);
+                }
+            }
+
+            /**
+             *  Called once changes are committed or rolled back,
+             *  see `object_cache::settle()` and `result_cache::settle()`.
+             */
+            void settle_caches() {
+                for (auto& entry: this->objectCaches) {
+                    entry.second->settle();
+                }
+                if (this->resultCache) {
+                    this->resultCache->settle();
                 }
-                return res;
             }
 
 #if SQLITE_VERSION_NUMBER >= 3006019
@@ -18204,14 +22411,28 @@ namespace sqlite_orm {
                     this->foreign_keys(db, true);
                 }
 #endif
-                if (this->pragma.synchronous_ != -1) {
-                    this->pragma.synchronous(this->pragma.synchronous_);
-                }
+                this->pragma.apply_profile_on_open(db, true);
 
                 if (this->pragma.journal_mode_ != -1) {
                     this->pragma.set_pragma("journal_mode", static_cast<journal_mode>(this->pragma.journal_mode_), db);
                 }
 
+                if (this->checkpointer) {
+                    this->install_wal_hook(db);
+                }
+
+                if (!this->changeNotifier.empty()) {
+                    this->changeNotifier.install(db);
+                }
+
+                this->on_open_reader_internal(db);
+            }
+
+            /**
+             *  Connection setup shared by the writer connection and pooled reader connections.
+             *  Pragmas changing how the database is written are left to the writer connection.
+             */
+            void on_open_reader_internal(sqlite3* db) {
                 for (auto& p: this->collatingFunctions) {
                     int rc = sqlite3_create_collation(db, p.first.c_str(), SQLITE_UTF8, &p.second, collate_callback);
                     if (rc != SQLITE_OK) {
@@ -18223,9 +22444,17 @@ namespace sqlite_orm {
                     sqlite3_limit(db, p.first, p.second);
                 }
 
+                this->pragma.apply_profile_on_open(db, false);
+
                 if (_busy_handler) {
-                    sqlite3_busy_handler(this->connection->get(), busy_handler_callback, this);
+                    sqlite3_busy_handler(db, busy_handler_callback, this);
+                }
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+                if (this->profilingStatements) {
+                    this->install_statement_profiler(db);
                 }
+#endif
 
                 for (auto& udfProxy: this->scalarFunctions) {
                     try_to_create_scalar_function(db, udfProxy);
@@ -18240,6 +22469,64 @@ namespace sqlite_orm {
                 }
             }
 
+            /**
+             *  Replaces the auto-checkpoints of the writer connection by notifications of the background checkpointer.
+             */
+            void install_wal_hook(sqlite3* db) {
+                sqlite3_wal_hook(db, background_checkpointer::wal_hook_callback, this->checkpointer.get());
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+            void install_statement_profiler(sqlite3* db) {
+                if (this->profilingStatements) {
+                    sqlite3_trace_v2(db,
+                                     SQLITE_TRACE_PROFILE | SQLITE_TRACE_ROW,
+                                     statement_profiler::trace_callback,
+                                     &this->statementProfiler);
+                } else {
+                    sqlite3_trace_v2(db, 0, nullptr, nullptr);
+                }
+            }
+#endif
+
+            /**
+             *  Checks the query plan of `sql` if `check_full_scans()` is enabled.
+             */
+            void check_query_plan(sqlite3* db, const std::string& sql) const {
+                if (!this->checkingFullScans) {
+                    return;
+                }
+                for (const query_plan_node& node: query_plan_of(db, sql)) {
+                    if (!node.is_scan() || node.table.empty() || node.virtual_table) {
+                        continue;
+                    }
+                    const sqlite3_int64 rowsCount = table_rows_count(db, node.table);
+                    if (rowsCount < 0 || size_t(rowsCount) < this->fullScanMinTableRows) {
+                        continue;
+                    }
+                    if (this->onFullScan) {
+                        this->onFullScan(sql, node);
+                    } else {
+                        throw std::system_error{orm_error_code::full_table_scan, node.detail + " in " + sql};
+                    }
+                }
+            }
+
+            /**
+             *  A schema change expires the statements prepared by every connection, not only by the one
+             *  that made it, so the cached statements of pooled readers are finalized as well.
+             */
+            void clear_statement_caches_for_schema_change() {
+                this->for_each_opened_connection([this](sqlite3* db) {
+                    this->statementCache.clear(db);
+                });
+            }
+
+            void on_close_internal(sqlite3* db) {
+                //  cached statements must be finalized, otherwise the connection can't be closed
+                this->statementCache.clear(db);
+            }
+
             template<class F>
             void create_scalar_function_impl(udf_holder<F> udfName, std::function<void(void* location)> constructAt) {
                 using args_tuple = typename callable_arguments<F>::args_tuple;
@@ -18267,10 +22554,9 @@ namespace sqlite_orm {
                     },
                     udfMemorySpace);
 
-                if (this->connection->retain_count() > 0) {
-                    sqlite3* db = this->connection->get();
+                this->for_each_opened_connection([this](sqlite3* db) {
                     try_to_create_scalar_function(db, this->scalarFunctions.back());
-                }
+                });
             }
 
             template<class F>
@@ -18315,10 +22601,9 @@ namespace sqlite_orm {
                     },
                     obtain_udf_allocator<F>());
 
-                if (this->connection->retain_count() > 0) {
-                    sqlite3* db = this->connection->get();
+                this->for_each_opened_connection([this](sqlite3* db) {
                     try_to_create_aggregate_function(db, this->aggregateFunctions.back());
-                }
+                });
             }
 
             void delete_function_impl(const std::string& name, std::list<udf_proxy>& functions) const {
@@ -18330,8 +22615,7 @@ namespace sqlite_orm {
                 });
 #endif
                 if (it != functions.end()) {
-                    if (this->connection->retain_count() > 0) {
-                        sqlite3* db = this->connection->get();
+                    this->for_each_opened_connection([&name, it](sqlite3* db) {
                         int rc = sqlite3_create_function_v2(db,
                                                             name.c_str(),
                                                             it->argumentsCount,
@@ -18344,7 +22628,7 @@ namespace sqlite_orm {
                         if (rc != SQLITE_OK) {
                             throw_translated_sqlite_error(db);
                         }
-                    }
+                    });
                     it = functions.erase(it);
                 } else {
                     throw std::system_error{orm_error_code::function_not_found};
@@ -18399,6 +22683,7 @@ namespace sqlite_orm {
             }
 
             void drop_table_internal(sqlite3* db, const std::string& tableName, bool ifExists) {
+                this->clear_statement_caches_for_schema_change();
                 std::stringstream ss;
                 ss << "DROP TABLE";
                 if (ifExists) {
@@ -18489,18 +22774,91 @@ namespace sqlite_orm {
 
             const bool inMemory;
             bool isOpenedForever = false;
+            //  declared before the connection such that it outlives it
+            statement_cache statementCache;
             std::unique_ptr<connection_holder> connection;
+            std::unique_ptr<reader_pool> readers;
+            std::atomic_bool inTransaction{false};
+            std::atomic<std::thread::id> transactionThread;
             std::map<std::string, collating_function> collatingFunctions;
             const int cachedForeignKeysCount;
             std::function<int(int)> _busy_handler;
             std::list<udf_proxy> scalarFunctions;
             std::list<udf_proxy> aggregateFunctions;
+            bool checkingFullScans = false;
+            size_t fullScanMinTableRows = 0;
+            std::function<void(const std::string&, const query_plan_node&)> onFullScan;
+            //  SQLite's default number of WAL pages triggering an auto-checkpoint
+            static constexpr int default_wal_autocheckpoint = 1000;
+            std::unique_ptr<background_checkpointer> checkpointer;
+            change_notifier changeNotifier;
+            std::map<std::string, std::unique_ptr<object_cache>, std::less<>> objectCaches;
+            bool observingRows = false;
+            std::unique_ptr<result_cache> resultCache;
+#if SQLITE_VERSION_NUMBER >= 3014000
+            bool profilingStatements = false;
+            statement_profiler statementProfiler;
+#endif
         };
     }
 }
 
 // #include "prepared_statement.h"
 
+// #include "statement_cache.h"
+
+// #include "bulk_load.h"
+
+#include <cstddef>  //  size_t
+#include <chrono>  //  std::chrono::steady_clock, std::chrono::duration
+
+namespace sqlite_orm {
+
+    /**
+     *  Options for `storage_t::bulk_load()`.
+     */
+    struct bulk_load_options {
+        /**
+         *  Drop the indexes of the loaded table before writing and recreate them afterwards,
+         *  which builds every index once instead of updating it for every row.
+         */
+        bool drop_indexes = false;
+
+        /**
+         *  Set `synchronous` to OFF and `journal_mode` to MEMORY during the load and restore them afterwards.
+         *  A crash during the load may then corrupt the database.
+         *  `journal_mode` is kept if it is WAL. Has no effect inside an open transaction,
+         *  during which neither pragma can be changed.
+         */
+        bool relax_durability = false;
+
+        /**
+         *  Write objects including their primary key values, like `replace_range()`,
+         *  instead of letting SQLite assign them, like `insert_range()`.
+         */
+        bool keep_primary_keys = false;
+
+        /**
+         *  Sort objects by their primary key before writing them, which avoids B-tree page splits.
+         *  Only meaningful together with `keep_primary_keys`.
+         */
+        bool sort_by_primary_key = false;
+    };
+
+    /**
+     *  Result of `storage_t::bulk_load()`.
+     */
+    struct bulk_load_result {
+        size_t rows = 0;
+        std::chrono::steady_clock::duration elapsed{};
+
+        double rows_per_second() const {
+            const double seconds = std::chrono::duration<double>(this->elapsed).count();
+            return seconds > 0 ? double(this->rows) / seconds : 0;
+        }
+    };
+}
+
 // #include "expression_object_type.h"
 
 #include <type_traits>  //  std::decay, std::remove_reference
@@ -18526,6 +22884,9 @@ namespace sqlite_orm {
         template<class T>
         struct expression_object_type<update_t<T>, void> : value_unref_type<T> {};
 
+        template<class T>
+        struct expression_object_type<update_columns_t<T>, void> : value_unref_type<T> {};
+
         template<class T>
         struct expression_object_type<replace_t<T>, void> : value_unref_type<T> {};
 
@@ -18615,6 +22976,16 @@ namespace sqlite_orm {
                 return get_ref(e.object);
             }
         };
+
+        template<class T>
+        struct get_object_t<update_columns_t<T>> {
+            using expression_type = update_columns_t<T>;
+
+            template<class O>
+            auto& operator()(O& e) const {
+                return get_ref(e.object);
+            }
+        };
     }
 }
 
@@ -18667,6 +23038,50 @@ namespace sqlite_orm {
 
 // #include "ast/special_keywords.h"
 
+// #include "ast/returning.h"
+
+#include <utility>  //  std::move
+
+// #include "../functional/cxx_type_traits_polyfill.h"
+
+namespace sqlite_orm {
+    namespace internal {
+
+        /**
+         *  RETURNING clause appended to a data modification statement.
+         *  S is the modifying statement, T is the returned column expression or `columns_t`.
+         */
+        template<class S, class T>
+        struct returning_t {
+            using statement_type = S;
+            using columns_type = T;
+
+            S statement;
+            T columns;
+        };
+
+        template<class T>
+        using is_returning = polyfill::is_specialization_of<T, returning_t>;
+    }
+
+#if SQLITE_VERSION_NUMBER >= 3035000
+    /**
+     *  RETURNING clause https://sqlite.org/lang_returning.html
+     *  Makes an `insert`, `insert_range`, `replace`, `replace_range`, `update_all` or `remove_all` statement
+     *  (including raw inserts and replaces) return the given columns of every modified row,
+     *  extracted like the results of a `select`.
+     *
+     *  Example:
+     *  auto statement = storage.prepare(returning(insert(user), columns(&User::id, &User::createdAt)));
+     *  std::vector<std::tuple<int, std::string>> rows = storage.execute(statement);
+     */
+    template<class S, class T>
+    internal::returning_t<S, T> returning(S statement, T columns) {
+        return {std::move(statement), std::move(columns)};
+    }
+#endif
+}
+
 // #include "core_functions.h"
 
 // #include "constraints.h"
@@ -19518,6 +23933,11 @@ namespace sqlite_orm {
                 return quote_blob_literal(field_printer<std::vector<char>>{}(t));
             }
 
+            template<class E>
+            std::string do_serialize(const array_values_t<E>& a) const {
+                return quote_string_literal(serialize_json_array(a.values));
+            }
+
 #if SQLITE_VERSION_NUMBER >= 3020000
             template<class P, class PT, class D>
             std::string do_serialize(const pointer_binding<P, PT, D>&) const {
@@ -20217,7 +24637,8 @@ namespace sqlite_orm {
         struct statement_serializer<
             dynamic_in_t<L, C>,
             std::enable_if_t<!polyfill::disjunction<polyfill::is_specialization_of<C, std::vector>,
-                                                    polyfill::is_specialization_of<C, std::list>>::value>> {
+                                                    polyfill::is_specialization_of<C, std::list>,
+                                                    polyfill::is_specialization_of<C, array_values_t>>::value>> {
             using statement_type = dynamic_in_t<L, C>;
 
             template<class Ctx>
@@ -20266,6 +24687,36 @@ namespace sqlite_orm {
             }
         };
 
+        template<class L, class E>
+        struct statement_serializer<dynamic_in_t<L, array_values_t<E>>, void> {
+            using statement_type = dynamic_in_t<L, array_values_t<E>>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                std::stringstream ss;
+                ss << serialize(statement.left, context) << " ";
+                if (!statement.negative) {
+                    ss << "IN";
+                } else {
+                    ss << "NOT IN";
+                }
+#ifdef SQLITE_ORM_CARRAY_IN_SUPPORTED
+                //  bound are the pointer to the C array and its length
+                if (context.replace_bindable_with_question) {
+                    ss << " carray(?, ?, '" << carray_element<E>::name() << "')";
+                    return ss.str();
+                }
+#endif
+#ifdef SQLITE_ENABLE_JSON1
+                ss << " (SELECT value FROM json_each(" << serialize(statement.argument, context) << "))";
+#else
+                //  a literal array without JSON is a list of values
+                ss << " (" << streaming_dynamic_expressions(statement.argument.values, context) << ")";
+#endif
+                return ss.str();
+            }
+        };
+
         template<class L, class... Args>
         struct statement_serializer<in_t<L, Args...>, void> {
             using statement_type = in_t<L, Args...>;
@@ -20726,6 +25177,48 @@ namespace sqlite_orm {
             }
         };
 
+        template<class T>
+        struct statement_serializer<update_columns_t<T>, void> {
+            using statement_type = update_columns_t<T>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                using object_type = expression_object_type_t<statement_type>;
+                auto& table = pick_table<object_type>(context.db_objects);
+
+                std::stringstream ss;
+                ss << "UPDATE " << streaming_identifier(table.name) << " SET ";
+                table.for_each_column([&table,
+                                       &ss,
+                                       &context,
+                                       &object = get_ref(statement.object),
+                                       &columnsMask = statement.columnsMask,
+                                       index = size_t(0),
+                                       first = true](auto& column) mutable {
+                    if (!columnsMask.at(index++) || column.template is<is_primary_key>() ||
+                        column.template is<is_generated_always>() || exists_in_composite_primary_key(table, column)) {
+                        return;
+                    }
+
+                    static constexpr std::array<const char*, 2> sep = {", ", ""};
+                    ss << sep[std::exchange(first, false)] << streaming_identifier(column.name) << " = "
+                       << serialize(polyfill::invoke(column.member_pointer, object), context);
+                });
+                ss << " WHERE ";
+                table.for_each_column(
+                    [&table, &context, &ss, &object = get_ref(statement.object), first = true](auto& column) mutable {
+                        if (!column.template is<is_primary_key>() && !exists_in_composite_primary_key(table, column)) {
+                            return;
+                        }
+
+                        static constexpr std::array<const char*, 2> sep = {" AND ", ""};
+                        ss << sep[std::exchange(first, false)] << streaming_identifier(column.name) << " = "
+                           << serialize(polyfill::invoke(column.member_pointer, object), context);
+                    });
+                return ss.str();
+            }
+        };
+
         template<class C>
         struct statement_serializer<dynamic_set_t<C>, void> {
             using statement_type = dynamic_set_t<C>;
@@ -20807,6 +25300,24 @@ namespace sqlite_orm {
             }
         };
 
+        template<class S, class T>
+        struct statement_serializer<returning_t<S, T>, void> {
+            using statement_type = returning_t<S, T>;
+
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                //  only columns of the modified table can be returned
+                auto subCtx = context;
+                subCtx.skip_table_name = true;
+                subCtx.use_parentheses = true;
+
+                std::stringstream ss;
+                ss << serialize(statement.statement, context) << " RETURNING "
+                   << streaming_serialized(get_column_names(statement.columns, subCtx));
+                return ss.str();
+            }
+        };
+
         template<class T>
         struct statement_serializer<insert_t<T>, void> {
             using statement_type = insert_t<T>;
@@ -21102,6 +25613,55 @@ namespace sqlite_orm {
             }
         };
 
+#ifdef SQLITE_ENABLE_JSON1
+        template<class T, class Id>
+        struct statement_serializer<get_many_t<T, Id>, void> {
+            using statement_type = get_many_t<T, Id>;
+
+            /**
+             *  Ids are bound as one JSON array, which is joined with the table such that
+             *  the statement's text doesn't depend on the number of ids.
+             *  The last result column is the position of the id in the array.
+             */
+            template<class Ctx>
+            std::string operator()(const statement_type& statement, const Ctx& context) const {
+                auto& table = pick_table<T>(context.db_objects);
+                auto primaryKeyColumnNames = table.primary_key_column_names();
+                if (primaryKeyColumnNames.empty()) {
+                    throw std::system_error{orm_error_code::table_has_no_primary_key_column};
+                }
+                if (primaryKeyColumnNames.size() != id_columns_count<Id>::value) {
+                    throw std::system_error{orm_error_code::arguments_count_does_not_match};
+                }
+
+                const std::string idsAlias = "ids";
+                std::stringstream ss;
+                ss << "SELECT " << streaming_table_column_names(table, table.name) << ", "
+                   << streaming_identifier(idsAlias, "key", std::string{}) << " FROM json_each(";
+                if (context.replace_bindable_with_question) {
+                    ss << "?";
+                } else {
+                    ss << quote_string_literal(serialize_json_array(statement.ids));
+                }
+                ss << ") AS " << streaming_identifier(idsAlias) << " CROSS JOIN " << streaming_identifier(table.name)
+                   << " ON ";
+                for (size_t i = 0; i < primaryKeyColumnNames.size(); ++i) {
+                    if (i > 0) {
+                        ss << " AND ";
+                    }
+                    ss << streaming_identifier(table.name, primaryKeyColumnNames[i], std::string{}) << " = ";
+                    if (id_columns_count<Id>::value == 1 && !polyfill::is_specialization_of<Id, std::tuple>::value) {
+                        ss << streaming_identifier(idsAlias, "value", std::string{});
+                    } else {
+                        ss << "json_extract(" << streaming_identifier(idsAlias, "value", std::string{}) << ", '$["
+                           << i << "]')";
+                    }
+                }
+                return ss.str();
+            }
+        };
+#endif  //  SQLITE_ENABLE_JSON1
+
         template<>
         struct statement_serializer<conflict_action, void> {
             using statement_type = conflict_action;
@@ -22138,53 +26698,309 @@ namespace sqlite_orm {
             const auto& finalColRefs =
                 determine_cte_colrefs(dbObjects, subselectColRefs, cte.explicitColumns, index_sequence{});
 
-            serializer_context context{dbObjects};
-            std::vector<std::string> columnNames = collect_cte_column_names(subSelect, cte.explicitColumns, context);
+            serializer_context context{dbObjects};
+            std::vector<std::string> columnNames = collect_cte_column_names(subSelect, cte.explicitColumns, context);
+
+            using mapper_type = create_cte_mapper_t<cte_moniker_type_t<cte_type>,
+                                                    typename cte_type::explicit_colrefs_tuple,
+                                                    column_expression_of_t<DBOs, subselect_type>,
+                                                    decltype(subselectColRefs),
+                                                    polyfill::remove_cvref_t<decltype(finalColRefs)>,
+                                                    column_results>;
+            return make_cte_table_using_column_indices<mapper_type>(dbObjects,
+                                                                    std::move(tableName),
+                                                                    std::move(columnNames),
+                                                                    finalColRefs,
+                                                                    index_sequence{});
+        }
+
+        template<typename DBOs, typename... CTEs, size_t Ii, size_t... In>
+        decltype(auto) make_recursive_cte_db_objects(const DBOs& dbObjects,
+                                                     const common_table_expressions<CTEs...>& cte,
+                                                     std::index_sequence<Ii, In...>) {
+            auto tbl = make_cte_table(dbObjects, get<Ii>(cte));
+
+            if constexpr (sizeof...(In) > 0) {
+                return make_recursive_cte_db_objects(
+                    // Because CTEs can depend on their predecessor we recursively pass in a new set of DBOs
+                    db_objects_cat(dbObjects, std::move(tbl)),
+                    cte,
+                    std::index_sequence<In...>{});
+            } else {
+                return db_objects_cat(dbObjects, std::move(tbl));
+            }
+        }
+
+        /**
+         *  Return new DBOs for CTE expressions.
+         */
+        template<class DBOs, class E, class... CTEs, satisfies<is_db_objects, DBOs> = true>
+        decltype(auto) db_objects_for_expression(DBOs& dbObjects, const with_t<E, CTEs...>& e) {
+            return make_recursive_cte_db_objects(dbObjects, e.cte, std::index_sequence_for<CTEs...>{});
+        }
+#endif
+    }
+}
+
+// #include "util.h"
+
+// #include "serializing_util.h"
+
+// #include "is_std_ptr.h"
+
+// #include "interrupt.h"
+
+#include <sqlite3.h>
+#include <chrono>  //  std::chrono::steady_clock
+#include <memory>  //  std::shared_ptr, std::make_shared
+#include <mutex>  //  std::mutex, std::lock_guard
+#include <thread>  //  std::this_thread::get_id, std::thread::id
+#include <atomic>  //  std::atomic_bool
+#include <utility>  //  std::move, std::declval
+#include <iterator>  //  std::iterator_traits
+#include <system_error>  //  std::system_error
+
+// #include "error_code.h"
+
+// #include "connection_holder.h"
+
+namespace sqlite_orm {
+
+    namespace internal {
+
+        struct cancellation_state {
+            std::atomic_bool cancelled{false};
+        };
+
+        struct interrupt_guard;
+    }
+
+    /**
+     *  Lets another thread cancel the calls the token is passed to.
+     *  Copies of a token share their state. Cancellation can't be undone.
+     */
+    class cancellation_token {
+      public:
+        cancellation_token() : state{std::make_shared<internal::cancellation_state>()} {}
+
+        /**
+         *  Cancels the statement running on behalf of this token at its next progress check,
+         *  and any call this token is passed to later on.
+         *  Unlike `sqlite3_interrupt()` this leaves alone the statements other threads run on the same connection.
+         */
+        void cancel() {
+            this->state->cancelled = true;
+        }
+
+        bool is_cancelled() const {
+            return this->state->cancelled;
+        }
+
+      private:
+        friend struct internal::interrupt_guard;
+
+        std::shared_ptr<internal::cancellation_state> state;
+    };
+
+    /**
+     *  Limits the time a call may take, passed as the first argument to
+     *  `get_all`, `select` and `iterate`.
+     *  Every `progress_interval` virtual machine operations SQLite checks the deadline and the cancellation token,
+     *  and interrupts the statement once the deadline has passed or the token is cancelled. The call then throws
+     *  a `std::system_error` with `orm_error_code::deadline_exceeded` or `orm_error_code::query_cancelled`,
+     *  and the connection stays usable.
+     */
+    struct query_deadline {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+        cancellation_token token;
+        int progress_interval = 1000;
+    };
+
+    /**
+     *  Deadline `timeout` from now.
+     *  @example
+     *  ```c++
+     *  try {
+     *      auto rows = storage.get_all<Visit>(with_timeout(std::chrono::milliseconds{200}), where(...));
+     *  } catch (const std::system_error& e) {
+     *      if (e.code() == orm_error_code::deadline_exceeded) {
+     *          //  shed load
+     *      }
+     *  }
+     *  ```
+     */
+    inline query_deadline with_timeout(std::chrono::steady_clock::duration timeout, int progressInterval = 1000) {
+        return {std::chrono::steady_clock::now() + timeout, {}, progressInterval};
+    }
+
+    inline query_deadline with_deadline(std::chrono::steady_clock::time_point deadline, int progressInterval = 1000) {
+        return {deadline, {}, progressInterval};
+    }
+
+    /**
+     *  No deadline, but cancellation by calling `token.cancel()` from another thread.
+     */
+    inline query_deadline with_cancellation(cancellation_token token, int progressInterval = 1000) {
+        return {std::chrono::steady_clock::time_point::max(), std::move(token), progressInterval};
+    }
+
+    namespace internal {
+
+        /**
+         *  Enforces a `query_deadline` on the statements run by `run()`, and translates the resulting
+         *  `SQLITE_INTERRUPT` errors into ORM errors.
+         *  While running, the guard installs a progress handler on its connection, replacing any other
+         *  progress handler of the connection. As a connection has only one progress handler,
+         *  guards on the same connection run one at a time. Statements other threads step on the connection
+         *  in the meantime are left alone.
+         */
+        struct interrupt_guard {
+            interrupt_guard(connection_ref con, query_deadline limits) :
+                con{std::move(con)}, limits{std::move(limits)} {}
+
+            interrupt_guard(const interrupt_guard&) = delete;
+            interrupt_guard& operator=(const interrupt_guard&) = delete;
+
+            /**
+             *  Calls `f`, translating an interruption caused by this guard.
+             */
+            template<class F>
+            decltype(auto) run(F&& f) {
+                if (this->limits.token.is_cancelled()) {
+                    throw std::system_error{orm_error_code::query_cancelled};
+                }
+                std::lock_guard<std::mutex> lock{this->con.interrupt_mutex()};
+                progress_handler_scope scope{*this};
+                try {
+                    return f();
+                } catch (const std::system_error& e) {
+                    if (e.code() == sqlite_errc(SQLITE_INTERRUPT)) {
+                        if (this->limits.token.is_cancelled()) {
+                            throw std::system_error{orm_error_code::query_cancelled};
+                        }
+                        if (this->timedOut) {
+                            throw std::system_error{orm_error_code::deadline_exceeded};
+                        }
+                    }
+                    throw;
+                }
+            }
+
+          private:
+            struct progress_handler_scope {
+                interrupt_guard& guard;
+
+                explicit progress_handler_scope(interrupt_guard& guard) : guard{guard} {
+                    this->guard.thread = std::this_thread::get_id();
+                    sqlite3_progress_handler(this->guard.con.get(),
+                                             this->guard.limits.progress_interval,
+                                             progress_callback,
+                                             &this->guard);
+                }
+
+                ~progress_handler_scope() {
+                    sqlite3_progress_handler(this->guard.con.get(), 0, nullptr, nullptr);
+                }
+            };
+
+            static int progress_callback(void* data) {
+                auto& guard = *static_cast<interrupt_guard*>(data);
+                //  a statement of another thread sharing the connection
+                if (std::this_thread::get_id() != guard.thread) {
+                    return 0;
+                }
+                if (guard.limits.token.is_cancelled()) {
+                    return 1;
+                }
+                if (std::chrono::steady_clock::now() >= guard.limits.deadline) {
+                    guard.timedOut = true;
+                    return 1;
+                }
+                return 0;
+            }
+
+            connection_ref con;
+            query_deadline limits;
+            //  the thread running the guarded statement
+            std::thread::id thread;
+            bool timedOut = false;
+        };
+
+        /**
+         *  Iterator of an `interruptible_view`, translating interruptions while stepping.
+         */
+        template<class It>
+        class interruptible_iterator {
+          public:
+            using iterator_category = typename std::iterator_traits<It>::iterator_category;
+            using difference_type = typename std::iterator_traits<It>::difference_type;
+            using value_type = typename std::iterator_traits<It>::value_type;
+            using reference = typename std::iterator_traits<It>::reference;
+            using pointer = typename std::iterator_traits<It>::pointer;
+
+            interruptible_iterator() = default;
+
+            interruptible_iterator(It it, std::shared_ptr<interrupt_guard> guard) :
+                it{std::move(it)}, guard{std::move(guard)} {}
+
+            reference operator*() const {
+                return *this->it;
+            }
+
+            pointer operator->() const {
+                return this->it.operator->();
+            }
 
-            using mapper_type = create_cte_mapper_t<cte_moniker_type_t<cte_type>,
-                                                    typename cte_type::explicit_colrefs_tuple,
-                                                    column_expression_of_t<DBOs, subselect_type>,
-                                                    decltype(subselectColRefs),
-                                                    polyfill::remove_cvref_t<decltype(finalColRefs)>,
-                                                    column_results>;
-            return make_cte_table_using_column_indices<mapper_type>(dbObjects,
-                                                                    std::move(tableName),
-                                                                    std::move(columnNames),
-                                                                    finalColRefs,
-                                                                    index_sequence{});
-        }
+            interruptible_iterator& operator++() {
+                this->guard->run([this] {
+                    ++this->it;
+                });
+                return *this;
+            }
 
-        template<typename DBOs, typename... CTEs, size_t Ii, size_t... In>
-        decltype(auto) make_recursive_cte_db_objects(const DBOs& dbObjects,
-                                                     const common_table_expressions<CTEs...>& cte,
-                                                     std::index_sequence<Ii, In...>) {
-            auto tbl = make_cte_table(dbObjects, get<Ii>(cte));
+            auto operator++(int) {
+                return this->guard->run([this] {
+                    return this->it++;
+                });
+            }
 
-            if constexpr (sizeof...(In) > 0) {
-                return make_recursive_cte_db_objects(
-                    // Because CTEs can depend on their predecessor we recursively pass in a new set of DBOs
-                    db_objects_cat(dbObjects, std::move(tbl)),
-                    cte,
-                    std::index_sequence<In...>{});
-            } else {
-                return db_objects_cat(dbObjects, std::move(tbl));
+            friend bool operator==(const interruptible_iterator& lhs, const interruptible_iterator& rhs) {
+                return lhs.it == rhs.it;
             }
-        }
+
+            friend bool operator!=(const interruptible_iterator& lhs, const interruptible_iterator& rhs) {
+                return !(lhs.it == rhs.it);
+            }
+
+          private:
+            It it;
+            std::shared_ptr<interrupt_guard> guard;
+        };
 
         /**
-         *  Return new DBOs for CTE expressions.
+         *  View returned by `storage_t::iterate()` with a `query_deadline`.
+         *  The deadline is enforced whenever the view or one of its iterators steps the statement.
          */
-        template<class DBOs, class E, class... CTEs, satisfies<is_db_objects, DBOs> = true>
-        decltype(auto) db_objects_for_expression(DBOs& dbObjects, const with_t<E, CTEs...>& e) {
-            return make_recursive_cte_db_objects(dbObjects, e.cte, std::index_sequence_for<CTEs...>{});
-        }
-#endif
-    }
-}
+        template<class V>
+        struct interruptible_view {
+            using iterator = interruptible_iterator<decltype(std::declval<V&>().begin())>;
 
-// #include "util.h"
+            V view;
+            std::shared_ptr<interrupt_guard> guard;
 
-// #include "serializing_util.h"
+            iterator begin() {
+                return {this->guard->run([this] {
+                            return this->view.begin();
+                        }),
+                        this->guard};
+            }
+
+            iterator end() {
+                return {this->view.end(), this->guard};
+            }
+        };
+    }
+}
 
 namespace sqlite_orm {
 
@@ -22206,6 +27022,19 @@ namespace sqlite_orm {
             polyfill::void_t<indirectly_test_preparable<decltype(std::declval<S>().prepare(std::declval<E>()))>>> =
             true;
 
+        /**
+         *  Compares field values of two objects, smart pointers by the values they point to.
+         */
+        template<class T, std::enable_if_t<!is_std_ptr<T>::value, bool> = true>
+        bool field_values_equal(const T& lhs, const T& rhs) {
+            return lhs == rhs;
+        }
+
+        template<class P, std::enable_if_t<is_std_ptr<P>::value, bool> = true>
+        bool field_values_equal(const P& lhs, const P& rhs) {
+            return lhs == rhs || (lhs && rhs && *lhs == *rhs);
+        }
+
         /**
          *  Storage class itself. Create an instanse to use it as an interfacto to sqlite db by calling `make_storage`
          *  function.
@@ -22222,6 +27051,13 @@ namespace sqlite_orm {
             storage_t(std::string filename, db_objects_type dbObjects) :
                 storage_base{std::move(filename), foreign_keys_count(dbObjects)}, db_objects{std::move(dbObjects)} {}
 
+            /**
+             *  @param options how database connections are opened.
+             */
+            storage_t(std::string filename, open_options options, db_objects_type dbObjects) :
+                storage_base{std::move(filename), foreign_keys_count(dbObjects), std::move(options)},
+                db_objects{std::move(dbObjects)} {}
+
             storage_t(const storage_t&) = default;
 
           private:
@@ -22378,6 +27214,37 @@ namespace sqlite_orm {
                 return {*this, std::move(con), std::forward<Args>(args)...};
             }
 
+            /**
+             *  Like `iterate<T>(args...)`, but interrupted once `limits` is exceeded, see `query_deadline`.
+             *  The deadline applies while the returned view or one of its iterators is alive.
+             */
+            template<class T, class O = mapped_type_proxy_t<T>, class... Args>
+            interruptible_view<mapped_view<O, self, Args...>> iterate(query_deadline limits, Args&&... args) {
+                this->assert_mapped_type<O>();
+
+                auto con = this->get_connection();
+                auto guard = std::make_shared<interrupt_guard>(con, std::move(limits));
+                return {{*this, std::move(con), std::forward<Args>(args)...}, std::move(guard)};
+            }
+
+            /**
+             *  Like `iterate<T>(args...)`, but every row is read into the same object, such that scanning
+             *  a large table doesn't allocate per row. The object is overwritten when the iterator is incremented.
+             *  @example
+             *  ```c++
+             *  for (User& user: storage.iterate_in_place<User>(order_by(&User::id))) {
+             *      //  `user` refers to the same object for every row
+             *  }
+             *  ```
+             */
+            template<class T, class O = mapped_type_proxy_t<T>, class... Args>
+            in_place_mapped_view<O, self, Args...> iterate_in_place(Args&&... args) {
+                this->assert_mapped_type<O>();
+
+                auto con = this->get_connection();
+                return {*this, std::move(con), std::forward<Args>(args)...};
+            }
+
 #ifdef SQLITE_ORM_WITH_CPP20_ALIASES
             template<orm_refers_to_table auto mapped, class... Args>
             auto iterate(Args&&... args) {
@@ -22406,6 +27273,37 @@ namespace sqlite_orm {
                 return {this->db_objects, std::move(con), std::move(expression)};
             }
 #endif
+
+            /**
+             *  Like `iterate(select(...))`, but yields a `row_view` of every row instead of extracting its columns.
+             *  Text and blobs are accessed in place without copying, valid until the next row is stepped to:
+             *  @example
+             *  for (const row_view& row: storage.cursor(select(columns(&Log::id, &Log::message)))) {
+             *      if (row.text(1).find("error") != std::string_view::npos) {
+             *          ids.push_back(row.get<int>(0));
+             *      }
+             *  }
+             */
+            template<class Select>
+#ifdef SQLITE_ORM_CONCEPTS_SUPPORTED
+                requires (is_select_v<Select>)
+#endif
+            cursor_view<Select, db_objects_type> cursor(Select expression) {
+                expression.highest_level = true;
+                auto con = this->get_connection();
+                return {this->db_objects, std::move(con), std::move(expression)};
+            }
+
+#if (SQLITE_VERSION_NUMBER >= 3008003) && defined(SQLITE_ORM_WITH_CTE)
+            template<class... CTEs, class E>
+#ifdef SQLITE_ORM_CONCEPTS_SUPPORTED
+                requires (is_select_v<E>)
+#endif
+            cursor_view<with_t<E, CTEs...>, db_objects_type> cursor(with_t<E, CTEs...> expression) {
+                auto con = this->get_connection();
+                return {this->db_objects, std::move(con), std::move(expression)};
+            }
+#endif
 #endif
 
             /**
@@ -22415,61 +27313,365 @@ namespace sqlite_orm {
              * @example: storage.remove_all<User>(); - DELETE FROM users
              * @example: storage.remove_all<User>(where(in(&User::id, {5, 6, 7}))); - DELETE FROM users WHERE id IN (5, 6, 7)
              */
-            template<class O, class... Args>
-            void remove_all(Args&&... args) {
-                this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::remove_all<O>(std::forward<Args>(args)...));
-                this->execute(statement);
+            template<class O, class... Args>
+            void remove_all(Args&&... args) {
+                this->assert_mapped_type<O>();
+                auto statement = this->prepare_cached(sqlite_orm::remove_all<O>(std::forward<Args>(args)...));
+                this->execute(statement);
+            }
+
+#ifdef SQLITE_ORM_WITH_CPP20_ALIASES
+            template<orm_table_reference auto table, class... Args>
+            void remove_all(Args&&... args) {
+                return this->remove_all<auto_decay_table_ref_t<table>>(std::forward<Args>(args)...);
+            }
+#endif
+
+            /**
+             *  Delete routine.
+             *  O is an object's type. Must be specified explicitly.
+             *  @param ids ids of object to be removed.
+             */
+            template<class O, class... Ids>
+            void remove(Ids... ids) {
+                this->assert_mapped_type<O>();
+                auto statement = this->prepare_cached(sqlite_orm::remove<O>(std::forward<Ids>(ids)...));
+                this->execute(statement);
+            }
+
+#ifdef SQLITE_ORM_WITH_CPP20_ALIASES
+            template<orm_table_reference auto table, class... Ids>
+            void remove(Ids... ids) {
+                return this->remove<auto_decay_table_ref_t<table>>(std::forward<Ids>(ids)...);
+            }
+#endif
+
+            /**
+             *  Update routine. Sets all non primary key fields where primary key is equal.
+             *  O is an object type. May be not specified explicitly cause it can be deduced by
+             *      compiler from first parameter.
+             *  @param o object to be updated.
+             */
+            template<class O>
+            void update(const O& o) {
+                this->assert_mapped_type<O>();
+                auto statement = this->prepare_cached(sqlite_orm::update(std::ref(o)));
+                this->execute(statement);
+            }
+
+            /**
+             *  Update routine that sets only the given fields where primary key is equal.
+             *  Statements are cached per distinct set of fields.
+             *  Throws std::system_error{orm_error_code::incorrect_set_fields_specified} if none of the fields
+             *  can be set, i.e. all are primary key or generated columns.
+             *  @param o object to be updated.
+             *  @param members member pointers or getters/setters of the fields to be updated.
+             *  @example
+             *  ```c++
+             *  user.email = "new@example.com";
+             *  storage.update(user, &User::email);
+             *  ```
+             */
+            template<class O, class M, class... Ms>
+            void update(const O& o, M member, Ms... members) {
+                this->assert_mapped_type<O>();
+                this->assert_updatable_type<O>();
+                auto& table = this->get_table<O>();
+                const std::string* names[] = {table.find_column_name(member), table.find_column_name(members)...};
+                for (const std::string* name: names) {
+                    if (!name) {
+                        throw std::system_error{orm_error_code::column_not_found};
+                    }
+                }
+                std::vector<bool> columnsMask;
+                bool settable = false;
+                table.for_each_column([&table, &names, &columnsMask, &settable](auto& column) {
+                    const bool set =
+                        is_settable_column(table, column) &&
+                        std::any_of(std::begin(names), std::end(names), [&column](const std::string* name) {
+                            return *name == column.name;
+                        });
+                    columnsMask.push_back(set);
+                    settable = settable || set;
+                });
+                //  key columns identify the row and can't be set
+                if (!settable) {
+                    throw std::system_error{orm_error_code::incorrect_set_fields_specified};
+                }
+                this->update_columns(o, std::move(columnsMask));
+            }
+
+            /**
+             *  Update routine that sets only the fields of `updated` that differ from `original`,
+             *  where primary key of `updated` is equal. Nothing is executed if no field differs;
+             *  primary key and generated columns are never set.
+             *  Statements are cached per distinct set of fields.
+             *  @param original snapshot of the object, e.g. as it was fetched.
+             *  @param updated object to be updated.
+             *  @return Whether any field differed.
+             */
+            template<class O>
+            bool update_changed(const O& original, const O& updated) {
+                this->assert_mapped_type<O>();
+                this->assert_updatable_type<O>();
+                auto& table = this->get_table<O>();
+                std::vector<bool> columnsMask;
+                bool changed = false;
+                table.for_each_column([&table, &original, &updated, &columnsMask, &changed](auto& column) {
+                    const bool differs = is_settable_column(table, column) &&
+                                         !field_values_equal(polyfill::invoke(column.member_pointer, original),
+                                                             polyfill::invoke(column.member_pointer, updated));
+                    columnsMask.push_back(differs);
+                    changed = changed || differs;
+                });
+                if (changed) {
+                    this->update_columns(updated, std::move(columnsMask));
+                }
+                return changed;
+            }
+
+            template<class S, class... Wargs>
+            void update_all(S set, Wargs... wh) {
+                static_assert(internal::is_set<S>::value,
+                              "first argument in update_all can be either set or dynamic_set");
+                auto statement = this->prepare(sqlite_orm::update_all(std::move(set), std::forward<Wargs>(wh)...));
+                this->execute(statement);
+            }
+
+          protected:
+            /**
+             *  Looks up the object with the given primary key in the object cache of `O`,
+             *  loading and caching it on a miss.
+             *  @return Whether the object cache could be used, in which case `object` is a copy of the result.
+             */
+            template<class O, class... Ids>
+            bool get_through_object_cache(std::unique_ptr<O>& object, const Ids&... ids) {
+                return this->get_through_object_cache(std::is_copy_constructible<O>{}, object, ids...);
+            }
+
+            template<class O, class... Ids>
+            bool get_through_object_cache(std::false_type, std::unique_ptr<O>&, const Ids&...) {
+                return false;
+            }
+
+            template<class O, class... Ids>
+            bool get_through_object_cache(std::true_type, std::unique_ptr<O>& object, const Ids&... ids) {
+                //  objects aren't cached during own transactions, which may still roll back
+                object_cache* cache =
+                    this->in_own_transaction() ? nullptr : this->find_object_cache(this->tablename<O>());
+                std::string key;
+                if (!cache || !append_cache_keys(key, ids...)) {
+                    return false;
+                }
+                if (std::shared_ptr<const void> cached = cache->find(key)) {
+                    object = std::make_unique<O>(*static_cast<const O*>(cached.get()));
+                    return true;
+                }
+                const uint64_t generation = cache->generation();
+                auto statement = this->prepare_cached(sqlite_orm::get_pointer<O>(ids...));
+                object = this->execute(statement);
+                //  only cached by the key its primary key yields, which invalidation uses,
+                //  i.e. not if the ids were of other kinds than the primary key, e.g. `get<T>(1.0)` for an integer key
+                std::string objectKey;
+                if (object && this->append_object_cache_key(objectKey, *object) && objectKey == key) {
+                    cache->insert(std::move(key), std::make_shared<const O>(*object), generation);
+                }
+                return true;
+            }
+
+            /**
+             *  Executes a query through the result cache if it's enabled, see `enable_result_cache()`.
+             *  Results of move-only types aren't cached.
+             */
+            template<class S>
+            auto execute_through_result_cache(const S& statement) {
+                using R = decltype(this->execute(statement));
+                using is_cacheable = polyfill::bool_constant<std::is_copy_constructible<R>::value &&
+                                                             std::is_copy_constructible<typename R::value_type>::value>;
+                return this->execute_through_result_cache<R>(is_cacheable{}, statement);
+            }
+
+            template<class R, class S>
+            R execute_through_result_cache(std::false_type, const S& statement) {
+                return this->execute(statement);
+            }
+
+            template<class R, class S>
+            R execute_through_result_cache(std::true_type, const S& statement) {
+                result_cache* cache = this->find_result_cache();
+                if (!cache) {
+                    return this->execute(statement);
+                }
+                std::string key = make_result_cache_key<R>(statement.stmt, statement.expression);
+                if (key.empty()) {
+                    return this->execute(statement);
+                }
+                if (std::shared_ptr<const void> cached = cache->find(key)) {
+                    return *std::static_pointer_cast<const R>(std::move(cached));
+                }
+                const uint64_t generation = cache->generation();
+                R result = this->execute(statement);
+                std::set<std::string> tables = this->result_cache_tables(statement.expression);
+                if (!tables.empty()) {
+                    const size_t bytes = sizeof(R) + result.size() * sizeof(typename R::value_type);
+                    cache->insert(std::move(key), std::make_shared<const R>(result), bytes, std::move(tables), generation);
+                }
+                return result;
+            }
+
+            /**
+             *  Names of the tables a query reads, as far as its columns and conditions tell.
+             */
+            template<class E>
+            std::set<std::string> result_cache_tables(const E& expression) const {
+                auto collector = make_table_name_collector(this->db_objects);
+                iterate_ast(expression, collector);
+                std::set<std::string> tables;
+                for (auto& tableName: collector.table_names) {
+                    if (!tableName.first.empty()) {
+                        tables.insert(tableName.first);
+                    }
+                }
+                return tables;
+            }
+
+            template<class T, class R, class... Args>
+            std::set<std::string> result_cache_tables(const get_all_t<T, R, Args...>& expression) const {
+                std::set<std::string> tables = this->result_cache_tables(expression.conditions);
+                tables.insert(this->tablename<mapped_type_proxy_t<T>>());
+                return tables;
+            }
+
+            /**
+             *  Invalidates the cached object with the primary key of `object` after it was written.
+             */
+            template<class O>
+            void invalidate_cached_object(const O& object) {
+                object_cache* cache = this->find_object_cache(this->tablename<O>());
+                if (!cache) {
+                    return;
+                }
+                std::string key;
+                if (this->append_object_cache_key(key, object)) {
+                    cache->invalidate(std::move(key));
+                } else {
+                    cache->invalidate_all();
+                }
+            }
+
+            /**
+             *  Appends the values of the primary key of `object` to an object cache key.
+             *  @return false if a value can't be appended, in which case there is no key.
+             */
+            template<class O>
+            bool append_object_cache_key(std::string& key, const O& object) {
+                bool appended = true;
+                this->get_table<O>().for_each_primary_key_column([&key, &appended, &object](auto& memberPointer) {
+                    appended = append_cache_key(key, polyfill::invoke(memberPointer, object)) && appended;
+                });
+                return appended;
+            }
+
+            template<class O, class... Ids>
+            void invalidate_cached_object_by_id(const std::tuple<Ids...>& ids) {
+                object_cache* cache = this->find_object_cache(this->tablename<O>());
+                if (!cache) {
+                    return;
+                }
+                //  ids of other kinds than the primary key, e.g. `remove<T>(1.0)` for an integer key,
+                //  don't yield the key the object was cached by
+                std::string tags, idTags;
+                this->get_table<O>().for_each_primary_key_column([&tags](auto& memberPointer) {
+                    tags += cache_key_tag<member_field_type_t<std::decay_t<decltype(memberPointer)>>>::value;
+                });
+                std::string key;
+                bool appended = true;
+                iterate_tuple(ids, [&key, &appended, &idTags](auto& id) {
+                    idTags += cache_key_tag<std::decay_t<decltype(id)>>::value;
+                    appended = append_cache_key(key, id) && appended;
+                });
+                if (appended && idTags == tags) {
+                    cache->invalidate(std::move(key));
+                } else {
+                    cache->invalidate_all();
+                }
+            }
+
+            template<class T>
+            void invalidate_replaced_objects(const replace_t<T>& expression) {
+                this->invalidate_cached_object(get_object(expression));
+            }
+
+            template<class It, class Projection, class O>
+            void invalidate_replaced_objects(const replace_range_t<It, Projection, O>&) {
+                this->invalidate_object_caches(this->tablename<O>());
+            }
+
+            void invalidate_object_caches(const std::string& tableName) {
+                if (object_cache* cache = this->find_object_cache(tableName)) {
+                    cache->invalidate_all();
+                }
+            }
+
+            /**
+             *  Invalidates cached results of the table written by a completed statement, see `after_write()`.
+             */
+            void after_write(const std::string& tableName) {
+                this->invalidate_results(tableName);
+                this->after_write();
             }
 
-#ifdef SQLITE_ORM_WITH_CPP20_ALIASES
-            template<orm_table_reference auto table, class... Args>
-            void remove_all(Args&&... args) {
-                return this->remove_all<auto_decay_table_ref_t<table>>(std::forward<Args>(args)...);
+            /**
+             *  Settles the caches after a completed statement wrote the database,
+             *  unless a transaction is running, which settles them when it ends.
+             */
+            void after_write() {
+                if (!this->inTransaction) {
+                    this->settle_caches();
+                }
             }
-#endif
 
             /**
-             *  Delete routine.
-             *  O is an object's type. Must be specified explicitly.
-             *  @param ids ids of object to be removed.
+             *  Calls `f` running a statement that writes the database through `db`.
+             *  If it fails, the row changes the statement already reported to change listeners are discarded,
+             *  because SQLite rolls back a failed statement without calling a hook.
+             *  The connection's mutex is held meanwhile, such that statements of other threads sharing
+             *  the connection don't report changes in between.
              */
-            template<class O, class... Ids>
-            void remove(Ids... ids) {
-                this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::remove<O>(std::forward<Ids>(ids)...));
-                this->execute(statement);
+            template<class F>
+            decltype(auto) run_write_statement(sqlite3* db, F&& f) {
+                connection_mutex_lock lock{db};
+                const size_t mark = this->changeNotifier.mark();
+                try {
+                    return f();
+                } catch (...) {
+                    this->changeNotifier.discard_since(mark);
+                    throw;
+                }
             }
 
-#ifdef SQLITE_ORM_WITH_CPP20_ALIASES
-            template<orm_table_reference auto table, class... Ids>
-            void remove(Ids... ids) {
-                return this->remove<auto_decay_table_ref_t<table>>(std::forward<Ids>(ids)...);
+            void perform_write_step(sqlite3_stmt* stmt) {
+                this->run_write_statement(sqlite3_db_handle(stmt), [stmt] {
+                    perform_step(stmt);
+                });
             }
-#endif
 
             /**
-             *  Update routine. Sets all non primary key fields where primary key is equal.
-             *  O is an object type. May be not specified explicitly cause it can be deduced by
-             *      compiler from first parameter.
-             *  @param o object to be updated.
+             *  Whether a column can be set by `update_columns()`, i.e. it is neither a key column nor generated.
              */
-            template<class O>
-            void update(const O& o) {
-                this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::update(std::ref(o)));
-                this->execute(statement);
+            template<class Table, class C>
+            static bool is_settable_column(const Table& table, const C& column) {
+                return !column.template is<is_primary_key>() && !column.template is<is_generated_always>() &&
+                       !exists_in_composite_primary_key(table, column);
             }
 
-            template<class S, class... Wargs>
-            void update_all(S set, Wargs... wh) {
-                static_assert(internal::is_set<S>::value,
-                              "first argument in update_all can be either set or dynamic_set");
-                auto statement = this->prepare(sqlite_orm::update_all(std::move(set), std::forward<Wargs>(wh)...));
+            template<class O>
+            void update_columns(const O& o, std::vector<bool> columnsMask) {
+                using statement_type = update_columns_t<std::reference_wrapper<const O>>;
+                auto statement = this->prepare_cached(statement_type{std::cref(o), std::move(columnsMask)});
                 this->execute(statement);
             }
 
-          protected:
             template<class F, class O, class... Args>
             std::string group_concat_internal(F O::* m, std::unique_ptr<std::string> y, Args&&... args) {
                 this->assert_mapped_type<O>();
@@ -22498,8 +27700,22 @@ namespace sqlite_orm {
             template<class T, class R = std::vector<mapped_type_proxy_t<T>>, class... Args>
             R get_all(Args&&... args) {
                 this->assert_mapped_type<mapped_type_proxy_t<T>>();
-                auto statement = this->prepare(sqlite_orm::get_all<T, R>(std::forward<Args>(args)...));
-                return this->execute(statement);
+                auto statement = this->prepare_cached(sqlite_orm::get_all<T, R>(std::forward<Args>(args)...));
+                return this->execute_through_result_cache(statement);
+            }
+
+            /**
+             *  Like `get_all<T, R>(args...)`, but interrupted once `limits` is exceeded, see `query_deadline`.
+             *  @example: storage.get_all<User>(with_timeout(std::chrono::milliseconds{100}), where(...));
+             */
+            template<class T, class R = std::vector<mapped_type_proxy_t<T>>, class... Args>
+            R get_all(query_deadline limits, Args&&... args) {
+                this->assert_mapped_type<mapped_type_proxy_t<T>>();
+                auto statement = this->prepare_cached(sqlite_orm::get_all<T, R>(std::forward<Args>(args)...));
+                interrupt_guard guard{statement.con, std::move(limits)};
+                return guard.run([this, &statement] {
+                    return this->execute(statement);
+                });
             }
 
 #ifdef SQLITE_ORM_WITH_CPP20_ALIASES
@@ -22531,7 +27747,7 @@ namespace sqlite_orm {
             template<class O, class R = std::vector<std::unique_ptr<O>>, class... Args>
             auto get_all_pointer(Args&&... args) {
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::get_all_pointer<O, R>(std::forward<Args>(args)...));
+                auto statement = this->prepare_cached(sqlite_orm::get_all_pointer<O, R>(std::forward<Args>(args)...));
                 return this->execute(statement);
             }
 
@@ -22556,7 +27772,8 @@ namespace sqlite_orm {
             template<class O, class R = std::vector<std::optional<O>>, class... Args>
             auto get_all_optional(Args&&... conditions) {
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::get_all_optional<O, R>(std::forward<Args>(conditions)...));
+                auto statement =
+                    this->prepare_cached(sqlite_orm::get_all_optional<O, R>(std::forward<Args>(conditions)...));
                 return this->execute(statement);
             }
 #endif
@@ -22581,7 +27798,14 @@ namespace sqlite_orm {
             template<class O, class... Ids>
             O get(Ids... ids) {
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::get<O>(std::forward<Ids>(ids)...));
+                std::unique_ptr<O> cached;
+                if (this->get_through_object_cache(cached, ids...)) {
+                    if (!cached) {
+                        throw std::system_error{orm_error_code::not_found};
+                    }
+                    return std::move(*cached);
+                }
+                auto statement = this->prepare_cached(sqlite_orm::get<O>(std::forward<Ids>(ids)...));
                 return this->execute(statement);
             }
 
@@ -22599,7 +27823,11 @@ namespace sqlite_orm {
             template<class O, class... Ids>
             std::unique_ptr<O> get_pointer(Ids... ids) {
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::get_pointer<O>(std::forward<Ids>(ids)...));
+                std::unique_ptr<O> cached;
+                if (this->get_through_object_cache(cached, ids...)) {
+                    return cached;
+                }
+                auto statement = this->prepare_cached(sqlite_orm::get_pointer<O>(std::forward<Ids>(ids)...));
                 return this->execute(statement);
             }
 
@@ -22610,6 +27838,45 @@ namespace sqlite_orm {
             }
 #endif
 
+#ifdef SQLITE_ENABLE_JSON1
+            /**
+             *  Fetches the objects with the given primary keys in one statement.
+             *  The ids are bound as one JSON array, hence this needs the JSON1 extension.
+             *  @param ids Primary keys, or tuples of the values of a composite primary key.
+             *  @return Objects in the order of `ids`, with null pointers for ids that don't exist.
+             *  @example
+             *  ```c++
+             *  auto users = storage.get_many<User>(std::vector<int>{3, 1, 42});
+             *  //  users[2] == nullptr if there is no user with id 42
+             *  ```
+             */
+            template<class O, class Id>
+            std::vector<std::unique_ptr<O>> get_many(std::vector<Id> ids) {
+                this->assert_mapped_type<O>();
+                auto statement = this->prepare_cached(sqlite_orm::get_many<O>(std::move(ids)));
+                return this->execute(statement);
+            }
+
+            /**
+             *  The same as `get_many` but returns the found objects mapped by their id.
+             *  Ids that don't exist are absent from the map.
+             */
+            template<class O, class Id>
+            std::map<Id, O> get_many_map(std::vector<Id> ids) {
+                this->assert_mapped_type<O>();
+                auto statement = this->prepare_cached(sqlite_orm::get_many<O>(std::move(ids)));
+                auto objects = this->execute(statement);
+                auto& foundIds = statement.expression.ids;
+                std::map<Id, O> res;
+                for (size_t i = 0; i < objects.size(); ++i) {
+                    if (objects[i]) {
+                        res.emplace(std::move(foundIds[i]), std::move(*objects[i]));
+                    }
+                }
+                return res;
+            }
+#endif  //  SQLITE_ENABLE_JSON1
+
             /**
              * A previous version of get_pointer() that returns a shared_ptr
              * instead of a unique_ptr. New code should prefer get_pointer()
@@ -22636,7 +27903,11 @@ namespace sqlite_orm {
             template<class O, class... Ids>
             std::optional<O> get_optional(Ids... ids) {
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::get_optional<O>(std::forward<Ids>(ids)...));
+                std::unique_ptr<O> cached;
+                if (this->get_through_object_cache(cached, ids...)) {
+                    return cached ? std::optional<O>{std::move(*cached)} : std::nullopt;
+                }
+                auto statement = this->prepare_cached(sqlite_orm::get_optional<O>(std::forward<Ids>(ids)...));
                 return this->execute(statement);
             }
 #endif  // SQLITE_ORM_OPTIONAL_SUPPORTED
@@ -22854,8 +28125,40 @@ namespace sqlite_orm {
             auto select(T m, Args... args) {
                 static_assert(!is_compound_operator_v<T> || sizeof...(Args) == 0,
                               "Cannot use args with a compound operator");
-                auto statement = this->prepare(sqlite_orm::select(std::move(m), std::forward<Args>(args)...));
-                return this->execute(statement);
+                auto statement = this->prepare_cached(sqlite_orm::select(std::move(m), std::forward<Args>(args)...));
+                return this->execute_through_result_cache(statement);
+            }
+
+            /**
+             *  Like `select(m, args...)`, but interrupted once `limits` is exceeded, see `query_deadline`.
+             */
+            template<class T, class... Args>
+            auto select(query_deadline limits, T m, Args... args) {
+                static_assert(!is_compound_operator_v<T> || sizeof...(Args) == 0,
+                              "Cannot use args with a compound operator");
+                auto statement = this->prepare_cached(sqlite_orm::select(std::move(m), std::forward<Args>(args)...));
+                interrupt_guard guard{statement.con, std::move(limits)};
+                return guard.run([this, &statement] {
+                    return this->execute(statement);
+                });
+            }
+
+            /**
+             *  Select multiple columns into one vector per column instead of one tuple per row,
+             *  such that the values of a column are contiguous in memory.
+             *  Arithmetic values are read by `sqlite3_column_int()`, `sqlite3_column_int64()`
+             *  or `sqlite3_column_double()` straight into their vector.
+             *  Example: `auto [ids, scores] = storage.get_columns(columns(&User::id, &User::score), where(...));`
+             *
+             *  @return `std::tuple` of `std::vector`s in the order of the columns.
+             */
+            template<class... Cols, class... Args>
+            auto get_columns(columns_t<Cols...> cols, Args... args) {
+                using ColResult = column_result_of_t<db_objects_type, columns_t<Cols...>>;
+                auto statement = this->prepare_cached(sqlite_orm::select(std::move(cols), std::forward<Args>(args)...));
+                sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+                iterate_ast(statement.expression, conditional_binder{stmt});
+                return this->extract_columns(stmt, polyfill::type_identity<ColResult>{});
             }
 
 #if (SQLITE_VERSION_NUMBER >= 3008003) && defined(SQLITE_ORM_WITH_CTE)
@@ -22919,6 +28222,24 @@ namespace sqlite_orm {
                 return this->dump_highest_level(e2, parametrized);
             }
 
+            /**
+             *  Runs `EXPLAIN QUERY PLAN` for a high-level statement or a prepared statement,
+             *  serialized like by `prepare()`.
+             *  @return The nodes of the plan tree in the order SQLite reports them.
+             *
+             *  @example
+             *  ```c++
+             *  auto plan = storage.explain(get_all<User>(where(c(&User::email) == "")));
+             *  bool usesIndex = plan.at(0).is_search() && plan.at(0).index == "idx_users_email";
+             *  ```
+             */
+            template<class E>
+            std::vector<query_plan_node> explain(E&& expression) {
+                std::string sql = this->dump(std::forward<E>(expression), true);
+                auto con = this->get_connection();
+                return query_plan_of(con.get(), sql);
+            }
+
             /**
              *  Returns a string representation of object of a class mapped to the storage.
              *  Type of string has json-like style.
@@ -22948,7 +28269,7 @@ namespace sqlite_orm {
             template<class O>
             void replace(const O& o) {
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::replace(std::ref(o)));
+                auto statement = this->prepare_cached(sqlite_orm::replace(std::ref(o)));
                 this->execute(statement);
             }
 
@@ -22960,9 +28281,9 @@ namespace sqlite_orm {
                     return;
                 }
 
-                auto statement =
-                    this->prepare(sqlite_orm::replace_range(std::move(from), std::move(to), std::move(project)));
-                this->execute(statement);
+                this->execute_range_in_chunks(
+                    sqlite_orm::replace_range(std::move(from), std::move(to), std::move(project)),
+                    this->get_table<O>().template count_of_columns_excluding<is_generated_always>());
             }
 
             template<class O, class It, class Projection = polyfill::identity>
@@ -22972,16 +28293,16 @@ namespace sqlite_orm {
                     return;
                 }
 
-                auto statement =
-                    this->prepare(sqlite_orm::replace_range<O>(std::move(from), std::move(to), std::move(project)));
-                this->execute(statement);
+                this->execute_range_in_chunks(
+                    sqlite_orm::replace_range<O>(std::move(from), std::move(to), std::move(project)),
+                    this->get_table<O>().template count_of_columns_excluding<is_generated_always>());
             }
 
             template<class O, class... Cols>
             int insert(const O& o, columns_t<Cols...> cols) {
                 static_assert(cols.count > 0, "Use insert or replace with 1 argument instead");
                 this->assert_mapped_type<O>();
-                auto statement = this->prepare(sqlite_orm::insert(std::ref(o), std::move(cols)));
+                auto statement = this->prepare_cached(sqlite_orm::insert(std::ref(o), std::move(cols)));
                 return int(this->execute(statement));
             }
 
@@ -22994,7 +28315,7 @@ namespace sqlite_orm {
             int insert(const O& o) {
                 this->assert_mapped_type<O>();
                 this->assert_insertable_type<O>();
-                auto statement = this->prepare(sqlite_orm::insert(std::ref(o)));
+                auto statement = this->prepare_cached(sqlite_orm::insert(std::ref(o)));
                 return int(this->execute(statement));
             }
 
@@ -23080,9 +28401,9 @@ namespace sqlite_orm {
                 if (from == to) {
                     return;
                 }
-                auto statement =
-                    this->prepare(sqlite_orm::insert_range(std::move(from), std::move(to), std::move(project)));
-                this->execute(statement);
+                this->execute_range_in_chunks(
+                    sqlite_orm::insert_range(std::move(from), std::move(to), std::move(project)),
+                    this->count_of_insertable_columns<O>());
             }
 
             template<class O, class It, class Projection = polyfill::identity>
@@ -23092,9 +28413,87 @@ namespace sqlite_orm {
                 if (from == to) {
                     return;
                 }
-                auto statement =
-                    this->prepare(sqlite_orm::insert_range<O>(std::move(from), std::move(to), std::move(project)));
-                this->execute(statement);
+                this->execute_range_in_chunks(
+                    sqlite_orm::insert_range<O>(std::move(from), std::move(to), std::move(project)),
+                    this->count_of_insertable_columns<O>());
+            }
+
+            /**
+             *  Loads a large range of objects of type O into their table, following SQLite's bulk loading practices:
+             *  everything is written in one exclusive transaction, in chunks of reused statements,
+             *  optionally without the table's indexes (recreated at the end) and with relaxed durability.
+             *  If a transaction is already open the objects are written inside it, within a savepoint
+             *  that is rolled back on failure, and committing is left to the caller.
+             *  @param range Range of objects of type O, e.g. `std::vector<O>`.
+             *  @return Number of rows written and the time it took.
+             *  @example
+             *  ```c++
+             *  bulk_load_options options;
+             *  options.keep_primary_keys = true;
+             *  options.sort_by_primary_key = true;
+             *  auto result = storage.bulk_load<User>(users, options);
+             *  std::cout << result.rows_per_second() << " rows/s" << std::endl;
+             *  ```
+             */
+            template<class O, class R>
+            bulk_load_result bulk_load(const R& range, bulk_load_options options = {}) {
+                this->assert_mapped_type<O>();
+                const auto start = std::chrono::steady_clock::now();
+
+                //  pragmas are set per connection, hence the connection must stay opened during the load
+                auto con = this->get_connection();
+                sqlite3* db = con.get();
+
+                const bool inTransaction = !sqlite3_get_autocommit(db);
+                int synchronous = -1;
+                std::string journalMode;
+                //  neither pragma can be changed inside a transaction
+                if (options.relax_durability && !inTransaction) {
+                    perform_exec(db, "PRAGMA synchronous", extract_single_value<int>, &synchronous);
+                    perform_exec(db, "PRAGMA journal_mode", extract_single_value<std::string>, &journalMode);
+                    perform_void_exec(db, "PRAGMA synchronous = OFF");
+                    //  leaving WAL requires exclusive access to the database, so WAL is kept
+                    if (journalMode != "wal") {
+                        perform_void_exec(db, "PRAGMA journal_mode = MEMORY");
+                    }
+                }
+                auto restoreDurability = [db, synchronous, &journalMode] {
+                    if (synchronous != -1) {
+                        perform_void_exec(db, "PRAGMA synchronous = " + std::to_string(synchronous));
+                    }
+                    if (!journalMode.empty() && journalMode != "wal") {
+                        perform_void_exec(db, "PRAGMA journal_mode = " + journalMode);
+                    }
+                };
+
+                bulk_load_result result;
+                try {
+                    if (inTransaction) {
+                        connection_mutex_lock lock{db};
+                        perform_void_exec(db, "SAVEPOINT bulk_load");
+                        const size_t changesMark = this->changeNotifier.mark();
+                        try {
+                            result.rows = this->bulk_write_with_indexes<O>(range, options);
+                        } catch (...) {
+                            perform_void_exec(db, "ROLLBACK TO bulk_load");
+                            //  rolling back to a savepoint doesn't call a hook either
+                            this->changeNotifier.discard_since(changesMark);
+                            perform_void_exec(db, "RELEASE bulk_load");
+                            throw;
+                        }
+                        perform_void_exec(db, "RELEASE bulk_load");
+                    } else {
+                        auto guard = this->exclusive_transaction_guard();
+                        result.rows = this->bulk_write_with_indexes<O>(range, options);
+                        guard.commit();
+                    }
+                } catch (...) {
+                    restoreDurability();
+                    throw;
+                }
+                restoreDurability();
+                result.elapsed = std::chrono::steady_clock::now() - start;
+                return result;
             }
 
             /**
@@ -23110,6 +28509,104 @@ namespace sqlite_orm {
 
             using storage_base::rename_table;
 
+            /**
+             *  Registers a listener of the rows of `O` inserted, updated or deleted by committed transactions,
+             *  see `storage_base::add_change_listener()`.
+             *
+             *  @example
+             *  ```c++
+             *  storage.add_change_listener<User>([&cache](const std::vector<row_change>& changes) {
+             *      for (auto& change: changes) {
+             *          cache.erase(change.rowid);
+             *      }
+             *  });
+             *  ```
+             */
+            template<class O>
+            size_t add_change_listener(std::function<void(const std::vector<row_change>& changes)> listener) {
+                this->assert_mapped_type<O>();
+                return this->storage_base::add_change_listener(this->tablename<O>(), std::move(listener));
+            }
+
+            using storage_base::add_change_listener;
+
+            /**
+             *  Enables an identity map of the objects of `O` by primary key, which `get()`, `get_pointer()` and
+             *  `get_optional()` consult before querying. Objects are loaded and cached outside of transactions only.
+             *  Cached objects are invalidated by `update()`, `replace()`, `remove()`, `update_all()` and
+             *  `remove_all()`, and by the update hook for rows changed otherwise through this storage.
+             *  Changes by other connections, and changes of WITHOUT ROWID tables other than by the functions above,
+             *  aren't noticed. Neither are rows the update hook doesn't report: rows deleted by a raw `DELETE`
+             *  without `WHERE` clause (SQLite's truncate optimization) and rows deleted by the `REPLACE` conflict
+             *  resolution, e.g. when `replace()` conflicts with a unique column of another row;
+             *  call `clear_object_cache<O>()` after such changes.
+             *  The whole database being replaced by `deserialize_database()` or `backup_from()` clears the cache.
+             *  Must be called before the storage is used by several threads.
+             *
+             *  @param sizeOf Size of an object counted against `object_cache_options::max_bytes`,
+             *  `sizeof(O)` by default.
+             *  @example
+             *  ```c++
+             *  storage.enable_object_cache<User>();
+             *  auto user = storage.get<User>(1);  //  queried
+             *  user = storage.get<User>(1);  //  copied from the cache
+             *  ```
+             */
+            template<class O>
+            void enable_object_cache(object_cache_options options = {},
+                                     std::function<size_t(const O& object)> sizeOf = {}) {
+                this->assert_mapped_type<O>();
+                static_assert(std::is_copy_constructible<O>::value, "cached objects are returned as copies");
+                //  a single integer primary key is an alias for the rowid the update hook reports
+                int primaryKeyColumnsCount = 0;
+                bool integerPrimaryKey = false;
+                this->get_table<O>().for_each_primary_key_column(
+                    [&primaryKeyColumnsCount, &integerPrimaryKey](auto& memberPointer) {
+                        using field_type = member_field_type_t<std::decay_t<decltype(memberPointer)>>;
+                        static_assert(is_printable<field_type>::value,
+                                      "a field_printer is needed for the primary key of cached objects");
+                        ++primaryKeyColumnsCount;
+                        integerPrimaryKey = std::is_integral<field_type>::value;
+                    });
+                object_cache::size_function size;
+                if (sizeOf) {
+                    size = [sizeOf = std::move(sizeOf)](const void* object) {
+                        return sizeOf(*static_cast<const O*>(object));
+                    };
+                } else {
+                    size = [](const void*) {
+                        return sizeof(O);
+                    };
+                }
+                this->add_object_cache(
+                    this->tablename<O>(),
+                    std::make_unique<object_cache>(options,
+                                                   std::move(size),
+                                                   primaryKeyColumnsCount == 1 && integerPrimaryKey));
+            }
+
+            template<class O>
+            void disable_object_cache() {
+                this->assert_mapped_type<O>();
+                this->objectCaches.erase(this->tablename<O>());
+            }
+
+            template<class O>
+            void clear_object_cache() {
+                this->assert_mapped_type<O>();
+                this->storage_base::clear_object_cache(this->tablename<O>());
+            }
+
+            /**
+             *  @return Counters of the object cache of `O`, all zero if it isn't enabled.
+             */
+            template<class O>
+            object_cache_stats get_object_cache_stats() const {
+                this->assert_mapped_type<O>();
+                auto it = this->objectCaches.find(this->tablename<O>());
+                return it != this->objectCaches.end() ? it->second->stats() : object_cache_stats{};
+            }
+
             /**
              * Get table's name stored in storage's schema info. This function does not call
              * any SQLite queries
@@ -23132,6 +28629,49 @@ namespace sqlite_orm {
                 return internal::find_column_name(this->db_objects, memberPointer);
             }
 
+            /**
+             *  Opens the BLOB of a column in the row with the given rowid for incremental I/O,
+             *  such that large values are read and written in parts instead of as a whole `std::vector<char>`.
+             *  Writes invalidate cached objects and results of the table like the other write functions.
+             *
+             *  @example
+             *  ```c++
+             *  storage.allocate_blob(&Artifact::data, id, fileSize);
+             *  auto blob = storage.open_blob(&Artifact::data, id, true);
+             *  blob.write_from(file);
+             *  ```
+             *  @throws std::system_error if the row doesn't exist or its value isn't a BLOB or text.
+             */
+            template<class F, class O>
+            blob_handle open_blob(F O::* memberPointer, int64 rowid, bool writable = false) {
+                const std::string* columnName = this->find_column_name(memberPointer);
+                if (!columnName) {
+                    throw std::system_error{orm_error_code::column_not_found};
+                }
+                const std::string& tableName = this->tablename<O>();
+                return {this->get_connection(),
+                        tableName,
+                        *columnName,
+                        rowid,
+                        writable,
+                        [this, &tableName](sqlite3_int64 rowid) {
+                            this->on_row_changed(tableName.c_str(), rowid);
+                        },
+                        [this] {
+                            this->after_write();
+                        }};
+            }
+
+            /**
+             *  Sets the BLOB of a column in the row with the given rowid to `size` zero bytes
+             *  using the `zeroblob()` function, such that it can be written in parts by a handle of `open_blob()`.
+             */
+            template<class F, class O>
+            void allocate_blob(F O::* memberPointer, int64 rowid, size_t size) {
+                this->update_all(sqlite_orm::set(sqlite_orm::c(memberPointer) = sqlite_orm::zeroblob(int64(size))),
+                                 sqlite_orm::where(sqlite_orm::is_equal(sqlite_orm::rowid<O>(), rowid)));
+            }
+
           protected:
             template<class M>
             sync_schema_result schema_status(const virtual_table_t<M>&, sqlite3*, bool, bool*) {
@@ -23265,35 +28805,189 @@ namespace sqlite_orm {
                 return res;
             }
 
-            template<class Table, satisfies<is_table, Table> = true>
-            sync_schema_result sync_table(const Table& table, sqlite3* db, bool preserve);
+            template<class Table, satisfies<is_table, Table> = true>
+            sync_schema_result sync_table(const Table& table, sqlite3* db, bool preserve);
+
+            template<class C>
+            void add_column(sqlite3* db, const std::string& tableName, const C& column) const {
+                using context_t = serializer_context<db_objects_type>;
+
+                context_t context{this->db_objects};
+                std::stringstream ss;
+                ss << "ALTER TABLE " << streaming_identifier(tableName) << " ADD COLUMN " << serialize(column, context)
+                   << std::flush;
+                perform_void_exec(db, ss.str());
+            }
+
+            template<class ColResult, class S>
+            auto execute_select(const S& statement) {
+                sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+
+                iterate_ast(statement.expression, conditional_binder{stmt});
+
+                return this->extract_rows<ColResult>(stmt);
+            }
+
+            template<class ColResult>
+            auto extract_rows(sqlite3_stmt* stmt) {
+                using R = decltype(make_row_extractor<ColResult>(this->db_objects).extract(nullptr, 0));
+                std::vector<R> res;
+                perform_steps(
+                    stmt,
+                    [rowExtractor = make_row_extractor<ColResult>(this->db_objects), &res](sqlite3_stmt* stmt) {
+                        res.push_back(rowExtractor.extract(stmt, 0));
+                    });
+                res.shrink_to_fit();
+                return res;
+            }
+
+            template<class... Rs>
+            std::tuple<std::vector<Rs>...> extract_columns(sqlite3_stmt* stmt,
+                                                           polyfill::type_identity<std::tuple<Rs...>>) {
+                static_assert(polyfill::conjunction<polyfill::negation<polyfill::disjunction<
+                                  polyfill::is_specialization_of<Rs, std::tuple>,
+                                  polyfill::is_specialization_of<Rs, structure>,
+                                  is_table_reference<Rs>>>...>::value,
+                              "get_columns() only supports columns of single values");
+                std::tuple<std::vector<Rs>...> res;
+                perform_steps(stmt, [&res](sqlite3_stmt* stmt) {
+                    extract_column_values(res, stmt, std::index_sequence_for<Rs...>{});
+                });
+                return res;
+            }
+
+#ifdef SQLITE_ORM_FOLD_EXPRESSIONS_SUPPORTED
+            template<class Tpl, size_t... Idx>
+            static void extract_column_values(Tpl& columnValues, sqlite3_stmt* stmt, std::index_sequence<Idx...>) {
+                (std::get<Idx>(columnValues)
+                     .push_back(row_value_extractor<typename std::tuple_element_t<Idx, Tpl>::value_type>().extract(
+                         stmt,
+                         int(Idx))),
+                 ...);
+            }
+#else
+            template<class Tpl, size_t... Idx>
+            static void extract_column_values(Tpl& columnValues, sqlite3_stmt* stmt, std::index_sequence<Idx...>) {
+                using Sink = int[sizeof...(Idx)];
+                (void)Sink{
+                    (std::get<Idx>(columnValues)
+                         .push_back(row_value_extractor<typename std::tuple_element_t<Idx, Tpl>::value_type>().extract(
+                             stmt,
+                             int(Idx))),
+                     0)...};
+            }
+#endif
+
+            /**
+             *  Binds the fields of the objects written by a replace or replace range statement.
+             *  @return Index of the next parameter.
+             */
+            template<class E,
+                     std::enable_if_t<polyfill::disjunction<is_replace<E>, is_replace_range<E>>::value, bool> = true>
+            int bind_written_values(sqlite3_stmt* stmt, const E& expression) {
+                using object_type = expression_object_type_t<E>;
+
+                field_value_binder bindValue{stmt};
+                auto processObject = [&table = this->get_table<object_type>(), &bindValue](auto& object) {
+                    table.template for_each_column_excluding<is_generated_always>(
+                        call_as_template_base<column_field>([&bindValue, &object](auto& column) {
+                            bindValue(polyfill::invoke(column.member_pointer, object));
+                        }));
+                };
+
+                static_if<is_replace_range<E>::value>(
+                    [&processObject](auto& expr) {
+#if __cpp_lib_ranges >= 201911L
+                        std::ranges::for_each(expr.range.first,
+                                              expr.range.second,
+                                              std::ref(processObject),
+                                              std::ref(expr.transformer));
+#else
+                        auto& transformer = expr.transformer;
+                        std::for_each(expr.range.first,
+                                      expr.range.second,
+                                      [&processObject, &transformer](auto& item) {
+                                          const object_type& object = polyfill::invoke(transformer, item);
+                                          processObject(object);
+                                      });
+#endif
+                    },
+                    [&processObject](auto& expr) {
+                        const object_type& o = get_object(expr);
+                        processObject(o);
+                    })(expression);
+
+                return bindValue.index;
+            }
+
+            /**
+             *  Binds the fields of the objects written by an insert or insert range statement.
+             *  @return Index of the next parameter.
+             */
+            template<class E,
+                     std::enable_if_t<polyfill::disjunction<is_insert<E>, is_insert_range<E>>::value, bool> = true>
+            int bind_written_values(sqlite3_stmt* stmt, const E& expression) {
+                using object_type = expression_object_type_t<E>;
 
-            template<class C>
-            void add_column(sqlite3* db, const std::string& tableName, const C& column) const {
-                using context_t = serializer_context<db_objects_type>;
+                field_value_binder bindValue{stmt};
+                auto processObject = [&table = this->get_table<object_type>(), &bindValue](auto& object) {
+                    using is_without_rowid = typename std::remove_reference_t<decltype(table)>::is_without_rowid;
+                    table.template for_each_column_excluding<
+                        mpl::conjunction<mpl::not_<mpl::always<is_without_rowid>>,
+                                         mpl::disjunction_fn<is_primary_key, is_generated_always>>>(
+                        call_as_template_base<column_field>([&table, &bindValue, &object](auto& column) {
+                            if (!exists_in_composite_primary_key(table, column)) {
+                                bindValue(polyfill::invoke(column.member_pointer, object));
+                            }
+                        }));
+                };
 
-                context_t context{this->db_objects};
-                std::stringstream ss;
-                ss << "ALTER TABLE " << streaming_identifier(tableName) << " ADD COLUMN " << serialize(column, context)
-                   << std::flush;
-                perform_void_exec(db, ss.str());
+                static_if<is_insert_range<E>::value>(
+                    [&processObject](auto& expr) {
+#if __cpp_lib_ranges >= 201911L
+                        std::ranges::for_each(expr.range.first,
+                                              expr.range.second,
+                                              std::ref(processObject),
+                                              std::ref(expr.transformer));
+#else
+                        auto& transformer = expr.transformer;
+                        std::for_each(expr.range.first,
+                                      expr.range.second,
+                                      [&processObject, &transformer](auto& item) {
+                                          const object_type& object = polyfill::invoke(transformer, item);
+                                          processObject(object);
+                                      });
+#endif
+                    },
+                    [&processObject](auto& expr) {
+                        const object_type& o = get_object(expr);
+                        processObject(o);
+                    })(expression);
+
+                return bindValue.index;
             }
 
-            template<class ColResult, class S>
-            auto execute_select(const S& statement) {
-                sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+            template<class E,
+                     std::enable_if_t<polyfill::disjunction<is_insert_raw<E>, is_replace_raw<E>>::value, bool> = true>
+            int bind_written_values(sqlite3_stmt* stmt, const E& expression) {
+                conditional_binder bindNode{stmt};
+                iterate_ast(expression, bindNode);
+                return bindNode.index;
+            }
 
-                iterate_ast(statement.expression, conditional_binder{stmt});
+            template<class S, class... Wargs>
+            int bind_written_values(sqlite3_stmt* stmt, const update_all_t<S, Wargs...>& expression) {
+                conditional_binder bindNode{stmt};
+                iterate_ast(expression.set, bindNode);
+                iterate_ast(expression.conditions, bindNode);
+                return bindNode.index;
+            }
 
-                using R = decltype(make_row_extractor<ColResult>(this->db_objects).extract(nullptr, 0));
-                std::vector<R> res;
-                perform_steps(
-                    stmt,
-                    [rowExtractor = make_row_extractor<ColResult>(this->db_objects), &res](sqlite3_stmt* stmt) {
-                        res.push_back(rowExtractor.extract(stmt, 0));
-                    });
-                res.shrink_to_fit();
-                return res;
+            template<class T, class... Args>
+            int bind_written_values(sqlite3_stmt* stmt, const remove_all_t<T, Args...>& expression) {
+                conditional_binder bindNode{stmt};
+                iterate_ast(expression.conditions, bindNode);
+                return bindNode.index;
             }
 
             template<class E>
@@ -23317,10 +29011,200 @@ namespace sqlite_orm {
 
                 auto con = this->get_connection();
                 std::string sql = serialize(statement, context);
+                this->check_query_plan(con.get(), sql);
                 sqlite3_stmt* stmt = prepare_stmt(con.get(), std::move(sql));
                 return prepared_statement_t<S>{std::forward<S>(statement), stmt, con};
             }
 
+            /**
+             *  Like `prepare_impl()`, but reuses an idle statement from the statement cache if there is one
+             *  for the same connection, expression type and SQL,
+             *  and gives the statement back to the cache afterwards instead of finalizing it.
+             */
+            template<typename S>
+            cached_prepared_statement_t<S> prepare_cached_impl(S statement) {
+                const auto& exprDBOs = db_objects_for_expression(this->db_objects, statement);
+                using context_t = serializer_context<polyfill::remove_cvref_t<decltype(exprDBOs)>>;
+                context_t context{exprDBOs};
+                context.skip_table_name = false;
+                context.replace_bindable_with_question = true;
+
+                auto con = is_read_only_expression<S>::value ? this->get_reader_connection() : this->get_connection();
+                statement_cache::key_type key{con.get(), &expression_type_tag<S>::id, serialize(statement, context)};
+                sqlite3_stmt* stmt = this->statementCache.take(key);
+                if (!stmt) {
+                    this->check_query_plan(con.get(), key.sql);
+                    stmt = prepare_stmt(con.get(), key.sql);
+                }
+                return {prepared_statement_t<S>{std::move(statement), stmt, con}, this->statementCache, std::move(key)};
+            }
+
+            template<class T, class... Args>
+            cached_prepared_statement_t<select_t<T, Args...>> prepare_cached(select_t<T, Args...> statement) {
+                statement.highest_level = true;
+                return this->prepare_cached_impl(std::move(statement));
+            }
+
+            template<class S>
+            cached_prepared_statement_t<S> prepare_cached(S statement) {
+                return this->prepare_cached_impl(std::move(statement));
+            }
+
+            /**
+             *  Collects the name and the `CREATE INDEX` statement of an index of the table mapped to O.
+             */
+            template<class O, class... Els>
+            void collect_index_of(const index_t<O, Els...>& index,
+                                  std::vector<std::pair<std::string, std::string>>& indexes) const {
+                using context_t = serializer_context<db_objects_type>;
+                context_t context{this->db_objects};
+                indexes.emplace_back(index.name, serialize(index, context));
+            }
+
+            template<class O, class E>
+            void collect_index_of(const E&, std::vector<std::pair<std::string, std::string>>&) const {}
+
+            template<class O, class R>
+            size_t bulk_write_with_indexes(const R& range, const bulk_load_options& options) {
+                std::vector<std::pair<std::string, std::string>> indexes;
+                if (options.drop_indexes) {
+                    iterate_tuple(this->db_objects, [this, &indexes](auto& dbObject) {
+                        this->collect_index_of<O>(dbObject, indexes);
+                    });
+                    for (auto& index: indexes) {
+                        //  an index of the storage's schema may not have been created yet
+                        this->drop_index_internal(index.first, true);
+                    }
+                }
+                const size_t rows = this->bulk_write<O>(std::begin(range), std::end(range), options);
+                auto con = this->get_connection();
+                for (auto& index: indexes) {
+                    perform_void_exec(con.get(), index.second);
+                }
+                return rows;
+            }
+
+            template<class O, class It>
+            size_t bulk_write(It from, It to, const bulk_load_options& options) {
+                const size_t count = std::distance(from, to);
+                if (!options.keep_primary_keys) {
+                    this->insert_range<O>(std::move(from), std::move(to));
+                    return count;
+                }
+                if (!options.sort_by_primary_key) {
+                    this->replace_range<O>(std::move(from), std::move(to));
+                    return count;
+                }
+
+                std::vector<std::reference_wrapper<const O>> objects(from, to);
+                auto& table = this->get_table<O>();
+                std::stable_sort(objects.begin(), objects.end(), [&table](const O& lhs, const O& rhs) {
+                    int res = 0;
+                    table.for_each_primary_key_column([&table, &lhs, &rhs, &res](auto& memberPointer) {
+                        if (res != 0) {
+                            return;
+                        }
+                        auto compare = [&res](const auto& lhsValue, const auto& rhsValue) {
+                            res = lhsValue < rhsValue ? -1 : (rhsValue < lhsValue ? 1 : 0);
+                        };
+                        using member_type = std::decay_t<decltype(memberPointer)>;
+                        static_if<is_setter<member_type>::value>(
+                            [&table, &lhs, &rhs, &compare](auto& setter) {
+                                auto lhsValue = table.object_field_value(lhs, setter);
+                                auto rhsValue = table.object_field_value(rhs, setter);
+                                //  null if no column is mapped with the setter
+                                if (lhsValue && rhsValue) {
+                                    compare(*lhsValue, *rhsValue);
+                                }
+                            },
+                            [&table, &lhs, &rhs, &compare](auto& memberPointer) {
+                                compare(table.object_field_value(lhs, memberPointer),
+                                        table.object_field_value(rhs, memberPointer));
+                            })(memberPointer);
+                    });
+                    return res < 0;
+                });
+                this->replace_range<O>(objects.begin(),
+                                       objects.end(),
+                                       [](const std::reference_wrapper<const O>& object) -> const O& {
+                                           return object.get();
+                                       });
+                return count;
+            }
+
+            /**
+             *  Number of values bound per object by an `insert_range` statement.
+             */
+            template<class O>
+            size_t count_of_insertable_columns() const {
+                auto& table = this->get_table<O>();
+                using is_without_rowid = typename std::remove_reference_t<decltype(table)>::is_without_rowid;
+                size_t res = 0;
+                table.template for_each_column_excluding<
+                    mpl::conjunction<mpl::not_<mpl::always<is_without_rowid>>,
+                                     mpl::disjunction_fn<is_primary_key, is_generated_always>>>(
+                    [&table, &res](auto& column) {
+                        if (!exists_in_composite_primary_key(table, column)) {
+                            ++res;
+                        }
+                    });
+                return res;
+            }
+
+            /**
+             *  Executes an `insert_range` or `replace_range` expression in chunks of as many objects as fit
+             *  into `SQLITE_LIMIT_VARIABLE_NUMBER`, such that ranges of any size can be written
+             *  and the SQL of a chunk is the same for every chunk.
+             *  The statement for full chunks is prepared once and rebound for every chunk,
+             *  the remainder is written by a single tail statement.
+             *  Multiple chunks are written in a transaction unless a transaction is already in progress.
+             *
+             *  @param columnsCount Number of values bound per object.
+             */
+            template<class E>
+            void execute_range_in_chunks(E expression, size_t columnsCount) {
+                auto con = this->get_connection();
+                const size_t objectsCount = std::distance(expression.range.first, expression.range.second);
+                size_t chunkSize = objectsCount;
+                //  a range of objects without any column to bind can't be split (`DEFAULT VALUES`)
+                if (columnsCount) {
+                    const int maxVariables = sqlite3_limit(con.get(), SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+                    chunkSize = std::max<size_t>(size_t(maxVariables) / columnsCount, 1);
+                }
+                if (objectsCount <= chunkSize) {
+                    auto statement = this->prepare(std::move(expression));
+                    this->execute(statement);
+                    return;
+                }
+
+                auto executeChunks = [this, &expression, objectsCount, chunkSize] {
+                    const auto last = expression.range.second;
+                    auto first = expression.range.first;
+                    expression.range.second = std::next(first, chunkSize);
+                    auto statement = this->prepare_cached(expression);
+                    size_t remaining = objectsCount;
+                    for (; remaining >= chunkSize; remaining -= chunkSize) {
+                        statement.expression.range.first = first;
+                        statement.expression.range.second = first = std::next(first, chunkSize);
+                        this->execute(statement);
+                    }
+                    if (remaining) {
+                        expression.range.first = first;
+                        expression.range.second = last;
+                        auto tailStatement = this->prepare(std::move(expression));
+                        this->execute(tailStatement);
+                    }
+                };
+                if (sqlite3_get_autocommit(con.get())) {
+                    this->transaction([&executeChunks] {
+                        executeChunks();
+                        return true;
+                    });
+                } else {
+                    executeChunks();
+                }
+            }
+
           public:
             /**
              *  This is a cute function used to replace migration up/down functionality.
@@ -23351,6 +29235,7 @@ namespace sqlite_orm {
              */
             std::map<std::string, sync_schema_result> sync_schema(bool preserve = false) {
                 auto con = this->get_connection();
+                this->clear_statement_caches_for_schema_change();
                 std::map<std::string, sync_schema_result> result;
                 iterate_tuple<true>(this->db_objects, [this, db = con.get(), preserve, &result](auto& schemaObject) {
                     sync_schema_result status = this->sync_table(schemaObject, db, preserve);
@@ -23444,6 +29329,29 @@ namespace sqlite_orm {
                 return this->prepare_impl(std::move(statement));
             }
 
+#ifdef SQLITE_ENABLE_JSON1
+            template<class T, class Id>
+            prepared_statement_t<get_many_t<T, Id>> prepare(get_many_t<T, Id> statement) {
+                return this->prepare_impl(std::move(statement));
+            }
+#endif  //  SQLITE_ENABLE_JSON1
+
+#if SQLITE_VERSION_NUMBER >= 3035000
+            template<class S, class T>
+            prepared_statement_t<returning_t<S, T>> prepare(returning_t<S, T> statement) {
+                static_assert(polyfill::disjunction<is_insert<S>,
+                                                    is_insert_range<S>,
+                                                    is_insert_raw<S>,
+                                                    is_replace<S>,
+                                                    is_replace_range<S>,
+                                                    is_replace_raw<S>,
+                                                    is_update_all<S>,
+                                                    is_remove_all<S>>::value,
+                              "RETURNING is only supported for insert, replace, update_all and remove_all statements");
+                return this->prepare_impl(std::move(statement));
+            }
+#endif
+
 #ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
             template<class T, class... Ids>
             prepared_statement_t<get_optional_t<T, Ids...>> prepare(get_optional_t<T, Ids...> statement) {
@@ -23507,7 +29415,8 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<replace_raw_t<Args...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_write_step(stmt);
+                this->after_write();
             }
 
 #if (SQLITE_VERSION_NUMBER >= 3008003) && defined(SQLITE_ORM_WITH_CTE)
@@ -23520,7 +29429,8 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<with_t<E, CTEs...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_write_step(stmt);
+                this->after_write();
             }
 #endif
 
@@ -23528,7 +29438,8 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<insert_raw_t<Args...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_write_step(stmt);
+                this->after_write();
             }
 
             template<class T, class... Cols>
@@ -23542,93 +29453,30 @@ namespace sqlite_orm {
                     [&table = this->get_table<object_type>(), &object = statement.expression.obj](auto& memberPointer) {
                         return table.object_field_value(object, memberPointer);
                     });
-                perform_step(stmt);
+                this->perform_write_step(stmt);
+                this->after_write(this->tablename<object_type>());
                 return sqlite3_last_insert_rowid(sqlite3_db_handle(stmt));
             }
 
             template<class T,
                      std::enable_if_t<polyfill::disjunction<is_replace<T>, is_replace_range<T>>::value, bool> = true>
             void execute(const prepared_statement_t<T>& statement) {
-                using object_type = statement_object_type_t<decltype(statement)>;
-
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
-
-                auto processObject = [&table = this->get_table<object_type>(),
-                                      bindValue = field_value_binder{stmt}](auto& object) mutable {
-                    table.template for_each_column_excluding<is_generated_always>(
-                        call_as_template_base<column_field>([&bindValue, &object](auto& column) {
-                            bindValue(polyfill::invoke(column.member_pointer, object));
-                        }));
-                };
-
-                static_if<is_replace_range<T>::value>(
-                    [&processObject](auto& expression) {
-#if __cpp_lib_ranges >= 201911L
-                        std::ranges::for_each(expression.range.first,
-                                              expression.range.second,
-                                              std::ref(processObject),
-                                              std::ref(expression.transformer));
-#else
-                        auto& transformer = expression.transformer;
-                        std::for_each(expression.range.first,
-                                      expression.range.second,
-                                      [&processObject, &transformer](auto& item) {
-                                          const object_type& object = polyfill::invoke(transformer, item);
-                                          processObject(object);
-                                      });
-#endif
-                    },
-                    [&processObject](auto& expression) {
-                        const object_type& o = get_object(expression);
-                        processObject(o);
-                    })(statement.expression);
-
-                perform_step(stmt);
+                this->bind_written_values(stmt, statement.expression);
+                this->perform_write_step(stmt);
+                using object_type = statement_object_type_t<decltype(statement)>;
+                this->invalidate_replaced_objects(statement.expression);
+                this->after_write(this->tablename<object_type>());
             }
 
             template<class T,
                      std::enable_if_t<polyfill::disjunction<is_insert<T>, is_insert_range<T>>::value, bool> = true>
             int64 execute(const prepared_statement_t<T>& statement) {
-                using object_type = statement_object_type_t<decltype(statement)>;
-
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
-
-                auto processObject = [&table = this->get_table<object_type>(),
-                                      bindValue = field_value_binder{stmt}](auto& object) mutable {
-                    using is_without_rowid = typename std::remove_reference_t<decltype(table)>::is_without_rowid;
-                    table.template for_each_column_excluding<
-                        mpl::conjunction<mpl::not_<mpl::always<is_without_rowid>>,
-                                         mpl::disjunction_fn<is_primary_key, is_generated_always>>>(
-                        call_as_template_base<column_field>([&table, &bindValue, &object](auto& column) {
-                            if (!exists_in_composite_primary_key(table, column)) {
-                                bindValue(polyfill::invoke(column.member_pointer, object));
-                            }
-                        }));
-                };
-
-                static_if<is_insert_range<T>::value>(
-                    [&processObject](auto& expression) {
-#if __cpp_lib_ranges >= 201911L
-                        std::ranges::for_each(expression.range.first,
-                                              expression.range.second,
-                                              std::ref(processObject),
-                                              std::ref(expression.transformer));
-#else
-                        auto& transformer = expression.transformer;
-                        std::for_each(expression.range.first,
-                                      expression.range.second,
-                                      [&processObject, &transformer](auto& item) {
-                                          const object_type& object = polyfill::invoke(transformer, item);
-                                          processObject(object);
-                                      });
-#endif
-                    },
-                    [&processObject](auto& expression) {
-                        const object_type& o = get_object(expression);
-                        processObject(o);
-                    })(statement.expression);
-
-                perform_step(stmt);
+                this->bind_written_values(stmt, statement.expression);
+                this->perform_write_step(stmt);
+                using object_type = statement_object_type_t<decltype(statement)>;
+                this->after_write(this->tablename<object_type>());
                 return sqlite3_last_insert_rowid(sqlite3_db_handle(stmt));
             }
 
@@ -23636,7 +29484,9 @@ namespace sqlite_orm {
             void execute(const prepared_statement_t<remove_t<T, Ids...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
                 iterate_ast(statement.expression.ids, conditional_binder{stmt});
-                perform_step(stmt);
+                this->perform_write_step(stmt);
+                this->invalidate_cached_object_by_id<T>(statement.expression.ids);
+                this->after_write(this->tablename<T>());
             }
 
             template<class T>
@@ -23659,7 +29509,38 @@ namespace sqlite_orm {
                         bindValue(polyfill::invoke(column.member_pointer, object));
                     }
                 });
-                perform_step(stmt);
+                this->perform_write_step(stmt);
+                this->invalidate_cached_object(object);
+                this->after_write(this->tablename<object_type>());
+            }
+
+            template<class T>
+            void execute(const prepared_statement_t<update_columns_t<T>>& statement) {
+                using object_type = statement_object_type_t<decltype(statement)>;
+
+                sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+                auto& table = this->get_table<object_type>();
+
+                field_value_binder bindValue{stmt};
+                auto& object = get_object(statement.expression);
+                table.for_each_column([&table,
+                                       &bindValue,
+                                       &object,
+                                       &columnsMask = statement.expression.columnsMask,
+                                       index = size_t(0)](auto& column) mutable {
+                    if (columnsMask.at(index++) && !column.template is<is_primary_key>() &&
+                        !column.template is<is_generated_always>() && !exists_in_composite_primary_key(table, column)) {
+                        bindValue(polyfill::invoke(column.member_pointer, object));
+                    }
+                });
+                table.for_each_column([&table, &bindValue, &object](auto& column) {
+                    if (column.template is<is_primary_key>() || exists_in_composite_primary_key(table, column)) {
+                        bindValue(polyfill::invoke(column.member_pointer, object));
+                    }
+                });
+                this->perform_write_step(stmt);
+                this->invalidate_cached_object(object);
+                this->after_write(this->tablename<object_type>());
             }
 
             template<class T, class... Ids>
@@ -23677,6 +29558,30 @@ namespace sqlite_orm {
                 return res;
             }
 
+#ifdef SQLITE_ENABLE_JSON1
+            template<class T, class Id>
+            std::vector<std::unique_ptr<T>> execute(const prepared_statement_t<get_many_t<T, Id>>& statement) {
+                sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+
+                auto& ids = statement.expression.ids;
+                const std::string json = serialize_json_array(ids);
+                if (SQLITE_OK != statement_binder<std::string>().bind(stmt, 1, json)) {
+                    throw_translated_sqlite_error(stmt);
+                }
+
+                std::vector<std::unique_ptr<T>> res(ids.size());
+                perform_steps(stmt, [&table = this->get_table<T>(), &res](sqlite3_stmt* stmt) {
+                    //  the position of the id follows the table's columns
+                    const int position = sqlite3_column_int(stmt, sqlite3_column_count(stmt) - 1);
+                    auto object = std::make_unique<T>();
+                    object_from_column_builder<T> builder{*object, stmt};
+                    table.for_each_column(builder);
+                    res[position] = std::move(object);
+                });
+                return res;
+            }
+#endif  //  SQLITE_ENABLE_JSON1
+
 #ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
             template<class T, class... Ids>
             std::optional<T> execute(const prepared_statement_t<get_optional_t<T, Ids...>>& statement) {
@@ -23732,18 +29637,49 @@ namespace sqlite_orm {
             template<class T, class... Args>
             void execute(const prepared_statement_t<remove_all_t<T, Args...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
-                iterate_ast(statement.expression.conditions, conditional_binder{stmt});
-                perform_step(stmt);
+                this->bind_written_values(stmt, statement.expression);
+                this->perform_write_step(stmt);
+                this->invalidate_object_caches(this->tablename<T>());
+                this->after_write(this->tablename<T>());
             }
 
             template<class S, class... Wargs>
             void execute(const prepared_statement_t<update_all_t<S, Wargs...>>& statement) {
                 sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+                this->bind_written_values(stmt, statement.expression);
+                this->perform_write_step(stmt);
+                if (!this->objectCaches.empty() || this->resultCache) {
+                    using context_t = serializer_context<db_objects_type>;
+                    context_t context{this->db_objects};
+                    for (auto& tableName: collect_table_names(statement.expression.set, context)) {
+                        this->invalidate_object_caches(tableName.first);
+                        this->invalidate_results(tableName.first);
+                    }
+                }
+                this->after_write();
+            }
+
+#if SQLITE_VERSION_NUMBER >= 3035000
+            /**
+             *  Executes the modifying statement and returns the rows of its RETURNING clause,
+             *  like `select` with the same columns.
+             */
+            template<class S, class T>
+            auto execute(const prepared_statement_t<returning_t<S, T>>& statement) {
+                using ColResult = column_result_of_t<db_objects_type, T>;
+                sqlite3_stmt* stmt = reset_stmt(statement.stmt);
+
                 conditional_binder bindNode{stmt};
-                iterate_ast(statement.expression.set, bindNode);
-                iterate_ast(statement.expression.conditions, bindNode);
-                perform_step(stmt);
+                bindNode.index = this->bind_written_values(stmt, statement.expression.statement);
+                iterate_ast(statement.expression.columns, bindNode);
+
+                auto rows = this->run_write_statement(sqlite3_db_handle(stmt), [this, stmt] {
+                    return this->extract_rows<ColResult>(stmt);
+                });
+                this->after_write();
+                return rows;
             }
+#endif
 
 #if (SQLITE_VERSION_NUMBER >= 3008003) && defined(SQLITE_ORM_WITH_CTE)
             template<class... CTEs, class T, class... Args>
@@ -23837,6 +29773,17 @@ namespace sqlite_orm {
         return {std::move(filename), internal::db_objects_tuple<DBO...>{std::forward<DBO>(dbObjects)...}};
     }
 
+    /**
+     *  Factory function for a storage whose database connections are opened with the given options,
+     *  e.g. read-only, with URI parameters or a particular VFS.
+     */
+    template<class... DBO>
+    internal::storage_t<DBO...> make_storage(std::string filename, open_options options, DBO... dbObjects) {
+        return {std::move(filename),
+                std::move(options),
+                internal::db_objects_tuple<DBO...>{std::forward<DBO>(dbObjects)...}};
+    }
+
     /**
      *  sqlite3_threadsafe() interface.
      */
@@ -24706,6 +30653,10 @@ namespace sqlite_orm {
 
 // #include "pointer_value.h"
 
+// #include "array_values.h"
+
+// #include "statement_binder.h"
+
 #if SQLITE_VERSION_NUMBER >= 3020000
 #ifdef SQLITE_ORM_INLINE_VARIABLES_SUPPORTED
 namespace sqlite_orm {
@@ -24830,6 +30781,33 @@ namespace sqlite_orm {
             return "remember";
         }
     };
+
+#ifdef SQLITE_ORM_CARRAY_IN_SUPPORTED
+    /**
+     *  Specialization for the values of an IN list bound as one array (`as_array()`),
+     *  bound as a C array and its length for `carray(?, ?, '<type>')`.
+     */
+    template<class E>
+    struct statement_binder<internal::array_values_t<E>, void> {
+        using pointer_binding_type = static_carray_pointer_binding<typename internal::carray_element<E>::type>;
+
+        int bind(sqlite3_stmt* stmt, int index, const internal::array_values_t<E>& value) const {
+            auto& carray = value.carray_values();
+            int rc = statement_binder<pointer_binding_type>{}.bind(stmt,
+                                                                   index,
+                                                                   bind_carray_pointer_statically(carray.data()));
+            if (SQLITE_OK != rc) {
+                return rc;
+            }
+            return sqlite3_bind_int(stmt, index + 1, int(carray.size()));
+        }
+    };
+
+    namespace internal {
+        template<class E>
+        SQLITE_ORM_INLINE_VAR constexpr int bound_parameters_count_v<array_values_t<E>> = 2;
+    }
+#endif
 }
 #endif
 #endif
@@ -1,6 +1,9 @@
 #include <sqlite_orm/sqlite_orm.h>
 #include <catch2/catch_all.hpp>
 #include <cstdio>  //  remove
+#include <chrono>  //  std::chrono::milliseconds, std::chrono::hours
+#include <stdexcept>  //  std::runtime_error
+#include <memory>  //  std::make_unique
 
 using namespace sqlite_orm;
 
@@ -157,3 +160,92 @@ TEST_CASE("Backup crash") {
     auto backup = storage.make_backup_to(backupFilename);
     backup.step(-1);
 }
+
+TEST_CASE("background backup") {
+    auto makeStorage = [](const std::string& filename) {
+        return make_storage(
+            filename,
+            make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)));
+    };
+    const std::string sourceFilename = "background_backup_source.sqlite";
+    const std::string backupFilename = "background_backup.sqlite";
+    ::remove(sourceFilename.c_str());
+    ::remove(backupFilename.c_str());
+    auto storage = makeStorage(sourceFilename);
+    storage.sync_schema();
+    storage.transaction([&storage] {
+        for (int i = 1; i <= 500; ++i) {
+            storage.replace(User{i, std::string(200, char('a' + i % 26))});
+        }
+        return true;
+    });
+
+    backup_options options;
+    options.pages_per_step = 4;
+    options.pause = std::chrono::milliseconds{0};
+    std::vector<backup_progress> reports;
+
+    SECTION("completes") {
+        options.on_progress = [&reports](const backup_progress& progress) {
+            reports.push_back(progress);
+        };
+        auto runner = storage.start_backup_to(backupFilename, options);
+        REQUIRE(runner.wait());
+        REQUIRE(runner.get_status() == internal::backup_runner::status::done);
+        REQUIRE(reports.size() > 1);
+        REQUIRE(reports.front().remaining > 0);
+        REQUIRE(reports.back().remaining == 0);
+        REQUIRE(reports.back().fraction() == 1);
+        REQUIRE(runner.progress().pagecount == reports.back().pagecount);
+        REQUIRE(makeStorage(backupFilename).count<User>() == 500);
+    }
+    SECTION("to storage") {
+        auto storage2 = makeStorage(backupFilename);
+        auto runner = storage.start_backup_to(storage2, options);
+        REQUIRE(runner.wait());
+        REQUIRE(storage2.count<User>() == 500);
+    }
+    SECTION("in-memory databases can't be backed up in the background") {
+        auto inMemory = makeStorage("");
+        REQUIRE_THROWS_AS(inMemory.start_backup_to(backupFilename, options), std::system_error);
+        REQUIRE_THROWS_AS(storage.start_backup_to(inMemory, options), std::system_error);
+    }
+    SECTION("outlives the storage") {
+        options.pages_per_step = 1;
+        auto source = std::make_unique<decltype(storage)>(makeStorage(sourceFilename));
+        auto runner = source->start_backup_to(backupFilename, options);
+        source.reset();
+        REQUIRE(runner.wait());
+        REQUIRE(makeStorage(backupFilename).count<User>() == 500);
+    }
+    SECTION("restarts when the source changes") {
+        auto writer = makeStorage(sourceFilename);
+        options.on_progress = [&writer, &reports](const backup_progress& progress) {
+            if (reports.empty()) {
+                writer.replace(User{501, "Written meanwhile"});
+            }
+            reports.push_back(progress);
+        };
+        auto runner = storage.start_backup_to(backupFilename, options);
+        REQUIRE(runner.wait());
+        REQUIRE(runner.progress().restarts >= 1);
+        REQUIRE(makeStorage(backupFilename).count<User>() == 501);
+    }
+    SECTION("cancel") {
+        options.pages_per_step = 1;
+        options.pause = std::chrono::hours{1};
+        auto runner = storage.start_backup_to(backupFilename, options);
+        runner.cancel();
+        REQUIRE_FALSE(runner.wait());
+        REQUIRE(runner.get_status() == internal::backup_runner::status::cancelled);
+        REQUIRE(runner.progress().remaining > 0);
+    }
+    SECTION("failing callback") {
+        options.on_progress = [](const backup_progress&) {
+            throw std::runtime_error("stop");
+        };
+        auto runner = storage.start_backup_to(backupFilename, options);
+        REQUIRE_THROWS_AS(runner.wait(), std::runtime_error);
+        REQUIRE(runner.get_status() == internal::backup_runner::status::failed);
+    }
+}
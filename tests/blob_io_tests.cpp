@@ -0,0 +1,117 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <sstream>  //  std::istringstream, std::ostringstream
+#include <system_error>  //  std::system_error
+
+using namespace sqlite_orm;
+
+namespace {
+    struct Artifact {
+        int id = 0;
+        std::string name;
+        std::vector<char> data;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Artifact() = default;
+        Artifact(int id, std::string name, std::vector<char> data) :
+            id{id}, name{std::move(name)}, data{std::move(data)} {}
+#endif
+    };
+
+    auto makeStorage(const std::string& filename) {
+        return make_storage(filename,
+                            make_table("artifacts",
+                                       make_column("id", &Artifact::id, primary_key()),
+                                       make_column("name", &Artifact::name),
+                                       make_column("data", &Artifact::data)));
+    }
+}
+
+TEST_CASE("blob incremental I/O") {
+    auto storage = makeStorage("");
+    storage.sync_schema();
+    storage.replace(Artifact{1, "a", {'a', 'b', 'c', 'd'}});
+    storage.replace(Artifact{2, "b", {'x', 'y'}});
+
+    SECTION("positioned read") {
+        auto blob = storage.open_blob(&Artifact::data, 1);
+        REQUIRE(blob.rowid() == 1);
+        REQUIRE(blob.size() == 4);
+        char buffer[2] = {};
+        blob.read(buffer, 2, 1);
+        REQUIRE(std::string(buffer, 2) == "bc");
+        REQUIRE_THROWS_AS(blob.read(buffer, 2, 3), std::system_error);
+    }
+    SECTION("positioned write") {
+        {
+            auto blob = storage.open_blob(&Artifact::data, 1, true);
+            blob.write("ZZ", 2, 2);
+        }
+        REQUIRE(storage.get<Artifact>(1).data == std::vector<char>{'a', 'b', 'Z', 'Z'});
+    }
+    SECTION("close") {
+        auto blob = storage.open_blob(&Artifact::data, 1, true);
+        blob.write("ZZ", 2, 0);
+        blob.close();
+        REQUIRE(storage.get<Artifact>(1).data == std::vector<char>{'Z', 'Z', 'c', 'd'});
+        blob.close();
+    }
+    SECTION("read-only") {
+        auto blob = storage.open_blob(&Artifact::data, 1);
+        REQUIRE_THROWS_AS(blob.write("Z", 1, 0), std::system_error);
+    }
+    SECTION("reopen") {
+        auto blob = storage.open_blob(&Artifact::data, 1);
+        blob.reopen(2);
+        REQUIRE(blob.rowid() == 2);
+        REQUIRE(blob.size() == 2);
+        REQUIRE_THROWS_AS(blob.reopen(3), std::system_error);
+    }
+    SECTION("missing row") {
+        REQUIRE_THROWS_AS(storage.open_blob(&Artifact::data, 3), std::system_error);
+    }
+    SECTION("streams") {
+        const std::string content(100000, 'q');
+        storage.allocate_blob(&Artifact::data, 2, content.size());
+        {
+            auto blob = storage.open_blob(&Artifact::data, 2, true);
+            REQUIRE(blob.size() == content.size());
+            std::istringstream is{content};
+            REQUIRE(blob.write_from(is, 0, 4096) == content.size());
+        }
+        auto blob = storage.open_blob(&Artifact::data, 2);
+        std::ostringstream os;
+        REQUIRE(blob.read_to(os, 10) == content.size() - 10);
+        REQUIRE(os.str() == content.substr(10));
+    }
+    SECTION("writes invalidate cached objects") {
+        storage.enable_object_cache<Artifact>();
+        REQUIRE(storage.get<Artifact>(1).data.size() == 4);
+        {
+            auto blob = storage.open_blob(&Artifact::data, 1, true);
+            blob.write("Z", 1, 0);
+        }
+        REQUIRE(storage.get<Artifact>(1).data == std::vector<char>{'Z', 'b', 'c', 'd'});
+    }
+}
+
+TEST_CASE("blob close failure") {
+    const std::string filename = "blob_close.sqlite";
+    ::remove(filename.c_str());
+    auto storage = makeStorage(filename);
+    storage.sync_schema();
+    storage.replace(Artifact{1, "a", {'a', 'b'}});
+    auto other = makeStorage(filename);
+    other.begin_transaction();
+    REQUIRE(other.count<Artifact>() == 1);
+
+    //  the reader holds a shared lock, so the writes can't be committed
+    auto blob = storage.open_blob(&Artifact::data, 1, true);
+    blob.write("Z", 1, 0);
+    REQUIRE_THROWS_AS(blob.close(), std::system_error);
+    other.commit();
+    REQUIRE(storage.get<Artifact>(1).data == std::vector<char>{'a', 'b'});
+}
@@ -0,0 +1,146 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+#include <vector>  //  std::vector
+#include <string>  //  std::string, std::to_string
+
+using namespace sqlite_orm;
+
+namespace {
+    struct Visit {
+        int id = 0;
+        std::string url;
+        int userId = 0;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Visit() = default;
+        Visit(int id, std::string url, int userId) : id{id}, url{std::move(url)}, userId{userId} {}
+#endif
+    };
+
+    auto makeStorage(const std::string& filename) {
+        return make_storage(filename,
+                            make_sqlite_schema_table(),
+                            make_index("idx_visits_url", &Visit::url),
+                            make_unique_index("idx_visits_user_url", &Visit::userId, &Visit::url),
+                            make_table("visits",
+                                       make_column("id", &Visit::id, primary_key()),
+                                       make_column("url", &Visit::url),
+                                       make_column("user_id", &Visit::userId)));
+    }
+
+    std::vector<Visit> makeVisits(int count) {
+        std::vector<Visit> visits;
+        for (int i = count; i > 0; --i) {
+            visits.push_back(Visit{i, "https://example.com/" + std::to_string(i), i % 7});
+        }
+        return visits;
+    }
+}
+
+TEST_CASE("bulk_load") {
+    const std::string filename = "bulk_load.sqlite";
+    ::remove(filename.c_str());
+    auto storage = makeStorage(filename);
+    storage.sync_schema();
+    storage.limit.variable_number(100);
+    const auto visits = makeVisits(250);
+
+    auto indexCount = [&storage] {
+        return storage.count<sqlite_master>(where(c(&sqlite_master::type) == "index"));
+    };
+    REQUIRE(indexCount() == 2);
+
+    SECTION("default options") {
+        auto result = storage.bulk_load<Visit>(visits);
+        REQUIRE(result.rows == 250);
+        REQUIRE(storage.count<Visit>() == 250);
+        REQUIRE(result.rows_per_second() >= 0);
+        REQUIRE(indexCount() == 2);
+        //  primary keys are assigned by SQLite
+        REQUIRE(storage.get<Visit>(1).url == "https://example.com/250");
+    }
+    SECTION("keep primary keys") {
+        bulk_load_options options;
+        options.keep_primary_keys = true;
+        SECTION("unsorted") {}
+        SECTION("sorted") {
+            options.sort_by_primary_key = true;
+        }
+        auto result = storage.bulk_load<Visit>(visits, options);
+        REQUIRE(result.rows == 250);
+        REQUIRE(storage.get<Visit>(1).url == "https://example.com/1");
+        REQUIRE(storage.get<Visit>(250).url == "https://example.com/250");
+    }
+    SECTION("drop indexes") {
+        bulk_load_options options;
+        options.drop_indexes = true;
+        storage.bulk_load<Visit>(visits, options);
+        REQUIRE(storage.count<Visit>() == 250);
+        REQUIRE(indexCount() == 2);
+    }
+    SECTION("drop indexes not created yet") {
+        storage.drop_index("idx_visits_url");
+        REQUIRE(indexCount() == 1);
+        bulk_load_options options;
+        options.drop_indexes = true;
+        storage.bulk_load<Visit>(visits, options);
+        REQUIRE(indexCount() == 2);
+    }
+    SECTION("durability is restored") {
+        storage.open_forever();
+        storage.pragma.synchronous(1);
+        storage.pragma.journal_mode(journal_mode::TRUNCATE);
+        bulk_load_options options;
+        options.relax_durability = true;
+        storage.bulk_load<Visit>(visits, options);
+        REQUIRE(storage.pragma.synchronous() == 1);
+        REQUIRE(storage.pragma.journal_mode() == journal_mode::TRUNCATE);
+    }
+    SECTION("failure rolls back") {
+        auto duplicates = visits;
+        duplicates.push_back(duplicates.front());
+        bulk_load_options options;
+        options.drop_indexes = true;
+        //  the unique index can't be recreated
+        REQUIRE_THROWS(storage.bulk_load<Visit>(duplicates, options));
+        REQUIRE(storage.count<Visit>() == 0);
+        REQUIRE(indexCount() == 2);
+    }
+    SECTION("inside a transaction") {
+        bulk_load_options options;
+        options.drop_indexes = true;
+        options.relax_durability = true;
+        storage.transaction([&] {
+            storage.replace(Visit{1000, "https://example.com/first", 1});
+            REQUIRE(storage.bulk_load<Visit>(visits, options).rows == 250);
+            return true;
+        });
+        REQUIRE(storage.count<Visit>() == 251);
+        REQUIRE(indexCount() == 2);
+    }
+    SECTION("failure inside a transaction rolls back the load only") {
+        auto duplicates = visits;
+        duplicates.push_back(duplicates.front());
+        bulk_load_options options;
+        options.drop_indexes = true;
+        std::vector<row_change> changes;
+        storage.add_change_listener<Visit>([&changes](const std::vector<row_change>& committed) {
+            changes.insert(changes.end(), committed.begin(), committed.end());
+        });
+        storage.begin_transaction();
+        storage.replace(Visit{1000, "https://example.com/first", 1});
+        REQUIRE_THROWS(storage.bulk_load<Visit>(duplicates, options));
+        REQUIRE(storage.count<Visit>() == 1);
+        REQUIRE(indexCount() == 2);
+        storage.commit();
+        REQUIRE(storage.count<Visit>() == 1);
+        //  the rows rolled back to the savepoint aren't reported
+        REQUIRE(changes == std::vector<row_change>{{change_kind::insert, 1000}});
+    }
+    SECTION("empty range") {
+        auto result = storage.bulk_load<Visit>(std::vector<Visit>{});
+        REQUIRE(result.rows == 0);
+        REQUIRE(indexCount() == 2);
+    }
+}
@@ -0,0 +1,154 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <thread>  //  std::thread
+#include <system_error>  //  std::system_error
+
+using namespace sqlite_orm;
+
+namespace {
+    struct User {
+        int id = 0;
+        std::string name;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        User() = default;
+        User(int id, std::string name) : id{id}, name{std::move(name)} {}
+#endif
+    };
+
+    struct Visit {
+        int id = 0;
+        int userId = 0;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Visit() = default;
+        Visit(int id, int userId) : id{id}, userId{userId} {}
+#endif
+    };
+
+    struct Tag {
+        int id = 0;
+        std::string name;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Tag() = default;
+        Tag(int id, std::string name) : id{id}, name{std::move(name)} {}
+#endif
+    };
+
+    auto makeTagStorage() {
+        return make_storage(
+            "",
+            make_table("tags", make_column("id", &Tag::id, primary_key()), make_column("name", &Tag::name, unique())));
+    }
+
+    auto makeStorage(const std::string& filename) {
+        return make_storage(
+            filename,
+            make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)),
+            make_table("visits", make_column("id", &Visit::id, primary_key()), make_column("user_id", &Visit::userId)));
+    }
+}
+
+TEST_CASE("change listeners") {
+    const std::string filename = "change_listeners.sqlite";
+    ::remove(filename.c_str());
+    //  the connection is reopened for every call, hence the hooks survive reconnects
+    auto storage = makeStorage(filename);
+    storage.sync_schema();
+
+    std::vector<std::vector<row_change>> deliveries;
+    const size_t id = storage.add_change_listener<User>([&deliveries](const std::vector<row_change>& changes) {
+        deliveries.push_back(changes);
+    });
+
+    SECTION("autocommit") {
+        storage.replace(User{1, "Bebe"});
+        storage.replace(Visit{1, 1});
+        REQUIRE(deliveries.size() == 1);
+        REQUIRE(deliveries[0] == std::vector<row_change>{{change_kind::insert, 1}});
+    }
+    SECTION("delivered on commit") {
+        storage.transaction([&storage, &deliveries] {
+            storage.replace(User{1, "Bebe"});
+            storage.update_all(set(c(&User::name) = "Rexha"), where(c(&User::id) == 1));
+            storage.replace(User{2, "Dua"});
+            storage.remove<User>(2);
+            REQUIRE(deliveries.empty());
+            return true;
+        });
+        REQUIRE(deliveries.size() == 1);
+        REQUIRE(deliveries[0] == std::vector<row_change>{{change_kind::insert, 1},
+                                                         {change_kind::update, 1},
+                                                         {change_kind::insert, 2},
+                                                         {change_kind::remove, 2}});
+    }
+    SECTION("discarded on rollback") {
+        storage.transaction([&storage] {
+            storage.replace(User{1, "Bebe"});
+            return false;
+        });
+        REQUIRE(deliveries.empty());
+        storage.replace(User{3, "Kim"});
+        REQUIRE(deliveries == std::vector<std::vector<row_change>>{{{change_kind::insert, 3}}});
+    }
+    SECTION("failed statement inside a transaction") {
+        auto storage = makeTagStorage();
+        storage.sync_schema();
+        std::vector<row_change> tagChanges;
+        storage.add_change_listener<Tag>([&tagChanges](const std::vector<row_change>& changes) {
+            tagChanges.insert(tagChanges.end(), changes.begin(), changes.end());
+        });
+        storage.transaction([&storage] {
+            storage.replace(Tag{1, "a"});
+            //  the second row violates the unique constraint, the first one is rolled back with it
+            std::vector<Tag> tags{{11, "b"}, {12, "a"}};
+            REQUIRE_THROWS_AS(storage.insert_range(tags.begin(), tags.end()), std::system_error);
+            REQUIRE_THROWS_AS(storage.insert(Tag{13, "a"}), std::system_error);
+            return true;
+        });
+        REQUIRE(tagChanges == std::vector<row_change>{{change_kind::insert, 1}});
+    }
+    SECTION("failed statements of other threads") {
+        auto storage = makeTagStorage();
+        storage.sync_schema();
+        storage.replace(Tag{1, "a"});
+        size_t inserts = 0;
+        storage.add_change_listener<Tag>([&inserts](const std::vector<row_change>& changes) {
+            inserts += changes.size();
+        });
+        storage.begin_transaction();
+        std::thread failing{[&storage] {
+            for (int i = 0; i < 200; ++i) {
+                try {
+                    storage.insert(Tag{0, "a"});
+                } catch (const std::system_error&) {
+                }
+            }
+        }};
+        for (int i = 0; i < 200; ++i) {
+            storage.insert(Tag{0, std::to_string(i)});
+        }
+        failing.join();
+        storage.commit();
+        REQUIRE(inserts == 200);
+    }
+    SECTION("by table name") {
+        std::vector<row_change> visitChanges;
+        storage.add_change_listener("visits", [&visitChanges](const std::vector<row_change>& changes) {
+            visitChanges.insert(visitChanges.end(), changes.begin(), changes.end());
+        });
+        storage.replace(Visit{5, 1});
+        REQUIRE(visitChanges == std::vector<row_change>{{change_kind::insert, 5}});
+        REQUIRE(deliveries.empty());
+    }
+    SECTION("removed") {
+        REQUIRE(storage.remove_change_listener(id));
+        REQUIRE_FALSE(storage.remove_change_listener(id));
+        storage.replace(User{1, "Bebe"});
+        REQUIRE(deliveries.empty());
+    }
+}
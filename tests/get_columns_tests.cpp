@@ -0,0 +1,60 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <tuple>  //  std::get
+
+using namespace sqlite_orm;
+
+namespace {
+    struct Measurement {
+        int id = 0;
+        std::string sensor;
+        double value = 0;
+        int64 timestamp = 0;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Measurement() = default;
+        Measurement(int id, std::string sensor, double value, int64 timestamp) :
+            id{id}, sensor{std::move(sensor)}, value{value}, timestamp{timestamp} {}
+#endif
+    };
+}
+
+TEST_CASE("get_columns") {
+    auto storage = make_storage("",
+                                make_table("measurements",
+                                           make_column("id", &Measurement::id, primary_key()),
+                                           make_column("sensor", &Measurement::sensor),
+                                           make_column("value", &Measurement::value),
+                                           make_column("timestamp", &Measurement::timestamp)));
+    storage.sync_schema();
+
+    SECTION("empty") {
+        auto result = storage.get_columns(columns(&Measurement::id, &Measurement::value));
+        REQUIRE(std::get<0>(result).empty());
+        REQUIRE(std::get<1>(result).empty());
+    }
+    SECTION("one vector per column") {
+        storage.replace(Measurement{1, "a", 0.5, 100});
+        storage.replace(Measurement{2, "b", 1.5, 200});
+        storage.replace(Measurement{3, "a", 2.5, 300});
+        auto result = storage.get_columns(
+            columns(&Measurement::value, &Measurement::timestamp, &Measurement::sensor, length(&Measurement::sensor)),
+            where(c(&Measurement::id) > 1),
+            order_by(&Measurement::id));
+        REQUIRE(std::get<0>(result) == std::vector<double>{1.5, 2.5});
+        REQUIRE(std::get<1>(result) == std::vector<int64>{200, 300});
+        REQUIRE(std::get<2>(result) == std::vector<std::string>{"b", "a"});
+        REQUIRE(std::get<3>(result) == std::vector<int>{1, 1});
+    }
+    SECTION("bound parameters are rebound") {
+        for (int id = 1; id <= 10; ++id) {
+            storage.replace(Measurement{id, "a", id * 0.5, id});
+        }
+        for (int minId = 0; minId <= 10; minId += 5) {
+            auto result = storage.get_columns(columns(&Measurement::id), where(c(&Measurement::id) > minId));
+            REQUIRE(std::get<0>(result).size() == size_t(10 - minId));
+        }
+    }
+}
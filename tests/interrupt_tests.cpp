@@ -0,0 +1,155 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <chrono>  //  std::chrono::milliseconds, std::chrono::seconds
+#include <thread>  //  std::thread, std::this_thread::sleep_for
+#include <atomic>  //  std::atomic_bool, std::atomic_int
+
+using namespace sqlite_orm;
+
+namespace {
+    struct A {
+        int value = 0;
+    };
+    struct B {
+        int value = 0;
+    };
+    struct C {
+        int value = 0;
+    };
+
+    auto makeStorage() {
+        return make_storage({},
+                            make_table("a", make_column("value", &A::value)),
+                            make_table("b", make_column("value", &B::value)),
+                            make_table("c", make_column("value", &C::value)));
+    }
+
+    template<class S>
+    void fill(S& storage, int count) {
+        storage.transaction([&storage, count] {
+            for (int i = 0; i < count; ++i) {
+                storage.insert(A{i});
+                storage.insert(B{i});
+                storage.insert(C{i});
+            }
+            return true;
+        });
+    }
+
+    auto orm_error(orm_error_code code) {
+        return Catch::Matchers::Predicate<std::system_error>([code](const std::system_error& error) {
+            return error.code() == code;
+        });
+    }
+}
+
+TEST_CASE("query deadline") {
+    auto storage = makeStorage();
+    storage.sync_schema();
+    fill(storage, 300);
+    //  the queries timing out join 27 million combinations yielding no row
+
+    SECTION("completes in time") {
+        REQUIRE(storage.get_all<A>(with_timeout(std::chrono::seconds{60}), where(c(&A::value) < 10)).size() == 10);
+        REQUIRE(storage.select(with_timeout(std::chrono::seconds{60}), &A::value, where(c(&A::value) < 5)).size() == 5);
+        const query_deadline limits = with_timeout(std::chrono::seconds{60});
+        REQUIRE(storage.get_all<B>(limits).size() == 300);
+    }
+    SECTION("get_all times out") {
+        const auto timeout = with_timeout(std::chrono::milliseconds{20}, 100);
+        REQUIRE_THROWS_MATCHES(storage.get_all<A>(timeout,
+                                                  cross_join<B>(),
+                                                  cross_join<C>(),
+                                                  where(c(&A::value) + c(&B::value) + c(&C::value) == -1)),
+                               std::system_error,
+                               orm_error(orm_error_code::deadline_exceeded));
+        //  the connection is still usable
+        REQUIRE(storage.count<A>() == 300);
+    }
+    SECTION("select times out") {
+        REQUIRE_THROWS_MATCHES(storage.select(with_timeout(std::chrono::milliseconds{20}),
+                                              &A::value,
+                                              where(c(&A::value) + c(&B::value) + c(&C::value) == -1)),
+                               std::system_error,
+                               orm_error(orm_error_code::deadline_exceeded));
+    }
+    SECTION("iterate times out") {
+        auto iterateAll = [&storage] {
+            for (auto& a: storage.iterate<A>(with_timeout(std::chrono::milliseconds{20}),
+                                             cross_join<B>(),
+                                             cross_join<C>(),
+                                             where(c(&A::value) + c(&B::value) + c(&C::value) == -1))) {
+                (void)a;
+            }
+        };
+        REQUIRE_THROWS_MATCHES(iterateAll(), std::system_error, orm_error(orm_error_code::deadline_exceeded));
+        size_t count = 0;
+        for (auto& a: storage.iterate<A>(with_timeout(std::chrono::seconds{60}), where(c(&A::value) < 3))) {
+            REQUIRE(a.value == int(count));
+            ++count;
+        }
+        REQUIRE(count == 3);
+    }
+    SECTION("cancellation") {
+        cancellation_token token;
+        std::thread canceller{[token]() mutable {
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+            token.cancel();
+        }};
+        auto run = [&storage, &token] {
+            return storage.get_all<A>(with_cancellation(token),
+                                      cross_join<B>(),
+                                      cross_join<C>(),
+                                      where(c(&A::value) + c(&B::value) + c(&C::value) == -1));
+        };
+        REQUIRE_THROWS_MATCHES(run(), std::system_error, orm_error(orm_error_code::query_cancelled));
+        canceller.join();
+        REQUIRE(token.is_cancelled());
+        //  a cancelled token cancels right away
+        REQUIRE_THROWS_MATCHES(storage.get_all<A>(with_cancellation(token)),
+                               std::system_error,
+                               orm_error(orm_error_code::query_cancelled));
+        REQUIRE(storage.get_all<A>().size() == 300);
+    }
+    SECTION("other threads sharing the connection") {
+        auto longQuery = [&storage](query_deadline limits) {
+            return storage.get_all<A>(std::move(limits),
+                                      cross_join<B>(),
+                                      cross_join<C>(),
+                                      where(c(&A::value) + c(&B::value) + c(&C::value) == -1));
+        };
+        std::atomic_bool done{false};
+        std::atomic_int failures{0};
+        //  statements of another thread, with and without a deadline of its own
+        std::thread other{[&storage, &done, &failures] {
+            while (!done) {
+                try {
+                    if (storage.count<A>(where(c(&A::value) >= 0)) != 300 ||
+                        storage.get_all<B>(with_timeout(std::chrono::seconds{60}), where(c(&B::value) < 10)).size() !=
+                            10) {
+                        ++failures;
+                    }
+                } catch (const std::system_error&) {
+                    ++failures;
+                }
+            }
+        }};
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE_THROWS_MATCHES(longQuery(with_timeout(std::chrono::milliseconds{20}, 100)),
+                                   std::system_error,
+                                   orm_error(orm_error_code::deadline_exceeded));
+            cancellation_token token;
+            std::thread canceller{[token]() mutable {
+                std::this_thread::sleep_for(std::chrono::milliseconds{20});
+                token.cancel();
+            }};
+            REQUIRE_THROWS_MATCHES(longQuery(with_cancellation(token, 100)),
+                                   std::system_error,
+                                   orm_error(orm_error_code::query_cancelled));
+            canceller.join();
+        }
+        done = true;
+        other.join();
+        REQUIRE(failures == 0);
+    }
+}
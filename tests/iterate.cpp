@@ -1,6 +1,7 @@
 #include <sqlite_orm/sqlite_orm.h>
 #include <catch2/catch_all.hpp>
 #include <numeric>  //  std::iota
+#include <type_traits>  //  std::is_convertible
 
 using namespace sqlite_orm;
 
@@ -60,6 +61,54 @@ TEST_CASE("Iterate mapped") {
     }
 }
 
+TEST_CASE("Iterate mapped in place") {
+    struct Test {
+        int64_t id;
+        std::string name;
+    };
+
+    auto db =
+        make_storage("",
+                     make_table("Test", make_column("id", &Test::id, primary_key()), make_column("name", &Test::name)));
+    db.sync_schema(true);
+    db.replace(Test{1, "first row with a rather long name"});
+    db.replace(Test{2, "second"});
+    db.replace(Test{3, "third"});
+
+    SECTION("range-based for") {
+        std::vector<int64_t> ids;
+        for (Test& obj: db.iterate_in_place<Test>(order_by(&Test::id))) {
+            ids.push_back(obj.id);
+        }
+        REQUIRE(ids == std::vector<int64_t>{1, 2, 3});
+    }
+    SECTION("reuses the object") {
+        auto view = db.iterate_in_place<Test>(order_by(&Test::id));
+        auto it = view.begin();
+        const Test* object = &*it;
+        REQUIRE(it->name == "first row with a rather long name");
+        const auto capacity = it->name.capacity();
+        ++it;
+        REQUIRE(&*it == object);
+        REQUIRE(it->id == 2);
+        REQUIRE(it->name == "second");
+        REQUIRE(it->name.capacity() == capacity);
+        it++;
+        REQUIRE(it->id == 3);
+        REQUIRE(++it == view.end());
+    }
+    SECTION("explicit copies share the position") {
+        STATIC_REQUIRE_FALSE(std::is_convertible<const decltype(db.iterate_in_place<Test>().begin())&,
+                                                 decltype(db.iterate_in_place<Test>().begin())>::value);
+        auto view = db.iterate_in_place<Test>(order_by(&Test::id));
+        auto it = view.begin();
+        decltype(it) copy{it};
+        ++it;
+        REQUIRE(copy->id == 2);
+        REQUIRE(copy == it);
+    }
+}
+
 #if defined(SQLITE_ORM_SENTINEL_BASED_FOR_SUPPORTED) && defined(SQLITE_ORM_DEFAULT_COMPARISONS_SUPPORTED)
 TEST_CASE("Iterate select statement") {
     struct Test {
@@ -112,3 +161,66 @@ TEST_CASE("Iterate select statement") {
 #endif
 }
 #endif
+
+#if defined(SQLITE_ORM_SENTINEL_BASED_FOR_SUPPORTED) && defined(SQLITE_ORM_DEFAULT_COMPARISONS_SUPPORTED)
+TEST_CASE("Cursor") {
+    struct Log {
+        int64_t id;
+        std::string message;
+        std::vector<char> payload;
+    };
+
+    auto db = make_storage("",
+                           make_table("logs",
+                                      make_column("id", &Log::id, primary_key()),
+                                      make_column("message", &Log::message),
+                                      make_column("payload", &Log::payload)));
+    db.sync_schema(true);
+    db.replace(Log{1, "started", {}});
+    db.replace(Log{2, "error: disk full", {'\x01', '\x02', '\x03'}});
+    db.replace(Log{3, "stopped", {'\x04'}});
+
+    SECTION("columns are accessed in place") {
+        std::vector<int64_t> ids;
+        std::vector<std::string> messages;
+        for (const row_view& row: db.cursor(select(columns(&Log::id, &Log::message), order_by(&Log::id)))) {
+            REQUIRE(row.column_count() == 2);
+            ids.push_back(row.get<int64_t>(0));
+            messages.emplace_back(row.text(1));
+        }
+        REQUIRE(ids == std::vector<int64_t>{1, 2, 3});
+        REQUIRE(messages == std::vector<std::string>{"started", "error: disk full", "stopped"});
+    }
+    SECTION("filter") {
+        std::vector<int64_t> ids;
+        for (const row_view& row: db.cursor(select(columns(&Log::id, &Log::message), where(c(&Log::id) > 1)))) {
+            if (row.text(1).starts_with("error")) {
+                ids.push_back(row.get<int64_t>(0));
+            }
+        }
+        REQUIRE(ids == std::vector<int64_t>{2});
+    }
+#ifdef SQLITE_ORM_SPAN_SUPPORTED
+    SECTION("blobs") {
+        size_t bytes = 0;
+        for (const row_view& row: db.cursor(select(&Log::payload, order_by(&Log::id)))) {
+            std::span<const std::byte> payload = row.blob(0);
+            bytes += payload.size();
+            if (!payload.empty()) {
+                REQUIRE(payload[0] != std::byte{0});
+            }
+        }
+        REQUIRE(bytes == 4);
+    }
+#endif
+    SECTION("nulls") {
+        auto rows = db.cursor(select(columns(nullptr, &Log::message), where(c(&Log::id) == 1)));
+        auto it = rows.begin();
+        REQUIRE((*it).is_null(0));
+        REQUIRE((*it).text(0).empty());
+        REQUIRE((*it).size(1) == 7);
+        ++it;
+        REQUIRE(it == rows.end());
+    }
+}
+#endif
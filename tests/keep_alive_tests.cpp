@@ -0,0 +1,127 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+#include <chrono>  //  std::chrono::milliseconds, std::chrono::steady_clock
+#include <thread>  //  std::this_thread::sleep_for
+
+#include "user_storage.h"
+
+using namespace sqlite_orm;
+using namespace UserStorageTests;
+
+namespace {
+    template<class S>
+    bool waitUntilClosed(const S& storage) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (storage.is_opened()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds{5});
+        }
+        return true;
+    }
+}
+
+TEST_CASE("keep alive") {
+    const std::string filename = "keep_alive.sqlite";
+    ::remove(filename.c_str());
+    auto storage = makeStorage(filename);
+    REQUIRE(storage.keep_alive() == std::chrono::milliseconds{0});
+    storage.sync_schema();
+    storage.replace(User{1, "Tom"});
+
+    SECTION("disabled") {
+        const auto statsBefore = storage.connection_stats();
+        storage.get<User>(1);
+        storage.count<User>();
+        REQUIRE_FALSE(storage.is_opened());
+        const auto statsAfter = storage.connection_stats();
+        REQUIRE(statsAfter.opened - statsBefore.opened == 2);
+        REQUIRE(statsAfter.closed - statsBefore.closed == 2);
+        REQUIRE(statsAfter.reused == 0);
+    }
+    SECTION("reuses the connection") {
+        storage.keep_alive(std::chrono::minutes{1});
+        const auto statsBefore = storage.connection_stats();
+        storage.get<User>(1);
+        REQUIRE(storage.is_opened());
+        storage.count<User>();
+        storage.replace(User{2, "Jerry"});
+        const auto statsAfter = storage.connection_stats();
+        REQUIRE(statsAfter.opened - statsBefore.opened == 1);
+        REQUIRE(statsAfter.closed == statsBefore.closed);
+        REQUIRE(statsAfter.reused == 2);
+
+        //  the kept-alive connection also keeps its cached statements
+        const auto hitsBefore = storage.statement_cache_stats().hits;
+        storage.get<User>(1);
+        REQUIRE(storage.statement_cache_stats().hits == hitsBefore + 1);
+    }
+    SECTION("closes after the idle timeout") {
+        storage.keep_alive(std::chrono::milliseconds{20});
+        const auto statsBefore = storage.connection_stats();
+        storage.get<User>(1);
+        REQUIRE(waitUntilClosed(storage));
+        REQUIRE(storage.connection_stats().closed - statsBefore.closed == 1);
+        REQUIRE(storage.statement_cache_stats().size == 0);
+
+        REQUIRE(storage.get<User>(1).name == "Tom");
+        REQUIRE(storage.connection_stats().opened - statsBefore.opened == 2);
+    }
+    SECTION("disabling closes an idle connection") {
+        storage.keep_alive(std::chrono::minutes{1});
+        storage.get<User>(1);
+        REQUIRE(storage.is_opened());
+        storage.keep_alive(std::chrono::milliseconds{0});
+        REQUIRE(waitUntilClosed(storage));
+    }
+    SECTION("failing close is retried") {
+        sqlite3_stmt* userStmt = nullptr;
+        storage.on_open = [&userStmt](sqlite3* db) {
+            sqlite3_prepare_v2(db, "SELECT 1", -1, &userStmt, nullptr);
+        };
+        storage.keep_alive(std::chrono::milliseconds{20});
+        storage.get<User>(1);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (storage.connection_stats().failed_closes == 0 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{5});
+        }
+        REQUIRE(storage.connection_stats().failed_closes > 0);
+        REQUIRE(storage.is_opened());
+        REQUIRE(storage.count<User>() == 1);
+
+        sqlite3_finalize(userStmt);
+        REQUIRE(waitUntilClosed(storage));
+    }
+    SECTION("functions registered while idle") {
+        struct FirstFunction {
+            int operator()() const {
+                return 1;
+            }
+
+            static const char* name() {
+                return "FIRST";
+            }
+        };
+        storage.keep_alive(std::chrono::minutes{1});
+        storage.count<User>();
+        storage.create_scalar_function<FirstFunction>();
+        REQUIRE(storage.select(func<FirstFunction>()) == std::vector<int>{1});
+        storage.delete_scalar_function<FirstFunction>();
+    }
+    SECTION("transaction") {
+        storage.keep_alive(std::chrono::minutes{1});
+        storage.transaction([&storage] {
+            storage.replace(User{2, "Jerry"});
+            return true;
+        });
+        REQUIRE(storage.count<User>() == 2);
+        REQUIRE(storage.connection_stats().reused > 0);
+    }
+    SECTION("copy keeps the setting") {
+        storage.keep_alive(std::chrono::minutes{1});
+        auto copy = storage;
+        REQUIRE(copy.keep_alive() == std::chrono::minutes{1});
+    }
+}
@@ -0,0 +1,163 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+#include <string>  //  std::string
+#include <tuple>  //  std::make_tuple
+
+#include "user_storage.h"
+
+using namespace sqlite_orm;
+using namespace UserStorageTests;
+
+namespace {
+    struct Membership {
+        int userId = 0;
+        int groupId = 0;
+        std::string role;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Membership() = default;
+        Membership(int userId, int groupId, std::string role) :
+            userId{userId}, groupId{groupId}, role{std::move(role)} {}
+#endif
+    };
+
+    struct Reading {
+        double at = 0;
+        std::string value;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Reading() = default;
+        Reading(double at, std::string value) : at{at}, value{std::move(value)} {}
+#endif
+    };
+
+    auto makeCacheStorage(const std::string& filename) {
+        return make_storage(
+            filename,
+            make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)),
+            make_table("memberships",
+                       make_column("user_id", &Membership::userId),
+                       make_column("group_id", &Membership::groupId),
+                       make_column("role", &Membership::role),
+                       primary_key(&Membership::userId, &Membership::groupId)),
+            make_table("readings",
+                       make_column("at", &Reading::at, primary_key()),
+                       make_column("value", &Reading::value)));
+    }
+}
+
+TEST_CASE("object cache") {
+    const std::string filename = "object_cache.sqlite";
+    ::remove(filename.c_str());
+    auto storage = makeCacheStorage(filename);
+    storage.sync_schema();
+    storage.replace(User{1, "Bebe"});
+    storage.replace(User{2, "Dua"});
+    storage.replace(Membership{1, 10, "owner"});
+    storage.enable_object_cache<User>();
+    storage.enable_object_cache<Membership>();
+    storage.enable_object_cache<Reading>();
+
+    SECTION("hits") {
+        REQUIRE(storage.get<User>(1).name == "Bebe");
+        REQUIRE(storage.get<User>(1).name == "Bebe");
+        REQUIRE(storage.get_pointer<User>(1)->name == "Bebe");
+#ifdef SQLITE_ORM_OPTIONAL_SUPPORTED
+        REQUIRE(storage.get_optional<User>(1)->name == "Bebe");
+#endif
+        auto stats = storage.get_object_cache_stats<User>();
+        REQUIRE(stats.misses == 1);
+        REQUIRE(stats.hits >= 2);
+        REQUIRE(stats.entries == 1);
+        REQUIRE(stats.bytes == sizeof(User));
+        REQUIRE(stats.hit_rate() > 0.5);
+    }
+    SECTION("missing objects aren't cached") {
+        REQUIRE_THROWS_AS(storage.get<User>(3), std::system_error);
+        REQUIRE(storage.get_pointer<User>(3) == nullptr);
+        storage.replace(User{3, "Kim"});
+        REQUIRE(storage.get<User>(3).name == "Kim");
+        REQUIRE(storage.get_object_cache_stats<User>().hits == 0);
+    }
+    SECTION("invalidated by writes") {
+        storage.get<User>(1);
+        storage.get<User>(2);
+        storage.update(User{1, "Rexha"});
+        REQUIRE(storage.get<User>(1).name == "Rexha");
+        storage.update_all(set(c(&User::name) = "Lipa"), where(c(&User::id) == 2));
+        REQUIRE(storage.get<User>(2).name == "Lipa");
+        storage.remove<User>(1);
+        REQUIRE(storage.get_pointer<User>(1) == nullptr);
+        storage.remove_all<User>();
+        REQUIRE(storage.get_pointer<User>(2) == nullptr);
+    }
+    SECTION("invalidated by the update hook") {
+        storage.get<User>(1);
+        storage.replace(into<User>(), columns(&User::id, &User::name), values(std::make_tuple(1, "Rexha")));
+        REQUIRE(storage.get<User>(1).name == "Rexha");
+    }
+    SECTION("cleared when the database is replaced") {
+        auto other = makeCacheStorage("");
+        other.sync_schema();
+        other.replace(User{1, "Rexha"});
+        REQUIRE(storage.get<User>(1).name == "Bebe");
+        storage.backup_from(other);
+        REQUIRE(storage.get<User>(1).name == "Rexha");
+#if SQLITE_VERSION_NUMBER >= 3036000 || defined(SQLITE_ENABLE_DESERIALIZE)
+#ifndef SQLITE_OMIT_DESERIALIZE
+        other.replace(User{1, "Lipa"});
+        storage.open_forever();
+        storage.deserialize_database(other.serialize_database());
+        REQUIRE(storage.get<User>(1).name == "Lipa");
+#endif
+#endif
+    }
+    SECTION("not used in transactions") {
+        storage.get<User>(1);
+        storage.transaction([&storage] {
+            storage.update(User{1, "Rexha"});
+            REQUIRE(storage.get<User>(1).name == "Rexha");
+            return false;
+        });
+        REQUIRE(storage.get<User>(1).name == "Bebe");
+    }
+    SECTION("composite keys") {
+        REQUIRE(storage.get<Membership>(1, 10).role == "owner");
+        REQUIRE(storage.get<Membership>(1, 10).role == "owner");
+        REQUIRE(storage.get_object_cache_stats<Membership>().hits == 1);
+        storage.update(Membership{1, 10, "member"});
+        REQUIRE(storage.get<Membership>(1, 10).role == "member");
+        REQUIRE(storage.get_pointer<Membership>(11, 0) == nullptr);
+    }
+    SECTION("real keys") {
+        storage.replace(Reading{1.0000001, "first"});
+        storage.replace(Reading{1.0000002, "second"});
+        storage.replace(Reading{2, "third"});
+        REQUIRE(storage.get<Reading>(1.0000001).value == "first");
+        REQUIRE(storage.get<Reading>(1.0000002).value == "second");
+        REQUIRE(storage.get<Reading>(1.0000001).value == "first");
+        REQUIRE(storage.get<Reading>(2).value == "third");
+        storage.update(Reading{2, "fourth"});
+        REQUIRE(storage.get<Reading>(2).value == "fourth");
+    }
+    SECTION("ids of other kinds than the key") {
+        REQUIRE(storage.get<User>(1.0).name == "Bebe");
+        storage.get<User>(1);
+        storage.remove<User>(1.0);
+        REQUIRE(storage.get_pointer<User>(1) == nullptr);
+    }
+    SECTION("bounded") {
+        storage.disable_object_cache<User>();
+        object_cache_options options;
+        options.max_entries = 1;
+        storage.enable_object_cache<User>(options);
+        storage.get<User>(1);
+        storage.get<User>(2);
+        storage.get<User>(1);
+        auto stats = storage.get_object_cache_stats<User>();
+        REQUIRE(stats.entries == 1);
+        REQUIRE(stats.evictions == 2);
+        REQUIRE(stats.hits == 0);
+    }
+}
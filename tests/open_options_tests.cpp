@@ -0,0 +1,71 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+#include <string>  //  std::string
+
+#include "user_storage.h"
+
+using namespace sqlite_orm;
+using namespace UserStorageTests;
+
+TEST_CASE("open filename") {
+    using internal::make_open_filename;
+
+    open_options options;
+    REQUIRE(make_open_filename("data.sqlite", options) == "data.sqlite");
+    options.uri_parameters = {{"mode", "ro"}, {"note", "a&b=c"}};
+    REQUIRE(make_open_filename("data?#%.sqlite", options) == "file:data%3F%23%25.sqlite?mode=ro&note=a%26b%3Dc");
+    REQUIRE(make_open_filename(":memory:", options) == "file::memory:?mode=ro&note=a%26b%3Dc");
+    REQUIRE(internal::make_open_flags(options) & SQLITE_OPEN_URI);
+
+    options.flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX;
+    REQUIRE(internal::make_reader_open_options(options).flags == SQLITE_OPEN_READONLY);
+}
+
+TEST_CASE("open options") {
+    const std::string filename = "open_options.sqlite";
+    ::remove(filename.c_str());
+    {
+        auto storage = makeStorage(filename);
+        storage.sync_schema();
+        storage.replace(User{1, "model"});
+    }
+
+    SECTION("read-only") {
+        open_options options;
+        options.flags = SQLITE_OPEN_READONLY;
+        auto storage = makeStorage(filename, options);
+        REQUIRE(storage.get<User>(1).name == "model");
+        REQUIRE_THROWS_AS(storage.replace(User{2, "weights"}), std::system_error);
+        REQUIRE(storage.get_open_options().flags == SQLITE_OPEN_READONLY);
+    }
+    SECTION("immutable") {
+        open_options options;
+        options.flags = SQLITE_OPEN_READONLY;
+        options.uri_parameters = {{"immutable", "1"}};
+        auto storage = makeStorage(filename, options);
+        REQUIRE(storage.count<User>() == 1);
+        //  reader connections are opened with the same URI
+        storage.reader_pool_size(1);
+        REQUIRE(storage.get_all<User>().size() == 1);
+    }
+    SECTION("no mutex and lookaside") {
+        open_options options;
+        options.flags |= SQLITE_OPEN_NOMUTEX;
+        options.lookaside_slot_size = 256;
+        options.lookaside_slot_count = 64;
+        auto storage = makeStorage(filename, options);
+        //  reopened for every call
+        storage.replace(User{2, "weights"});
+        REQUIRE(storage.count<User>() == 2);
+        REQUIRE(storage.connection_stats().opened == 2);
+    }
+    SECTION("vfs") {
+        open_options options;
+        options.vfs = sqlite3_vfs_find(nullptr)->zName;
+        REQUIRE(makeStorage(filename, options).count<User>() == 1);
+
+        options.vfs = "no such vfs";
+        REQUIRE_THROWS_AS(makeStorage(filename, options).count<User>(), std::system_error);
+    }
+}
@@ -1,5 +1,7 @@
 #include <sqlite_orm/sqlite_orm.h>
 #include <catch2/catch_all.hpp>
+#include <limits>  //  std::numeric_limits
+#include <system_error>  //  std::system_error
 
 using namespace sqlite_orm;
 
@@ -113,3 +115,74 @@ TEST_CASE("In") {
         }
     }
 }
+
+#ifdef SQLITE_ORM_AS_ARRAY_SUPPORTED
+TEST_CASE("In array") {
+    struct Letter {
+        int id = 0;
+        std::string name;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Letter() = default;
+        Letter(int id, std::string name) : id{id}, name{std::move(name)} {}
+#endif
+    };
+    auto storage = make_storage(
+        "",
+        make_table("letters", make_column("id", &Letter::id, primary_key()), make_column("name", &Letter::name)));
+    storage.sync_schema();
+    storage.replace(Letter{1, "A"});
+    storage.replace(Letter{2, "B"});
+    storage.replace(Letter{3, "C"});
+    storage.replace(Letter{4, "\"D\"\\"});
+
+    SECTION("integers") {
+        auto ids = storage.select(&Letter::id, where(in(&Letter::id, as_array({1, 3, 5}))), order_by(&Letter::id));
+        REQUIRE(ids == std::vector<int>{1, 3});
+    }
+    SECTION("strings") {
+        auto ids =
+            storage.select(&Letter::id, where(in(&Letter::name, as_array({"B", "\"D\"\\"}))), order_by(&Letter::id));
+        REQUIRE(ids == std::vector<int>{2, 4});
+    }
+    SECTION("not in") {
+        auto ids = storage.select(&Letter::id, where(not_in(&Letter::id, as_array({1, 3}))), order_by(&Letter::id));
+        REQUIRE(ids == std::vector<int>{2, 4});
+    }
+    SECTION("empty") {
+        REQUIRE(storage.count<Letter>(where(in(&Letter::id, as_array(std::vector<int>{})))) == 0);
+    }
+    SECTION("followed by other parameters") {
+        auto ids = storage.select(&Letter::id,
+                                  where(in(&Letter::id, as_array({1, 2, 3})) and c(&Letter::name) != "B"),
+                                  order_by(&Letter::id));
+        REQUIRE(ids == std::vector<int>{1, 3});
+    }
+    SECTION("floating point") {
+        REQUIRE(storage.count<Letter>(where(in(&Letter::id, as_array({1.0, 2.5})))) == 1);
+#ifndef SQLITE_ORM_CARRAY_IN_SUPPORTED
+        //  not representable as JSON
+        REQUIRE_THROWS_AS(
+            storage.count<Letter>(where(in(&Letter::id, as_array({std::numeric_limits<double>::quiet_NaN()})))),
+            std::system_error);
+        REQUIRE_THROWS_AS(
+            storage.count<Letter>(where(in(&Letter::id, as_array({std::numeric_limits<double>::infinity()})))),
+            std::system_error);
+#endif
+    }
+    SECTION("same statement for any length") {
+        std::vector<int> ids;
+        for (int i = 0; i < 1000; ++i) {
+            ids.push_back(i);
+        }
+        storage.limit.variable_number(10);
+        REQUIRE(storage.count<Letter>(where(in(&Letter::id, as_array(ids)))) == 4);
+        auto statement = storage.prepare(get_all<Letter>(where(in(&Letter::id, as_array({2})))));
+        const auto sql = statement.sql();
+        REQUIRE(storage.execute(statement).size() == 1);
+        get<0>(statement) = as_array({1, 2, 3});
+        REQUIRE(statement.sql() == sql);
+        REQUIRE(storage.execute(statement).size() == 3);
+    }
+}
+#endif
@@ -207,3 +207,68 @@ TEST_CASE("application_id") {
     storage.pragma.application_id(3);
     REQUIRE(storage.pragma.application_id() == 3);
 }
+
+TEST_CASE("performance pragmas") {
+    auto storage = make_storage({});
+
+    storage.pragma.cache_size(-4096);
+    REQUIRE(storage.pragma.cache_size() == -4096);
+
+    storage.pragma.temp_store(temp_store::MEMORY);
+    REQUIRE(storage.pragma.temp_store() == temp_store::MEMORY);
+
+    storage.pragma.wal_autocheckpoint(500);
+    REQUIRE(storage.pragma.wal_autocheckpoint() == 500);
+
+    storage.pragma.page_size(8192);
+    REQUIRE(storage.pragma.page_size() == 8192);
+}
+
+TEST_CASE("pragma profile") {
+    auto filename = "pragma_profile.sqlite";
+    ::remove(filename);
+    auto storage = make_storage(filename);
+
+    SECTION("persists across reconnects") {
+        storage.pragma.cache_size(-4096);
+        storage.pragma.mmap_size(1024 * 1024);
+        storage.pragma.busy_timeout(250);
+        storage.pragma.synchronous(1);
+        //  the connection is closed in between
+        REQUIRE_FALSE(storage.is_opened());
+        REQUIRE(storage.pragma.cache_size() == -4096);
+        REQUIRE(storage.pragma.mmap_size() == 1024 * 1024);
+        REQUIRE(storage.pragma.busy_timeout() == 250);
+        REQUIRE(storage.pragma.synchronous() == 1);
+    }
+    SECTION("switching") {
+        storage.pragma.apply_profile(pragma_profile::bulk_load());
+        REQUIRE(storage.pragma.synchronous() == 0);
+        REQUIRE(storage.pragma.wal_autocheckpoint() == 0);
+        REQUIRE(storage.pragma.cache_size() == -256 * 1024);
+
+        storage.pragma.apply_profile(pragma_profile::low_memory().busy_timeout(100));
+        REQUIRE(storage.pragma.synchronous() == 2);
+        REQUIRE(storage.pragma.wal_autocheckpoint() == 1000);
+        REQUIRE(storage.pragma.cache_size() == -1024);
+        REQUIRE(storage.pragma.temp_store() == temp_store::FILE);
+        REQUIRE(storage.pragma.busy_timeout() == 100);
+        REQUIRE(storage.pragma.applied_profile().has(internal::profile_pragma::busy_timeout));
+    }
+    SECTION("reader connections") {
+        storage.open_forever();
+        storage.pragma.journal_mode(journal_mode::WAL);
+        storage.reader_pool_size(1);
+        storage.pragma.apply_profile(pragma_profile::read_heavy());
+        int readerCacheSize = 0;
+        storage.on_open = [&readerCacheSize](sqlite3* db) {
+            sqlite3_stmt* stmt = nullptr;
+            REQUIRE(sqlite3_prepare_v2(db, "PRAGMA cache_size", -1, &stmt, nullptr) == SQLITE_OK);
+            REQUIRE(sqlite3_step(stmt) == SQLITE_ROW);
+            readerCacheSize = sqlite3_column_int(stmt, 0);
+            sqlite3_finalize(stmt);
+        };
+        REQUIRE(storage.select(1).size() == 1);
+        REQUIRE(readerCacheSize == -64 * 1024);
+    }
+}
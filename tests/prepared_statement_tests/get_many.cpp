@@ -0,0 +1,90 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+
+#include "prepared_common.h"
+
+using namespace sqlite_orm;
+
+#ifdef SQLITE_ENABLE_JSON1
+TEST_CASE("Prepared get many") {
+    using namespace PreparedStatementTests;
+
+    auto filename = "prepared.sqlite";
+    remove(filename);
+    auto storage = make_storage(filename,
+                                make_table("users",
+                                           make_column("id", &User::id, primary_key().autoincrement()),
+                                           make_column("name", &User::name)),
+                                make_table("users_and_visits",
+                                           make_column("user_id", &UserAndVisit::userId),
+                                           make_column("visit_id", &UserAndVisit::visitId),
+                                           make_column("description", &UserAndVisit::description),
+                                           primary_key(&UserAndVisit::userId, &UserAndVisit::visitId)));
+    storage.sync_schema();
+
+    storage.replace(User{1, "Team BS"});
+    storage.replace(User{2, "Shy'm"});
+    storage.replace(User{3, "Maître Gims"});
+
+    storage.replace(UserAndVisit{2, 1, "Glad you came"});
+    storage.replace(UserAndVisit{3, 1, "Shine on"});
+
+    SECTION("input order") {
+        auto users = storage.get_many<User>(std::vector<int>{3, 1, 4, 3});
+        REQUIRE(users.size() == 4);
+        REQUIRE(users[0]);
+        REQUIRE(*users[0] == User{3, "Maître Gims"});
+        REQUIRE(users[1]);
+        REQUIRE(*users[1] == User{1, "Team BS"});
+        REQUIRE_FALSE(users[2]);
+        REQUIRE(users[3]);
+        REQUIRE(*users[3] == User{3, "Maître Gims"});
+    }
+    SECTION("empty") {
+        REQUIRE(storage.get_many<User>(std::vector<int>{}).empty());
+    }
+    SECTION("map") {
+        auto users = storage.get_many_map<User>(std::vector<int>{2, 5, 1});
+        REQUIRE(users.size() == 2);
+        REQUIRE(users.at(1) == User{1, "Team BS"});
+        REQUIRE(users.at(2) == User{2, "Shy'm"});
+        REQUIRE(users.count(5) == 0);
+    }
+    SECTION("composite primary key") {
+        using id_type = std::tuple<int, int>;
+        auto rows = storage.get_many<UserAndVisit>(std::vector<id_type>{{3, 1}, {1, 1}, {2, 1}});
+        REQUIRE(rows.size() == 3);
+        REQUIRE(rows[0]);
+        REQUIRE(rows[0]->description == "Shine on");
+        REQUIRE_FALSE(rows[1]);
+        REQUIRE(rows[2]);
+        REQUIRE(rows[2]->description == "Glad you came");
+
+        auto map = storage.get_many_map<UserAndVisit>(std::vector<id_type>{{2, 1}, {2, 2}});
+        REQUIRE(map.size() == 1);
+        REQUIRE(map.at(id_type{2, 1}).description == "Glad you came");
+    }
+    SECTION("wrong number of primary key values") {
+        REQUIRE_THROWS_WITH(storage.get_many<UserAndVisit>(std::vector<int>{2}),
+                            "Arguments count does not match");
+    }
+    SECTION("same statement for any number of ids") {
+        std::vector<int> ids;
+        for (int i = 0; i < 1000; ++i) {
+            ids.push_back(i);
+        }
+        storage.limit.variable_number(10);
+        auto statement = storage.prepare(get_many<User>(ids));
+        testSerializing(statement);
+        auto users = storage.execute(statement);
+        REQUIRE(users.size() == 1000);
+        REQUIRE(users[2]);
+        REQUIRE(*users[2] == User{2, "Shy'm"});
+
+        const auto sql = statement.sql();
+        statement.expression.ids = {1};
+        REQUIRE(statement.sql() == sql);
+        REQUIRE(storage.execute(statement).size() == 1);
+    }
+}
+#endif  //  SQLITE_ENABLE_JSON1
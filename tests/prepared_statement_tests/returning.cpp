@@ -0,0 +1,81 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+
+#include "prepared_common.h"
+
+#if SQLITE_VERSION_NUMBER >= 3035000
+using namespace sqlite_orm;
+
+TEST_CASE("Prepared returning") {
+    using namespace PreparedStatementTests;
+
+    const int defaultVisitTime = 50;
+
+    auto filename = "prepared.sqlite";
+    remove(filename);
+    auto storage = make_storage(filename,
+                                make_table("users",
+                                           make_column("id", &User::id, primary_key().autoincrement()),
+                                           make_column("name", &User::name)),
+                                make_table("visits",
+                                           make_column("id", &Visit::id, primary_key().autoincrement()),
+                                           make_column("user_id", &Visit::userId),
+                                           make_column("time", &Visit::time, default_value(defaultVisitTime))));
+    storage.sync_schema();
+
+    storage.replace(User{1, "Team BS"});
+    storage.replace(User{2, "Shy'm"});
+
+    SECTION("insert") {
+        auto statement = storage.prepare(returning(insert(User{0, "Maître Gims"}), &User::id));
+        REQUIRE(statement.sql() == R"(INSERT INTO "users" ("name") VALUES (?) RETURNING "id")");
+        REQUIRE(storage.execute(statement) == std::vector<int>{3});
+        REQUIRE(storage.get<User>(3) == User{3, "Maître Gims"});
+    }
+    SECTION("insert with default value") {
+        auto insertVisit = insert(into<Visit>(), columns(&Visit::userId), values(std::make_tuple(1)));
+        auto statement = storage.prepare(returning(insertVisit, columns(&Visit::id, &Visit::time)));
+        auto rows = storage.execute(statement);
+        REQUIRE(rows == std::vector<std::tuple<int, long>>{{1, defaultVisitTime}});
+    }
+    SECTION("insert range") {
+        std::vector<User> users = {User{0, "Lana"}, User{0, "Billie"}};
+        auto statement = storage.prepare(returning(insert_range(users.begin(), users.end()), &User::id));
+        REQUIRE(storage.execute(statement) == std::vector<int>{3, 4});
+    }
+    SECTION("replace") {
+        auto statement = storage.prepare(returning(replace(User{2, "Shy'm 2"}), columns(&User::id, &User::name)));
+        auto rows = storage.execute(statement);
+        REQUIRE(rows == std::vector<std::tuple<int, std::string>>{{2, "Shy'm 2"}});
+    }
+    SECTION("replace range") {
+        std::vector<User> users = {User{1, "Team BS 2"}, User{5, "Dua"}};
+        auto statement = storage.prepare(returning(replace_range(users.begin(), users.end()), &User::name));
+        REQUIRE(storage.execute(statement) == std::vector<std::string>{"Team BS 2", "Dua"});
+    }
+    SECTION("update all") {
+        auto statement = storage.prepare(returning(update_all(set(c(&User::name) = "Nobody"), where(c(&User::id) > 1)),
+                                                   columns(&User::id, &User::name)));
+        REQUIRE(statement.sql() ==
+                R"(UPDATE "users" SET "name" = ? WHERE ("users"."id" > ?) RETURNING "id", "name")");
+        auto rows = storage.execute(statement);
+        REQUIRE(rows == std::vector<std::tuple<int, std::string>>{{2, "Nobody"}});
+        REQUIRE(storage.get<User>(1).name == "Team BS");
+    }
+    SECTION("remove all") {
+        auto statement = storage.prepare(returning(remove_all<User>(where(c(&User::id) == 1)), &User::name));
+        REQUIRE(storage.execute(statement) == std::vector<std::string>{"Team BS"});
+        REQUIRE(storage.count<User>() == 1);
+    }
+    SECTION("bound values in returned columns") {
+        auto statement = storage.prepare(returning(remove_all<User>(where(c(&User::id) == 2)), c(&User::id) + 10));
+        REQUIRE(storage.execute(statement) == std::vector<double>{12});
+    }
+    SECTION("object") {
+        auto statement = storage.prepare(returning(insert(User{0, "Dua"}), object<User>()));
+        auto rows = storage.execute(statement);
+        REQUIRE(rows.size() == 1);
+        REQUIRE(rows[0] == User{3, "Dua"});
+    }
+}
+#endif
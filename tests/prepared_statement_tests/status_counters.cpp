@@ -0,0 +1,78 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+
+#include "prepared_common.h"
+
+using namespace sqlite_orm;
+
+TEST_CASE("Prepared statement status counters") {
+    using namespace PreparedStatementTests;
+
+    auto storage = make_storage({},
+                                make_index("idx_visits_time", &Visit::time),
+                                make_table("users",
+                                           make_column("id", &User::id, primary_key()),
+                                           make_column("name", &User::name)),
+                                make_table("visits",
+                                           make_column("id", &Visit::id, primary_key()),
+                                           make_column("user_id", &Visit::userId),
+                                           make_column("time", &Visit::time)));
+    storage.sync_schema();
+    for (int i = 1; i <= 10; ++i) {
+        storage.replace(User{i, "User " + std::to_string(i)});
+        storage.replace(Visit{i, i, 100 + i});
+    }
+
+    SECTION("full scan and sort") {
+        auto statement = storage.prepare(select(&User::id, where(c(&User::name) != "User 3"), order_by(&User::name)));
+        REQUIRE(storage.execute(statement).size() == 9);
+        REQUIRE(statement.fullscan_steps() > 0);
+        REQUIRE(statement.sort_operations() == 1);
+#ifdef SQLITE_STMTSTATUS_VM_STEP
+        REQUIRE(statement.vm_steps() > 0);
+        REQUIRE(statement.reprepares() == 0);
+        storage.execute(statement);
+        //  the second run completes when the statement is reset for the next execution
+        storage.execute(statement);
+        REQUIRE(statement.runs() >= 2);
+#endif
+
+        statement.reset_status_counters();
+        REQUIRE(statement.fullscan_steps() == 0);
+        REQUIRE(statement.sort_operations() == 0);
+#ifdef SQLITE_STMTSTATUS_VM_STEP
+        REQUIRE(statement.vm_steps() == 0);
+        REQUIRE(statement.runs() == 0);
+#endif
+#ifdef SQLITE_STMTSTATUS_FILTER_HIT
+        REQUIRE(statement.filter_hits() == 0);
+        REQUIRE(statement.filter_misses() == 0);
+#endif
+    }
+    SECTION("index lookup") {
+        auto statement = storage.prepare(select(&Visit::id, where(c(&Visit::time) == 105), order_by(&Visit::time)));
+        REQUIRE(storage.execute(statement) == std::vector<int>{5});
+        REQUIRE(statement.fullscan_steps() == 0);
+        REQUIRE(statement.sort_operations() == 0);
+    }
+    SECTION("automatic index") {
+        //  neither column of the join condition is indexed
+        auto statement = storage.prepare(
+            select(columns(&User::id, &Visit::id), from<User>(), join<Visit>(on(c(&Visit::userId) == &User::name))));
+        REQUIRE(storage.execute(statement).empty());
+        REQUIRE(statement.autoindex_rows() > 0);
+    }
+#ifdef SQLITE_ENABLE_STMT_SCANSTATUS
+    SECTION("scan status") {
+        auto statement = storage.prepare(select(&User::id, where(c(&User::name) == "User 3")));
+        storage.execute(statement);
+        auto statuses = statement.scan_statuses();
+        REQUIRE(statuses.size() == 1);
+        REQUIRE(statuses[0].loops == 1);
+        REQUIRE(statuses[0].rows_visited == 10);
+        REQUIRE(statuses[0].name == "users");
+        statement.reset_scan_statuses();
+        REQUIRE(statement.scan_statuses()[0].loops == 0);
+    }
+#endif
+}
@@ -0,0 +1,142 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <vector>  //  std::vector
+#include <string>  //  std::string
+
+using namespace sqlite_orm;
+
+namespace {
+    struct User {
+        int id = 0;
+        std::string name;
+        std::string email;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        User() = default;
+        User(int id, std::string name, std::string email) :
+            id{id}, name{std::move(name)}, email{std::move(email)} {}
+#endif
+    };
+
+    auto makeStorage() {
+        return make_storage({},
+                            make_unique_index("idx_users_email", &User::email),
+                            make_table("users",
+                                       make_column("id", &User::id, primary_key()),
+                                       make_column("name", &User::name),
+                                       make_column("email", &User::email)));
+    }
+}
+
+TEST_CASE("query plan node") {
+    using internal::make_query_plan_node;
+
+    SECTION("scan") {
+        auto node = make_query_plan_node(2, 0, "SCAN users");
+        REQUIRE(node.id == 2);
+        REQUIRE(node.parent == 0);
+        REQUIRE(node.is_scan());
+        REQUIRE(node.table == "users");
+        REQUIRE(node.index.empty());
+    }
+    SECTION("legacy scan with alias") {
+        auto node = make_query_plan_node(2, 0, "SCAN TABLE users AS u");
+        REQUIRE(node.is_scan());
+        REQUIRE(node.table == "users");
+    }
+    SECTION("covering index") {
+        auto node = make_query_plan_node(3, 0, "SEARCH visits USING COVERING INDEX idx_visits (user_id=?)");
+        REQUIRE(node.is_search());
+        REQUIRE(node.table == "visits");
+        REQUIRE(node.index == "idx_visits");
+        REQUIRE(node.covering_index);
+        REQUIRE_FALSE(node.automatic_index);
+    }
+    SECTION("automatic index") {
+        auto node = make_query_plan_node(3, 0, "SEARCH visits USING AUTOMATIC COVERING INDEX (user_id=?)");
+        REQUIRE(node.automatic_index);
+        REQUIRE(node.covering_index);
+        REQUIRE(node.index.empty());
+    }
+    SECTION("primary key") {
+        auto node = make_query_plan_node(3, 0, "SEARCH TABLE users USING INTEGER PRIMARY KEY (rowid=?)");
+        REQUIRE(node.is_search());
+        REQUIRE(node.primary_key);
+    }
+    SECTION("virtual table") {
+        auto node = make_query_plan_node(3, 0, "SCAN json_each VIRTUAL TABLE INDEX 1:");
+        REQUIRE(node.virtual_table);
+        REQUIRE(node.table == "json_each");
+    }
+    SECTION("other") {
+        auto node = make_query_plan_node(7, 2, "USE TEMP B-TREE FOR ORDER BY");
+        REQUIRE(node.operation == query_plan_operation::other);
+        REQUIRE(node.table.empty());
+        REQUIRE(make_query_plan_node(2, 0, "SCAN CONSTANT ROW").table.empty());
+    }
+}
+
+TEST_CASE("explain") {
+    auto storage = makeStorage();
+    storage.sync_schema();
+
+    SECTION("search by index") {
+        auto plan = storage.explain(get_all<User>(where(c(&User::email) == "tom@example.com")));
+        REQUIRE(plan.size() == 1);
+        REQUIRE(plan[0].is_search());
+        REQUIRE(plan[0].table == "users");
+        REQUIRE(plan[0].index == "idx_users_email");
+    }
+    SECTION("search by primary key") {
+        auto plan = storage.explain(select(&User::name, where(c(&User::id) == 1)));
+        REQUIRE(plan.size() == 1);
+        REQUIRE(plan[0].primary_key);
+    }
+    SECTION("scan and sort") {
+        auto statement = storage.prepare(select(&User::id, where(c(&User::name) != "Tom"), order_by(&User::name)));
+        auto plan = storage.explain(statement);
+        REQUIRE(plan.size() == 2);
+        REQUIRE(plan[0].is_scan());
+        REQUIRE(plan[0].table == "users");
+        REQUIRE(plan[1].operation == query_plan_operation::other);
+    }
+}
+
+TEST_CASE("check full scans") {
+    auto storage = makeStorage();
+    storage.sync_schema();
+    for (int i = 1; i <= 10; ++i) {
+        storage.replace(User{i, "User", "user" + std::to_string(i) + "@example.com"});
+    }
+    auto scan = where(c(&User::name) == "User");
+
+    SECTION("throws") {
+        storage.check_full_scans(10);
+        REQUIRE_THROWS_MATCHES(storage.get_all<User>(scan),
+                               std::system_error,
+                               Catch::Matchers::Predicate<std::system_error>([](const std::system_error& error) {
+                                   return error.code() == orm_error_code::full_table_scan;
+                               }));
+        REQUIRE_THROWS_AS(storage.prepare(select(&User::id, scan)), std::system_error);
+        //  searches are fine
+        REQUIRE(storage.get_all<User>(where(c(&User::email) == "user1@example.com")).size() == 1);
+        REQUIRE(storage.get<User>(1).id == 1);
+    }
+    SECTION("small tables are ignored") {
+        storage.check_full_scans(11);
+        REQUIRE(storage.get_all<User>(scan).size() == 10);
+    }
+    SECTION("callback") {
+        std::vector<std::string> scannedTables;
+        storage.check_full_scans(1, [&scannedTables](const std::string&, const query_plan_node& node) {
+            scannedTables.push_back(node.table);
+        });
+        REQUIRE(storage.get_all<User>(scan).size() == 10);
+        REQUIRE(scannedTables == std::vector<std::string>{"users"});
+    }
+    SECTION("disabled") {
+        storage.check_full_scans(1);
+        storage.disable_full_scan_check();
+        REQUIRE(storage.get_all<User>(scan).size() == 10);
+    }
+}
@@ -0,0 +1,142 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+#include <thread>  //  std::thread
+#include <vector>  //  std::vector
+#include <atomic>  //  std::atomic_int
+#include <algorithm>  //  std::transform
+#include <cctype>  //  std::toupper
+
+#include "user_storage.h"
+
+using namespace sqlite_orm;
+using namespace UserStorageTests;
+
+namespace {
+    struct UpperFunction {
+        std::string operator()(const std::string& arg) const {
+            std::string res = arg;
+            std::transform(res.begin(), res.end(), res.begin(), [](unsigned char c) {
+                return char(std::toupper(c));
+            });
+            return res;
+        }
+
+        static const char* name() {
+            return "MY_UPPER";
+        }
+    };
+}
+
+TEST_CASE("reader pool") {
+    const std::string filename = "reader_pool.sqlite";
+    ::remove(filename.c_str());
+    auto storage = makeStorage(filename);
+    storage.open_forever();
+    storage.pragma.journal_mode(journal_mode::WAL);
+    storage.sync_schema();
+    storage.replace(User{1, "Lana"});
+    storage.replace(User{2, "Billie"});
+
+    REQUIRE(storage.reader_pool_size() == 0);
+    storage.reader_pool_size(2);
+    REQUIRE(storage.reader_pool_size() == 2);
+
+    SECTION("reads") {
+        int openedReaders = 0;
+        storage.on_open = [&openedReaders](sqlite3* db) {
+            REQUIRE(sqlite3_db_readonly(db, "main") == 1);
+            ++openedReaders;
+        };
+        REQUIRE(storage.count<User>() == 2);
+        REQUIRE(openedReaders == 1);
+        REQUIRE(storage.get<User>(2).name == "Billie");
+        REQUIRE(storage.get_pointer<User>(3) == nullptr);
+        REQUIRE(storage.get_all<User>(order_by(&User::id)).size() == 2);
+        REQUIRE(storage.select(&User::name, where(c(&User::id) == 1)) == std::vector<std::string>{"Lana"});
+        //  sequential reads reuse the idle reader
+        REQUIRE(openedReaders == 1);
+    }
+    SECTION("reads see committed writes") {
+        REQUIRE(storage.count<User>() == 2);
+        storage.replace(User{3, "Dua"});
+        REQUIRE(storage.count<User>() == 3);
+        storage.remove<User>(1);
+        REQUIRE(storage.get_pointer<User>(1) == nullptr);
+    }
+    SECTION("reads inside a transaction see its changes") {
+        storage.begin_transaction();
+        storage.replace(User{3, "Dua"});
+        REQUIRE(storage.count<User>() == 3);
+        storage.rollback();
+        REQUIRE(storage.count<User>() == 2);
+    }
+    SECTION("other threads don't see a transaction's changes") {
+        storage.begin_transaction();
+        storage.replace(User{3, "Dua"});
+        int otherCount = 0;
+        std::thread other{[&storage, &otherCount] {
+            otherCount = storage.count<User>();
+        }};
+        other.join();
+        REQUIRE(otherCount == 2);
+        REQUIRE(storage.count<User>() == 3);
+        storage.commit();
+        REQUIRE(storage.count<User>() == 3);
+    }
+    SECTION("writes go to the writer") {
+        REQUIRE(storage.count<User>() == 2);
+        storage.update(User{1, "Lana Del Rey"});
+        REQUIRE(storage.get<User>(1).name == "Lana Del Rey");
+    }
+    SECTION("functions") {
+        storage.create_scalar_function<UpperFunction>();
+        REQUIRE(storage.select(func<UpperFunction>(&User::name), where(c(&User::id) == 1)) ==
+                std::vector<std::string>{"LANA"});
+        storage.delete_scalar_function<UpperFunction>();
+        REQUIRE_THROWS(storage.select(func<UpperFunction>(&User::name)));
+
+        //  registered while readers are opened
+        storage.create_scalar_function<UpperFunction>();
+        REQUIRE(storage.select(func<UpperFunction>(&User::name), where(c(&User::id) == 2)) ==
+                std::vector<std::string>{"BILLIE"});
+    }
+    SECTION("concurrent readers") {
+        std::atomic_int failures{0};
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i) {
+            threads.emplace_back([&storage, &failures] {
+                for (int j = 0; j < 50; ++j) {
+                    if (storage.count<User>() != 2 || storage.get<User>(1).name != "Lana") {
+                        ++failures;
+                    }
+                }
+            });
+        }
+        for (auto& thread: threads) {
+            thread.join();
+        }
+        REQUIRE(failures == 0);
+    }
+    SECTION("schema changes finalize cached reader statements") {
+        REQUIRE(storage.count<User>() == 2);
+        //  `replace` on the writer and `count` on a reader
+        REQUIRE(storage.statement_cache_stats().size == 2);
+        storage.drop_table("users");
+        REQUIRE(storage.statement_cache_stats().size == 0);
+    }
+    SECTION("disable") {
+        REQUIRE(storage.count<User>() == 2);
+        storage.reader_pool_size(0);
+        REQUIRE(storage.count<User>() == 2);
+    }
+}
+
+TEST_CASE("reader pool in-memory") {
+    auto storage = makeStorage("");
+    storage.reader_pool_size(2);
+    REQUIRE(storage.reader_pool_size() == 0);
+    storage.sync_schema();
+    storage.replace(User{1, "Lana"});
+    REQUIRE(storage.count<User>() == 1);
+}
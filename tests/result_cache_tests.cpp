@@ -0,0 +1,160 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+#include <string>  //  std::string
+#include <vector>  //  std::vector
+#include <tuple>  //  std::get
+
+using namespace sqlite_orm;
+
+namespace {
+    struct Order {
+        int id = 0;
+        int customerId = 0;
+        double amount = 0;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Order() = default;
+        Order(int id, int customerId, double amount) : id{id}, customerId{customerId}, amount{amount} {}
+#endif
+    };
+
+    struct Customer {
+        int id = 0;
+        std::string name;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Customer() = default;
+        Customer(int id, std::string name) : id{id}, name{std::move(name)} {}
+#endif
+    };
+
+    auto makeStorage(const std::string& filename) {
+        return make_storage(filename,
+                            make_table("orders",
+                                       make_column("id", &Order::id, primary_key()),
+                                       make_column("customer_id", &Order::customerId),
+                                       make_column("amount", &Order::amount)),
+                            make_table("customers",
+                                       make_column("id", &Customer::id, primary_key()),
+                                       make_column("name", &Customer::name)));
+    }
+}
+
+TEST_CASE("result cache") {
+    const std::string filename = "result_cache.sqlite";
+    ::remove(filename.c_str());
+    auto storage = makeStorage(filename);
+    storage.sync_schema();
+    storage.replace(Order{1, 1, 10});
+    storage.replace(Order{2, 1, 5});
+    storage.replace(Order{3, 2, 7});
+    storage.replace(Customer{1, "Bebe"});
+    storage.enable_result_cache();
+
+    auto totalOf = [&storage](int customerId) {
+        return storage.select(total(&Order::amount), where(c(&Order::customerId) == customerId)).front();
+    };
+
+    SECTION("hits") {
+        REQUIRE(totalOf(1) == 15);
+        REQUIRE(totalOf(1) == 15);
+        REQUIRE(totalOf(2) == 7);
+        REQUIRE(storage.get_all<Order>(where(c(&Order::amount) > 6)).size() == 2);
+        REQUIRE(storage.get_all<Order>(where(c(&Order::amount) > 6)).size() == 2);
+        auto stats = storage.get_result_cache_stats();
+        REQUIRE(stats.hits == 2);
+        REQUIRE(stats.misses == 3);
+        REQUIRE(stats.entries == 3);
+    }
+    SECTION("results of different types don't mix") {
+        REQUIRE(storage.select(&Order::id, where(c(&Order::id) == 1)) == std::vector<int>{1});
+        auto rows = storage.select(columns(&Order::id), where(c(&Order::id) == 1));
+        REQUIRE(rows.size() == 1);
+        REQUIRE(std::get<0>(rows[0]) == 1);
+        REQUIRE(storage.get_result_cache_stats().hits == 0);
+    }
+    SECTION("invalidated by writes to dependencies") {
+        REQUIRE(totalOf(1) == 15);
+        storage.replace(Customer{2, "Dua"});
+        REQUIRE(totalOf(1) == 15);
+        REQUIRE(storage.get_result_cache_stats().hits == 1);
+        storage.insert(Order{0, 1, 1});
+        REQUIRE(totalOf(1) == 16);
+        storage.update_all(set(c(&Order::amount) = 2), where(c(&Order::id) == 1));
+        REQUIRE(totalOf(1) == 8);
+        storage.transaction([&storage] {
+            storage.remove<Order>(2);
+            return true;
+        });
+        REQUIRE(totalOf(1) == 3);
+        storage.remove_all<Order>();
+        REQUIRE(totalOf(1) == 0);
+    }
+    SECTION("invalidated by other connections") {
+        REQUIRE(totalOf(1) == 15);
+        auto other = makeStorage(filename);
+        other.remove<Order>(1);
+        REQUIRE(totalOf(1) == 5);
+    }
+    SECTION("bound values are keyed exactly") {
+        storage.replace(Order{4, 3, 1});
+        REQUIRE(storage.count<Order>(where(c(&Order::amount) > 0.99999999999999989)) == 4);
+        REQUIRE(storage.count<Order>(where(c(&Order::amount) > 1.0)) == 3);
+        REQUIRE(storage.count<Order>(where(c(&Order::amount) == 1)) == 1);
+        REQUIRE(storage.get_result_cache_stats().hits == 0);
+    }
+    SECTION("cleared when the database is replaced") {
+        auto other = makeStorage("");
+        other.sync_schema();
+        other.replace(Order{1, 1, 1});
+        REQUIRE(totalOf(1) == 15);
+        storage.backup_from(other);
+        REQUIRE(totalOf(1) == 1);
+#if SQLITE_VERSION_NUMBER >= 3036000 || defined(SQLITE_ENABLE_DESERIALIZE)
+#ifndef SQLITE_OMIT_DESERIALIZE
+        other.replace(Order{2, 1, 2});
+        storage.open_forever();
+        storage.deserialize_database(other.serialize_database());
+        REQUIRE(totalOf(1) == 3);
+#endif
+#endif
+    }
+    SECTION("data version statement is cached") {
+        REQUIRE(totalOf(1) == 15);
+        const auto before = storage.statement_cache_stats();
+        REQUIRE(totalOf(1) == 15);
+        REQUIRE(totalOf(1) == 15);
+        const auto after = storage.statement_cache_stats();
+        REQUIRE(after.misses == before.misses);
+        //  the query's statement and the one checking the data version
+        REQUIRE(after.hits - before.hits == 4);
+    }
+    SECTION("not used in transactions") {
+        REQUIRE(totalOf(1) == 15);
+        storage.transaction([&storage, &totalOf] {
+            storage.remove<Order>(1);
+            REQUIRE(totalOf(1) == 5);
+            return false;
+        });
+        REQUIRE(totalOf(1) == 15);
+    }
+    SECTION("bounded") {
+        result_cache_options options;
+        options.max_entries = 1;
+        storage.enable_result_cache(options);
+        totalOf(1);
+        totalOf(2);
+        totalOf(1);
+        auto stats = storage.get_result_cache_stats();
+        REQUIRE(stats.entries == 1);
+        REQUIRE(stats.evictions == 2);
+        REQUIRE(stats.hits == 0);
+    }
+    SECTION("disabled") {
+        storage.disable_result_cache();
+        totalOf(1);
+        totalOf(1);
+        REQUIRE(storage.get_result_cache_stats().hits == 0);
+    }
+}
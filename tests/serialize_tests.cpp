@@ -0,0 +1,77 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+#include <vector>  //  std::vector
+
+#include "user_storage.h"
+
+using namespace sqlite_orm;
+using namespace UserStorageTests;
+
+#if SQLITE_VERSION_NUMBER >= 3036000 || defined(SQLITE_ENABLE_DESERIALIZE)
+#ifndef SQLITE_OMIT_DESERIALIZE
+TEST_CASE("serialize") {
+    auto source = makeStorage("");
+    source.sync_schema();
+    source.replace(User{1, "Tom"});
+    source.replace(User{2, "Bob"});
+
+    const std::vector<unsigned char> image = source.serialize_database();
+    //  the image is a database file
+    REQUIRE(image.size() >= 16);
+    REQUIRE(std::string(image.begin(), image.begin() + 15) == "SQLite format 3");
+
+    auto clone = makeStorage("");
+    SECTION("writable copy") {
+        clone.deserialize_database(image);
+        REQUIRE(clone.count<User>() == 2);
+        clone.replace(User{3, "Jim"});
+        REQUIRE(clone.count<User>() == 3);
+        //  the source is independent of its clone
+        REQUIRE(source.count<User>() == 2);
+        REQUIRE(clone.serialize_database().size() >= image.size());
+    }
+    SECTION("read-only without copying") {
+        clone.deserialize_database(image.data(), image.size(), true, false);
+        REQUIRE(clone.get<User>(2).name == "Bob");
+        REQUIRE_THROWS_AS(clone.replace(User{3, "Jim"}), std::system_error);
+    }
+    SECTION("read-only copy") {
+        clone.deserialize_database(image, true);
+        REQUIRE(clone.count<User>() == 2);
+        REQUIRE_THROWS_AS(clone.remove<User>(1), std::system_error);
+    }
+    SECTION("replaces the previous image") {
+        clone.sync_schema();
+        clone.replace(User{7, "Zoe"});
+        REQUIRE(clone.get_all<User>().size() == 1);
+        clone.deserialize_database(image);
+        REQUIRE_FALSE(clone.get_pointer<User>(7));
+        REQUIRE(clone.get<User>(1).name == "Tom");
+    }
+    SECTION("file database") {
+        const std::string filename = "serialize.sqlite";
+        ::remove(filename.c_str());
+        auto fileStorage = makeStorage(filename);
+        fileStorage.sync_schema();
+        fileStorage.replace(User{5, "Ann"});
+        auto fileImage = fileStorage.serialize_database();
+        clone.deserialize_database(fileImage);
+        REQUIRE(clone.get<User>(5).name == "Ann");
+
+        //  the connection and the image with it would be closed right away
+        REQUIRE_THROWS_AS(fileStorage.deserialize_database(image), std::system_error);
+        REQUIRE(fileStorage.get<User>(5).name == "Ann");
+
+        //  pooled readers would read the file rather than the image
+        fileStorage.open_forever();
+        fileStorage.reader_pool_size(1);
+        REQUIRE_THROWS_AS(fileStorage.deserialize_database(image), std::system_error);
+        REQUIRE(fileStorage.get<User>(5).name == "Ann");
+        fileStorage.reader_pool_size(0);
+        fileStorage.deserialize_database(image);
+        REQUIRE(fileStorage.get<User>(1).name == "Tom");
+    }
+}
+#endif
+#endif
@@ -0,0 +1,113 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+
+#include "user_storage.h"
+
+using namespace sqlite_orm;
+using namespace UserStorageTests;
+
+TEST_CASE("statement cache") {
+    auto storage = makeStorage("");
+    storage.sync_schema();
+    storage.replace(User{1, "Bebe Rexha"});
+    storage.replace(User{2, "Zara Larsson"});
+
+    SECTION("default capacity") {
+        REQUIRE(storage.statement_cache_capacity() > 0);
+    }
+    SECTION("hits and misses") {
+        storage.clear_statement_cache();
+        const auto statsBefore = storage.statement_cache_stats();
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(storage.get<User>(1) == User{1, "Bebe Rexha"});
+        }
+        const auto statsAfter = storage.statement_cache_stats();
+        REQUIRE(statsAfter.misses - statsBefore.misses == 1);
+        REQUIRE(statsAfter.hits - statsBefore.hits == 2);
+        REQUIRE(statsAfter.size == 1);
+    }
+    SECTION("rebinds values") {
+        REQUIRE(storage.get<User>(1) == User{1, "Bebe Rexha"});
+        REQUIRE(storage.get<User>(2) == User{2, "Zara Larsson"});
+        REQUIRE_FALSE(storage.get_pointer<User>(3));
+        storage.update(User{2, "Ava Max"});
+        REQUIRE(storage.get<User>(2) == User{2, "Ava Max"});
+        storage.remove<User>(1);
+        REQUIRE(storage.count<User>() == 1);
+        REQUIRE(storage.get_all<User>() == std::vector<User>{User{2, "Ava Max"}});
+    }
+    SECTION("expression type is part of the key") {
+        storage.clear_statement_cache();
+        storage.get<User>(1);
+        storage.get_pointer<User>(1);
+        REQUIRE(storage.statement_cache_stats().size == 2);
+    }
+    SECTION("LRU eviction") {
+        storage.clear_statement_cache();
+        storage.statement_cache_capacity(2);
+        storage.get<User>(1);
+        storage.get_all<User>();
+        storage.count<User>();
+        auto stats = storage.statement_cache_stats();
+        REQUIRE(stats.size == 2);
+        REQUIRE(stats.evictions == 1);
+
+        //  `get` was the least recently used one
+        const auto missesBefore = stats.misses;
+        storage.get_all<User>();
+        REQUIRE(storage.statement_cache_stats().misses == missesBefore);
+        storage.get<User>(1);
+        REQUIRE(storage.statement_cache_stats().misses == missesBefore + 1);
+    }
+    SECTION("disabled") {
+        storage.statement_cache_capacity(0);
+        const auto hitsBefore = storage.statement_cache_stats().hits;
+        storage.get<User>(1);
+        storage.get<User>(1);
+        REQUIRE(storage.statement_cache_stats().size == 0);
+        REQUIRE(storage.statement_cache_stats().hits == hitsBefore);
+    }
+    SECTION("drop_table invalidates") {
+        storage.get<User>(1);
+        REQUIRE(storage.statement_cache_stats().size > 0);
+        storage.drop_table("users");
+        REQUIRE(storage.statement_cache_stats().size == 0);
+    }
+    SECTION("sync_schema invalidates") {
+        storage.get<User>(1);
+        REQUIRE(storage.statement_cache_stats().size > 0);
+        storage.sync_schema();
+        REQUIRE(storage.statement_cache_stats().size == 0);
+        REQUIRE(storage.get<User>(1) == User{1, "Bebe Rexha"});
+    }
+}
+
+TEST_CASE("statement cache and reconnect") {
+    const std::string filename = "statement_cache.sqlite";
+    ::remove(filename.c_str());
+    auto storage = makeStorage(filename);
+    storage.sync_schema();
+    storage.replace(User{1, "Sharon"});
+
+    //  the connection gets closed after every call, which finalizes cached statements
+    REQUIRE(storage.get<User>(1) == User{1, "Sharon"});
+    REQUIRE_FALSE(storage.is_opened());
+    REQUIRE(storage.statement_cache_stats().size == 0);
+
+    SECTION("open forever") {
+        storage.open_forever();
+        const auto statsBefore = storage.statement_cache_stats();
+        REQUIRE(storage.get<User>(1) == User{1, "Sharon"});
+        REQUIRE(storage.get<User>(1) == User{1, "Sharon"});
+        REQUIRE(storage.statement_cache_stats().hits - statsBefore.hits == 1);
+    }
+    SECTION("transaction") {
+        storage.transaction([&storage] {
+            storage.replace(User{2, "Maitre"});
+            storage.replace(User{3, "Rita"});
+            return true;
+        });
+        REQUIRE(storage.count<User>() == 3);
+    }
+}
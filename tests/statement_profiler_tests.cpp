@@ -0,0 +1,77 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+#include <algorithm>  //  std::find_if
+#include <numeric>  //  std::accumulate
+
+#include "user_storage.h"
+
+using namespace sqlite_orm;
+using namespace UserStorageTests;
+
+#if SQLITE_VERSION_NUMBER >= 3014000
+namespace {
+    const statement_profile* findProfile(const std::vector<statement_profile>& profiles, const std::string& prefix) {
+        auto it = std::find_if(profiles.begin(), profiles.end(), [&prefix](const statement_profile& profile) {
+            return profile.sql.compare(0, prefix.size(), prefix) == 0;
+        });
+        return it != profiles.end() ? &*it : nullptr;
+    }
+}
+
+TEST_CASE("statement profiler") {
+    const std::string filename = "statement_profiler.sqlite";
+    ::remove(filename.c_str());
+    auto storage = makeStorage(filename);
+    storage.sync_schema();
+    storage.replace(User{1, "Tom"});
+    storage.replace(User{2, "Bob"});
+    REQUIRE_FALSE(storage.profile_statements());
+
+    SECTION("disabled") {
+        storage.get_all<User>();
+        REQUIRE(storage.statement_profiles().empty());
+    }
+    SECTION("enabled") {
+        storage.profile_statements(true);
+        REQUIRE(storage.profile_statements());
+        for (int i = 0; i < 3; ++i) {
+            storage.get_all<User>();
+        }
+        storage.get<User>(1);
+
+        auto profiles = storage.statement_profiles();
+        auto getAll = findProfile(profiles, R"(SELECT "users"."id", "users"."name" FROM "users")");
+        REQUIRE(getAll);
+        REQUIRE(getAll->count >= 3);
+        REQUIRE(getAll->rows >= 6);
+        REQUIRE(getAll->p50 <= getAll->p99);
+        REQUIRE(getAll->p99 <= getAll->max_time);
+        REQUIRE(getAll->max_time <= getAll->total_time);
+        REQUIRE(std::accumulate(getAll->histogram.begin(), getAll->histogram.end(), size_t(0)) == getAll->count);
+        for (size_t i = 1; i < profiles.size(); ++i) {
+            REQUIRE(profiles[i - 1].total_time >= profiles[i].total_time);
+        }
+
+        SECTION("survives reconnects") {
+            //  the connection is closed after every call of a storage that isn't opened forever
+            storage.clear_statement_profiles();
+            REQUIRE(storage.statement_profiles().empty());
+            storage.get_all<User>();
+            storage.get_all<User>();
+            profiles = storage.statement_profiles();
+            getAll = findProfile(profiles, R"(SELECT "users"."id", "users"."name" FROM "users")");
+            REQUIRE(getAll);
+            REQUIRE(getAll->count == 2);
+            REQUIRE(getAll->rows == 4);
+        }
+        SECTION("disabling") {
+            storage.open_forever();
+            storage.profile_statements(false);
+            storage.clear_statement_profiles();
+            storage.get_all<User>();
+            REQUIRE(storage.statement_profiles().empty());
+        }
+    }
+}
+#endif
@@ -110,6 +110,29 @@ TEST_CASE("statement_serializer logical operators") {
             stringValue = internal::serialize(inValue, context);
             expected = R"("id" NOT IN (1, 2, 3))";
         }
+#ifdef SQLITE_ORM_AS_ARRAY_SUPPORTED
+        SECTION("array in") {
+            SECTION("literal") {
+                auto inValue = in(&User::name, as_array({"a", "b\"c"}));
+                stringValue = internal::serialize(inValue, context);
+#ifdef SQLITE_ENABLE_JSON1
+                expected = R"("name" IN (SELECT value FROM json_each('["a","b\"c"]')))";
+#else
+                expected = R"("name" IN ('a', 'b"c'))";
+#endif
+            }
+            SECTION("bound") {
+                context.replace_bindable_with_question = true;
+                auto inValue = not_in(&User::id, as_array({1, 2, 3}));
+                stringValue = internal::serialize(inValue, context);
+#ifdef SQLITE_ORM_CARRAY_IN_SUPPORTED
+                expected = R"("id" NOT IN carray(?, ?, 'int64'))";
+#else
+                expected = R"("id" NOT IN (SELECT value FROM json_each(?)))";
+#endif
+            }
+        }
+#endif
     }
     SECTION("parentheses keeping order of precedence") {
         SECTION("1") {
@@ -121,6 +121,101 @@ TEST_CASE("update set null") {
     }
 }
 
+TEST_CASE("update columns") {
+    struct User {
+        int id = 0;
+        std::string name;
+        int age = 0;
+        std::unique_ptr<std::string> bio;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        User() = default;
+        User(int id, std::string name, int age, decltype(bio) bio) :
+            id{id}, name{std::move(name)}, age{age}, bio{std::move(bio)} {}
+#endif
+    };
+    auto storage = make_storage({},
+                                make_table("users",
+                                           make_column("id", &User::id, primary_key()),
+                                           make_column("name", &User::name),
+                                           make_column("age", &User::age),
+                                           make_column("bio", &User::bio)));
+    storage.sync_schema();
+    storage.replace(User{1, "Tom", 30, std::make_unique<std::string>("cat")});
+
+    SECTION("explicit members") {
+        auto user = storage.get<User>(1);
+        user.name = "Thomas";
+        user.age = 31;
+        storage.update(user, &User::name);
+        auto row = storage.get<User>(1);
+        REQUIRE(row.name == "Thomas");
+        REQUIRE(row.age == 30);
+
+        storage.update(user, &User::age, &User::name);
+        REQUIRE(storage.get<User>(1).age == 31);
+
+        const auto cacheSize = storage.statement_cache_stats().size;
+        const auto hitsBefore = storage.statement_cache_stats().hits;
+        storage.update(user, &User::name);
+        REQUIRE(storage.statement_cache_stats().size == cacheSize);
+        REQUIRE(storage.statement_cache_stats().hits == hitsBefore + 1);
+    }
+    SECTION("only key members") {
+        auto user = storage.get<User>(1);
+        REQUIRE_THROWS_WITH(storage.update(user, &User::id), "Incorrect set fields specified");
+        storage.update(user, &User::id, &User::age);
+    }
+    SECTION("changed fields") {
+        const auto original = storage.get<User>(1);
+        auto user = storage.get<User>(1);
+        REQUIRE_FALSE(storage.update_changed(original, user));
+
+        //  a concurrent change of another column is kept
+        storage.update_all(set(c(&User::age) = 40), where(c(&User::id) == 1));
+        user.name = "Thomas";
+        *user.bio = "dog";
+        REQUIRE(storage.update_changed(original, user));
+        auto row = storage.get<User>(1);
+        REQUIRE(row.name == "Thomas");
+        REQUIRE(row.age == 40);
+        REQUIRE(*row.bio == "dog");
+
+        //  pointers are compared by their values
+        auto copy = storage.get<User>(1);
+        REQUIRE_FALSE(storage.update_changed(row, copy));
+        copy.bio.reset();
+        REQUIRE(storage.update_changed(row, copy));
+        REQUIRE_FALSE(storage.get<User>(1).bio);
+    }
+    SECTION("changed composite key") {
+        struct Membership {
+            int userId = 0;
+            int groupId = 0;
+            std::string role;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+            Membership() = default;
+            Membership(int userId, int groupId, std::string role) :
+                userId{userId}, groupId{groupId}, role{std::move(role)} {}
+#endif
+        };
+        auto storage = make_storage({},
+                                    make_table("memberships",
+                                               make_column("user_id", &Membership::userId),
+                                               make_column("group_id", &Membership::groupId),
+                                               make_column("role", &Membership::role),
+                                               primary_key(&Membership::userId, &Membership::groupId)));
+        storage.sync_schema();
+        storage.replace(Membership{1, 2, "owner"});
+
+        //  key columns identify the row and aren't set
+        REQUIRE_FALSE(storage.update_changed(Membership{1, 2, "owner"}, Membership{1, 3, "owner"}));
+        REQUIRE(storage.update_changed(Membership{1, 2, "owner"}, Membership{1, 2, "member"}));
+        REQUIRE(storage.get<Membership>(1, 2).role == "member");
+    }
+}
+
 TEST_CASE("InsertRange") {
     struct Object {
         int id;
@@ -199,6 +294,68 @@ TEST_CASE("InsertRange") {
     }
 }
 
+TEST_CASE("InsertRange and ReplaceRange in chunks") {
+    struct Object {
+        int id = 0;
+        std::string name;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Object() = default;
+        Object(int id, std::string name) : id{id}, name{std::move(name)} {}
+#endif
+    };
+
+    auto storage = make_storage("",
+                                make_table("objects",
+                                           make_column("id", &Object::id, primary_key()),
+                                           make_column("name", &Object::name, unique())));
+    storage.sync_schema();
+    //  5 objects per chunk for insert_range (name only), 2 objects per chunk for replace_range (id and name)
+    storage.limit.variable_number(5);
+
+    std::vector<Object> objects;
+    for (int i = 1; i <= 12; ++i) {
+        objects.push_back(Object{i, "name" + std::to_string(i)});
+    }
+
+    SECTION("insert_range") {
+        storage.insert_range(objects.begin(), objects.end());
+        REQUIRE(storage.count<Object>() == 12);
+        REQUIRE(storage.get<Object>(12).name == "name12");
+        //  the statement for full chunks is cached
+        REQUIRE(storage.statement_cache_stats().size > 0);
+
+        //  range fitting into a single chunk
+        std::vector<Object> fewObjects = {Object{0, "a"}, Object{0, "b"}};
+        storage.insert_range(fewObjects.begin(), fewObjects.end());
+        REQUIRE(storage.count<Object>() == 14);
+    }
+    SECTION("replace_range") {
+        storage.replace_range(objects.begin(), objects.end());
+        REQUIRE(storage.count<Object>() == 12);
+        std::vector<std::unique_ptr<Object>> pointers;
+        for (auto it = objects.begin() + 1; it != objects.end(); ++it) {
+            pointers.push_back(std::make_unique<Object>(Object{it->id, it->name + "!"}));
+        }
+        storage.replace_range(pointers.begin(), pointers.end(), &std::unique_ptr<Object>::operator*);
+        REQUIRE(storage.get<Object>(1).name == "name1");
+        REQUIRE(storage.get<Object>(11).name == "name11!");
+        REQUIRE(storage.count<Object>() == 12);
+    }
+    SECTION("failing chunk rolls back the whole range") {
+        objects.back().name = objects.front().name;
+        REQUIRE_THROWS_AS(storage.insert_range(objects.begin(), objects.end()), std::system_error);
+        REQUIRE(storage.count<Object>() == 0);
+    }
+    SECTION("within a transaction") {
+        storage.begin_transaction();
+        storage.insert_range(objects.begin(), objects.end());
+        REQUIRE(storage.count<Object>() == 12);
+        storage.rollback();
+        REQUIRE(storage.count<Object>() == 0);
+    }
+}
+
 TEST_CASE("Select") {
     sqlite3* db;
     auto dbFileName = "test.db";
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <sqlite_orm/sqlite_orm.h>
+#include <string>  //  std::string
+#include <utility>  //  std::move
+
+namespace UserStorageTests {
+    struct User {
+        int id = 0;
+        std::string name;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        User() = default;
+        User(int id, std::string name) : id{id}, name{std::move(name)} {}
+#endif
+    };
+
+    inline bool operator==(const User& lhs, const User& rhs) {
+        return lhs.id == rhs.id && lhs.name == rhs.name;
+    }
+
+    inline auto makeStorage(const std::string& filename, sqlite_orm::open_options options = {}) {
+        using namespace sqlite_orm;
+        return make_storage(
+            filename,
+            std::move(options),
+            make_table("users", make_column("id", &User::id, primary_key()), make_column("name", &User::name)));
+    }
+}
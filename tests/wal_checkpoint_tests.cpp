@@ -0,0 +1,140 @@
+#include <sqlite_orm/sqlite_orm.h>
+#include <catch2/catch_all.hpp>
+#include <cstdio>  //  remove
+#include <string>  //  std::string
+#include <algorithm>  //  std::max
+#include <chrono>  //  std::chrono::seconds
+#include <mutex>  //  std::mutex, std::unique_lock
+#include <condition_variable>  //  std::condition_variable
+#include <stdexcept>  //  std::runtime_error
+
+using namespace sqlite_orm;
+
+namespace {
+    struct Event {
+        int id = 0;
+        std::string payload;
+
+#ifndef SQLITE_ORM_AGGREGATE_NSDMI_SUPPORTED
+        Event() = default;
+        Event(int id, std::string payload) : id{id}, payload{std::move(payload)} {}
+#endif
+    };
+
+    void removeDatabase(const std::string& filename) {
+        ::remove(filename.c_str());
+        ::remove((filename + "-wal").c_str());
+        ::remove((filename + "-shm").c_str());
+    }
+}
+
+TEST_CASE("wal checkpoint") {
+    const std::string filename = "wal_checkpoint.sqlite";
+    removeDatabase(filename);
+    auto storage = make_storage(
+        filename,
+        make_table("events", make_column("id", &Event::id, primary_key()), make_column("payload", &Event::payload)));
+    //  a connection closed last checkpoints the WAL and removes it
+    storage.open_forever();
+    storage.sync_schema();
+
+    SECTION("not in WAL mode") {
+        auto result = storage.wal_checkpoint();
+        REQUIRE(result.log_frames == -1);
+        REQUIRE(result.checkpointed_frames == -1);
+        REQUIRE_FALSE(result.busy);
+    }
+    SECTION("modes") {
+        storage.pragma.journal_mode(journal_mode::WAL);
+        for (int i = 1; i <= 10; ++i) {
+            storage.insert(Event{0, "event " + std::to_string(i)});
+        }
+        auto passive = storage.wal_checkpoint();
+        REQUIRE(passive.log_frames > 0);
+        REQUIRE(passive.checkpointed_frames == passive.log_frames);
+        REQUIRE_FALSE(passive.busy);
+
+        auto truncated = storage.wal_checkpoint(checkpoint_mode::truncate);
+        REQUIRE(truncated.log_frames == 0);
+        REQUIRE(truncated.checkpointed_frames == 0);
+        REQUIRE(storage.count<Event>() == 10);
+    }
+    SECTION("background checkpointer") {
+        storage.pragma.journal_mode(journal_mode::WAL);
+        std::mutex mutex;
+        std::condition_variable checkpointed;
+        int checkpointsCount = 0;
+        int logFrames = 0;
+
+        background_checkpoint_options options;
+        options.wal_pages_threshold = 5;
+        options.on_checkpoint = [&](const checkpoint_result& result) {
+            std::lock_guard<std::mutex> lock{mutex};
+            ++checkpointsCount;
+            logFrames = std::max(logFrames, result.log_frames);
+            checkpointed.notify_one();
+        };
+        storage.start_background_checkpointer(options);
+        REQUIRE(storage.has_background_checkpointer());
+
+        for (int i = 1; i <= 10; ++i) {
+            storage.insert(Event{0, "event " + std::to_string(i)});
+        }
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            REQUIRE(checkpointed.wait_for(lock, std::chrono::seconds{10}, [&checkpointsCount] {
+                return checkpointsCount > 0;
+            }));
+            REQUIRE(logFrames >= 5);
+        }
+
+        storage.stop_background_checkpointer();
+        REQUIRE_FALSE(storage.has_background_checkpointer());
+        REQUIRE(storage.count<Event>() == 10);
+    }
+    SECTION("throwing callbacks") {
+        storage.pragma.journal_mode(journal_mode::WAL);
+        std::mutex mutex;
+        std::condition_variable checkpointed;
+        int checkpointsCount = 0;
+
+        background_checkpoint_options options;
+        options.wal_pages_threshold = 1;
+        options.on_checkpoint = [&](const checkpoint_result&) {
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                ++checkpointsCount;
+            }
+            checkpointed.notify_one();
+            throw std::runtime_error{"on_checkpoint"};
+        };
+        storage.start_background_checkpointer(options);
+
+        storage.insert(Event{0, "first"});
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            REQUIRE(checkpointed.wait_for(lock, std::chrono::seconds{10}, [&checkpointsCount] {
+                return checkpointsCount > 0;
+            }));
+        }
+        //  the checkpointer keeps running
+        storage.insert(Event{0, "second"});
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            REQUIRE(checkpointed.wait_for(lock, std::chrono::seconds{10}, [&checkpointsCount] {
+                return checkpointsCount > 1;
+            }));
+        }
+        storage.stop_background_checkpointer();
+        REQUIRE(storage.count<Event>() == 2);
+    }
+    SECTION("auto-checkpoints are restored") {
+        storage.pragma.journal_mode(journal_mode::WAL);
+        storage.start_background_checkpointer();
+        //  the hook of the background checkpointer stays in place
+        storage.pragma.wal_autocheckpoint(500);
+        REQUIRE(storage.pragma.wal_autocheckpoint() == 0);
+        storage.stop_background_checkpointer();
+        REQUIRE(storage.pragma.wal_autocheckpoint() == 500);
+    }
+}